@@ -0,0 +1,182 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>          // uintptr_t
+#include <jni.h>
+
+#ifndef ALIGNEDBUFFER_INCLUDED_
+#include "AlignedBuffer.h"
+#endif /* ALIGNEDBUFFER_INCLUDED_ */
+
+#ifndef __CONTEXT_H_INCLUDED_
+#include "Context.h"
+#endif /* __CONTEXT_H_INCLUDED_ */
+
+#ifndef JEXCEPTION_INCLUDED_
+#include "JException.h"
+#endif /* JEXCEPTION_INCLUDED_ */
+
+#ifndef JEXCEPTIONUTILS_INCLUDED_
+#include "JExceptionUtils.h"
+#endif /* JEXCEPTIONUTILS_INCLUDED_ */
+
+#if !defined (_WIN64) && !defined (_WIN32)
+#include <sys/mman.h>        // mmap, munmap, madvise, mlock
+#endif
+
+
+constexpr size_t PAGE_BYTES = 4096;
+
+static size_t round_up(size_t n, size_t multiple) {
+    return (n + multiple - 1) / multiple * multiple;
+}
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    /*
+     * Class:     net_cramer_simd_AlignedBuffer
+     * Method:    allocate_n
+     * Signature: (JI[J)J
+     */
+    JNIEXPORT jlong JNICALL Java_net_cramer_simd_AlignedBuffer_allocate_1n
+    (JNIEnv* env, jclass, jlong bytes, jint flags, jlongArray info) {
+        if (bytes <= 0 || info == nullptr) {
+            throwJavaRuntimeException(env, "%s %lld", "aligned_allocate - invalid size argument:",
+                static_cast<long long>(bytes));
+            return 0;
+        }
+        try {
+            const bool hugePages = (flags & ALIGNED_HUGE_PAGES) != 0;
+            const size_t size = round_up(static_cast<size_t>(bytes), hugePages ? HUGE_PAGE_BYTES : PAGE_BYTES);
+            bool huge = false;
+            void* p = page_allocate(size, hugePages, huge);
+            if (p == nullptr) {
+                return 0;
+            }
+            jlong res[2] = { static_cast<jlong>(size), huge ? ALIGNED_HUGE_PAGES : 0 };
+            if ((flags & ALIGNED_LOCK) != 0 && page_lock(p, size)) {
+                res[1] |= ALIGNED_LOCK;
+            }
+            try {
+                static_cast<Context*>(env)->SetLongArrayRegion(info, 0, 2, res);
+            }
+            catch (...) {
+                page_free(p, size);
+                throw;
+            }
+            return static_cast<jlong>(reinterpret_cast<uintptr_t>(p));
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "aligned_allocate", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "aligned_allocate: caught unknown exception");
+        }
+        return 0;
+    }
+
+    /*
+     * Class:     net_cramer_simd_AlignedBuffer
+     * Method:    free_n
+     * Signature: (JJ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_AlignedBuffer_free_1n
+    (JNIEnv*, jclass, jlong address, jlong reserved) {
+        if (address != 0) {
+            page_free(address_ptr<void>(address), static_cast<size_t>(reserved));
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_AlignedBuffer
+     * Method:    view_n
+     * Signature: (JJ)Ljava/nio/ByteBuffer;
+     */
+    JNIEXPORT jobject JNICALL Java_net_cramer_simd_AlignedBuffer_view_1n
+    (JNIEnv* env, jclass, jlong address, jlong bytes) {
+        try {
+            return static_cast<Context*>(env)->NewDirectByteBuffer(
+                address_ptr<void>(address), bytes);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "aligned_view", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "aligned_view: caught unknown exception");
+        }
+        return nullptr;
+    }
+#ifdef __cplusplus
+}
+#endif
+
+
+void* page_allocate(size_t size, bool hugePages, bool& huge) {
+    huge = false;
+#if defined (_WIN64) || defined (_WIN32)
+    SIZE_T large = GetLargePageMinimum();
+    if (hugePages && large != 0 && size % large == 0) {
+        void* p = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+        if (p != nullptr) {
+            huge = true;
+            return p;
+        }
+    }
+    return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+    if (!hugePages) {
+        void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        return (p == MAP_FAILED) ? nullptr : p;
+    }
+    // over-allocate to get a huge page aligned range and unmap the rest
+    size_t span = size + HUGE_PAGE_BYTES;
+    void* p = mmap(nullptr, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+        return nullptr;
+    }
+    char* base = static_cast<char*>(p);
+    char* aligned = reinterpret_cast<char*>(round_up(reinterpret_cast<uintptr_t>(base), HUGE_PAGE_BYTES));
+    if (aligned > base) {
+        munmap(base, aligned - base);
+    }
+    if (aligned + size < base + span) {
+        munmap(aligned + size, (base + span) - (aligned + size));
+    }
+#ifdef MADV_HUGEPAGE
+    huge = (madvise(aligned, size, MADV_HUGEPAGE) == 0);
+#endif
+    return aligned;
+#endif
+}
+
+void page_free(void* p, size_t size) {
+#if defined (_WIN64) || defined (_WIN32)
+    (void) size;
+    VirtualFree(p, 0, MEM_RELEASE);
+#else
+    munmap(p, size);
+#endif
+}
+
+bool page_lock(void* p, size_t size) {
+#if defined (_WIN64) || defined (_WIN32)
+    return VirtualLock(p, size) != 0;
+#else
+    return mlock(p, size) == 0;
+#endif
+}
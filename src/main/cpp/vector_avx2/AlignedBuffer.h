@@ -0,0 +1,55 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ALIGNEDBUFFER_INCLUDED_
+#define ALIGNEDBUFFER_INCLUDED_
+
+#ifndef STDAFX_INCLUDED_
+#include "stdafx.h"
+#endif /* STDAFX_INCLUDED_ */
+
+#include <stddef.h>          // size_t
+#include <stdint.h>          // int64_t, uintptr_t
+
+// size (and alignment) of a (transparent) huge page
+constexpr size_t HUGE_PAGE_BYTES = size_t(2) << 20;
+
+// flags of AlignedBuffer allocations (keep in sync with AlignedBuffer.java)
+constexpr int ALIGNED_LOCK = 1;
+constexpr int ALIGNED_HUGE_PAGES = 2;
+
+// Page-aligned (hence 64-byte aligned) memory directly from the OS, used
+// for the off-heap AlignedBuffers and the blocks of the Arena. If hugePages
+// the range is huge page aligned and backed by huge pages where possible
+// (huge is set if that worked: transparent huge pages on Linux, large pages
+// on Windows which need the SeLockMemoryPrivilege). Returns nullptr if the
+// allocation fails.
+void* page_allocate(size_t size, bool hugePages, bool& huge);
+
+void page_free(void* p, size_t size);
+
+// Tries to lock the range into physical memory (may fail, e.g., due to
+// RLIMIT_MEMLOCK or the working set size of the process)
+bool page_lock(void* p, size_t size);
+
+// The address of an AlignedBuffer as passed from Java (bounds are checked
+// in AlignedBuffer.java)
+template <typename T>
+inline T* address_ptr(int64_t address) {
+    return reinterpret_cast<T*>(static_cast<uintptr_t>(address));
+}
+
+#endif /* ALIGNEDBUFFER_INCLUDED_ */
@@ -0,0 +1,144 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ARENA_INCLUDED_
+#include "Arena.h"
+#endif /* ARENA_INCLUDED_ */
+
+#include <algorithm>         // std::max
+#include <atomic>            // std::atomic
+#include <new>               // std::bad_alloc
+
+#ifndef ALIGNEDBUFFER_INCLUDED_
+#include "AlignedBuffer.h"
+#endif /* ALIGNEDBUFFER_INCLUDED_ */
+
+
+// totals over the arenas of all threads
+static std::atomic<int64_t> g_reserved(0);
+static std::atomic<int64_t> g_peakReserved(0);
+static std::atomic<int64_t> g_hugeReserved(0);
+static std::atomic<int64_t> g_highWater(0);
+
+static void atomic_max(std::atomic<int64_t>& target, int64_t value) {
+    int64_t prev = target.load(std::memory_order_relaxed);
+    while (prev < value && !target.compare_exchange_weak(prev, value, std::memory_order_relaxed)) {
+    }
+}
+
+static size_t round_up(size_t n, size_t multiple) {
+    return (n + multiple - 1) / multiple * multiple;
+}
+
+
+Arena& Arena::local() {
+    static thread_local Arena arena;
+    return arena;
+}
+
+Arena::Arena()
+    : current(0), offset(0), inUse(0), highWater(0), reserved(0), scopes(0) {
+}
+
+Arena::~Arena() {
+    for (const Block& b : blocks) {
+        page_free(b.base, b.size);
+        g_reserved -= b.size;
+        if (b.huge) {
+            g_hugeReserved -= b.size;
+        }
+    }
+}
+
+void* Arena::allocate(size_t bytes) {
+    bytes = round_up(std::max(bytes, size_t(1)), ARENA_ALIGNMENT);
+    // the blocks after the current one are unused
+    while (current < blocks.size() && blocks[current].size - offset < bytes) {
+        ++current;
+        offset = 0;
+    }
+    if (current == blocks.size()) {
+        size_t size = std::max(bytes, ARENA_BLOCK_BYTES);
+        size = round_up(size, (size >= ARENA_HUGE_PAGE_BYTES) ? ARENA_HUGE_PAGE_BYTES : size_t(4096));
+        bool huge = false;
+        void* base = page_allocate(size, size >= ARENA_HUGE_PAGE_BYTES, huge);
+        if (base == nullptr) {
+            throw std::bad_alloc();
+        }
+        blocks.push_back(Block{ static_cast<char*>(base), size, huge });
+        reserved += size;
+        atomic_max(g_peakReserved, g_reserved += size);
+        if (huge) {
+            g_hugeReserved += size;
+        }
+    }
+    void* p = blocks[current].base + offset;
+    offset += bytes;
+    inUse += bytes;
+    if (inUse > highWater) {
+        highWater = inUse;
+        atomic_max(g_highWater, int64_t(highWater));
+    }
+    return p;
+}
+
+Arena::Mark Arena::mark() const {
+    return Mark{ current, offset, inUse };
+}
+
+void Arena::rewind(const Mark& m) {
+    current = m.block;
+    offset = m.offset;
+    inUse = m.inUse;
+}
+
+// returns the unused blocks beyond ARENA_RETAIN_BYTES to the OS
+void Arena::trim() {
+    while (reserved > ARENA_RETAIN_BYTES && blocks.size() > current + 1) {
+        const Block& b = blocks.back();
+        page_free(b.base, b.size);
+        reserved -= b.size;
+        g_reserved -= b.size;
+        if (b.huge) {
+            g_hugeReserved -= b.size;
+        }
+        blocks.pop_back();
+    }
+}
+
+void Arena::stats(ArenaStats& st) {
+    const Arena& arena = local();
+    st.threadInUse = arena.inUse;
+    st.threadHighWater = arena.highWater;
+    st.threadReserved = arena.reserved;
+    st.highWater = g_highWater.load();
+    st.reserved = g_reserved.load();
+    st.peakReserved = g_peakReserved.load();
+    st.hugeReserved = g_hugeReserved.load();
+}
+
+
+ArenaScope::ArenaScope()
+    : arena(Arena::local()), saved(arena.mark()) {
+    ++arena.scopes;
+}
+
+ArenaScope::~ArenaScope() {
+    arena.rewind(saved);
+    if (--arena.scopes == 0) {
+        arena.trim();
+    }
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ARENA_INCLUDED_
+#define ARENA_INCLUDED_
+
+#ifndef STDAFX_INCLUDED_
+#include "stdafx.h"
+#endif /* STDAFX_INCLUDED_ */
+
+#include <stddef.h>          // size_t
+#include <stdint.h>          // int64_t
+#include <string.h>          // memset
+#include <vector>            // std::vector
+
+// alignment of all arena allocations (a cache line, an AVX-512 register)
+constexpr size_t ARENA_ALIGNMENT = 64;
+// smallest block the arena gets from the OS
+constexpr size_t ARENA_BLOCK_BYTES = size_t(1) << 20;
+// blocks of at least this size are backed by huge pages where possible
+constexpr size_t ARENA_HUGE_PAGE_BYTES = size_t(2) << 20;
+// memory a thread keeps for reuse once its outermost ArenaScope has ended
+constexpr size_t ARENA_RETAIN_BYTES = size_t(64) << 20;
+
+// Usage statistics of the arenas. The layout must be kept in sync with
+// ArenaStats.java
+struct ArenaStats {
+    int64_t threadInUse;        // bytes in use in the arena of the calling thread
+    int64_t threadHighWater;    // most bytes ever in use in that arena
+    int64_t threadReserved;     // bytes of the blocks that arena holds
+    int64_t highWater;          // largest threadHighWater of all threads so far
+    int64_t reserved;           // bytes of the blocks of all arenas
+    int64_t peakReserved;       // most bytes the arenas ever held together
+    int64_t hugeReserved;       // part of reserved that is backed by huge pages
+};
+
+constexpr int ARENA_STATS_LENGTH = 7;
+
+
+// Per-thread bump allocator for the scratch memory of the kernels (and of
+// the exception message formatting). The memory comes from 64-byte aligned
+// blocks that are kept across native calls, so a kernel's temporaries cost
+// a pointer bump instead of a malloc / free pair. Allocations live until
+// the innermost enclosing ArenaScope ends. Must not be used by the worker
+// threads of parallel_for (allocate up front on the calling thread).
+class __GCC_DONT_EXPORT Arena
+{
+public:
+    // the arena of the calling thread
+    static Arena& local();
+
+    // bytes aligned to ARENA_ALIGNMENT (throws std::bad_alloc)
+    void* allocate(size_t bytes);
+
+    // uninitialized storage for count elements of a trivial type
+    template <typename T>
+    T* allocate(int64_t count) {
+        return static_cast<T*>(allocate(size_t(count) * sizeof(T)));
+    }
+
+    template <typename T>
+    T* allocate_zeroed(int64_t count);
+
+    static void stats(ArenaStats& st);
+
+    ~Arena();
+
+private:
+    struct Block {
+        char* base;
+        size_t size;
+        bool huge;
+    };
+
+    struct Mark {
+        size_t block;
+        size_t offset;
+        size_t inUse;
+    };
+
+    Arena();
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    Mark mark() const;
+    void rewind(const Mark& m);
+    void trim();
+
+    std::vector<Block> blocks;
+    size_t current;
+    size_t offset;
+    size_t inUse;
+    size_t highWater;
+    size_t reserved;
+    int scopes;
+
+    friend class ArenaScope;
+};
+
+// Releases everything allocated from the calling thread's arena while it
+// was alive. The outermost scope of a native call resets the arena.
+class __GCC_DONT_EXPORT ArenaScope
+{
+public:
+    ArenaScope();
+    ~ArenaScope();
+
+private:
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+    Arena& arena;
+    Arena::Mark saved;
+};
+
+template <typename T>
+T* Arena::allocate_zeroed(int64_t count) {
+    T* p = allocate<T>(count);
+    memset(p, 0, size_t(count) * sizeof(T));
+    return p;
+}
+
+#endif /* ARENA_INCLUDED_ */
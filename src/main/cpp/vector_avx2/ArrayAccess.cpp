@@ -0,0 +1,308 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ARRAYACCESS_INCLUDED_
+#include "ArrayAccess.h"
+#endif /* ARRAYACCESS_INCLUDED_ */
+
+#include <algorithm>         // std::min, std::max
+#include <atomic>            // std::atomic
+#include <chrono>            // std::chrono::steady_clock
+#include <string.h>          // memcpy
+#include <vector>            // std::vector
+#include <new>               // std::bad_alloc
+
+#ifndef __CONTEXT_H_INCLUDED_
+#include "Context.h"
+#endif /* __CONTEXT_H_INCLUDED_ */
+
+#ifndef ARENA_INCLUDED_
+#include "Arena.h"
+#endif /* ARENA_INCLUDED_ */
+
+#ifndef ALIGNEDBUFFER_INCLUDED_
+#include "AlignedBuffer.h"
+#endif /* ALIGNEDBUFFER_INCLUDED_ */
+
+#ifndef JEXCEPTION_INCLUDED_
+#include "JException.h"
+#endif /* JEXCEPTION_INCLUDED_ */
+
+
+static std::atomic<int64_t> pinMicros(0);
+static std::atomic<int64_t> pinBytes(0);
+
+static double measure_copy_rate() {
+    constexpr size_t bytes = size_t(16) << 20;
+    std::vector<char> src(bytes, 1);
+    std::vector<char> dst(bytes, 0);
+    memcpy(dst.data(), src.data(), bytes);
+    int64_t best = INT64_MAX;
+    for (int i = 0; i < 3; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        memcpy(dst.data(), src.data(), bytes);
+        int64_t took = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        best = std::min(best, took);
+    }
+    // keep the copies from being optimized away
+    volatile char sink = dst[bytes / 2];
+    (void) sink;
+    double rate = double(bytes) / double(std::max(best, int64_t(1)));
+    // clamp to a plausible range in case the clock is too coarse
+    return std::min(std::max(rate, 0.5), 100.0);
+}
+
+double copy_bytes_per_nano() {
+    static const double rate = measure_copy_rate();
+    return rate;
+}
+
+void set_max_pin_micros(int64_t micros) {
+    if (micros <= 0) {
+        pinBytes.store(0);
+        pinMicros.store(0);
+        return;
+    }
+    double bytes = double(micros) * 1000.0 * copy_bytes_per_nano();
+    int64_t limit = bytes >= 9.0e18 ? INT64_MAX : static_cast<int64_t>(bytes);
+    pinBytes.store(std::max(limit, PIN_MIN_SLICE_BYTES));
+    pinMicros.store(micros);
+}
+
+int64_t max_pin_micros() {
+    return pinMicros.load();
+}
+
+int64_t max_pin_bytes() {
+    return pinBytes.load(std::memory_order_relaxed);
+}
+
+void* region_allocate(int64_t bytes, std::optional<ArenaScope>& scope, size_t& pages) {
+    pages = 0;
+    if (bytes <= ACCESS_REGION_MAX_BYTES) {
+        scope.emplace();
+        try {
+            return Arena::local().allocate(size_t(bytes));
+        }
+        catch (const std::bad_alloc&) {
+            scope.reset();
+        }
+    }
+    size_t multiple = size_t(bytes) >= HUGE_PAGE_BYTES ? HUGE_PAGE_BYTES : size_t(4096);
+    size_t size = (size_t(bytes) + multiple - 1) / multiple * multiple;
+    bool huge = false;
+    void* p = page_allocate(size, multiple == HUGE_PAGE_BYTES, huge);
+    if (p != nullptr) {
+        pages = size;
+    }
+    return p;
+}
+
+int region_fallback(int64_t bytes) {
+    int64_t limit = max_pin_bytes();
+    if (limit > 0 && bytes > limit) {
+        throw JException("not enough memory to copy an array larger than the pin time limit");
+    }
+    return has_copies() ? ACCESS_ELEMENTS : ACCESS_CRITICAL;
+}
+
+struct ArrayCopy {
+    jarray array;
+    void* elements;
+    int64_t length;
+    bool written;
+};
+
+static thread_local std::vector<ArrayCopy> copies;
+
+bool has_copies() {
+    return !copies.empty();
+}
+
+void* find_copy(JNIEnv* env, jarray array, int64_t length, bool write) {
+    Context* ctx = static_cast<Context*>(env);
+    for (ArrayCopy& c : copies) {
+        if (c.length >= length && ctx->IsSameObject(c.array, array)) {
+            c.written = c.written || write;
+            return c.elements;
+        }
+    }
+    return nullptr;
+}
+
+void add_copy(jarray array, void* elements, int64_t length, bool write) {
+    copies.push_back(ArrayCopy{ array, elements, length, write });
+}
+
+bool remove_copy(void* elements) {
+    for (size_t i = copies.size(); i-- > 0; ) {
+        if (copies[i].elements == elements) {
+            bool written = copies[i].written;
+            copies.erase(copies.begin() + i);
+            return written;
+        }
+    }
+    return true;
+}
+
+constexpr int CALIBRATION_NONE = 0;
+constexpr int CALIBRATION_RUNNING = 1;
+constexpr int CALIBRATION_DONE = 2;
+constexpr int CALIBRATION_FAILED = 3;
+
+// an alternative to pinning must be at least that much faster to be used
+constexpr double ACCESS_MIN_GAIN = 0.9;
+
+static std::atomic<bool> adaptive(true);
+static std::atomic<int> calibration(CALIBRATION_NONE);
+static AccessClass classes[ACCESS_SIZE_CLASSES];
+static int modes[ACCESS_SIZE_CLASSES];
+
+static int size_class(int64_t bytes) {
+    int k = 0;
+    for (int64_t bound = ACCESS_MIN_CLASS_BYTES; k < ACCESS_SIZE_CLASSES - 1 && bytes > bound; bound *= 4) {
+        ++k;
+    }
+    return k;
+}
+
+// one load per cache line, as a stand-in for the kernel's pass over the data
+static double touch(const double* p, jsize n) {
+    double sum = 0.0;
+    for (jsize i = 0; i < n; i += 8) {
+        sum += p[i];
+    }
+    return sum;
+}
+
+// the best of three batches of reps accesses, in nanoseconds per access
+static double time_access(Context* ctx, jdoubleArray array, jsize n, int mode, double* scratch, int reps) {
+    double best = 1.0e300;
+    double sum = 0.0;
+    for (int batch = 0; batch < 3; ++batch) {
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < reps; ++r) {
+            jboolean isCopy = JNI_FALSE;
+            if (mode == ACCESS_CRITICAL) {
+                double* p = static_cast<double*>(ctx->GetPrimitiveArrayCritical(array, &isCopy));
+                if (p == nullptr) {
+                    throw JException("calibration: GetPrimitiveArrayCritical failed");
+                }
+                sum += touch(p, n);
+                ctx->ReleasePrimitiveArrayCritical(array, p, 0);
+            } else if (mode == ACCESS_ELEMENTS) {
+                double* p = ctx->GetDoubleArrayElements(array, &isCopy);
+                if (p == nullptr) {
+                    throw JException("calibration: GetDoubleArrayElements failed");
+                }
+                sum += touch(p, n);
+                ctx->ReleaseDoubleArrayElements(array, p, 0);
+            } else {
+                ctx->GetDoubleArrayRegion(array, 0, n, scratch);
+                sum += touch(scratch, n);
+                ctx->SetDoubleArrayRegion(array, 0, n, scratch);
+            }
+        }
+        double took = double(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+        best = std::min(best, took / reps);
+    }
+    // keep the loads from being optimized away
+    volatile double sink = sum;
+    (void) sink;
+    return best;
+}
+
+static void calibrate(JNIEnv* env) {
+    Context* ctx = static_cast<Context*>(env);
+    ArenaScope scope;
+    int64_t maxBytes = ACCESS_MIN_CLASS_BYTES << (2 * (ACCESS_SIZE_CLASSES - 1));
+    double* scratch = Arena::local().allocate<double>(maxBytes / int64_t(sizeof(double)));
+    int64_t bytes = ACCESS_MIN_CLASS_BYTES;
+    for (int k = 0; k < ACCESS_SIZE_CLASSES; ++k, bytes *= 4) {
+        jsize n = static_cast<jsize>(bytes / int64_t(sizeof(double)));
+        int reps = static_cast<int>(std::min(std::max((int64_t(1) << 20) / bytes, int64_t(2)), int64_t(1024)));
+        jdoubleArray array = ctx->NewDoubleArray(n);
+        AccessClass& c = classes[k];
+        c.maxBytes = double(bytes);
+        // warm up (first touch, lazy JNI setup)
+        time_access(ctx, array, n, ACCESS_REGION, scratch, 1);
+        for (int mode = ACCESS_CRITICAL; mode <= ACCESS_REGION; ++mode) {
+            c.nanos[mode] = time_access(ctx, array, n, mode, scratch, reps);
+        }
+        ctx->DeleteLocalRef(array);
+        int best = ACCESS_CRITICAL;
+        for (int mode = ACCESS_ELEMENTS; mode <= ACCESS_REGION; ++mode) {
+            if (c.nanos[mode] < ACCESS_MIN_GAIN * c.nanos[ACCESS_CRITICAL] && c.nanos[mode] < c.nanos[best]) {
+                best = mode;
+            }
+        }
+        c.mode = double(best);
+        modes[k] = best;
+    }
+}
+
+void calibrate_access(JNIEnv* env) {
+    int expected = CALIBRATION_NONE;
+    if (!calibration.compare_exchange_strong(expected, CALIBRATION_RUNNING)) {
+        return;
+    }
+    try {
+        calibrate(env);
+        calibration.store(CALIBRATION_DONE, std::memory_order_release);
+    }
+    catch (...) {
+        // JException (e.g. OutOfMemoryError) or std::bad_alloc: keep pinning
+        calibration.store(CALIBRATION_FAILED, std::memory_order_release);
+    }
+}
+
+int access_mode(int64_t bytes) {
+    int64_t limit = max_pin_bytes();
+    if (limit > 0 && bytes > limit) {
+        return ACCESS_REGION;
+    }
+    if (!adaptive.load(std::memory_order_relaxed)) {
+        return ACCESS_CRITICAL;
+    }
+    // a concurrent set_adaptive_access() may still be calibrating
+    int state = calibration.load(std::memory_order_acquire);
+    return state == CALIBRATION_DONE ? modes[size_class(bytes)] : ACCESS_CRITICAL;
+}
+
+void set_adaptive_access(JNIEnv* env, bool enabled) {
+    if (enabled) {
+        calibrate_access(env);
+    }
+    adaptive.store(enabled);
+}
+
+void access_policy(AccessPolicyInfo& info) {
+    bool enabled = adaptive.load();
+    bool done = calibration.load(std::memory_order_acquire) == CALIBRATION_DONE;
+    info.adaptive = enabled ? 1.0 : 0.0;
+    info.calibrated = done ? 1.0 : 0.0;
+    info.maxPinBytes = double(max_pin_bytes());
+    int64_t bytes = ACCESS_MIN_CLASS_BYTES;
+    for (int k = 0; k < ACCESS_SIZE_CLASSES; ++k, bytes *= 4) {
+        if (done) {
+            info.classes[k] = classes[k];
+        } else {
+            info.classes[k] = AccessClass{ double(bytes), double(ACCESS_CRITICAL), { 0.0, 0.0, 0.0 } };
+        }
+    }
+}
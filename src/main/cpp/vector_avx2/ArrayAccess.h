@@ -0,0 +1,142 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ARRAYACCESS_INCLUDED_
+#define ARRAYACCESS_INCLUDED_
+
+#ifndef STDAFX_INCLUDED_
+#include "stdafx.h"
+#endif /* STDAFX_INCLUDED_ */
+
+#include <stddef.h>          // size_t
+#include <stdint.h>          // int64_t
+#include <optional>          // std::optional
+
+#ifndef _JAVASOFT_JNI_H_
+#include <jni.h>
+#endif /* _JAVASOFT_JNI_H_ */
+
+#ifndef ARENA_INCLUDED_
+#include "Arena.h"
+#endif /* ARENA_INCLUDED_ */
+
+// how the array wrappers access the elements of a Java array (IntArray,
+// LongArray, ShortArray and ByteArray only pin or use ACCESS_ELEMENTS)
+constexpr int ACCESS_CRITICAL = 0;   // Get / ReleasePrimitiveArrayCritical
+constexpr int ACCESS_ELEMENTS = 1;   // Get / Release<Type>ArrayElements
+constexpr int ACCESS_REGION = 2;     // Get / Set<Type>ArrayRegion into arena memory
+constexpr int ACCESS_SHARED = 3;     // the copy another wrapper holds of the same array
+
+// smallest slice a pinned copy is split into
+constexpr int64_t PIN_MIN_SLICE_BYTES = int64_t(64) << 10;
+
+// Limits the time a single native call keeps a Java array pinned (which
+// blocks the garbage collector for all threads). The limit is converted
+// into a byte count with the memory bandwidth measured on first use: in
+// critical mode DoubleArray / FloatArray pin arrays up to that size for
+// the whole kernel, larger ones are copied slice by slice (each slice a
+// Get<Type>ArrayRegion call of bounded duration) into arena memory and
+// written back the same way, so the kernel itself runs unpinned.
+// micros <= 0 removes the limit (the default).
+void set_max_pin_micros(int64_t micros);
+int64_t max_pin_micros();
+
+// the byte size above which an array is copied instead of pinned for the
+// whole call (0: no limit)
+int64_t max_pin_bytes();
+
+// rough bandwidth of a large memcpy in bytes per nanosecond (measured once)
+double copy_bytes_per_nano();
+
+// Adaptive access policy: which of ACCESS_CRITICAL / ACCESS_ELEMENTS /
+// ACCESS_REGION is cheapest depends on the JVM (its GC and whether it pins
+// or copies) and on the array size. When the library gets loaded
+// (JNI_OnLoad) calibrate_access() benchmarks the three strategies (acquire,
+// read every cache line, release) on double[] arrays of ACCESS_SIZE_CLASSES
+// sizes, once, and from then on DoubleArray / FloatArray use the fastest one
+// per size class for callers that allow critical access. If the calibration
+// fails they keep pinning as requested. A pin time limit set with
+// set_max_pin_micros() takes precedence.
+constexpr int ACCESS_SIZE_CLASSES = 8;
+// class k holds the arrays of up to ACCESS_MIN_CLASS_BYTES * 4^k bytes (the
+// last class all larger ones)
+constexpr int64_t ACCESS_MIN_CLASS_BYTES = 128;
+
+// Result of the calibration of one size class
+struct AccessClass {
+    double maxBytes;           // upper bound of the class (the size benchmarked)
+    double mode;               // the ACCESS_* mode used for the class
+    double nanos[3];           // per access, indexed by ACCESS_CRITICAL..ACCESS_REGION
+};
+
+// Diagnostics of the policy. The layout must be kept in sync with
+// AccessPolicy.java
+struct AccessPolicyInfo {
+    double adaptive;           // 1 if the adaptive policy is enabled
+    double calibrated;         // 1 once the benchmark has run successfully
+    double maxPinBytes;        // see max_pin_bytes()
+    AccessClass classes[ACCESS_SIZE_CLASSES];
+};
+
+constexpr int ACCESS_POLICY_LENGTH = 3 + 5 * ACCESS_SIZE_CLASSES;
+
+// The mode for an array of the given size whose caller allows critical
+// access (never calibrates, so it is safe inside a critical region)
+int access_mode(int64_t bytes);
+// runs the calibration unless that has been done (or tried) already, must
+// not be called while a critical region is held
+void calibrate_access(JNIEnv* env);
+// enabling calibrates first if that hasn't been done yet
+void set_adaptive_access(JNIEnv* env, bool enabled);
+void access_policy(AccessPolicyInfo& info);
+
+// ACCESS_REGION copies the whole array, so it doubles the memory the array
+// needs for the duration of the call. Copies up to this size (the arena
+// memory retained between calls, see ARENA_RETAIN_BYTES) live in the arena,
+// larger ones get pages of their own that are returned to the OS when the
+// wrapper ends. Either way the copy is made slice by slice.
+constexpr int64_t ACCESS_REGION_MAX_BYTES = int64_t(64) << 20;
+
+// Memory for the ACCESS_REGION copy of an array of the given size, from the
+// arena in scope (which gets emplaced) or, above ACCESS_REGION_MAX_BYTES or
+// if the arena fails, directly from the OS with page_allocate(). pages is
+// set to the size to pass to page_free(), 0 for arena memory. Returns nullptr if
+// there isn't enough memory.
+void* region_allocate(int64_t bytes, std::optional<ArenaScope>& scope, size_t& pages);
+
+// The mode to use instead of ACCESS_REGION if region_allocate() failed:
+// ACCESS_CRITICAL (ACCESS_ELEMENTS while the thread holds copies) if the
+// array may be pinned for the whole call, i.e. unless it is larger than the
+// pin time limit. Beyond the limit neither is acceptable, so this throws.
+int region_fallback(int64_t bytes);
+
+// Copies of Java arrays (ACCESS_ELEMENTS / ACCESS_REGION) the calling thread
+// currently holds. A second wrapper of the same array (e.g. an in-place
+// output) must use the same copy, as it would share the elements if both
+// were pinned, otherwise the write-back of one copy would overwrite the
+// other. Looking a copy up is a JNI call (IsSameObject), so while a thread
+// holds copies the wrappers never pin (has_copies()) and hence never hold a
+// critical region a lookup would violate.
+// find_copy returns nullptr if there is no copy of at least length
+// elements, with write == true it marks the copy as modified.
+// remove_copy returns whether a wrapper of the copy was writable, i.e.
+// whether the copy must be written back.
+bool has_copies();
+void* find_copy(JNIEnv* env, jarray array, int64_t length, bool write);
+void add_copy(jarray array, void* elements, int64_t length, bool write);
+bool remove_copy(void* elements);
+
+#endif /* ARRAYACCESS_INCLUDED_ */
@@ -27,6 +27,11 @@
 
 
 
+// critical regions held by the current thread (see criticalRegions())
+static thread_local int criticalDepth = 0;
+
+
+
 //////////////////////////////////////////////////////////////////////
 // Private helper function for determining the Java stacktrace
 //////////////////////////////////////////////////////////////////////
@@ -3255,6 +3260,9 @@ void* Context::GetPrimitiveArrayCritical(jarray array, jboolean* isCopy)
 {
     clearException();
     void* result = JNIEnv_::GetPrimitiveArrayCritical(array, isCopy);
+    if (result) {
+        ++criticalDepth;
+    }
 
     jthrowable error = JNIEnv_::ExceptionOccurred();
     if (error)
@@ -3270,6 +3278,9 @@ void Context::ReleasePrimitiveArrayCritical(jarray array, void* carray, jint mod
 {
     // release funtions should never throw
     JNIEnv_::ReleasePrimitiveArrayCritical(array, carray, mode);
+    if (carray) {
+        --criticalDepth;
+    }
 }
 
 
@@ -3277,6 +3288,9 @@ const jchar* Context::GetStringCritical(jstring string, jboolean* isCopy)
 {
     clearException();
     const jchar* result = JNIEnv_::GetStringCritical(string, isCopy);
+    if (result) {
+        ++criticalDepth;
+    }
 
     jthrowable error = JNIEnv_::ExceptionOccurred();
     if (error)
@@ -3292,6 +3306,9 @@ void Context::ReleaseStringCritical(jstring string, const jchar* cstring)
 {
     // release funtions should never throw
     JNIEnv_::ReleaseStringCritical(string, cstring);
+    if (cstring) {
+        --criticalDepth;
+    }
 }
 
 
@@ -3367,3 +3384,9 @@ jlong Context::GetDirectBufferCapacity(jobject buf)
 
     return result;
 }
+
+
+int Context::criticalRegions()
+{
+    return criticalDepth;
+}
@@ -487,6 +487,11 @@ public:
 
     jlong GetDirectBufferCapacity(jobject buf);
 
+    // the number of critical regions (arrays and strings) the calling
+    // thread currently holds through a Context; no other JNI function may
+    // be called while this is > 0
+    static int criticalRegions();
+
 private:
     void clearException();
 };
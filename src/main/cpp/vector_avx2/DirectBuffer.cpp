@@ -0,0 +1,71 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DirectBuffer.h"
+
+#ifndef _JAVASOFT_JNI_H_
+#include <jni.h>
+#endif /* _JAVASOFT_JNI_H_ */
+
+#ifndef JEXCEPTION_INCLUDED_
+#include "JException.h"
+#endif /* JEXCEPTION_INCLUDED_ */
+
+
+
+DirectBuffer::DirectBuffer(JNIEnv* env, jobject jbuffer, jlong length)
+    : addr(NULL), len(length)
+{
+    if (jbuffer) {
+        Context* ctx = static_cast<Context*>(env);
+        addr = ctx->GetDirectBufferAddress(jbuffer);
+        if (addr == NULL) {
+            throw JException("Buffer argument is not a direct buffer");
+        }
+        if (length > ctx->GetDirectBufferCapacity(jbuffer)) {
+            throw JException("length argument exceeds the Buffer capacity");
+        }
+    } else {
+        throw JException("Buffer argument: null");
+    }
+}
+
+void* DirectBuffer::address() {
+    return addr;
+}
+
+double* DirectBuffer::doublePtr() {
+    return static_cast<double*>(addr);
+}
+
+float* DirectBuffer::floatPtr() {
+    return static_cast<float*>(addr);
+}
+
+int32_t* DirectBuffer::intPtr() {
+    return static_cast<int32_t*>(addr);
+}
+
+int64_t* DirectBuffer::longPtr() {
+    return static_cast<int64_t*>(addr);
+}
+
+jlong DirectBuffer::length() {
+    return len;
+}
+
+DirectBuffer::~DirectBuffer() {
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DIRECTBUFFER_INCLUDED_
+#define DIRECTBUFFER_INCLUDED_
+
+#ifndef STDAFX_INCLUDED_
+#include "stdafx.h"
+#endif /* STDAFX_INCLUDED_ */
+
+#ifndef __CONTEXT_H_INCLUDED_
+#include "Context.h"
+#endif /* __CONTEXT_H_INCLUDED_ */
+
+// Access to the memory of a direct java.nio.Buffer. The length is given
+// in elements of the Buffer (e.g., doubles for a DoubleBuffer) and must
+// not exceed the capacity of the Buffer. Nothing has to be released.
+class __GCC_DONT_EXPORT DirectBuffer
+{
+public:
+    DirectBuffer(JNIEnv* env, jobject jbuffer, jlong length);
+    ~DirectBuffer();
+    void* address();
+    double* doublePtr();
+    float* floatPtr();
+    int32_t* intPtr();
+    int64_t* longPtr();
+    jlong length();
+private:
+    void* addr;
+    jlong len;
+};
+
+#endif /* DIRECTBUFFER_INCLUDED_ */
@@ -24,14 +24,65 @@
 #include "JException.h"
 #endif /* JEXCEPTION_INCLUDED_ */
 
+#ifndef ARRAYACCESS_INCLUDED_
+#include "ArrayAccess.h"
+#endif /* ARRAYACCESS_INCLUDED_ */
 
+#ifndef ALIGNEDBUFFER_INCLUDED_
+#include "AlignedBuffer.h"
+#endif /* ALIGNEDBUFFER_INCLUDED_ */
 
-FloatArray::FloatArray(JNIEnv* env, jfloatArray jarray, long length, jboolean critical)
-    : ctx(static_cast<Context*>(env)), jarray(jarray), len(length), critical(critical == JNI_TRUE)
+#include <algorithm>         // std::min
+
+
+
+FloatArray::FloatArray(JNIEnv* env, jfloatArray jarray, long length, jboolean critical, bool readOnly)
+    : ctx(static_cast<Context*>(env)), jarray(jarray), carray(nullptr), len(length), mode(ACCESS_CRITICAL), slice(0), pages(0), readOnly(readOnly)
 {
     if (jarray) {
+        if (length > ctx->GetArrayLength(jarray)) {
+            throw JException("length argument exceeds the jfloatArray array length");
+        }
+        int64_t bytes = int64_t(length) * int64_t(sizeof(float));
+        if (has_copies()) {
+            // no critical region is held (see find_copy), and none must be
+            // taken: a pinned alias of a copied array would be overwritten
+            // by the write-back of the copy
+            carray = static_cast<float*>(find_copy(env, jarray, length, !readOnly));
+            if (carray) {
+                mode = ACCESS_SHARED;
+                return;
+            }
+            mode = critical ? ACCESS_REGION : ACCESS_ELEMENTS;
+        } else if (!critical) {
+            mode = ACCESS_ELEMENTS;
+        } else if (Context::criticalRegions() == 0) {
+            // copies are made by JNI calls and hence impossible while another
+            // critical region is held
+            mode = access_mode(bytes);
+        }
+        if (mode == ACCESS_REGION) {
+            carray = static_cast<float*>(region_allocate(bytes, scope, pages));
+            if (carray == nullptr) {
+                mode = region_fallback(bytes);
+            }
+        }
         jboolean isCopy = JNI_FALSE;
-        if (critical) {
+        if (mode == ACCESS_REGION) {
+            int64_t limit = max_pin_bytes();
+            slice = limit > 0 ? static_cast<long>(std::min(int64_t(length), limit / int64_t(sizeof(float)))) : length;
+            try {
+                for (long off = 0; off < length; off += slice) {
+                    ctx->GetFloatArrayRegion(jarray, off, std::min(slice, length - off), carray + off);
+                }
+            }
+            catch (...) {
+                if (pages) {
+                    page_free(carray, pages);
+                }
+                throw;
+            }
+        } else if (mode == ACCESS_CRITICAL) {
             carray = static_cast<float*>(ctx->GetPrimitiveArrayCritical(jarray, &isCopy));
         } else {
             carray = ctx->GetFloatArrayElements(jarray, &isCopy);
@@ -39,6 +90,9 @@ FloatArray::FloatArray(JNIEnv* env, jfloatArray jarray, long length, jboolean cr
         if (carray == NULL) {
             throw JException("float* result: NULL");
         }
+        if (mode != ACCESS_CRITICAL) {
+            add_copy(jarray, carray, length, !readOnly);
+        }
     } else {
         throw JException("jfloatArray argument: null");
     }
@@ -53,9 +107,20 @@ long FloatArray::length() {
 }
 
 FloatArray::~FloatArray() {
-    if (critical) {
-        ctx->ReleasePrimitiveArrayCritical(jarray, carray, 0);
-    } else {
-        ctx->ReleaseFloatArrayElements(jarray, carray, 0);
+    if (mode == ACCESS_REGION) {
+        // write back unless no wrapper of the copy may have modified it,
+        // like the release functions this must not throw
+        if (remove_copy(carray)) {
+            for (long off = 0; off < len; off += slice) {
+                ctx->JNIEnv_::SetFloatArrayRegion(jarray, off, std::min(slice, len - off), carray + off);
+            }
+        }
+        if (pages) {
+            page_free(carray, pages);
+        }
+    } else if (mode == ACCESS_CRITICAL) {
+        ctx->ReleasePrimitiveArrayCritical(jarray, carray, readOnly ? JNI_ABORT : 0);
+    } else if (mode == ACCESS_ELEMENTS) {
+        ctx->ReleaseFloatArrayElements(jarray, carray, remove_copy(carray) ? 0 : JNI_ABORT);
     }
 }
@@ -25,10 +25,24 @@
 #include "Context.h"
 #endif /* __CONTEXT_H_INCLUDED_ */
 
+#ifndef ARENA_INCLUDED_
+#include "Arena.h"
+#endif /* ARENA_INCLUDED_ */
+
+#include <optional>          // std::optional
+
+// Access to the first length elements of a Java float[]. With critical ==
+// JNI_TRUE the array gets pinned for the lifetime of the object, unless the
+// thread holds no other critical region and the access policy (see
+// ArrayAccess.h) prefers a copy for arrays of that size or the array is
+// larger than the pin time limit, in which case it is copied slice by
+// slice (an array beyond the limit is never pinned or copied in one call). A wrapper of an array another wrapper of the thread already holds
+// a copy of uses that copy, and while the thread holds copies no wrapper
+// pins. With readOnly == true the elements are not written back.
 class __GCC_DONT_EXPORT FloatArray
 {
 public:
-    FloatArray(JNIEnv* env, jfloatArray jarray, long length, jboolean critical);
+    FloatArray(JNIEnv* env, jfloatArray jarray, long length, jboolean critical, bool readOnly = false);
     ~FloatArray();
     float* ptr();
     long length();
@@ -37,7 +51,13 @@ private:
     jfloatArray jarray;
     float* carray;
     long len;
-    bool critical;
+    int mode;
+    // ACCESS_REGION: elements per Get / Set<Type>ArrayRegion call
+    long slice;
+    // ACCESS_REGION: size of the pages of a copy beyond ACCESS_REGION_MAX_BYTES
+    size_t pages;
+    std::optional<ArenaScope> scope;
+    bool readOnly;
 };
 
 #endif /* FLOATARRAY_INCLUDED_ */
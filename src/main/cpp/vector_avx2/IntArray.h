@@ -0,0 +1,47 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INTARRAY_INCLUDED_
+#define INTARRAY_INCLUDED_
+
+#include <stdint.h>          // int32_t
+
+#ifndef STDAFX_INCLUDED_
+#include "stdafx.h"
+#endif /* STDAFX_INCLUDED_ */
+
+#ifndef __CONTEXT_H_INCLUDED_
+#include "Context.h"
+#endif /* __CONTEXT_H_INCLUDED_ */
+
+// With readOnly == true the elements are not written back
+class __GCC_DONT_EXPORT IntArray
+{
+public:
+    IntArray(JNIEnv* env, jintArray jarray, long length, jboolean critical, bool readOnly = false);
+    ~IntArray();
+    int32_t* ptr();
+    long length();
+private:
+    Context* ctx;
+    jintArray jarray;
+    int32_t* carray;
+    long len;
+    int mode;
+    bool readOnly;
+};
+
+#endif /* INTARRAY_INCLUDED_ */
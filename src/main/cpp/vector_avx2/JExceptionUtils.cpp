@@ -24,7 +24,14 @@
 #endif /* POTABILITY_INCLUDED_ */
 
 
+#ifndef ARENA_INCLUDED_
+#include "Arena.h" // for the message buffers
+#endif /* ARENA_INCLUDED_ */
+
+
+#include <stdio.h> // for vsnprintf
 #include <string.h> // for strncpy
+#include <new> // for std::bad_alloc
 
 
 
@@ -120,7 +127,8 @@ bool printStackTrace(JNIEnv* env, jthrowable exception, char* buf, size_t bufLen
  */
 bool printStackTrace(JNIEnv* env, jthrowable exception, SlimString& msg, const char* context) {
     const int BUFFER_LEN = 4096; // max size of gathered stacktrace is 4K
-    char buffer[BUFFER_LEN] = {0};
+    ArenaScope scope;
+    char* buffer = Arena::local().allocate_zeroed<char>(BUFFER_LEN);
     msg.append(context).append("\n");
     bool success = printStackTrace(env, exception, buffer, BUFFER_LEN);
     msg.append(buffer);
@@ -199,11 +207,28 @@ bool throwJavaRuntimeException(JNIEnv* env, const char* format, ...) {
         if (exceptClass == NULL) {
             return false;
         }
+        // measure first, then format into an exactly sized arena buffer, or
+        // truncated into a stack buffer if the arena is out of memory (which
+        // may well be the error being reported)
         const int MAX_MSG_SIZE = 4096;
-        char message[MAX_MSG_SIZE] = {0};
+        char fallback[MAX_MSG_SIZE];
+        ArenaScope scope;
         va_list args;
         va_start(args, format);
-        int rc = vsprintf(message, format, args);
+        int rc = vsnprintf(NULL, 0, format, args);
+        va_end(args);
+        if (rc < 0) {
+            return false;
+        }
+        char* message = fallback;
+        size_t size = MAX_MSG_SIZE;
+        try {
+            message = Arena::local().allocate<char>(rc + 1);
+            size = size_t(rc) + 1;
+        } catch (const std::bad_alloc&) {
+        }
+        va_start(args, format);
+        rc = vsnprintf(message, size, format, args);
         va_end(args);
         if (rc < 0) {
             return false;
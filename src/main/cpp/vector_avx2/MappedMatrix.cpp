@@ -0,0 +1,248 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>          // uintptr_t
+#include <jni.h>
+
+#ifndef STDAFX_INCLUDED_
+#include "stdafx.h"
+#endif /* STDAFX_INCLUDED_ */
+
+#ifndef ALIGNEDBUFFER_INCLUDED_
+#include "AlignedBuffer.h"
+#endif /* ALIGNEDBUFFER_INCLUDED_ */
+
+#ifndef __CONTEXT_H_INCLUDED_
+#include "Context.h"
+#endif /* __CONTEXT_H_INCLUDED_ */
+
+#ifndef JEXCEPTION_INCLUDED_
+#include "JException.h"
+#endif /* JEXCEPTION_INCLUDED_ */
+
+#ifndef JEXCEPTIONUTILS_INCLUDED_
+#include "JExceptionUtils.h"
+#endif /* JEXCEPTIONUTILS_INCLUDED_ */
+
+#if defined (_WIN64) || defined (_WIN32)
+#include <string>            // std::wstring
+#else
+#include <errno.h>           // errno
+#include <fcntl.h>           // open
+#include <unistd.h>          // close
+#include <sys/mman.h>        // mmap, munmap, madvise, msync
+#include <sys/stat.h>        // fstat
+#endif
+
+
+// Memory mapping of the files of MappedMatrix.java. The header is parsed
+// and written in Java, here the whole file just gets mapped (shared, so
+// that writes go to the file) and the kernels run over the mapped pages
+// through the address based natives of AlignedBuffer.
+
+// access pattern hints, must be kept in sync with MappedMatrix.java
+constexpr int ADVICE_NORMAL = 0;
+constexpr int ADVICE_SEQUENTIAL = 1;
+constexpr int ADVICE_RANDOM = 2;
+constexpr int ADVICE_WILLNEED = 3;
+constexpr int ADVICE_DONTNEED = 4;
+
+
+// Maps the whole file, returns nullptr and an OS error code on failure
+static void* map_file(Context* ctx, jstring path, bool writable, int64_t& length, int64_t& error) {
+    length = 0;
+    error = 0;
+#if defined (_WIN64) || defined (_WIN32)
+    const jchar* chars = ctx->GetStringChars(path, nullptr);
+    std::wstring name(reinterpret_cast<const wchar_t*>(chars), ctx->GetStringLength(path));
+    ctx->ReleaseStringChars(path, chars);
+    HANDLE file = CreateFileW(name.c_str(), writable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ,
+        FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        error = GetLastError();
+        return nullptr;
+    }
+    // an empty file can't be mapped (nullptr without an error code)
+    void* p = nullptr;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        error = GetLastError();
+    } else if (size.QuadPart > 0) {
+        HANDLE mapping = CreateFileMappingW(file, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+        if (mapping != nullptr) {
+            p = MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0);
+        }
+        if (p == nullptr) {
+            error = GetLastError();
+        }
+        if (mapping != nullptr) {
+            CloseHandle(mapping);
+        }
+        length = size.QuadPart;
+    }
+    CloseHandle(file);
+    return p;
+#else
+    const char* name = ctx->GetStringUTFChars(path, nullptr);
+    int fd = open(name, (writable ? O_RDWR : O_RDONLY) | O_CLOEXEC);
+    ctx->ReleaseStringUTFChars(path, name);
+    if (fd < 0) {
+        error = errno;
+        return nullptr;
+    }
+    // an empty file can't be mapped (nullptr without an error code)
+    void* p = nullptr;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        error = errno;
+    } else if (st.st_size > 0) {
+        p = mmap(nullptr, st.st_size, writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            p = nullptr;
+            error = errno;
+        }
+        length = st.st_size;
+    }
+    close(fd);
+    return p;
+#endif
+}
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    /*
+     * Class:     net_cramer_simd_MappedMatrix
+     * Method:    map_n
+     * Signature: (Ljava/lang/String;Z[J)J
+     */
+    JNIEXPORT jlong JNICALL Java_net_cramer_simd_MappedMatrix_map_1n
+    (JNIEnv* env, jclass, jstring path, jboolean writable, jlongArray info) {
+        if (path == nullptr || info == nullptr) {
+            return 0;
+        }
+        try {
+            Context* ctx = static_cast<Context*>(env);
+            jlong res[2];
+            void* p = map_file(ctx, path, writable == JNI_TRUE, res[0], res[1]);
+            try {
+                ctx->SetLongArrayRegion(info, 0, 2, res);
+            }
+            catch (...) {
+                if (p != nullptr) {
+#if defined (_WIN64) || defined (_WIN32)
+                    UnmapViewOfFile(p);
+#else
+                    munmap(p, static_cast<size_t>(res[0]));
+#endif
+                }
+                throw;
+            }
+            return static_cast<jlong>(reinterpret_cast<uintptr_t>(p));
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "mapped_map", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "mapped_map: caught unknown exception");
+        }
+        return 0;
+    }
+
+    /*
+     * Class:     net_cramer_simd_MappedMatrix
+     * Method:    unmap_n
+     * Signature: (JJ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_MappedMatrix_unmap_1n
+    (JNIEnv*, jclass, jlong address, jlong length) {
+        if (address == 0) {
+            return;
+        }
+#if defined (_WIN64) || defined (_WIN32)
+        (void) length;
+        UnmapViewOfFile(address_ptr<void>(address));
+#else
+        munmap(address_ptr<void>(address), static_cast<size_t>(length));
+#endif
+    }
+
+    /*
+     * Class:     net_cramer_simd_MappedMatrix
+     * Method:    advise_n
+     * Signature: (JJI)Z
+     */
+    JNIEXPORT jboolean JNICALL Java_net_cramer_simd_MappedMatrix_advise_1n
+    (JNIEnv*, jclass, jlong address, jlong length, jint advice) {
+        if (address == 0 || length <= 0) {
+            return JNI_FALSE;
+        }
+#if defined (_WIN64) || defined (_WIN32)
+        // only read-ahead has a Windows counterpart
+#if _WIN32_WINNT >= 0x0602
+        if (advice == ADVICE_WILLNEED) {
+            WIN32_MEMORY_RANGE_ENTRY range;
+            range.VirtualAddress = address_ptr<void>(address);
+            range.NumberOfBytes = static_cast<SIZE_T>(length);
+            return PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0) ? JNI_TRUE : JNI_FALSE;
+        }
+#endif
+        return JNI_FALSE;
+#else
+        int adv;
+        switch (advice) {
+        case ADVICE_NORMAL:
+            adv = MADV_NORMAL;
+            break;
+        case ADVICE_SEQUENTIAL:
+            adv = MADV_SEQUENTIAL;
+            break;
+        case ADVICE_RANDOM:
+            adv = MADV_RANDOM;
+            break;
+        case ADVICE_WILLNEED:
+            adv = MADV_WILLNEED;
+            break;
+        case ADVICE_DONTNEED:
+            adv = MADV_DONTNEED;
+            break;
+        default:
+            return JNI_FALSE;
+        }
+        return (madvise(address_ptr<void>(address), static_cast<size_t>(length), adv) == 0) ? JNI_TRUE : JNI_FALSE;
+#endif
+    }
+
+    /*
+     * Class:     net_cramer_simd_MappedMatrix
+     * Method:    force_n
+     * Signature: (JJ)Z
+     */
+    JNIEXPORT jboolean JNICALL Java_net_cramer_simd_MappedMatrix_force_1n
+    (JNIEnv*, jclass, jlong address, jlong length) {
+        if (address == 0 || length <= 0) {
+            return JNI_FALSE;
+        }
+#if defined (_WIN64) || defined (_WIN32)
+        return FlushViewOfFile(address_ptr<void>(address), static_cast<SIZE_T>(length)) ? JNI_TRUE : JNI_FALSE;
+#else
+        return (msync(address_ptr<void>(address), static_cast<size_t>(length), MS_SYNC) == 0) ? JNI_TRUE : JNI_FALSE;
+#endif
+    }
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PARALLEL_INCLUDED_
+#define PARALLEL_INCLUDED_
+
+#include <stdint.h>          // int64_t
+#include <algorithm>         // std::min, std::max
+#include <exception>         // std::exception_ptr
+#include <thread>            // std::thread
+#include <vector>            // std::vector
+
+// Number of threads the parallel kernels use at most (at least 1)
+int max_threads();
+
+// Number of parts parallel_for(count, grain, ...) splits [0, count) into:
+// at most max_threads() parts of at least grain elements each (at least 1)
+inline int parallel_parts(int64_t count, int64_t grain) {
+    int64_t parts = count / std::max(grain, int64_t(1));
+    return int(std::max(int64_t(1), std::min(parts, int64_t(max_threads()))));
+}
+
+// Runs body(begin, end, part) for each of the parallel_parts(count, grain)
+// contiguous parts of [0, count), the last one on the calling thread, and
+// returns when all parts are done. If a part throws, the exception of the
+// first such part is rethrown on the calling thread once all parts are done
+// (parts whose worker thread can't be started run on the calling thread).
+// The body must not call back into the JVM (the worker threads are not
+// attached).
+template <typename F>
+void parallel_for(int64_t count, int64_t grain, F body) {
+    int parts = parallel_parts(count, grain);
+    if (parts == 1) {
+        body(int64_t(0), count, 0);
+        return;
+    }
+    std::vector<std::exception_ptr> errors(parts);
+    auto run = [&](int part) {
+        try {
+            body(count * part / parts, count * (part + 1) / parts, part);
+        }
+        catch (...) {
+            errors[part] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(parts - 1);
+    int started = 0;
+    for (; started < parts - 1; ++started) {
+        try {
+            workers.emplace_back(run, started);
+        }
+        catch (...) {
+            break;
+        }
+    }
+    for (int part = started; part < parts; ++part) {
+        run(part);
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    for (std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+#endif /* PARALLEL_INCLUDED_ */
@@ -55,6 +55,15 @@ static void next8Longs(uint64_t* r0, uint64_t* r1, uint64_t* r2, uint64_t* r3, u
 }
 
 
+static void next2048Longs(uint64_t* r) {
+    const int SIZE = 8 * 256;
+    PREFETCH(r + SIZE - 8);
+    for (int i = 0; i < SIZE; i += 8) {
+        next8Longs(&r[i + 0], &r[i + 1], &r[i + 2], &r[i + 3], &r[i + 4], &r[i + 5], &r[i + 6], &r[i + 7]);
+    }
+}
+
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -66,16 +75,23 @@ extern "C" {
 JNIEXPORT void JNICALL Java_net_cramer_simd_RNG_sfc64Large
 (JNIEnv* env, jclass, jlongArray array) {
     // array must have length 2048 as we retrieve 2K numbers on each call
-    const int SIZE = 8 * 256;
     jboolean copy = JNI_FALSE;
     uint64_t* r = static_cast<uint64_t*>(env->GetPrimitiveArrayCritical(array, &copy));
-    PREFETCH(r + SIZE - 8);
-    for (int i = 0; i < SIZE; i += 8) {
-        next8Longs(&r[i + 0], &r[i + 1], &r[i + 2], &r[i + 3], &r[i + 4], &r[i + 5], &r[i + 6], &r[i + 7]);
-    }
+    next2048Longs(r);
     env->ReleasePrimitiveArrayCritical(array, r, 0);
 }
 
+/*
+ * Class:     net_cramer_simd_RNG
+ * Method:    sfc64LargeAddress
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_net_cramer_simd_RNG_sfc64LargeAddress
+(JNIEnv*, jclass, jlong address) {
+    // the off-heap range (checked in RNG.java) must hold 2048 longs
+    next2048Longs(reinterpret_cast<uint64_t*>(static_cast<uintptr_t>(address)));
+}
+
 /*
  * Class:     net_cramer_simd_RNG
  * Method:    initSfc64
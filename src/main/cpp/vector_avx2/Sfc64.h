@@ -0,0 +1,59 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SFC64_INCLUDED_
+#define SFC64_INCLUDED_
+
+#include <stdint.h>          // uint64_t
+
+// Chris Doty-Humphrey's "Small Fast Counting RNG" (sfc64), the scalar
+// counterpart of the 8 lane generator in Sfc64.cpp for kernels that need
+// their own (seeded, thread-confined) random stream.
+class Sfc64
+{
+public:
+    explicit Sfc64(uint64_t seed) : a(seed), b(seed), c(seed), counter(1) {
+        for (int i = 0; i < 12; ++i) {
+            next();
+        }
+    }
+
+    uint64_t next() {
+        uint64_t r = a + b + counter++;
+        a = b ^ (b >> 11);
+        b = c + (c << 3);
+        c = ((c << 24) | (c >> 40)) + r;
+        return r;
+    }
+
+    // uniform in [0, 1)
+    double nextDouble() {
+        return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    // uniform in [0, bound) for bound > 0
+    int64_t nextLong(int64_t bound) {
+        return static_cast<int64_t>(nextDouble() * static_cast<double>(bound));
+    }
+
+private:
+    uint64_t a;
+    uint64_t b;
+    uint64_t c;
+    uint64_t counter;
+};
+
+#endif /* SFC64_INCLUDED_ */
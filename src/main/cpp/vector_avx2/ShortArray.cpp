@@ -0,0 +1,80 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ShortArray.h"
+
+#ifndef _JAVASOFT_JNI_H_
+#include <jni.h>
+#endif /* _JAVASOFT_JNI_H_ */
+
+#ifndef JEXCEPTION_INCLUDED_
+#include "JException.h"
+#endif /* JEXCEPTION_INCLUDED_ */
+
+#ifndef ARRAYACCESS_INCLUDED_
+#include "ArrayAccess.h"
+#endif /* ARRAYACCESS_INCLUDED_ */
+
+
+
+ShortArray::ShortArray(JNIEnv* env, jshortArray jarray, long length, jboolean critical, bool readOnly)
+    : ctx(static_cast<Context*>(env)), jarray(jarray), len(length), mode(critical ? ACCESS_CRITICAL : ACCESS_ELEMENTS), readOnly(readOnly)
+{
+    if (jarray) {
+        if (length > ctx->GetArrayLength(jarray)) {
+            throw JException("length argument exceeds the jshortArray array length");
+        }
+        if (has_copies()) {
+            // while the thread holds copies no wrapper pins (see find_copy)
+            carray = static_cast<uint16_t*>(find_copy(env, jarray, length, !readOnly));
+            if (carray) {
+                mode = ACCESS_SHARED;
+                return;
+            }
+            mode = ACCESS_ELEMENTS;
+        }
+        jboolean isCopy = JNI_FALSE;
+        if (mode == ACCESS_CRITICAL) {
+            carray = static_cast<uint16_t*>(ctx->GetPrimitiveArrayCritical(jarray, &isCopy));
+        } else {
+            carray = reinterpret_cast<uint16_t*>(ctx->GetShortArrayElements(jarray, &isCopy));
+        }
+        if (carray == NULL) {
+            throw JException("short* result: NULL");
+        }
+        if (mode == ACCESS_ELEMENTS) {
+            add_copy(jarray, carray, length, !readOnly);
+        }
+    } else {
+        throw JException("jshortArray argument: null");
+    }
+}
+
+uint16_t* ShortArray::ptr() {
+    return carray;
+}
+
+long ShortArray::length() {
+    return len;
+}
+
+ShortArray::~ShortArray() {
+    if (mode == ACCESS_CRITICAL) {
+        ctx->ReleasePrimitiveArrayCritical(jarray, carray, readOnly ? JNI_ABORT : 0);
+    } else if (mode == ACCESS_ELEMENTS) {
+        ctx->ReleaseShortArrayElements(jarray, reinterpret_cast<jshort*>(carray), remove_copy(carray) ? 0 : JNI_ABORT);
+    }
+}
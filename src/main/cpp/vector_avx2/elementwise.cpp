@@ -0,0 +1,712 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <jni.h>
+
+#ifndef VECTORIZE_INCLUDED_
+#include "vectorize.h"
+#endif /* VECTORIZE_INCLUDED_ */
+
+#include "vcl/vectormath_exp.h"
+#include "vcl/vectormath_hyp.h"
+#include "vcl/vectormath_trig.h"
+
+#ifndef DOUBLEARRAY_INCLUDED_
+#include "DoubleArray.h"
+#endif /* DOUBLEARRAY_INCLUDED_ */
+
+#ifndef FLOATARRAY_INCLUDED_
+#include "FloatArray.h"
+#endif /* FLOATARRAY_INCLUDED_ */
+
+#ifndef DIRECTBUFFER_INCLUDED_
+#include "DirectBuffer.h"
+#endif /* DIRECTBUFFER_INCLUDED_ */
+
+#ifndef JEXCEPTION_INCLUDED_
+#include "JException.h"
+#endif /* JEXCEPTION_INCLUDED_ */
+
+#ifndef JEXCEPTIONUTILS_INCLUDED_
+#include "JExceptionUtils.h"
+#endif /* JEXCEPTIONUTILS_INCLUDED_ */
+
+
+// Elementwise transcendental functions from VCL's vectormath_*.h headers.
+// The op codes must be kept in sync with the constants in VectorMath.java
+constexpr int OP_EXP = 0;
+constexpr int OP_LOG = 1;
+constexpr int OP_LOG1P = 2;
+constexpr int OP_EXPM1 = 3;
+constexpr int OP_TANH = 4;
+constexpr int OP_SIGMOID = 5;
+constexpr int OP_SIN = 6;
+constexpr int OP_COS = 7;
+
+
+bool unary_double(int op, double* x, double* y, int64_t count);
+bool unary_float(int op, float* x, float* y, int64_t count);
+void pow_double(double* x, double* y, double* z, int64_t count);
+void pow_float(float* x, float* y, float* z, int64_t count);
+void pow_scalar_double(double* x, double e, double* z, int64_t count);
+void pow_scalar_float(float* x, float e, float* z, int64_t count);
+void sincos_double(double* x, double* s, double* c, int64_t count);
+void sincos_float(float* x, float* s, float* c, int64_t count);
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    /*
+     * Class:     net_cramer_simd_VectorMath
+     * Method:    unary_double_n
+     * Signature: (I[D[DIZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_VectorMath_unary_1double_1n
+    (JNIEnv* env, jclass, jint op, jdoubleArray x, jdoubleArray y, jint count, jboolean useCrit) {
+        if (count == 0 || x == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "unary_double - negative count argument:", count);
+            return;
+        }
+        try {
+            DoubleArray xx = DoubleArray(env, x, count, useCrit, y != nullptr);
+            if (y == nullptr) {
+                if (!unary_double(op, xx.ptr(), xx.ptr(), count)) {
+                    throw JException("- unknown op");
+                }
+            } else {
+                DoubleArray yy = DoubleArray(env, y, count, useCrit);
+                if (!unary_double(op, xx.ptr(), yy.ptr(), count)) {
+                    throw JException("- unknown op");
+                }
+            }
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "unary_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "unary_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_VectorMath
+     * Method:    unary_float_n
+     * Signature: (I[F[FIZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_VectorMath_unary_1float_1n
+    (JNIEnv* env, jclass, jint op, jfloatArray x, jfloatArray y, jint count, jboolean useCrit) {
+        if (count == 0 || x == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "unary_float - negative count argument:", count);
+            return;
+        }
+        try {
+            FloatArray xx = FloatArray(env, x, count, useCrit, y != nullptr);
+            if (y == nullptr) {
+                if (!unary_float(op, xx.ptr(), xx.ptr(), count)) {
+                    throw JException("- unknown op");
+                }
+            } else {
+                FloatArray yy = FloatArray(env, y, count, useCrit);
+                if (!unary_float(op, xx.ptr(), yy.ptr(), count)) {
+                    throw JException("- unknown op");
+                }
+            }
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "unary_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "unary_float: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_VectorMath
+     * Method:    unary_double_b
+     * Signature: (ILjava/nio/DoubleBuffer;Ljava/nio/DoubleBuffer;I)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_VectorMath_unary_1double_1b
+    (JNIEnv* env, jclass, jint op, jobject x, jobject y, jint count) {
+        if (count == 0 || x == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "unary_double - negative count argument:", count);
+            return;
+        }
+        try {
+            DirectBuffer xx = DirectBuffer(env, x, count);
+            double* out = (y == nullptr) ? xx.doublePtr() : DirectBuffer(env, y, count).doublePtr();
+            if (!unary_double(op, xx.doublePtr(), out, count)) {
+                throw JException("- unknown op");
+            }
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "unary_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "unary_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_VectorMath
+     * Method:    unary_float_b
+     * Signature: (ILjava/nio/FloatBuffer;Ljava/nio/FloatBuffer;I)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_VectorMath_unary_1float_1b
+    (JNIEnv* env, jclass, jint op, jobject x, jobject y, jint count) {
+        if (count == 0 || x == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "unary_float - negative count argument:", count);
+            return;
+        }
+        try {
+            DirectBuffer xx = DirectBuffer(env, x, count);
+            float* out = (y == nullptr) ? xx.floatPtr() : DirectBuffer(env, y, count).floatPtr();
+            if (!unary_float(op, xx.floatPtr(), out, count)) {
+                throw JException("- unknown op");
+            }
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "unary_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "unary_float: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_VectorMath
+     * Method:    pow_double_n
+     * Signature: ([D[D[DIZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_VectorMath_pow_1double_1n
+    (JNIEnv* env, jclass, jdoubleArray x, jdoubleArray y, jdoubleArray z, jint count, jboolean useCrit) {
+        if (count == 0 || x == nullptr || y == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "pow_double - negative count argument:", count);
+            return;
+        }
+        try {
+            DoubleArray xx = DoubleArray(env, x, count, useCrit, z != nullptr);
+            DoubleArray yy = DoubleArray(env, y, count, useCrit, true);
+            if (z == nullptr) {
+                pow_double(xx.ptr(), yy.ptr(), xx.ptr(), count);
+            } else {
+                DoubleArray zz = DoubleArray(env, z, count, useCrit);
+                pow_double(xx.ptr(), yy.ptr(), zz.ptr(), count);
+            }
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "pow_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "pow_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_VectorMath
+     * Method:    pow_float_n
+     * Signature: ([F[F[FIZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_VectorMath_pow_1float_1n
+    (JNIEnv* env, jclass, jfloatArray x, jfloatArray y, jfloatArray z, jint count, jboolean useCrit) {
+        if (count == 0 || x == nullptr || y == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "pow_float - negative count argument:", count);
+            return;
+        }
+        try {
+            FloatArray xx = FloatArray(env, x, count, useCrit, z != nullptr);
+            FloatArray yy = FloatArray(env, y, count, useCrit, true);
+            if (z == nullptr) {
+                pow_float(xx.ptr(), yy.ptr(), xx.ptr(), count);
+            } else {
+                FloatArray zz = FloatArray(env, z, count, useCrit);
+                pow_float(xx.ptr(), yy.ptr(), zz.ptr(), count);
+            }
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "pow_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "pow_float: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_VectorMath
+     * Method:    pow_double_b
+     * Signature: (Ljava/nio/DoubleBuffer;Ljava/nio/DoubleBuffer;Ljava/nio/DoubleBuffer;I)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_VectorMath_pow_1double_1b
+    (JNIEnv* env, jclass, jobject x, jobject y, jobject z, jint count) {
+        if (count == 0 || x == nullptr || y == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "pow_double - negative count argument:", count);
+            return;
+        }
+        try {
+            DirectBuffer xx = DirectBuffer(env, x, count);
+            DirectBuffer yy = DirectBuffer(env, y, count);
+            double* out = (z == nullptr) ? xx.doublePtr() : DirectBuffer(env, z, count).doublePtr();
+            pow_double(xx.doublePtr(), yy.doublePtr(), out, count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "pow_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "pow_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_VectorMath
+     * Method:    pow_float_b
+     * Signature: (Ljava/nio/FloatBuffer;Ljava/nio/FloatBuffer;Ljava/nio/FloatBuffer;I)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_VectorMath_pow_1float_1b
+    (JNIEnv* env, jclass, jobject x, jobject y, jobject z, jint count) {
+        if (count == 0 || x == nullptr || y == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "pow_float - negative count argument:", count);
+            return;
+        }
+        try {
+            DirectBuffer xx = DirectBuffer(env, x, count);
+            DirectBuffer yy = DirectBuffer(env, y, count);
+            float* out = (z == nullptr) ? xx.floatPtr() : DirectBuffer(env, z, count).floatPtr();
+            pow_float(xx.floatPtr(), yy.floatPtr(), out, count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "pow_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "pow_float: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_VectorMath
+     * Method:    pow_scalar_double_n
+     * Signature: ([DD[DIZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_VectorMath_pow_1scalar_1double_1n
+    (JNIEnv* env, jclass, jdoubleArray x, jdouble e, jdoubleArray z, jint count, jboolean useCrit) {
+        if (count == 0 || x == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "pow_scalar_double - negative count argument:", count);
+            return;
+        }
+        try {
+            DoubleArray xx = DoubleArray(env, x, count, useCrit, z != nullptr);
+            if (z == nullptr) {
+                pow_scalar_double(xx.ptr(), e, xx.ptr(), count);
+            } else {
+                DoubleArray zz = DoubleArray(env, z, count, useCrit);
+                pow_scalar_double(xx.ptr(), e, zz.ptr(), count);
+            }
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "pow_scalar_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "pow_scalar_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_VectorMath
+     * Method:    pow_scalar_float_n
+     * Signature: ([FF[FIZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_VectorMath_pow_1scalar_1float_1n
+    (JNIEnv* env, jclass, jfloatArray x, jfloat e, jfloatArray z, jint count, jboolean useCrit) {
+        if (count == 0 || x == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "pow_scalar_float - negative count argument:", count);
+            return;
+        }
+        try {
+            FloatArray xx = FloatArray(env, x, count, useCrit, z != nullptr);
+            if (z == nullptr) {
+                pow_scalar_float(xx.ptr(), e, xx.ptr(), count);
+            } else {
+                FloatArray zz = FloatArray(env, z, count, useCrit);
+                pow_scalar_float(xx.ptr(), e, zz.ptr(), count);
+            }
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "pow_scalar_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "pow_scalar_float: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_VectorMath
+     * Method:    pow_scalar_double_b
+     * Signature: (Ljava/nio/DoubleBuffer;DLjava/nio/DoubleBuffer;I)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_VectorMath_pow_1scalar_1double_1b
+    (JNIEnv* env, jclass, jobject x, jdouble e, jobject z, jint count) {
+        if (count == 0 || x == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "pow_scalar_double - negative count argument:", count);
+            return;
+        }
+        try {
+            DirectBuffer xx = DirectBuffer(env, x, count);
+            double* out = (z == nullptr) ? xx.doublePtr() : DirectBuffer(env, z, count).doublePtr();
+            pow_scalar_double(xx.doublePtr(), e, out, count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "pow_scalar_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "pow_scalar_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_VectorMath
+     * Method:    pow_scalar_float_b
+     * Signature: (Ljava/nio/FloatBuffer;FLjava/nio/FloatBuffer;I)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_VectorMath_pow_1scalar_1float_1b
+    (JNIEnv* env, jclass, jobject x, jfloat e, jobject z, jint count) {
+        if (count == 0 || x == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "pow_scalar_float - negative count argument:", count);
+            return;
+        }
+        try {
+            DirectBuffer xx = DirectBuffer(env, x, count);
+            float* out = (z == nullptr) ? xx.floatPtr() : DirectBuffer(env, z, count).floatPtr();
+            pow_scalar_float(xx.floatPtr(), e, out, count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "pow_scalar_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "pow_scalar_float: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_VectorMath
+     * Method:    sincos_double_n
+     * Signature: ([D[D[DIZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_VectorMath_sincos_1double_1n
+    (JNIEnv* env, jclass, jdoubleArray x, jdoubleArray s, jdoubleArray c, jint count, jboolean useCrit) {
+        if (count == 0 || x == nullptr || s == nullptr || c == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "sincos_double - negative count argument:", count);
+            return;
+        }
+        try {
+            DoubleArray xx = DoubleArray(env, x, count, useCrit, true);
+            DoubleArray ss = DoubleArray(env, s, count, useCrit);
+            DoubleArray cc = DoubleArray(env, c, count, useCrit);
+            sincos_double(xx.ptr(), ss.ptr(), cc.ptr(), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "sincos_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "sincos_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_VectorMath
+     * Method:    sincos_float_n
+     * Signature: ([F[F[FIZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_VectorMath_sincos_1float_1n
+    (JNIEnv* env, jclass, jfloatArray x, jfloatArray s, jfloatArray c, jint count, jboolean useCrit) {
+        if (count == 0 || x == nullptr || s == nullptr || c == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "sincos_float - negative count argument:", count);
+            return;
+        }
+        try {
+            FloatArray xx = FloatArray(env, x, count, useCrit, true);
+            FloatArray ss = FloatArray(env, s, count, useCrit);
+            FloatArray cc = FloatArray(env, c, count, useCrit);
+            sincos_float(xx.ptr(), ss.ptr(), cc.ptr(), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "sincos_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "sincos_float: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_VectorMath
+     * Method:    sincos_double_b
+     * Signature: (Ljava/nio/DoubleBuffer;Ljava/nio/DoubleBuffer;Ljava/nio/DoubleBuffer;I)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_VectorMath_sincos_1double_1b
+    (JNIEnv* env, jclass, jobject x, jobject s, jobject c, jint count) {
+        if (count == 0 || x == nullptr || s == nullptr || c == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "sincos_double - negative count argument:", count);
+            return;
+        }
+        try {
+            DirectBuffer xx = DirectBuffer(env, x, count);
+            DirectBuffer ss = DirectBuffer(env, s, count);
+            DirectBuffer cc = DirectBuffer(env, c, count);
+            sincos_double(xx.doublePtr(), ss.doublePtr(), cc.doublePtr(), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "sincos_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "sincos_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_VectorMath
+     * Method:    sincos_float_b
+     * Signature: (Ljava/nio/FloatBuffer;Ljava/nio/FloatBuffer;Ljava/nio/FloatBuffer;I)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_VectorMath_sincos_1float_1b
+    (JNIEnv* env, jclass, jobject x, jobject s, jobject c, jint count) {
+        if (count == 0 || x == nullptr || s == nullptr || c == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "sincos_float - negative count argument:", count);
+            return;
+        }
+        try {
+            DirectBuffer xx = DirectBuffer(env, x, count);
+            DirectBuffer ss = DirectBuffer(env, s, count);
+            DirectBuffer cc = DirectBuffer(env, c, count);
+            sincos_float(xx.floatPtr(), ss.floatPtr(), cc.floatPtr(), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "sincos_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "sincos_float: caught unknown exception");
+        }
+    }
+#ifdef __cplusplus
+}
+#endif
+
+
+// Applies op to all elements of x and stores the results in y (x and y may be
+// identical). The remainder is processed with a partial vector so that every
+// element gets the same (vectorized) treatment.
+template <typename V, typename T, typename Op>
+static inline void map_unary(T* x, T* y, int64_t count, Op op) {
+    constexpr int N = V::size();
+    V vx;
+
+    int64_t i;
+    for (i = 0; i < count - (N - 1); i += N) {
+        PREFETCH(x + i + 63 * N);
+        vx.load(x + i);
+        op(vx).store(y + i);
+    }
+    if (i < count) {
+        int rest = static_cast<int>(count - i);
+        vx.load_partial(rest, x + i);
+        op(vx).store_partial(rest, y + i);
+    }
+}
+
+template <typename V, typename T, typename Op>
+static inline void map_binary(T* x, T* y, T* z, int64_t count, Op op) {
+    constexpr int N = V::size();
+    V vx;
+    V vy;
+
+    int64_t i;
+    for (i = 0; i < count - (N - 1); i += N) {
+        PREFETCH(x + i + 63 * N);
+        PREFETCH(y + i + 63 * N);
+        vx.load(x + i);
+        vy.load(y + i);
+        op(vx, vy).store(z + i);
+    }
+    if (i < count) {
+        int rest = static_cast<int>(count - i);
+        vx.load_partial(rest, x + i);
+        vy.load_partial(rest, y + i);
+        op(vx, vy).store_partial(rest, z + i);
+    }
+}
+
+bool unary_double(int op, double* x, double* y, int64_t count) {
+    switch (op) {
+    case OP_EXP:
+        map_unary<Vec8d>(x, y, count, [](Vec8d v) { return exp(v); });
+        break;
+    case OP_LOG:
+        map_unary<Vec8d>(x, y, count, [](Vec8d v) { return log(v); });
+        break;
+    case OP_LOG1P:
+        map_unary<Vec8d>(x, y, count, [](Vec8d v) { return log1p(v); });
+        break;
+    case OP_EXPM1:
+        map_unary<Vec8d>(x, y, count, [](Vec8d v) { return expm1(v); });
+        break;
+    case OP_TANH:
+        map_unary<Vec8d>(x, y, count, [](Vec8d v) { return tanh(v); });
+        break;
+    case OP_SIGMOID:
+        map_unary<Vec8d>(x, y, count, [](Vec8d v) { return Vec8d(1.0) / (Vec8d(1.0) + exp(-v)); });
+        break;
+    case OP_SIN:
+        map_unary<Vec8d>(x, y, count, [](Vec8d v) { return sin(v); });
+        break;
+    case OP_COS:
+        map_unary<Vec8d>(x, y, count, [](Vec8d v) { return cos(v); });
+        break;
+    default:
+        return false;
+    }
+    return true;
+}
+
+bool unary_float(int op, float* x, float* y, int64_t count) {
+    switch (op) {
+    case OP_EXP:
+        map_unary<Vec16f>(x, y, count, [](Vec16f v) { return exp(v); });
+        break;
+    case OP_LOG:
+        map_unary<Vec16f>(x, y, count, [](Vec16f v) { return log(v); });
+        break;
+    case OP_LOG1P:
+        map_unary<Vec16f>(x, y, count, [](Vec16f v) { return log1p(v); });
+        break;
+    case OP_EXPM1:
+        map_unary<Vec16f>(x, y, count, [](Vec16f v) { return expm1(v); });
+        break;
+    case OP_TANH:
+        map_unary<Vec16f>(x, y, count, [](Vec16f v) { return tanh(v); });
+        break;
+    case OP_SIGMOID:
+        map_unary<Vec16f>(x, y, count, [](Vec16f v) { return Vec16f(1.0f) / (Vec16f(1.0f) + exp(-v)); });
+        break;
+    case OP_SIN:
+        map_unary<Vec16f>(x, y, count, [](Vec16f v) { return sin(v); });
+        break;
+    case OP_COS:
+        map_unary<Vec16f>(x, y, count, [](Vec16f v) { return cos(v); });
+        break;
+    default:
+        return false;
+    }
+    return true;
+}
+
+void pow_double(double* x, double* y, double* z, int64_t count) {
+    map_binary<Vec8d>(x, y, z, count, [](Vec8d a, Vec8d b) { return pow(a, b); });
+}
+
+void pow_float(float* x, float* y, float* z, int64_t count) {
+    map_binary<Vec16f>(x, y, z, count, [](Vec16f a, Vec16f b) { return pow(a, b); });
+}
+
+void pow_scalar_double(double* x, double e, double* z, int64_t count) {
+    map_unary<Vec8d>(x, z, count, [e](Vec8d v) { return pow(v, e); });
+}
+
+void pow_scalar_float(float* x, float e, float* z, int64_t count) {
+    map_unary<Vec16f>(x, z, count, [e](Vec16f v) { return pow(v, e); });
+}
+
+void sincos_double(double* x, double* s, double* c, int64_t count) {
+    Vec8d vx;
+    Vec8d vc;
+
+    int64_t i;
+    for (i = 0; i < count - 7; i += STEP_8) {
+        PREFETCH(x + i + 63 * STEP_8);
+        vx.load(x + i);
+        sincos(&vc, vx).store(s + i);
+        vc.store(c + i);
+    }
+    if (i < count) {
+        int rest = static_cast<int>(count - i);
+        vx.load_partial(rest, x + i);
+        sincos(&vc, vx).store_partial(rest, s + i);
+        vc.store_partial(rest, c + i);
+    }
+}
+
+void sincos_float(float* x, float* s, float* c, int64_t count) {
+    Vec16f vx;
+    Vec16f vc;
+
+    int64_t i;
+    for (i = 0; i < count - 15; i += STEP_16) {
+        PREFETCH(x + i + 63 * STEP_16);
+        vx.load(x + i);
+        sincos(&vc, vx).store(s + i);
+        vc.store(c + i);
+    }
+    if (i < count) {
+        int rest = static_cast<int>(count - i);
+        vx.load_partial(rest, x + i);
+        sincos(&vc, vx).store_partial(rest, s + i);
+        vc.store_partial(rest, c + i);
+    }
+}
@@ -0,0 +1,804 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>          // memcpy
+#include <algorithm>         // std::min, std::max
+#include <limits>            // std::numeric_limits
+#include <type_traits>       // std::is_floating_point
+#include <jni.h>
+
+#ifndef VECTORIZE_INCLUDED_
+#include "vectorize.h"
+#endif /* VECTORIZE_INCLUDED_ */
+
+#ifndef DOUBLEARRAY_INCLUDED_
+#include "DoubleArray.h"
+#endif /* DOUBLEARRAY_INCLUDED_ */
+
+#ifndef FLOATARRAY_INCLUDED_
+#include "FloatArray.h"
+#endif /* FLOATARRAY_INCLUDED_ */
+
+#ifndef LONGARRAY_INCLUDED_
+#include "LongArray.h"
+#endif /* LONGARRAY_INCLUDED_ */
+
+#ifndef INTARRAY_INCLUDED_
+#include "IntArray.h"
+#endif /* INTARRAY_INCLUDED_ */
+
+#ifndef SHORTARRAY_INCLUDED_
+#include "ShortArray.h"
+#endif /* SHORTARRAY_INCLUDED_ */
+
+#ifndef BYTEARRAY_INCLUDED_
+#include "ByteArray.h"
+#endif /* BYTEARRAY_INCLUDED_ */
+
+#ifndef ALIGNEDBUFFER_INCLUDED_
+#include "AlignedBuffer.h"
+#endif /* ALIGNEDBUFFER_INCLUDED_ */
+
+#ifndef JEXCEPTION_INCLUDED_
+#include "JException.h"
+#endif /* JEXCEPTION_INCLUDED_ */
+
+#ifndef JEXCEPTIONUTILS_INCLUDED_
+#include "JExceptionUtils.h"
+#endif /* JEXCEPTIONUTILS_INCLUDED_ */
+
+
+// Minimum, maximum, argmin, argmax and (argmin, argmax) pairs. The extremal
+// values are found in one pass (two independent min / max accumulators to
+// hide the latency) and the first index holding them in a second pass that
+// stops at the first hit, which is cheaper than tracking indices per lane.
+// Floating-point inputs can either ignore NaNs or propagate them (then the
+// first NaN is the result). -0.0 and 0.0 compare equal.
+
+// reduction ops (keep in sync with SIMD.java)
+constexpr int OP_MIN = 0;
+constexpr int OP_MAX = 1;
+constexpr int OP_ARGMIN = 2;
+constexpr int OP_ARGMAX = 3;
+
+
+int64_t extremum_double(double* a, int64_t count, int op, bool ignoreNaN);
+int64_t extremum_float(float* a, int64_t count, int op, bool ignoreNaN);
+int64_t extremum_long(int64_t* a, int64_t count, int op);
+int64_t extremum_int(int32_t* a, int64_t count, int op);
+int64_t extremum_short(int16_t* a, int64_t count, int op);
+int64_t extremum_byte(int8_t* a, int64_t count, int op);
+void min_max_double(double* a, int64_t count, bool ignoreNaN, int64_t* result);
+void min_max_float(float* a, int64_t count, bool ignoreNaN, int64_t* result);
+void min_max_long(int64_t* a, int64_t count, int64_t* result);
+void min_max_int(int32_t* a, int64_t count, int64_t* result);
+void min_max_short(int16_t* a, int64_t count, int64_t* result);
+void min_max_byte(int8_t* a, int64_t count, int64_t* result);
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    extremum_double_n
+     * Signature: ([DIIZZ)J
+     */
+    JNIEXPORT jlong JNICALL Java_net_cramer_simd_SIMD_extremum_1double_1n
+    (JNIEnv* env, jclass, jdoubleArray a, jint count, jint op, jboolean ignoreNaN, jboolean useCrit) {
+        if (op < OP_MIN || op > OP_ARGMAX) {
+            throwJavaRuntimeException(env, "%s %d", "extremum_double - unknown op:", op);
+            return 0;
+        }
+        if (count == 0 || a == nullptr) {
+            return extremum_double(static_cast<double*>(nullptr), 0, op, ignoreNaN == JNI_TRUE);
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "extremum_double - negative count argument:", count);
+            return 0;
+        }
+        try {
+            DoubleArray aa = DoubleArray(env, a, count, useCrit, true);
+            return extremum_double(aa.ptr(), count, op, ignoreNaN == JNI_TRUE);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "extremum_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "extremum_double: caught unknown exception");
+        }
+        return 0;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    extremum_float_n
+     * Signature: ([FIIZZ)J
+     */
+    JNIEXPORT jlong JNICALL Java_net_cramer_simd_SIMD_extremum_1float_1n
+    (JNIEnv* env, jclass, jfloatArray a, jint count, jint op, jboolean ignoreNaN, jboolean useCrit) {
+        if (op < OP_MIN || op > OP_ARGMAX) {
+            throwJavaRuntimeException(env, "%s %d", "extremum_float - unknown op:", op);
+            return 0;
+        }
+        if (count == 0 || a == nullptr) {
+            return extremum_float(static_cast<float*>(nullptr), 0, op, ignoreNaN == JNI_TRUE);
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "extremum_float - negative count argument:", count);
+            return 0;
+        }
+        try {
+            FloatArray aa = FloatArray(env, a, count, useCrit, true);
+            return extremum_float(aa.ptr(), count, op, ignoreNaN == JNI_TRUE);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "extremum_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "extremum_float: caught unknown exception");
+        }
+        return 0;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    extremum_long_n
+     * Signature: ([JIIZ)J
+     */
+    JNIEXPORT jlong JNICALL Java_net_cramer_simd_SIMD_extremum_1long_1n
+    (JNIEnv* env, jclass, jlongArray a, jint count, jint op, jboolean useCrit) {
+        if (op < OP_MIN || op > OP_ARGMAX) {
+            throwJavaRuntimeException(env, "%s %d", "extremum_long - unknown op:", op);
+            return 0;
+        }
+        if (count == 0 || a == nullptr) {
+            return extremum_long(static_cast<int64_t*>(nullptr), 0, op);
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "extremum_long - negative count argument:", count);
+            return 0;
+        }
+        try {
+            LongArray aa = LongArray(env, a, count, useCrit, true);
+            return extremum_long(reinterpret_cast<int64_t*>(aa.ptr()), count, op);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "extremum_long", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "extremum_long: caught unknown exception");
+        }
+        return 0;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    extremum_int_n
+     * Signature: ([IIIZ)J
+     */
+    JNIEXPORT jlong JNICALL Java_net_cramer_simd_SIMD_extremum_1int_1n
+    (JNIEnv* env, jclass, jintArray a, jint count, jint op, jboolean useCrit) {
+        if (op < OP_MIN || op > OP_ARGMAX) {
+            throwJavaRuntimeException(env, "%s %d", "extremum_int - unknown op:", op);
+            return 0;
+        }
+        if (count == 0 || a == nullptr) {
+            return extremum_int(static_cast<int32_t*>(nullptr), 0, op);
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "extremum_int - negative count argument:", count);
+            return 0;
+        }
+        try {
+            IntArray aa = IntArray(env, a, count, useCrit, true);
+            return extremum_int(aa.ptr(), count, op);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "extremum_int", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "extremum_int: caught unknown exception");
+        }
+        return 0;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    extremum_short_n
+     * Signature: ([SIIZ)J
+     */
+    JNIEXPORT jlong JNICALL Java_net_cramer_simd_SIMD_extremum_1short_1n
+    (JNIEnv* env, jclass, jshortArray a, jint count, jint op, jboolean useCrit) {
+        if (op < OP_MIN || op > OP_ARGMAX) {
+            throwJavaRuntimeException(env, "%s %d", "extremum_short - unknown op:", op);
+            return 0;
+        }
+        if (count == 0 || a == nullptr) {
+            return extremum_short(static_cast<int16_t*>(nullptr), 0, op);
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "extremum_short - negative count argument:", count);
+            return 0;
+        }
+        try {
+            ShortArray aa = ShortArray(env, a, count, useCrit, true);
+            return extremum_short(reinterpret_cast<int16_t*>(aa.ptr()), count, op);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "extremum_short", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "extremum_short: caught unknown exception");
+        }
+        return 0;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    extremum_byte_n
+     * Signature: ([BIIZ)J
+     */
+    JNIEXPORT jlong JNICALL Java_net_cramer_simd_SIMD_extremum_1byte_1n
+    (JNIEnv* env, jclass, jbyteArray a, jint count, jint op, jboolean useCrit) {
+        if (op < OP_MIN || op > OP_ARGMAX) {
+            throwJavaRuntimeException(env, "%s %d", "extremum_byte - unknown op:", op);
+            return 0;
+        }
+        if (count == 0 || a == nullptr) {
+            return extremum_byte(static_cast<int8_t*>(nullptr), 0, op);
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "extremum_byte - negative count argument:", count);
+            return 0;
+        }
+        try {
+            ByteArray aa = ByteArray(env, a, count, useCrit, true);
+            return extremum_byte(aa.ptr(), count, op);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "extremum_byte", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "extremum_byte: caught unknown exception");
+        }
+        return 0;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    min_max_double_n
+     * Signature: ([DIZ[JZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_min_1max_1double_1n
+    (JNIEnv* env, jclass, jdoubleArray a, jint count, jboolean ignoreNaN, jlongArray result, jboolean useCrit) {
+        if (result == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "min_max_double - negative count argument:", count);
+            return;
+        }
+        try {
+            jlong res[4];
+            if (count == 0 || a == nullptr) {
+                min_max_double(static_cast<double*>(nullptr), 0, ignoreNaN == JNI_TRUE, reinterpret_cast<int64_t*>(res));
+            } else {
+                DoubleArray aa = DoubleArray(env, a, count, useCrit, true);
+                min_max_double(aa.ptr(), count, ignoreNaN == JNI_TRUE, reinterpret_cast<int64_t*>(res));
+            }
+            static_cast<Context*>(env)->SetLongArrayRegion(result, 0, 4, res);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "min_max_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "min_max_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    min_max_float_n
+     * Signature: ([FIZ[JZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_min_1max_1float_1n
+    (JNIEnv* env, jclass, jfloatArray a, jint count, jboolean ignoreNaN, jlongArray result, jboolean useCrit) {
+        if (result == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "min_max_float - negative count argument:", count);
+            return;
+        }
+        try {
+            jlong res[4];
+            if (count == 0 || a == nullptr) {
+                min_max_float(static_cast<float*>(nullptr), 0, ignoreNaN == JNI_TRUE, reinterpret_cast<int64_t*>(res));
+            } else {
+                FloatArray aa = FloatArray(env, a, count, useCrit, true);
+                min_max_float(aa.ptr(), count, ignoreNaN == JNI_TRUE, reinterpret_cast<int64_t*>(res));
+            }
+            static_cast<Context*>(env)->SetLongArrayRegion(result, 0, 4, res);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "min_max_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "min_max_float: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    min_max_long_n
+     * Signature: ([JI[JZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_min_1max_1long_1n
+    (JNIEnv* env, jclass, jlongArray a, jint count, jlongArray result, jboolean useCrit) {
+        if (result == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "min_max_long - negative count argument:", count);
+            return;
+        }
+        try {
+            jlong res[4];
+            if (count == 0 || a == nullptr) {
+                min_max_long(static_cast<int64_t*>(nullptr), 0, reinterpret_cast<int64_t*>(res));
+            } else {
+                LongArray aa = LongArray(env, a, count, useCrit, true);
+                min_max_long(reinterpret_cast<int64_t*>(aa.ptr()), count, reinterpret_cast<int64_t*>(res));
+            }
+            static_cast<Context*>(env)->SetLongArrayRegion(result, 0, 4, res);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "min_max_long", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "min_max_long: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    min_max_int_n
+     * Signature: ([II[JZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_min_1max_1int_1n
+    (JNIEnv* env, jclass, jintArray a, jint count, jlongArray result, jboolean useCrit) {
+        if (result == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "min_max_int - negative count argument:", count);
+            return;
+        }
+        try {
+            jlong res[4];
+            if (count == 0 || a == nullptr) {
+                min_max_int(static_cast<int32_t*>(nullptr), 0, reinterpret_cast<int64_t*>(res));
+            } else {
+                IntArray aa = IntArray(env, a, count, useCrit, true);
+                min_max_int(aa.ptr(), count, reinterpret_cast<int64_t*>(res));
+            }
+            static_cast<Context*>(env)->SetLongArrayRegion(result, 0, 4, res);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "min_max_int", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "min_max_int: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    min_max_short_n
+     * Signature: ([SI[JZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_min_1max_1short_1n
+    (JNIEnv* env, jclass, jshortArray a, jint count, jlongArray result, jboolean useCrit) {
+        if (result == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "min_max_short - negative count argument:", count);
+            return;
+        }
+        try {
+            jlong res[4];
+            if (count == 0 || a == nullptr) {
+                min_max_short(static_cast<int16_t*>(nullptr), 0, reinterpret_cast<int64_t*>(res));
+            } else {
+                ShortArray aa = ShortArray(env, a, count, useCrit, true);
+                min_max_short(reinterpret_cast<int16_t*>(aa.ptr()), count, reinterpret_cast<int64_t*>(res));
+            }
+            static_cast<Context*>(env)->SetLongArrayRegion(result, 0, 4, res);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "min_max_short", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "min_max_short: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    min_max_byte_n
+     * Signature: ([BI[JZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_min_1max_1byte_1n
+    (JNIEnv* env, jclass, jbyteArray a, jint count, jlongArray result, jboolean useCrit) {
+        if (result == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "min_max_byte - negative count argument:", count);
+            return;
+        }
+        try {
+            jlong res[4];
+            if (count == 0 || a == nullptr) {
+                min_max_byte(static_cast<int8_t*>(nullptr), 0, reinterpret_cast<int64_t*>(res));
+            } else {
+                ByteArray aa = ByteArray(env, a, count, useCrit, true);
+                min_max_byte(aa.ptr(), count, reinterpret_cast<int64_t*>(res));
+            }
+            static_cast<Context*>(env)->SetLongArrayRegion(result, 0, 4, res);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "min_max_byte", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "min_max_byte: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    extremum_double_a
+     * Signature: (JJIZ)J
+     */
+    JNIEXPORT jlong JNICALL Java_net_cramer_simd_SIMD_extremum_1double_1a
+    (JNIEnv* env, jclass, jlong a, jlong count, jint op, jboolean ignoreNaN) {
+        if (op < OP_MIN || op > OP_ARGMAX) {
+            throwJavaRuntimeException(env, "%s %d", "extremum_double - unknown op:", op);
+            return 0;
+        }
+        if (count == 0 || a == 0) {
+            return extremum_double(static_cast<double*>(nullptr), 0, op, ignoreNaN == JNI_TRUE);
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %lld", "extremum_double - negative count argument:", static_cast<long long>(count));
+            return 0;
+        }
+        try {
+            return extremum_double(address_ptr<double>(a), count, op, ignoreNaN == JNI_TRUE);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "extremum_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "extremum_double: caught unknown exception");
+        }
+        return 0;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    extremum_float_a
+     * Signature: (JJIZ)J
+     */
+    JNIEXPORT jlong JNICALL Java_net_cramer_simd_SIMD_extremum_1float_1a
+    (JNIEnv* env, jclass, jlong a, jlong count, jint op, jboolean ignoreNaN) {
+        if (op < OP_MIN || op > OP_ARGMAX) {
+            throwJavaRuntimeException(env, "%s %d", "extremum_float - unknown op:", op);
+            return 0;
+        }
+        if (count == 0 || a == 0) {
+            return extremum_float(static_cast<float*>(nullptr), 0, op, ignoreNaN == JNI_TRUE);
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %lld", "extremum_float - negative count argument:", static_cast<long long>(count));
+            return 0;
+        }
+        try {
+            return extremum_float(address_ptr<float>(a), count, op, ignoreNaN == JNI_TRUE);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "extremum_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "extremum_float: caught unknown exception");
+        }
+        return 0;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    min_max_double_a
+     * Signature: (JJZ[J)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_min_1max_1double_1a
+    (JNIEnv* env, jclass, jlong a, jlong count, jboolean ignoreNaN, jlongArray result) {
+        if (result == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %lld", "min_max_double - negative count argument:", static_cast<long long>(count));
+            return;
+        }
+        try {
+            jlong res[4];
+            min_max_double((a == 0) ? static_cast<double*>(nullptr) : address_ptr<double>(a), (a == 0) ? 0 : count,
+                ignoreNaN == JNI_TRUE, reinterpret_cast<int64_t*>(res));
+            static_cast<Context*>(env)->SetLongArrayRegion(result, 0, 4, res);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "min_max_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "min_max_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    min_max_float_a
+     * Signature: (JJZ[J)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_min_1max_1float_1a
+    (JNIEnv* env, jclass, jlong a, jlong count, jboolean ignoreNaN, jlongArray result) {
+        if (result == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %lld", "min_max_float - negative count argument:", static_cast<long long>(count));
+            return;
+        }
+        try {
+            jlong res[4];
+            min_max_float((a == 0) ? static_cast<float*>(nullptr) : address_ptr<float>(a), (a == 0) ? 0 : count,
+                ignoreNaN == JNI_TRUE, reinterpret_cast<int64_t*>(res));
+            static_cast<Context*>(env)->SetLongArrayRegion(result, 0, 4, res);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "min_max_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "min_max_float: caught unknown exception");
+        }
+    }
+#ifdef __cplusplus
+}
+#endif
+
+
+template <typename T>
+struct ExtVec;
+
+#if INSTRSET >= 10
+template <> struct ExtVec<double> { typedef Vec8d V; };
+template <> struct ExtVec<float> { typedef Vec16f V; };
+template <> struct ExtVec<int64_t> { typedef Vec8q V; };
+template <> struct ExtVec<int32_t> { typedef Vec16i V; };
+template <> struct ExtVec<int16_t> { typedef Vec32s V; };
+template <> struct ExtVec<int8_t> { typedef Vec64c V; };
+#else
+template <> struct ExtVec<double> { typedef Vec4d V; };
+template <> struct ExtVec<float> { typedef Vec8f V; };
+template <> struct ExtVec<int64_t> { typedef Vec4q V; };
+template <> struct ExtVec<int32_t> { typedef Vec8i V; };
+template <> struct ExtVec<int16_t> { typedef Vec16s V; };
+template <> struct ExtVec<int8_t> { typedef Vec32c V; };
+#endif
+
+// Minimum and maximum of the non-NaN elements of a[0 .. n) (+inf / -inf, or
+// the largest / smallest value of an integer type, if there are none) and
+// whether there are NaNs. Note that the operand order of min(x, acc) and
+// max(x, acc) makes minps / maxps return acc if x is NaN.
+template <typename T>
+static void reduce_min_max(T* a, int64_t n, T& mn, T& mx, bool& nan) {
+    typedef typename ExtVec<T>::V V;
+    constexpr int L = V::size();
+    constexpr bool FP = std::is_floating_point<T>::value;
+    const T hi = FP ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+    const T lo = FP ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest();
+    V min0 = V(hi);
+    V min1 = V(hi);
+    V max0 = V(lo);
+    V max1 = V(lo);
+    auto nans = (min0 != min0);
+    int64_t i;
+    for (i = 0; i <= n - 2 * L; i += 2 * L) {
+        V x0 = V().load(a + i);
+        V x1 = V().load(a + i + L);
+        min0 = min(x0, min0);
+        min1 = min(x1, min1);
+        max0 = max(x0, max0);
+        max1 = max(x1, max1);
+        if constexpr (FP) {
+            nans |= is_nan(x0) | is_nan(x1);
+        }
+    }
+    for (; i <= n - L; i += L) {
+        V x0 = V().load(a + i);
+        min0 = min(x0, min0);
+        max0 = max(x0, max0);
+        if constexpr (FP) {
+            nans |= is_nan(x0);
+        }
+    }
+    mn = horizontal_min1(min(min0, min1));
+    mx = horizontal_max1(max(max0, max1));
+    nan = horizontal_or(nans);
+    for (; i < n; ++i) {
+        T x = a[i];
+        if (x != x) {
+            nan = true;
+        } else {
+            mn = std::min(mn, x);
+            mx = std::max(mx, x);
+        }
+    }
+}
+
+// index of the first element equal to value (NaN if value is NaN) or -1
+template <typename T>
+static int64_t find_first(T* a, int64_t n, T value) {
+    typedef typename ExtVec<T>::V V;
+    constexpr int L = V::size();
+    const bool findNaN = (value != value);
+    const V v = V(value);
+    int64_t i;
+    for (i = 0; i <= n - L; i += L) {
+        V x = V().load(a + i);
+        int j;
+        if constexpr (std::is_floating_point<T>::value) {
+            j = horizontal_find_first(findNaN ? is_nan(x) : (x == v));
+        } else {
+            j = horizontal_find_first(x == v);
+        }
+        if (j >= 0) {
+            return i + j;
+        }
+    }
+    for (; i < n; ++i) {
+        if (findNaN ? (a[i] != a[i]) : (a[i] == value)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// floating-point values as the bits of the double value, integers as such
+template <typename T>
+static inline int64_t value_bits(T x) {
+    if constexpr (std::is_floating_point<T>::value) {
+        double d = x;
+        int64_t bits;
+        memcpy(&bits, &d, sizeof(bits));
+        return bits;
+    } else {
+        return static_cast<int64_t>(x);
+    }
+}
+
+template <typename T>
+static int64_t extremum(T* a, int64_t count, int op, bool ignoreNaN) {
+    T mn, mx;
+    bool nan;
+    reduce_min_max(a, count, mn, mx, nan);
+    const bool propagate = nan && !ignoreNaN;
+    const bool found = (mn <= mx) || propagate;
+    const T none = std::numeric_limits<T>::quiet_NaN();
+    if (propagate || (!found && std::is_floating_point<T>::value)) {
+        mn = none;
+        mx = none;
+    }
+    switch (op) {
+    case OP_MIN:
+        return value_bits(mn);
+    case OP_MAX:
+        return value_bits(mx);
+    case OP_ARGMIN:
+        return found ? find_first(a, count, mn) : -1;
+    case OP_ARGMAX:
+        return found ? find_first(a, count, mx) : -1;
+    default:
+        return -1;
+    }
+}
+
+// result: index of the minimum, index of the maximum, minimum, maximum
+// (the values as in value_bits)
+template <typename T>
+static void min_max(T* a, int64_t count, bool ignoreNaN, int64_t* result) {
+    T mn, mx;
+    bool nan;
+    reduce_min_max(a, count, mn, mx, nan);
+    const bool found = (mn <= mx);
+    const T none = std::numeric_limits<T>::quiet_NaN();
+    if (nan && !ignoreNaN) {
+        result[0] = find_first(a, count, none);
+        result[1] = result[0];
+        mn = none;
+        mx = none;
+    } else if (found) {
+        result[0] = find_first(a, count, mn);
+        result[1] = find_first(a, count, mx);
+    } else {
+        result[0] = -1;
+        result[1] = -1;
+        if (std::is_floating_point<T>::value) {
+            mn = none;
+            mx = none;
+        }
+    }
+    result[2] = value_bits(mn);
+    result[3] = value_bits(mx);
+}
+
+int64_t extremum_double(double* a, int64_t count, int op, bool ignoreNaN) {
+    return extremum(a, count, op, ignoreNaN);
+}
+
+int64_t extremum_float(float* a, int64_t count, int op, bool ignoreNaN) {
+    return extremum(a, count, op, ignoreNaN);
+}
+
+int64_t extremum_long(int64_t* a, int64_t count, int op) {
+    return extremum(a, count, op, false);
+}
+
+int64_t extremum_int(int32_t* a, int64_t count, int op) {
+    return extremum(a, count, op, false);
+}
+
+int64_t extremum_short(int16_t* a, int64_t count, int op) {
+    return extremum(a, count, op, false);
+}
+
+int64_t extremum_byte(int8_t* a, int64_t count, int op) {
+    return extremum(a, count, op, false);
+}
+
+void min_max_double(double* a, int64_t count, bool ignoreNaN, int64_t* result) {
+    min_max(a, count, ignoreNaN, result);
+}
+
+void min_max_float(float* a, int64_t count, bool ignoreNaN, int64_t* result) {
+    min_max(a, count, ignoreNaN, result);
+}
+
+void min_max_long(int64_t* a, int64_t count, int64_t* result) {
+    min_max(a, count, false, result);
+}
+
+void min_max_int(int32_t* a, int64_t count, int64_t* result) {
+    min_max(a, count, false, result);
+}
+
+void min_max_short(int16_t* a, int64_t count, int64_t* result) {
+    min_max(a, count, false, result);
+}
+
+void min_max_byte(int8_t* a, int64_t count, int64_t* result) {
+    min_max(a, count, false, result);
+}
@@ -0,0 +1,479 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>             // std::sqrt
+#include <algorithm>         // std::min
+#include <jni.h>
+
+#ifndef VECTORIZE_INCLUDED_
+#include "vectorize.h"
+#endif /* VECTORIZE_INCLUDED_ */
+
+// MSVC doesn't define __F16C__ for /arch:AVX2 although every AVX2 CPU has
+// the F16C conversion instructions
+#if defined (_MSC_VER) && !defined (__F16C__) && INSTRSET >= 8
+#define __F16C__ 1
+#endif
+
+// vectorfp16.h defines non-inline functions, it must not be included in
+// any other translation unit
+#include "vcl/vectorfp16.h"
+
+#ifndef FLOATARRAY_INCLUDED_
+#include "FloatArray.h"
+#endif /* FLOATARRAY_INCLUDED_ */
+
+#ifndef SHORTARRAY_INCLUDED_
+#include "ShortArray.h"
+#endif /* SHORTARRAY_INCLUDED_ */
+
+#ifndef JEXCEPTION_INCLUDED_
+#include "JException.h"
+#endif /* JEXCEPTION_INCLUDED_ */
+
+#ifndef JEXCEPTIONUTILS_INCLUDED_
+#include "JExceptionUtils.h"
+#endif /* JEXCEPTIONUTILS_INCLUDED_ */
+
+
+// 16 bit storage formats (IEEE half precision and bfloat16). The values are
+// converted to float in registers (F16C / AVX512F vcvtph2ps or AVX512-FP16
+// via VCL for half precision, a shift for bfloat16) and all arithmetic and
+// accumulation is done in float.
+
+// must be kept in sync with HalfPrecision.java
+constexpr int FORMAT_FP16 = 0;
+constexpr int FORMAT_BF16 = 1;
+
+
+static bool checkFormat(JNIEnv* env, const char* method, jint format) {
+    if (format != FORMAT_FP16 && format != FORMAT_BF16) {
+        throwJavaRuntimeException(env, "%s - unknown format: %d", method, format);
+        return false;
+    }
+    return true;
+}
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    /*
+     * Class:     net_cramer_simd_HalfPrecision
+     * Method:    encode_n
+     * Signature: ([F[SIIZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_HalfPrecision_encode_1n
+    (JNIEnv* env, jclass, jfloatArray x, jshortArray h, jint count, jint format, jboolean useCrit) {
+        if (!checkFormat(env, "encode", format)) {
+            return;
+        }
+        if (count == 0 || x == nullptr || h == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "encode - negative count argument:", count);
+            return;
+        }
+        try {
+            FloatArray xx = FloatArray(env, x, count, useCrit, true);
+            ShortArray hh = ShortArray(env, h, count, useCrit);
+            encode_half(xx.ptr(), hh.ptr(), count, format);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "encode", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "encode: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_HalfPrecision
+     * Method:    decode_n
+     * Signature: ([S[FIIZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_HalfPrecision_decode_1n
+    (JNIEnv* env, jclass, jshortArray h, jfloatArray x, jint count, jint format, jboolean useCrit) {
+        if (!checkFormat(env, "decode", format)) {
+            return;
+        }
+        if (count == 0 || x == nullptr || h == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "decode - negative count argument:", count);
+            return;
+        }
+        try {
+            ShortArray hh = ShortArray(env, h, count, useCrit, true);
+            FloatArray xx = FloatArray(env, x, count, useCrit);
+            decode_half(hh.ptr(), xx.ptr(), count, format);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "decode", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "decode: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_HalfPrecision
+     * Method:    dot_n
+     * Signature: ([S[SIIZ)F
+     */
+    JNIEXPORT jfloat JNICALL Java_net_cramer_simd_HalfPrecision_dot_1n
+    (JNIEnv* env, jclass, jshortArray a, jshortArray b, jint count, jint format, jboolean useCrit) {
+        if (!checkFormat(env, "dot", format)) {
+            return NOT_REACHED_F;
+        }
+        if (count == 0 || a == nullptr || b == nullptr) {
+            return 0.0f;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "dot - negative count argument:", count);
+            return NOT_REACHED_F;
+        }
+        try {
+            ShortArray aa = ShortArray(env, a, count, useCrit, true);
+            ShortArray bb = ShortArray(env, b, count, useCrit, true);
+            return dot_half(aa.ptr(), bb.ptr(), count, format);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "dot", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "dot: caught unknown exception");
+        }
+        return NOT_REACHED_F;
+    }
+
+    /*
+     * Class:     net_cramer_simd_HalfPrecision
+     * Method:    squared_distance_n
+     * Signature: ([S[SIIZ)F
+     */
+    JNIEXPORT jfloat JNICALL Java_net_cramer_simd_HalfPrecision_squared_1distance_1n
+    (JNIEnv* env, jclass, jshortArray a, jshortArray b, jint count, jint format, jboolean useCrit) {
+        if (!checkFormat(env, "squared_distance", format)) {
+            return NOT_REACHED_F;
+        }
+        if (count == 0 || a == nullptr || b == nullptr) {
+            return 0.0f;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "squared_distance - negative count argument:", count);
+            return NOT_REACHED_F;
+        }
+        try {
+            ShortArray aa = ShortArray(env, a, count, useCrit, true);
+            ShortArray bb = ShortArray(env, b, count, useCrit, true);
+            return squared_distance_half(aa.ptr(), bb.ptr(), count, format);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "squared_distance", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "squared_distance: caught unknown exception");
+        }
+        return NOT_REACHED_F;
+    }
+
+    /*
+     * Class:     net_cramer_simd_HalfPrecision
+     * Method:    distances_n
+     * Signature: ([F[SIIII[FZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_HalfPrecision_distances_1n
+    (JNIEnv* env, jclass, jfloatArray query, jshortArray base, jint rows, jint dim, jint format, jint metric,
+        jfloatArray out, jboolean useCrit) {
+        if (!checkFormat(env, "distances", format)) {
+            return;
+        }
+        if (metric < METRIC_L2_SQUARED || metric > METRIC_COSINE) {
+            throwJavaRuntimeException(env, "%s %d", "distances - unknown metric:", metric);
+            return;
+        }
+        if (rows < 0 || dim < 0) {
+            throwJavaRuntimeException(env, "%s %d %d", "distances - negative rows / dim argument:", rows, dim);
+            return;
+        }
+        if (static_cast<int64_t>(rows) * dim > INT32_MAX) {
+            throwJavaRuntimeException(env, "%s %d %d", "distances - rows * dim too large:", rows, dim);
+            return;
+        }
+        if (rows == 0 || query == nullptr || base == nullptr || out == nullptr) {
+            return;
+        }
+        try {
+            FloatArray qq = FloatArray(env, query, dim, useCrit, true);
+            ShortArray bb = ShortArray(env, base, rows * dim, useCrit, true);
+            FloatArray oo = FloatArray(env, out, rows, useCrit);
+            distances_half(qq.ptr(), bb.ptr(), rows, dim, format, metric, oo.ptr());
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "distances", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "distances: caught unknown exception");
+        }
+    }
+#ifdef __cplusplus
+}
+#endif
+
+
+// Loaders / storers of 16 lanes in the different storage formats
+
+struct Fp32 {
+    typedef float T;
+
+    static inline Vec16f load(float const* p) {
+        return Vec16f().load(p);
+    }
+
+    static inline Vec16f load_partial(int n, float const* p) {
+        return Vec16f().load_partial(n, p);
+    }
+};
+
+struct Fp16 {
+    typedef uint16_t T;
+
+    static inline Vec16f load(uint16_t const* p) {
+        return to_float(Vec16h().load(p));
+    }
+
+    static inline Vec16f load_partial(int n, uint16_t const* p) {
+        return to_float(Vec16h().load_partial(n, p));
+    }
+
+    // round to nearest even, overflow to infinity
+    static inline void store(Vec16f const v, uint16_t* p) {
+        to_float16(v).store(p);
+    }
+
+    static inline void store_partial(int n, Vec16f const v, uint16_t* p) {
+        to_float16(v).store_partial(n, p);
+    }
+};
+
+struct Bf16 {
+    typedef uint16_t T;
+
+    // bfloat16 is the upper half of a float
+    static inline Vec16f load(uint16_t const* p) {
+        return reinterpret_f(Vec16ui(extend(Vec16us().load(p))) << 16);
+    }
+
+    static inline Vec16f load_partial(int n, uint16_t const* p) {
+        return reinterpret_f(Vec16ui(extend(Vec16us().load_partial(n, p))) << 16);
+    }
+
+    // round to nearest even, NaNs stay (quiet) NaNs. AVX512-BF16 vcvtneps2bf16
+    // is not used since it flushes subnormals to zero and we want the same
+    // encoding on every instruction set
+    static inline Vec16us convert(Vec16f const v) {
+        Vec16ui bits = Vec16ui(reinterpret_i(v));
+        Vec16ui rounded = bits + (0x7FFFu + ((bits >> 16) & 1u));
+        return compress(select(is_nan(v), bits | 0x00400000u, rounded) >> 16);
+    }
+
+    static inline void store(Vec16f const v, uint16_t* p) {
+        convert(v).store(p);
+    }
+
+    static inline void store_partial(int n, Vec16f const v, uint16_t* p) {
+        convert(v).store_partial(n, p);
+    }
+};
+
+template <typename F>
+static inline void encode(float* x, uint16_t* h, int64_t count) {
+    int64_t i;
+    for (i = 0; i < count - (STEP_16 - 1); i += STEP_16) {
+        F::store(Vec16f().load(x + i), h + i);
+    }
+    if (i < count) {
+        int rest = static_cast<int>(count - i);
+        F::store_partial(rest, Vec16f().load_partial(rest, x + i), h + i);
+    }
+}
+
+template <typename F>
+static inline void decode(uint16_t* h, float* x, int64_t count) {
+    int64_t i;
+    for (i = 0; i < count - (STEP_16 - 1); i += STEP_16) {
+        F::load(h + i).store(x + i);
+    }
+    if (i < count) {
+        int rest = static_cast<int>(count - i);
+        F::load_partial(rest, h + i).store_partial(rest, x + i);
+    }
+}
+
+// sum of a_i * b_i (4 accumulators)
+template <typename FA, typename FB>
+static inline float dot(typename FA::T* a, typename FB::T* b, int64_t count) {
+    Vec16f acc0 = Vec16f(0.0f);
+    Vec16f acc1 = Vec16f(0.0f);
+    Vec16f acc2 = Vec16f(0.0f);
+    Vec16f acc3 = Vec16f(0.0f);
+
+    int64_t i;
+    for (i = 0; i <= count - 4 * STEP_16; i += 4 * STEP_16) {
+        acc0 = mul_add(FA::load(a + i), FB::load(b + i), acc0);
+        acc1 = mul_add(FA::load(a + i + STEP_16), FB::load(b + i + STEP_16), acc1);
+        acc2 = mul_add(FA::load(a + i + 2 * STEP_16), FB::load(b + i + 2 * STEP_16), acc2);
+        acc3 = mul_add(FA::load(a + i + 3 * STEP_16), FB::load(b + i + 3 * STEP_16), acc3);
+    }
+    for (; i <= count - STEP_16; i += STEP_16) {
+        acc0 = mul_add(FA::load(a + i), FB::load(b + i), acc0);
+    }
+    if (i < count) {
+        int rest = static_cast<int>(count - i);
+        acc1 = mul_add(FA::load_partial(rest, a + i), FB::load_partial(rest, b + i), acc1);
+    }
+    return horizontal_add((acc0 + acc1) + (acc2 + acc3));
+}
+
+// sum of (a_i - b_i)^2 (4 accumulators)
+template <typename FA, typename FB>
+static inline float squared_distance(typename FA::T* a, typename FB::T* b, int64_t count) {
+    Vec16f acc0 = Vec16f(0.0f);
+    Vec16f acc1 = Vec16f(0.0f);
+    Vec16f acc2 = Vec16f(0.0f);
+    Vec16f acc3 = Vec16f(0.0f);
+    Vec16f d0, d1, d2, d3;
+
+    int64_t i;
+    for (i = 0; i <= count - 4 * STEP_16; i += 4 * STEP_16) {
+        d0 = FA::load(a + i) - FB::load(b + i);
+        d1 = FA::load(a + i + STEP_16) - FB::load(b + i + STEP_16);
+        d2 = FA::load(a + i + 2 * STEP_16) - FB::load(b + i + 2 * STEP_16);
+        d3 = FA::load(a + i + 3 * STEP_16) - FB::load(b + i + 3 * STEP_16);
+        acc0 = mul_add(d0, d0, acc0);
+        acc1 = mul_add(d1, d1, acc1);
+        acc2 = mul_add(d2, d2, acc2);
+        acc3 = mul_add(d3, d3, acc3);
+    }
+    for (; i <= count - STEP_16; i += STEP_16) {
+        d0 = FA::load(a + i) - FB::load(b + i);
+        acc0 = mul_add(d0, d0, acc0);
+    }
+    if (i < count) {
+        int rest = static_cast<int>(count - i);
+        d1 = FA::load_partial(rest, a + i) - FB::load_partial(rest, b + i);
+        acc1 = mul_add(d1, d1, acc1);
+    }
+    return horizontal_add((acc0 + acc1) + (acc2 + acc3));
+}
+
+// a.b and b.b in one pass (2 x 2 accumulators)
+template <typename FA, typename FB>
+static inline void dot_norm(typename FA::T* a, typename FB::T* b, int64_t count, float& ab, float& bb) {
+    Vec16f ab0 = Vec16f(0.0f);
+    Vec16f ab1 = Vec16f(0.0f);
+    Vec16f bb0 = Vec16f(0.0f);
+    Vec16f bb1 = Vec16f(0.0f);
+    Vec16f va0, vb0, va1, vb1;
+
+    int64_t i;
+    for (i = 0; i <= count - 2 * STEP_16; i += 2 * STEP_16) {
+        va0 = FA::load(a + i);
+        vb0 = FB::load(b + i);
+        va1 = FA::load(a + i + STEP_16);
+        vb1 = FB::load(b + i + STEP_16);
+        ab0 = mul_add(va0, vb0, ab0);
+        bb0 = mul_add(vb0, vb0, bb0);
+        ab1 = mul_add(va1, vb1, ab1);
+        bb1 = mul_add(vb1, vb1, bb1);
+    }
+    for (; i < count; i += STEP_16) {
+        int n = static_cast<int>(std::min(count - i, int64_t(STEP_16)));
+        va0 = FA::load_partial(n, a + i);
+        vb0 = FB::load_partial(n, b + i);
+        ab0 = mul_add(va0, vb0, ab0);
+        bb0 = mul_add(vb0, vb0, bb0);
+    }
+    ab = horizontal_add(ab0 + ab1);
+    bb = horizontal_add(bb0 + bb1);
+}
+
+// The metric of the float query against each of the rows of the row-major
+// rows x dim matrix base in 16 bit format F
+template <typename F>
+static inline void distances(float* query, uint16_t* base, int64_t rows, int64_t dim, int metric, float* out) {
+    switch (metric) {
+    case METRIC_L2_SQUARED:
+        for (int64_t r = 0; r < rows; ++r) {
+            PREFETCH(base + (r + 1) * dim);
+            out[r] = squared_distance<Fp32, F>(query, base + r * dim, dim);
+        }
+        break;
+    case METRIC_INNER_PRODUCT:
+        for (int64_t r = 0; r < rows; ++r) {
+            PREFETCH(base + (r + 1) * dim);
+            out[r] = dot<Fp32, F>(query, base + r * dim, dim);
+        }
+        break;
+    default: {
+        float qq = dot<Fp32, Fp32>(query, query, dim);
+        for (int64_t r = 0; r < rows; ++r) {
+            PREFETCH(base + (r + 1) * dim);
+            float ab, bb;
+            dot_norm<Fp32, F>(query, base + r * dim, dim, ab, bb);
+            // a zero vector is orthogonal to everything (as in cosine_float)
+            out[r] = (qq == 0.0f || bb == 0.0f) ? 0.0f : ab / (std::sqrt(qq) * std::sqrt(bb));
+        }
+        break;
+    }
+    }
+}
+
+void encode_half(float* x, uint16_t* h, int64_t count, int format) {
+    if (format == FORMAT_FP16) {
+        encode<Fp16>(x, h, count);
+    } else {
+        encode<Bf16>(x, h, count);
+    }
+}
+
+void decode_half(uint16_t* h, float* x, int64_t count, int format) {
+    if (format == FORMAT_FP16) {
+        decode<Fp16>(h, x, count);
+    } else {
+        decode<Bf16>(h, x, count);
+    }
+}
+
+float dot_half(uint16_t* a, uint16_t* b, int64_t count, int format) {
+    return (format == FORMAT_FP16) ? dot<Fp16, Fp16>(a, b, count) : dot<Bf16, Bf16>(a, b, count);
+}
+
+float squared_distance_half(uint16_t* a, uint16_t* b, int64_t count, int format) {
+    return (format == FORMAT_FP16) ? squared_distance<Fp16, Fp16>(a, b, count)
+        : squared_distance<Bf16, Bf16>(a, b, count);
+}
+
+void distances_half(float* query, uint16_t* base, int64_t rows, int64_t dim, int format, int metric, float* out) {
+    if (format == FORMAT_FP16) {
+        distances<Fp16>(query, base, rows, dim, metric, out);
+    } else {
+        distances<Bf16>(query, base, rows, dim, metric, out);
+    }
+}
@@ -0,0 +1,316 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>         // std::min, std::max
+#include <jni.h>
+
+#ifndef VECTORIZE_INCLUDED_
+#include "vectorize.h"
+#endif /* VECTORIZE_INCLUDED_ */
+
+#ifndef PARALLEL_INCLUDED_
+#include "Parallel.h"
+#endif /* PARALLEL_INCLUDED_ */
+
+#ifndef LONGARRAY_INCLUDED_
+#include "LongArray.h"
+#endif /* LONGARRAY_INCLUDED_ */
+
+#ifndef INTARRAY_INCLUDED_
+#include "IntArray.h"
+#endif /* INTARRAY_INCLUDED_ */
+
+#ifndef JEXCEPTION_INCLUDED_
+#include "JException.h"
+#endif /* JEXCEPTION_INCLUDED_ */
+
+#ifndef JEXCEPTIONUTILS_INCLUDED_
+#include "JExceptionUtils.h"
+#endif /* JEXCEPTIONUTILS_INCLUDED_ */
+
+
+// Popcount and Hamming distance of bit vectors stored as rows of 'words'
+// 64 bit words. The 64 bit lanes are counted with vpopcntq where AVX512
+// VPOPCNTDQ is available, otherwise with a 4 bit lookup table (vpshufb)
+// whose byte counts are summed into the 64 bit lanes by vpsadbw. The common
+// signature sizes of 256 and 512 bits keep the query in registers, the
+// one-vs-many and pairwise scans are split across threads.
+
+// words per thread (at least)
+constexpr int64_t HAMMING_MIN_WORK = 1 << 20;
+// bytes of the second operand of the pairwise scan per block
+constexpr int64_t HAMMING_BLOCK_BYTES = 128 * 1024;
+
+
+int64_t popcount_words(uint64_t* a, int64_t words);
+int64_t hamming_distance(uint64_t* a, uint64_t* b, int64_t words);
+void hamming_distances(uint64_t* query, uint64_t* base, int64_t rows, int64_t words, int32_t* out);
+void hamming_pairwise(uint64_t* a, int64_t rowsA, uint64_t* b, int64_t rowsB, int64_t words, int32_t* out);
+
+
+static bool checkShape(JNIEnv* env, const char* method, jint rows, jint words) {
+    if (rows < 0 || words < 0) {
+        throwJavaRuntimeException(env, "%s - negative argument: rows = %d, words = %d", method, rows, words);
+        return false;
+    }
+    if (static_cast<int64_t>(rows) * words > INT32_MAX) {
+        throwJavaRuntimeException(env, "%s - rows * words too large: rows = %d, words = %d", method, rows, words);
+        return false;
+    }
+    return true;
+}
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    /*
+     * Class:     net_cramer_simd_BitVectors
+     * Method:    popcount_n
+     * Signature: ([JIZ)J
+     */
+    JNIEXPORT jlong JNICALL Java_net_cramer_simd_BitVectors_popcount_1n
+    (JNIEnv* env, jclass, jlongArray a, jint words, jboolean useCrit) {
+        if (words == 0 || a == nullptr) {
+            return 0L;
+        }
+        if (words < 0) {
+            throwJavaRuntimeException(env, "%s %d", "popcount - negative words argument:", words);
+            return -1L;
+        }
+        try {
+            LongArray aa = LongArray(env, a, words, useCrit, true);
+            return popcount_words(aa.ptr(), words);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "popcount", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "popcount: caught unknown exception");
+        }
+        return -1L;
+    }
+
+    /*
+     * Class:     net_cramer_simd_BitVectors
+     * Method:    distance_n
+     * Signature: ([J[JIZ)J
+     */
+    JNIEXPORT jlong JNICALL Java_net_cramer_simd_BitVectors_distance_1n
+    (JNIEnv* env, jclass, jlongArray a, jlongArray b, jint words, jboolean useCrit) {
+        if (words == 0 || a == nullptr || b == nullptr) {
+            return 0L;
+        }
+        if (words < 0) {
+            throwJavaRuntimeException(env, "%s %d", "distance - negative words argument:", words);
+            return -1L;
+        }
+        try {
+            LongArray aa = LongArray(env, a, words, useCrit, true);
+            LongArray bb = LongArray(env, b, words, useCrit, true);
+            return hamming_distance(aa.ptr(), bb.ptr(), words);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "distance", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "distance: caught unknown exception");
+        }
+        return -1L;
+    }
+
+    /*
+     * Class:     net_cramer_simd_BitVectors
+     * Method:    distances_n
+     * Signature: ([J[JII[IZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_BitVectors_distances_1n
+    (JNIEnv* env, jclass, jlongArray query, jlongArray base, jint rows, jint words, jintArray out,
+        jboolean useCrit) {
+        if (!checkShape(env, "distances", rows, words)) {
+            return;
+        }
+        if (rows == 0 || query == nullptr || base == nullptr || out == nullptr) {
+            return;
+        }
+        try {
+            LongArray qq = LongArray(env, query, words, useCrit, true);
+            LongArray bb = LongArray(env, base, rows * words, useCrit, true);
+            IntArray oo = IntArray(env, out, rows, useCrit);
+            hamming_distances(qq.ptr(), bb.ptr(), rows, words, oo.ptr());
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "distances", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "distances: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_BitVectors
+     * Method:    pairwise_n
+     * Signature: ([JI[JII[IZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_BitVectors_pairwise_1n
+    (JNIEnv* env, jclass, jlongArray a, jint rowsA, jlongArray b, jint rowsB, jint words, jintArray out,
+        jboolean useCrit) {
+        if (!checkShape(env, "pairwise", rowsA, words) || !checkShape(env, "pairwise", rowsB, words)) {
+            return;
+        }
+        if (static_cast<int64_t>(rowsA) * rowsB > INT32_MAX) {
+            throwJavaRuntimeException(env, "%s - rowsA * rowsB too large: rowsA = %d, rowsB = %d", "pairwise",
+                rowsA, rowsB);
+            return;
+        }
+        if (rowsA == 0 || rowsB == 0 || a == nullptr || b == nullptr || out == nullptr) {
+            return;
+        }
+        try {
+            LongArray aa = LongArray(env, a, rowsA * words, useCrit, true);
+            LongArray bb = LongArray(env, b, rowsB * words, useCrit, true);
+            IntArray oo = IntArray(env, out, rowsA * rowsB, useCrit);
+            hamming_pairwise(aa.ptr(), rowsA, bb.ptr(), rowsB, words, oo.ptr());
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "pairwise", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "pairwise: caught unknown exception");
+        }
+    }
+#ifdef __cplusplus
+}
+#endif
+
+
+// popcount of each 64 bit lane
+static inline Vec4uq popcount_lanes(Vec4uq const v) {
+#if defined (__AVX512VPOPCNTDQ__) && defined (__AVX512VL__)
+    return _mm256_popcnt_epi64(v);
+#else
+    const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low4 = _mm256_set1_epi8(0x0F);
+    __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, low4));
+    __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), low4));
+    return _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256());
+#endif
+}
+
+static inline Vec8uq popcount_lanes(Vec8uq const v) {
+#if defined (__AVX512VPOPCNTDQ__) && INSTRSET >= 10
+    return _mm512_popcnt_epi64(v);
+#elif INSTRSET >= 10
+    const __m512i table = _mm512_broadcast_i32x4(_mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4));
+    const __m512i low4 = _mm512_set1_epi8(0x0F);
+    __m512i lo = _mm512_shuffle_epi8(table, _mm512_and_si512(v, low4));
+    __m512i hi = _mm512_shuffle_epi8(table, _mm512_and_si512(_mm512_srli_epi16(v, 4), low4));
+    return _mm512_sad_epu8(_mm512_add_epi8(lo, hi), _mm512_setzero_si512());
+#else
+    return Vec8uq(popcount_lanes(v.get_low()), popcount_lanes(v.get_high()));
+#endif
+}
+
+// popcount of a ^ b (of a alone if b is nullptr), 2 accumulators
+template <bool XOR>
+static inline int64_t count_bits(uint64_t* a, uint64_t* b, int64_t words) {
+    Vec8uq acc0 = Vec8uq(0);
+    Vec8uq acc1 = Vec8uq(0);
+    Vec8uq v0, v1;
+
+    int64_t i;
+    for (i = 0; i <= words - 2 * 8; i += 2 * 8) {
+        v0 = Vec8uq().load(a + i);
+        v1 = Vec8uq().load(a + i + 8);
+        if (XOR) {
+            v0 ^= Vec8uq().load(b + i);
+            v1 ^= Vec8uq().load(b + i + 8);
+        }
+        acc0 += popcount_lanes(v0);
+        acc1 += popcount_lanes(v1);
+    }
+    for (; i < words; i += 8) {
+        // load_partial zero fills, zero words don't count
+        int n = static_cast<int>(std::min(words - i, int64_t(8)));
+        v0 = Vec8uq().load_partial(n, a + i);
+        if (XOR) {
+            v0 ^= Vec8uq().load_partial(n, b + i);
+        }
+        acc0 += popcount_lanes(v0);
+    }
+    return static_cast<int64_t>(horizontal_add(acc0 + acc1));
+}
+
+// Hamming distances of the query to the rows [begin, end) of base
+static void distances_range(uint64_t* query, uint64_t* base, int64_t begin, int64_t end, int64_t words,
+    int32_t* out) {
+    if (words == 4) {
+        Vec4uq q = Vec4uq().load(query);
+        for (int64_t r = begin; r < end; ++r) {
+            out[r] = static_cast<int32_t>(horizontal_add(popcount_lanes(q ^ Vec4uq().load(base + r * 4))));
+        }
+    } else if (words == 8) {
+        Vec8uq q = Vec8uq().load(query);
+        for (int64_t r = begin; r < end; ++r) {
+            out[r] = static_cast<int32_t>(horizontal_add(popcount_lanes(q ^ Vec8uq().load(base + r * 8))));
+        }
+    } else {
+        for (int64_t r = begin; r < end; ++r) {
+            PREFETCH(base + (r + 1) * words);
+            out[r] = static_cast<int32_t>(count_bits<true>(query, base + r * words, words));
+        }
+    }
+}
+
+int64_t popcount_words(uint64_t* a, int64_t words) {
+    return count_bits<false>(a, nullptr, words);
+}
+
+int64_t hamming_distance(uint64_t* a, uint64_t* b, int64_t words) {
+    return count_bits<true>(a, b, words);
+}
+
+void hamming_distances(uint64_t* query, uint64_t* base, int64_t rows, int64_t words, int32_t* out) {
+    if (words == 0) {
+        std::fill(out, out + rows, 0);
+        return;
+    }
+    const int64_t grain = std::max(int64_t(1), HAMMING_MIN_WORK / words);
+    parallel_for(rows, grain, [&](int64_t begin, int64_t end, int) {
+        distances_range(query, base, begin, end, words, out);
+    });
+}
+
+// out is the row-major (rowsA x rowsB) matrix of the Hamming distances of
+// the rows of a to the rows of b. Each thread takes a range of rows of a
+// and scans b in blocks that stay in cache.
+void hamming_pairwise(uint64_t* a, int64_t rowsA, uint64_t* b, int64_t rowsB, int64_t words, int32_t* out) {
+    if (words == 0) {
+        std::fill(out, out + rowsA * rowsB, 0);
+        return;
+    }
+    const int64_t blockRows = std::max(int64_t(1), HAMMING_BLOCK_BYTES / (words * int64_t(sizeof(uint64_t))));
+    const int64_t grain = std::max(int64_t(1), HAMMING_MIN_WORK / (words * rowsB));
+    parallel_for(rowsA, grain, [&](int64_t begin, int64_t end, int) {
+        for (int64_t b0 = 0; b0 < rowsB; b0 += blockRows) {
+            int64_t bn = std::min(blockRows, rowsB - b0);
+            for (int64_t i = begin; i < end; ++i) {
+                distances_range(a + i * words, b + b0 * words, 0, bn, words, out + i * rowsB + b0);
+            }
+        }
+    });
+}
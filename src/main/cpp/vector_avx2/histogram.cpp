@@ -0,0 +1,548 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>         // std::min, std::max, std::copy, std::fill
+#include <cmath>             // std::isfinite
+#include <limits>            // std::numeric_limits
+#include <vector>            // std::vector
+#include <jni.h>
+
+#ifndef VECTORIZE_INCLUDED_
+#include "vectorize.h"
+#endif /* VECTORIZE_INCLUDED_ */
+
+#ifndef PARALLEL_INCLUDED_
+#include "Parallel.h"
+#endif /* PARALLEL_INCLUDED_ */
+
+#ifndef ARENA_INCLUDED_
+#include "Arena.h"
+#endif /* ARENA_INCLUDED_ */
+
+#ifndef DOUBLEARRAY_INCLUDED_
+#include "DoubleArray.h"
+#endif /* DOUBLEARRAY_INCLUDED_ */
+
+#ifndef FLOATARRAY_INCLUDED_
+#include "FloatArray.h"
+#endif /* FLOATARRAY_INCLUDED_ */
+
+#ifndef INTARRAY_INCLUDED_
+#include "IntArray.h"
+#endif /* INTARRAY_INCLUDED_ */
+
+#ifndef LONGARRAY_INCLUDED_
+#include "LongArray.h"
+#endif /* LONGARRAY_INCLUDED_ */
+
+#ifndef ALIGNEDBUFFER_INCLUDED_
+#include "AlignedBuffer.h"
+#endif /* ALIGNEDBUFFER_INCLUDED_ */
+
+#ifndef JEXCEPTION_INCLUDED_
+#include "JException.h"
+#endif /* JEXCEPTION_INCLUDED_ */
+
+#ifndef JEXCEPTIONUTILS_INCLUDED_
+#include "JExceptionUtils.h"
+#endif /* JEXCEPTIONUTILS_INCLUDED_ */
+
+
+// Histograms of double / float arrays with fixed-width or explicit bins.
+// The bin indices of a whole vector are computed at once (a scaled
+// truncation for fixed-width bins, a comparison count for a few explicit
+// edges, a branchless binary search with gathers for many) and counted in
+// HISTOGRAM_SUBS interleaved sub-histograms, so that equal indices of
+// neighbouring elements don't serialize on the same counter. Values outside
+// the range and NaNs are counted in an extra bin behind the last one. Each
+// thread has its own sub-histograms, all get merged at the end.
+
+// elements per thread (at least)
+constexpr int64_t HISTOGRAM_MIN_WORK = 1 << 18;
+// sub-histograms per thread if they fit into HISTOGRAM_SUB_BYTES
+constexpr int HISTOGRAM_SUBS = 4;
+constexpr int64_t HISTOGRAM_SUB_BYTES = 64 * 1024;
+// the sub-histograms have 32-bit counters, a thread adds them to its 64-bit
+// totals (and restarts them) after at most this many elements
+constexpr int64_t HISTOGRAM_FLUSH_ELEMENTS = int64_t(1) << 31;
+// explicit edges are searched by comparison count up to this many bins
+constexpr int32_t HISTOGRAM_LINEAR_BINS = 16;
+// the bin indices are computed in floating-point (exact in float)
+constexpr int32_t HISTOGRAM_MAX_BINS = 1 << 24;
+
+
+int64_t histogram_double(double* a, int64_t count, double min, double max, int32_t bins, int32_t* counts,
+    int64_t* lcounts, bool parallel);
+int64_t histogram_float(float* a, int64_t count, float min, float max, int32_t bins, int32_t* counts,
+    int64_t* lcounts, bool parallel);
+bool histogram_edges_double(double* a, int64_t count, double* edges, int32_t bins, int32_t* counts,
+    int64_t* lcounts, bool parallel, int64_t& skipped);
+bool histogram_edges_float(float* a, int64_t count, float* edges, int32_t bins, int32_t* counts,
+    int64_t* lcounts, bool parallel, int64_t& skipped);
+
+
+static bool checkBins(JNIEnv* env, const char* method, jlong count, jint bins) {
+    if (count < 0) {
+        throwJavaRuntimeException(env, "%s - negative count argument: %lld", method, static_cast<long long>(count));
+        return false;
+    }
+    if (bins < 1 || bins > HISTOGRAM_MAX_BINS) {
+        throwJavaRuntimeException(env, "%s - bins out of range: bins = %d", method, bins);
+        return false;
+    }
+    return true;
+}
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    histogram_double_n
+     * Signature: ([DIDDI[I[JZZ)J
+     */
+    JNIEXPORT jlong JNICALL Java_net_cramer_simd_SIMD_histogram_1double_1n
+    (JNIEnv* env, jclass, jdoubleArray a, jint count, jdouble min, jdouble max, jint bins, jintArray counts, jlongArray lcounts,
+        jboolean parallel, jboolean useCrit) {
+        if (count == 0 || a == nullptr || (counts == nullptr && lcounts == nullptr)) {
+            return 0L;
+        }
+        if (!checkBins(env, "histogram_double", count, bins)) {
+            return -1L;
+        }
+        if (!(min < max) || !std::isfinite(max - min)) {
+            throwJavaRuntimeException(env, "%s - invalid range: min = %f, max = %f", "histogram_double", min, max);
+            return -1L;
+        }
+        try {
+            DoubleArray aa = DoubleArray(env, a, count, useCrit, true);
+            if (counts != nullptr) {
+                IntArray cc = IntArray(env, counts, bins, useCrit);
+                return histogram_double(aa.ptr(), count, min, max, bins, cc.ptr(), nullptr, parallel);
+            }
+            LongArray cc = LongArray(env, lcounts, bins, useCrit);
+            return histogram_double(aa.ptr(), count, min, max, bins, nullptr, reinterpret_cast<int64_t*>(cc.ptr()),
+                parallel);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "histogram_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "histogram_double: caught unknown exception");
+        }
+        return -1L;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    histogram_float_n
+     * Signature: ([FIFFI[I[JZZ)J
+     */
+    JNIEXPORT jlong JNICALL Java_net_cramer_simd_SIMD_histogram_1float_1n
+    (JNIEnv* env, jclass, jfloatArray a, jint count, jfloat min, jfloat max, jint bins, jintArray counts, jlongArray lcounts,
+        jboolean parallel, jboolean useCrit) {
+        if (count == 0 || a == nullptr || (counts == nullptr && lcounts == nullptr)) {
+            return 0L;
+        }
+        if (!checkBins(env, "histogram_float", count, bins)) {
+            return -1L;
+        }
+        if (!(min < max) || !std::isfinite(max - min)) {
+            throwJavaRuntimeException(env, "%s - invalid range: min = %f, max = %f", "histogram_float", min, max);
+            return -1L;
+        }
+        try {
+            FloatArray aa = FloatArray(env, a, count, useCrit, true);
+            if (counts != nullptr) {
+                IntArray cc = IntArray(env, counts, bins, useCrit);
+                return histogram_float(aa.ptr(), count, min, max, bins, cc.ptr(), nullptr, parallel);
+            }
+            LongArray cc = LongArray(env, lcounts, bins, useCrit);
+            return histogram_float(aa.ptr(), count, min, max, bins, nullptr, reinterpret_cast<int64_t*>(cc.ptr()),
+                parallel);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "histogram_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "histogram_float: caught unknown exception");
+        }
+        return -1L;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    histogram_edges_double_n
+     * Signature: ([DI[DI[I[JZZ)J
+     */
+    JNIEXPORT jlong JNICALL Java_net_cramer_simd_SIMD_histogram_1edges_1double_1n
+    (JNIEnv* env, jclass, jdoubleArray a, jint count, jdoubleArray edges, jint nEdges, jintArray counts, jlongArray lcounts,
+        jboolean parallel, jboolean useCrit) {
+        if (count == 0 || a == nullptr || edges == nullptr || (counts == nullptr && lcounts == nullptr)) {
+            return 0L;
+        }
+        if (!checkBins(env, "histogram_edges_double", count, nEdges - 1)) {
+            return -1L;
+        }
+        try {
+            const int32_t bins = nEdges - 1;
+            int64_t skipped = 0;
+            bool valid;
+            DoubleArray aa = DoubleArray(env, a, count, useCrit, true);
+            DoubleArray ee = DoubleArray(env, edges, nEdges, useCrit, true);
+            if (counts != nullptr) {
+                IntArray cc = IntArray(env, counts, bins, useCrit);
+                valid = histogram_edges_double(aa.ptr(), count, ee.ptr(), bins, cc.ptr(), nullptr, parallel, skipped);
+            } else {
+                LongArray cc = LongArray(env, lcounts, bins, useCrit);
+                valid = histogram_edges_double(aa.ptr(), count, ee.ptr(), bins, nullptr,
+                    reinterpret_cast<int64_t*>(cc.ptr()), parallel, skipped);
+            }
+            if (!valid) {
+                throw JException("- the edges must be strictly increasing");
+            }
+            return skipped;
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "histogram_edges_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "histogram_edges_double: caught unknown exception");
+        }
+        return -1L;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    histogram_edges_float_n
+     * Signature: ([FI[FI[I[JZZ)J
+     */
+    JNIEXPORT jlong JNICALL Java_net_cramer_simd_SIMD_histogram_1edges_1float_1n
+    (JNIEnv* env, jclass, jfloatArray a, jint count, jfloatArray edges, jint nEdges, jintArray counts, jlongArray lcounts,
+        jboolean parallel, jboolean useCrit) {
+        if (count == 0 || a == nullptr || edges == nullptr || (counts == nullptr && lcounts == nullptr)) {
+            return 0L;
+        }
+        if (!checkBins(env, "histogram_edges_float", count, nEdges - 1)) {
+            return -1L;
+        }
+        try {
+            const int32_t bins = nEdges - 1;
+            int64_t skipped = 0;
+            bool valid;
+            FloatArray aa = FloatArray(env, a, count, useCrit, true);
+            FloatArray ee = FloatArray(env, edges, nEdges, useCrit, true);
+            if (counts != nullptr) {
+                IntArray cc = IntArray(env, counts, bins, useCrit);
+                valid = histogram_edges_float(aa.ptr(), count, ee.ptr(), bins, cc.ptr(), nullptr, parallel, skipped);
+            } else {
+                LongArray cc = LongArray(env, lcounts, bins, useCrit);
+                valid = histogram_edges_float(aa.ptr(), count, ee.ptr(), bins, nullptr,
+                    reinterpret_cast<int64_t*>(cc.ptr()), parallel, skipped);
+            }
+            if (!valid) {
+                throw JException("- the edges must be strictly increasing");
+            }
+            return skipped;
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "histogram_edges_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "histogram_edges_float: caught unknown exception");
+        }
+        return -1L;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    histogram_double_a
+     * Signature: (JJDDI[JZ)J
+     */
+    JNIEXPORT jlong JNICALL Java_net_cramer_simd_SIMD_histogram_1double_1a
+    (JNIEnv* env, jclass, jlong a, jlong count, jdouble min, jdouble max, jint bins, jlongArray lcounts, jboolean parallel) {
+        if (count == 0 || a == 0 || lcounts == nullptr) {
+            return 0L;
+        }
+        if (!checkBins(env, "histogram_double", count, bins)) {
+            return -1L;
+        }
+        if (!(min < max) || !std::isfinite(max - min)) {
+            throwJavaRuntimeException(env, "%s - invalid range: min = %f, max = %f", "histogram_double", min, max);
+            return -1L;
+        }
+        try {
+            // the counts are copied, not pinned, for the whole (possibly long) pass
+            LongArray cc = LongArray(env, lcounts, bins, JNI_FALSE);
+            return histogram_double(address_ptr<double>(a), count, min, max, bins, nullptr,
+                reinterpret_cast<int64_t*>(cc.ptr()), parallel);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "histogram_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "histogram_double: caught unknown exception");
+        }
+        return -1L;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    histogram_float_a
+     * Signature: (JJFFI[JZ)J
+     */
+    JNIEXPORT jlong JNICALL Java_net_cramer_simd_SIMD_histogram_1float_1a
+    (JNIEnv* env, jclass, jlong a, jlong count, jfloat min, jfloat max, jint bins, jlongArray lcounts, jboolean parallel) {
+        if (count == 0 || a == 0 || lcounts == nullptr) {
+            return 0L;
+        }
+        if (!checkBins(env, "histogram_float", count, bins)) {
+            return -1L;
+        }
+        if (!(min < max) || !std::isfinite(max - min)) {
+            throwJavaRuntimeException(env, "%s - invalid range: min = %f, max = %f", "histogram_float", min, max);
+            return -1L;
+        }
+        try {
+            // the counts are copied, not pinned, for the whole (possibly long) pass
+            LongArray cc = LongArray(env, lcounts, bins, JNI_FALSE);
+            return histogram_float(address_ptr<float>(a), count, min, max, bins, nullptr,
+                reinterpret_cast<int64_t*>(cc.ptr()), parallel);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "histogram_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "histogram_float: caught unknown exception");
+        }
+        return -1L;
+    }
+#ifdef __cplusplus
+}
+#endif
+
+
+template <typename T>
+struct HistVec;
+
+template <>
+struct HistVec<double> {
+    typedef Vec8d V;
+    typedef Vec8i I;
+
+    static inline I index(V const f) {
+        return truncate_to_int32(f);
+    }
+
+    static inline V gather(const double* table, I const idx) {
+#if INSTRSET >= 10
+        return _mm512_i32gather_pd(idx, table, 8);
+#else
+        return V(_mm256_i32gather_pd(table, idx.get_low(), 8), _mm256_i32gather_pd(table, idx.get_high(), 8));
+#endif
+    }
+};
+
+template <>
+struct HistVec<float> {
+    typedef Vec16f V;
+    typedef Vec16i I;
+
+    static inline I index(V const f) {
+        return truncatei(f);
+    }
+
+    static inline V gather(const float* table, I const idx) {
+#if INSTRSET >= 10
+        return _mm512_i32gather_ps(idx, table, 4);
+#else
+        return V(_mm256_i32gather_ps(table, idx.get_low(), 4), _mm256_i32gather_ps(table, idx.get_high(), 4));
+#endif
+    }
+};
+
+// bins of width (max - min) / bins, max itself goes into the last bin
+template <typename T>
+struct FixedBins {
+    typedef typename HistVec<T>::V V;
+
+    T lo;
+    T hi;
+    T scale;
+    T last;
+    T outside;
+
+    FixedBins(T min, T max, int32_t bins)
+        : lo(min), hi(max), scale(T(bins) / (max - min)), last(T(bins - 1)), outside(T(bins)) {
+    }
+
+    inline V operator()(V const x) const {
+        V f = truncate(min((x - V(lo)) * V(scale), V(last)));
+        return select((x >= V(lo)) & (x <= V(hi)), f, V(outside));
+    }
+};
+
+// bins [edges[i], edges[i + 1]), the last one includes its upper edge.
+// Few bins: the number of inner edges <= x. Otherwise: the largest i with
+// edges[i] <= x by a binary search over the edges padded with +infinity to
+// a power of 2.
+template <typename T>
+struct EdgeBins {
+    typedef typename HistVec<T>::V V;
+
+    std::vector<T> table;
+    int32_t bins;
+    int32_t half;
+    T lo;
+    T hi;
+
+    EdgeBins(const T* edges, int32_t bins_) : bins(bins_), half(1), lo(edges[0]), hi(edges[bins_]) {
+        while (half < bins) {
+            half *= 2;
+        }
+        half /= 2;
+        table.assign(std::max(bins, 2 * half), std::numeric_limits<T>::infinity());
+        std::copy(edges, edges + bins, table.begin());
+    }
+
+    inline V operator()(V const x) const {
+        V f = V(0);
+        if (bins <= HISTOGRAM_LINEAR_BINS) {
+            for (int32_t j = 1; j < bins; ++j) {
+                f = if_add(x >= V(table[j]), f, V(1));
+            }
+        } else {
+            for (int32_t step = half; step > 0; step /= 2) {
+                V next = f + V(T(step));
+                V e = HistVec<T>::gather(table.data(), HistVec<T>::index(next));
+                f = select(e <= x, next, f);
+            }
+            f = min(f, V(T(bins - 1)));
+        }
+        return select((x >= V(lo)) & (x <= V(hi)), f, V(T(bins)));
+    }
+};
+
+// Counts the elements [begin, end) of a into the sub-histograms sub[0 .. subs)
+// of (bins + 1) counters each, element i goes into sub[i % subs]
+template <typename T, typename Binner>
+static void count_range(T* a, int64_t begin, int64_t end, const Binner& binner, uint32_t* sub, int subs,
+    int32_t stride) {
+    typedef typename HistVec<T>::V V;
+    constexpr int L = V::size();
+    const int subMask = subs - 1;
+    int32_t idx[L];
+    int64_t i;
+    for (i = begin; i <= end - L; i += L) {
+        HistVec<T>::index(binner(V().load(a + i))).store(idx);
+        for (int j = 0; j < L; ++j) {
+            ++sub[(j & subMask) * stride + idx[j]];
+        }
+    }
+    if (i < end) {
+        int n = static_cast<int>(end - i);
+        HistVec<T>::index(binner(V().load_partial(n, a + i))).store(idx);
+        for (int j = 0; j < n; ++j) {
+            ++sub[(j & subMask) * stride + idx[j]];
+        }
+    }
+}
+
+// Adds the sub-histograms sub[0 .. subs) to totals and clears them
+static void flush_subs(uint32_t* sub, int subs, int32_t stride, int64_t* totals) {
+    for (int s = 0; s < subs; ++s) {
+        for (int32_t b = 0; b < stride; ++b) {
+            totals[b] += sub[s * stride + b];
+        }
+    }
+    std::fill(sub, sub + int64_t(subs) * stride, uint32_t(0));
+}
+
+// Adds the histogram of a[0 .. count) to counts (or lcounts if counts is
+// nullptr) and returns the number of elements outside of all bins
+template <typename T, typename Binner>
+static int64_t histogram(T* a, int64_t count, const Binner& binner, int32_t bins, int32_t* counts,
+    int64_t* lcounts, bool parallel) {
+    const int32_t stride = bins + 1;
+    const int subs = (int64_t(HISTOGRAM_SUBS) * stride * int64_t(sizeof(uint32_t)) <= HISTOGRAM_SUB_BYTES)
+        ? HISTOGRAM_SUBS : 1;
+    const int64_t grain = parallel ? HISTOGRAM_MIN_WORK : std::max(count, int64_t(1));
+    const int parts = parallel_parts(count, grain);
+    ArenaScope scope;
+    uint32_t* subCounts = Arena::local().allocate_zeroed<uint32_t>(int64_t(parts) * subs * stride);
+    int64_t* totals = Arena::local().allocate_zeroed<int64_t>(int64_t(parts) * stride);
+    parallel_for(count, grain, [&](int64_t begin, int64_t end, int part) {
+        uint32_t* sub = subCounts + int64_t(part) * subs * stride;
+        for (int64_t from = begin; from < end; from += HISTOGRAM_FLUSH_ELEMENTS) {
+            count_range(a, from, std::min(end, from + HISTOGRAM_FLUSH_ELEMENTS), binner, sub, subs, stride);
+            flush_subs(sub, subs, stride, totals + int64_t(part) * stride);
+        }
+    });
+    int64_t skipped = 0;
+    for (int part = 0; part < parts; ++part) {
+        const int64_t* total = totals + int64_t(part) * stride;
+        if (counts != nullptr) {
+            for (int32_t b = 0; b < bins; ++b) {
+                counts[b] += static_cast<int32_t>(total[b]);
+            }
+        } else {
+            for (int32_t b = 0; b < bins; ++b) {
+                lcounts[b] += total[b];
+            }
+        }
+        skipped += total[bins];
+    }
+    return skipped;
+}
+
+template <typename T>
+static bool increasing(const T* edges, int32_t bins) {
+    for (int32_t i = 0; i < bins; ++i) {
+        if (!(edges[i] < edges[i + 1])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int64_t histogram_double(double* a, int64_t count, double min, double max, int32_t bins, int32_t* counts,
+    int64_t* lcounts, bool parallel) {
+    return histogram(a, count, FixedBins<double>(min, max, bins), bins, counts, lcounts, parallel);
+}
+
+int64_t histogram_float(float* a, int64_t count, float min, float max, int32_t bins, int32_t* counts,
+    int64_t* lcounts, bool parallel) {
+    return histogram(a, count, FixedBins<float>(min, max, bins), bins, counts, lcounts, parallel);
+}
+
+bool histogram_edges_double(double* a, int64_t count, double* edges, int32_t bins, int32_t* counts,
+    int64_t* lcounts, bool parallel, int64_t& skipped) {
+    if (!increasing(edges, bins)) {
+        return false;
+    }
+    skipped = histogram(a, count, EdgeBins<double>(edges, bins), bins, counts, lcounts, parallel);
+    return true;
+}
+
+bool histogram_edges_float(float* a, int64_t count, float* edges, int32_t bins, int32_t* counts,
+    int64_t* lcounts, bool parallel, int64_t& skipped) {
+    if (!increasing(edges, bins)) {
+        return false;
+    }
+    skipped = histogram(a, count, EdgeBins<float>(edges, bins), bins, counts, lcounts, parallel);
+    return true;
+}
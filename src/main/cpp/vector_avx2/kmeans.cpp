@@ -0,0 +1,605 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>         // std::min, std::max
+#include <limits>            // std::numeric_limits
+#include <jni.h>
+
+#ifndef VECTORIZE_INCLUDED_
+#include "vectorize.h"
+#endif /* VECTORIZE_INCLUDED_ */
+
+#ifndef PARALLEL_INCLUDED_
+#include "Parallel.h"
+#endif /* PARALLEL_INCLUDED_ */
+
+#ifndef SFC64_INCLUDED_
+#include "Sfc64.h"
+#endif /* SFC64_INCLUDED_ */
+
+#ifndef ARENA_INCLUDED_
+#include "Arena.h"
+#endif /* ARENA_INCLUDED_ */
+
+#ifndef DOUBLEARRAY_INCLUDED_
+#include "DoubleArray.h"
+#endif /* DOUBLEARRAY_INCLUDED_ */
+
+#ifndef FLOATARRAY_INCLUDED_
+#include "FloatArray.h"
+#endif /* FLOATARRAY_INCLUDED_ */
+
+#ifndef INTARRAY_INCLUDED_
+#include "IntArray.h"
+#endif /* INTARRAY_INCLUDED_ */
+
+#ifndef JEXCEPTION_INCLUDED_
+#include "JException.h"
+#endif /* JEXCEPTION_INCLUDED_ */
+
+#ifndef JEXCEPTIONUTILS_INCLUDED_
+#include "JExceptionUtils.h"
+#endif /* JEXCEPTIONUTILS_INCLUDED_ */
+
+
+// k-means (Lloyd iterations) on the rows of a (rows x dim) matrix whose rows
+// are ldx elements apart.
+//
+// The nearest centroid is found with the expansion
+// ||x - c||^2 = ||x||^2 - 2 x.c + ||c||^2: the row norms are computed once,
+// the centroid norms once per iteration, and the dot products of a tile of
+// rows with a cache-sized block of centroids are computed two rows times
+// four centroids at a time, so that each loaded vector feeds several FMAs.
+// The rows are split across threads, each thread accumulates the sums and
+// counts of its rows per cluster in its own buffers (in double), the
+// partial sums are combined in thread order after the pass. The seeding is
+// k-means++ (D^2 sampling) driven by a seeded Sfc64 generator.
+
+// rows of a tile that share the scan of a centroid block
+constexpr int64_t KMEANS_ROW_TILE = 32;
+// centroid bytes per block
+constexpr int64_t KMEANS_BLOCK_BYTES = 64 * 1024;
+// minimum number of row x centroid pairs (x dim) per thread
+constexpr int64_t KMEANS_MIN_WORK = 1 << 20;
+
+
+static bool checkShape(JNIEnv* env, const char* method, jint rows, jint dim, jint k) {
+    if (rows < 0 || dim < 0 || k < 0) {
+        throwJavaRuntimeException(env, "%s - negative argument: rows = %d, dim = %d, k = %d", method, rows, dim, k);
+        return false;
+    }
+    if (dim == 0 && rows > 0) {
+        // the kernels block the rows by dim
+        throwJavaRuntimeException(env, "%s - dim must be > 0 for rows > 0: rows = %d", method, rows);
+        return false;
+    }
+    if (static_cast<int64_t>(rows) * dim > INT32_MAX || static_cast<int64_t>(k) * dim > INT32_MAX) {
+        throwJavaRuntimeException(env, "%s - array size exceeds Integer.MAX_VALUE", method);
+        return false;
+    }
+    return true;
+}
+
+static bool checkCluster(JNIEnv* env, const char* method, jint rows, jint dim, jint k, jint maxIterations,
+    jdouble tolerance) {
+    if (!checkShape(env, method, rows, dim, k)) {
+        return false;
+    }
+    if (k == 0 || rows < k) {
+        throwJavaRuntimeException(env, "%s - need 0 < k <= rows: k = %d, rows = %d", method, k, rows);
+        return false;
+    }
+    if (maxIterations < 0 || !(tolerance >= 0.0)) {
+        throwJavaRuntimeException(env, "%s - invalid maxIterations / tolerance: %d %f", method, maxIterations,
+            tolerance);
+        return false;
+    }
+    return true;
+}
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    /*
+     * Class:     net_cramer_simd_KMeans
+     * Method:    cluster_double_n
+     * Signature: ([DIIIIDJ[D[I[DZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_KMeans_cluster_1double_1n
+    (JNIEnv* env, jclass, jdoubleArray x, jint rows, jint dim, jint k, jint maxIterations, jdouble tolerance,
+        jlong seed, jdoubleArray centroids, jintArray assignments, jdoubleArray stats, jboolean useCrit) {
+        if (!checkCluster(env, "cluster_double", rows, dim, k, maxIterations, tolerance)) {
+            return;
+        }
+        if (x == nullptr || centroids == nullptr || assignments == nullptr || stats == nullptr) {
+            return;
+        }
+        try {
+            DoubleArray xx = DoubleArray(env, x, rows * dim, useCrit, true);
+            DoubleArray cc = DoubleArray(env, centroids, k * dim, useCrit);
+            IntArray aa = IntArray(env, assignments, rows, useCrit);
+            DoubleArray ss = DoubleArray(env, stats, KMEANS_STATS_LENGTH, useCrit);
+            kmeans_double(xx.ptr(), rows, dim, dim, k, maxIterations, tolerance, seed, cc.ptr(), aa.ptr(),
+                *reinterpret_cast<KMeansStats*>(ss.ptr()));
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "cluster_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "cluster_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_KMeans
+     * Method:    cluster_float_n
+     * Signature: ([FIIIIDJ[F[I[DZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_KMeans_cluster_1float_1n
+    (JNIEnv* env, jclass, jfloatArray x, jint rows, jint dim, jint k, jint maxIterations, jdouble tolerance,
+        jlong seed, jfloatArray centroids, jintArray assignments, jdoubleArray stats, jboolean useCrit) {
+        if (!checkCluster(env, "cluster_float", rows, dim, k, maxIterations, tolerance)) {
+            return;
+        }
+        if (x == nullptr || centroids == nullptr || assignments == nullptr || stats == nullptr) {
+            return;
+        }
+        try {
+            FloatArray xx = FloatArray(env, x, rows * dim, useCrit, true);
+            FloatArray cc = FloatArray(env, centroids, k * dim, useCrit);
+            IntArray aa = IntArray(env, assignments, rows, useCrit);
+            DoubleArray ss = DoubleArray(env, stats, KMEANS_STATS_LENGTH, useCrit);
+            kmeans_float(xx.ptr(), rows, dim, dim, k, maxIterations, tolerance, seed, cc.ptr(), aa.ptr(),
+                *reinterpret_cast<KMeansStats*>(ss.ptr()));
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "cluster_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "cluster_float: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_KMeans
+     * Method:    assign_double_n
+     * Signature: ([DII[DI[IZ)D
+     */
+    JNIEXPORT jdouble JNICALL Java_net_cramer_simd_KMeans_assign_1double_1n
+    (JNIEnv* env, jclass, jdoubleArray x, jint rows, jint dim, jdoubleArray centroids, jint k,
+        jintArray assignments, jboolean useCrit) {
+        if (!checkShape(env, "assign_double", rows, dim, k)) {
+            return NOT_REACHED_D;
+        }
+        if (rows == 0 || k == 0 || x == nullptr || centroids == nullptr || assignments == nullptr) {
+            return 0.0;
+        }
+        try {
+            DoubleArray xx = DoubleArray(env, x, rows * dim, useCrit, true);
+            DoubleArray cc = DoubleArray(env, centroids, k * dim, useCrit, true);
+            IntArray aa = IntArray(env, assignments, rows, useCrit);
+            return kmeans_assign_double(xx.ptr(), rows, dim, cc.ptr(), k, aa.ptr());
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "assign_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "assign_double: caught unknown exception");
+        }
+        return NOT_REACHED_D;
+    }
+
+    /*
+     * Class:     net_cramer_simd_KMeans
+     * Method:    assign_float_n
+     * Signature: ([FII[FI[IZ)D
+     */
+    JNIEXPORT jdouble JNICALL Java_net_cramer_simd_KMeans_assign_1float_1n
+    (JNIEnv* env, jclass, jfloatArray x, jint rows, jint dim, jfloatArray centroids, jint k,
+        jintArray assignments, jboolean useCrit) {
+        if (!checkShape(env, "assign_float", rows, dim, k)) {
+            return NOT_REACHED_D;
+        }
+        if (rows == 0 || k == 0 || x == nullptr || centroids == nullptr || assignments == nullptr) {
+            return 0.0;
+        }
+        try {
+            FloatArray xx = FloatArray(env, x, rows * dim, useCrit, true);
+            FloatArray cc = FloatArray(env, centroids, k * dim, useCrit, true);
+            IntArray aa = IntArray(env, assignments, rows, useCrit);
+            return kmeans_assign_float(xx.ptr(), rows, dim, cc.ptr(), k, aa.ptr());
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "assign_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "assign_float: caught unknown exception");
+        }
+        return NOT_REACHED_D;
+    }
+#ifdef __cplusplus
+}
+#endif
+
+
+template <typename T>
+struct KVec;
+
+template <>
+struct KVec<double> {
+    typedef Vec8d V;
+};
+
+template <>
+struct KVec<float> {
+    typedef Vec16f V;
+};
+
+// dot products of the rows x0, x1 with the centroids c0 .. c3 (8 accumulators)
+template <typename T>
+static inline void dot_2x4(const T* x0, const T* x1, const T* c0, const T* c1, const T* c2, const T* c3,
+    int64_t dim, T* out) {
+    typedef typename KVec<T>::V V;
+    const int L = V::size();
+    V a00 = V(0), a01 = V(0), a02 = V(0), a03 = V(0);
+    V a10 = V(0), a11 = V(0), a12 = V(0), a13 = V(0);
+    V v0, v1, w;
+
+    int64_t i;
+    for (i = 0; i <= dim - L; i += L) {
+        v0 = V().load(x0 + i);
+        v1 = V().load(x1 + i);
+        w = V().load(c0 + i);
+        a00 = mul_add(v0, w, a00);
+        a10 = mul_add(v1, w, a10);
+        w = V().load(c1 + i);
+        a01 = mul_add(v0, w, a01);
+        a11 = mul_add(v1, w, a11);
+        w = V().load(c2 + i);
+        a02 = mul_add(v0, w, a02);
+        a12 = mul_add(v1, w, a12);
+        w = V().load(c3 + i);
+        a03 = mul_add(v0, w, a03);
+        a13 = mul_add(v1, w, a13);
+    }
+    if (i < dim) {
+        int n = static_cast<int>(dim - i);
+        v0 = V().load_partial(n, x0 + i);
+        v1 = V().load_partial(n, x1 + i);
+        w = V().load_partial(n, c0 + i);
+        a00 = mul_add(v0, w, a00);
+        a10 = mul_add(v1, w, a10);
+        w = V().load_partial(n, c1 + i);
+        a01 = mul_add(v0, w, a01);
+        a11 = mul_add(v1, w, a11);
+        w = V().load_partial(n, c2 + i);
+        a02 = mul_add(v0, w, a02);
+        a12 = mul_add(v1, w, a12);
+        w = V().load_partial(n, c3 + i);
+        a03 = mul_add(v0, w, a03);
+        a13 = mul_add(v1, w, a13);
+    }
+    out[0] = horizontal_add(a00);
+    out[1] = horizontal_add(a01);
+    out[2] = horizontal_add(a02);
+    out[3] = horizontal_add(a03);
+    out[4] = horizontal_add(a10);
+    out[5] = horizontal_add(a11);
+    out[6] = horizontal_add(a12);
+    out[7] = horizontal_add(a13);
+}
+
+template <typename T>
+static inline T squared_norm(const T* x, int64_t dim) {
+    typedef typename KVec<T>::V V;
+    const int L = V::size();
+    V acc0 = V(0);
+    V acc1 = V(0);
+    V v;
+    int64_t i;
+    for (i = 0; i <= dim - 2 * L; i += 2 * L) {
+        v = V().load(x + i);
+        acc0 = mul_add(v, v, acc0);
+        v = V().load(x + i + L);
+        acc1 = mul_add(v, v, acc1);
+    }
+    for (; i < dim; i += L) {
+        v = V().load_partial(static_cast<int>(std::min(dim - i, int64_t(L))), x + i);
+        acc0 = mul_add(v, v, acc0);
+    }
+    return horizontal_add(acc0 + acc1);
+}
+
+template <typename T>
+static inline T squared_distance(const T* a, const T* b, int64_t dim) {
+    typedef typename KVec<T>::V V;
+    const int L = V::size();
+    V acc0 = V(0);
+    V acc1 = V(0);
+    V d;
+    int64_t i;
+    for (i = 0; i <= dim - 2 * L; i += 2 * L) {
+        d = V().load(a + i) - V().load(b + i);
+        acc0 = mul_add(d, d, acc0);
+        d = V().load(a + i + L) - V().load(b + i + L);
+        acc1 = mul_add(d, d, acc1);
+    }
+    for (; i < dim; i += L) {
+        int n = static_cast<int>(std::min(dim - i, int64_t(L)));
+        d = V().load_partial(n, a + i) - V().load_partial(n, b + i);
+        acc0 = mul_add(d, d, acc0);
+    }
+    return horizontal_add(acc0 + acc1);
+}
+
+// Nearest centroid of the rows [begin, end): index to best[], squared
+// distance (clamped at 0) to bestDist[] (both indexed from begin)
+template <typename T>
+static void nearest(const T* x, int64_t ldx, int64_t dim, const T* xnorm, int64_t begin, int64_t end,
+    const T* c, const T* cnorm, int64_t k, int32_t* best, T* bestDist) {
+    const int64_t blockSize = std::max(int64_t(4), KMEANS_BLOCK_BYTES / (dim * int64_t(sizeof(T))));
+    T dots[8];
+    for (int64_t r0 = begin; r0 < end; r0 += KMEANS_ROW_TILE) {
+        const int64_t rn = std::min(KMEANS_ROW_TILE, end - r0);
+        int32_t* tb = best + (r0 - begin);
+        T* td = bestDist + (r0 - begin);
+        std::fill(td, td + rn, std::numeric_limits<T>::infinity());
+        std::fill(tb, tb + rn, 0);
+        for (int64_t c0 = 0; c0 < k; c0 += blockSize) {
+            const int64_t cend = std::min(k, c0 + blockSize);
+            for (int64_t i = 0; i < rn; i += 2) {
+                // an odd last row is paired with itself
+                const int64_t i1 = std::min(i + 1, rn - 1);
+                const T* x0 = x + (r0 + i) * ldx;
+                const T* x1 = x + (r0 + i1) * ldx;
+                for (int64_t j = c0; j < cend; j += 4) {
+                    // missing centroids of the last group repeat the last one
+                    const int64_t j1 = std::min(j + 1, cend - 1);
+                    const int64_t j2 = std::min(j + 2, cend - 1);
+                    const int64_t j3 = std::min(j + 3, cend - 1);
+                    dot_2x4(x0, x1, c + j * dim, c + j1 * dim, c + j2 * dim, c + j3 * dim, dim, dots);
+                    const int64_t jn = std::min(int64_t(4), cend - j);
+                    for (int64_t q = 0; q < jn; ++q) {
+                        T d0 = cnorm[j + q] - T(2) * dots[q];
+                        T d1 = cnorm[j + q] - T(2) * dots[4 + q];
+                        // ties go to the smaller centroid index
+                        if (d0 < td[i]) {
+                            td[i] = d0;
+                            tb[i] = static_cast<int32_t>(j + q);
+                        }
+                        if (d1 < td[i1]) {
+                            td[i1] = d1;
+                            tb[i1] = static_cast<int32_t>(j + q);
+                        }
+                    }
+                }
+            }
+        }
+        for (int64_t i = 0; i < rn; ++i) {
+            td[i] = std::max(T(0), td[i] + xnorm[r0 + i]);
+        }
+    }
+}
+
+template <typename T>
+static void norms(const T* x, int64_t rows, int64_t ldx, int64_t dim, T* out) {
+    parallel_for(rows, std::max(int64_t(1), KMEANS_MIN_WORK / std::max(dim, int64_t(1))),
+        [&](int64_t begin, int64_t end, int) {
+        for (int64_t r = begin; r < end; ++r) {
+            out[r] = squared_norm(x + r * ldx, dim);
+        }
+    });
+}
+
+// k-means++ seeding: the first centroid is a uniformly chosen row, each
+// further one is a row chosen with probability proportional to its squared
+// distance to the nearest centroid chosen so far
+template <typename T>
+static void seed_centroids(const T* x, int64_t rows, int64_t ldx, int64_t dim, int64_t k, uint64_t seed, T* c) {
+    ArenaScope scope;
+    Sfc64 rng(seed);
+    double* minDist = Arena::local().allocate<double>(rows);
+    int64_t pick = rng.nextLong(rows);
+    const int64_t grain = std::max(int64_t(1), KMEANS_MIN_WORK / std::max(dim, int64_t(1)));
+    for (int64_t j = 0; j < k; ++j) {
+        std::copy(x + pick * ldx, x + pick * ldx + dim, c + j * dim);
+        if (j == k - 1) {
+            break;
+        }
+        const T* cj = c + j * dim;
+        parallel_for(rows, grain, [&](int64_t begin, int64_t end, int) {
+            for (int64_t r = begin; r < end; ++r) {
+                double d = squared_distance(x + r * ldx, cj, dim);
+                minDist[r] = (j == 0) ? d : std::min(minDist[r], d);
+            }
+        });
+        double total = 0.0;
+        for (int64_t r = 0; r < rows; ++r) {
+            total += minDist[r];
+        }
+        if (!(total > 0.0)) {
+            // fewer distinct rows than centroids, fall back to uniform picks
+            pick = rng.nextLong(rows);
+            continue;
+        }
+        double u = rng.nextDouble() * total;
+        for (int64_t r = 0; r < rows; ++r) {
+            if (minDist[r] > 0.0) {
+                // the last candidate if rounding leaves u >= 0
+                pick = r;
+                u -= minDist[r];
+                if (u < 0.0) {
+                    break;
+                }
+            }
+        }
+    }
+}
+
+template <typename T>
+static double assign(const T* x, int64_t rows, int64_t ldx, int64_t dim, const T* c, int64_t k, int32_t* out) {
+    ArenaScope scope;
+    Arena& arena = Arena::local();
+    T* xnorm = arena.allocate<T>(rows);
+    T* cnorm = arena.allocate<T>(k);
+    T* dist = arena.allocate<T>(rows);
+    norms(x, rows, ldx, dim, xnorm);
+    norms(c, k, dim, dim, cnorm);
+    const int64_t grain = std::max(int64_t(1), KMEANS_MIN_WORK / std::max(k * dim, int64_t(1)));
+    parallel_for(rows, grain, [&](int64_t begin, int64_t end, int) {
+        nearest(x, ldx, dim, xnorm, begin, end, c, cnorm, k, out + begin, dist + begin);
+    });
+    double inertia = 0.0;
+    for (int64_t r = 0; r < rows; ++r) {
+        inertia += dist[r];
+    }
+    return inertia;
+}
+
+template <typename T>
+static void kmeans(const T* x, int64_t rows, int64_t ldx, int64_t dim, int64_t k, int maxIterations,
+    double tolerance, uint64_t seed, T* c, int32_t* assignments, KMeansStats& stats) {
+    stats.iterations = 0.0;
+    stats.inertia = 0.0;
+    stats.reassigned = 0.0;
+    stats.shift = 0.0;
+    stats.emptyClusters = 0.0;
+    stats.converged = 0.0;
+
+    seed_centroids(x, rows, ldx, dim, k, seed, c);
+
+    const int64_t grain = std::max(int64_t(1), KMEANS_MIN_WORK / std::max(k * dim, int64_t(1)));
+    const int parts = parallel_parts(rows, grain);
+    ArenaScope scope;
+    Arena& arena = Arena::local();
+    T* xnorm = arena.allocate<T>(rows);
+    T* cnorm = arena.allocate<T>(k);
+    T* dist = arena.allocate<T>(rows);
+    int32_t* next = arena.allocate<int32_t>(rows);
+    double* sums = arena.allocate<double>(parts * k * dim);
+    int64_t* counts = arena.allocate<int64_t>(parts * k);
+    double* inertias = arena.allocate<double>(parts);
+    int64_t* changes = arena.allocate<int64_t>(parts);
+    norms(x, rows, ldx, dim, xnorm);
+    std::fill(assignments, assignments + rows, -1);
+
+    double previous = std::numeric_limits<double>::infinity();
+    for (int it = 0; ; ++it) {
+        // assignment step, the members of each cluster are summed on the fly
+        norms(c, k, dim, dim, cnorm);
+        std::fill(sums, sums + parts * k * dim, 0.0);
+        std::fill(counts, counts + parts * k, int64_t(0));
+        parallel_for(rows, grain, [&](int64_t begin, int64_t end, int part) {
+            nearest(x, ldx, dim, xnorm, begin, end, c, cnorm, k, next + begin, dist + begin);
+            double* sum = sums + part * k * dim;
+            int64_t* count = counts + part * k;
+            double inertia = 0.0;
+            int64_t changed = 0;
+            for (int64_t r = begin; r < end; ++r) {
+                const int32_t j = next[r];
+                const T* xr = x + r * ldx;
+                double* sj = sum + j * dim;
+                for (int64_t i = 0; i < dim; ++i) {
+                    sj[i] += xr[i];
+                }
+                ++count[j];
+                inertia += dist[r];
+                changed += (j != assignments[r]) ? 1 : 0;
+                assignments[r] = j;
+            }
+            inertias[part] = inertia;
+            changes[part] = changed;
+        });
+        double inertia = 0.0;
+        int64_t reassigned = 0;
+        for (int p = 0; p < parts; ++p) {
+            inertia += inertias[p];
+            reassigned += changes[p];
+        }
+        stats.inertia = inertia;
+        stats.reassigned = static_cast<double>(reassigned);
+        if (reassigned == 0 || (it > 0 && previous - inertia <= tolerance * previous)) {
+            stats.converged = 1.0;
+            break;
+        }
+        if (it == maxIterations) {
+            break;
+        }
+        previous = inertia;
+
+        // update step: combine the partial sums in thread order
+        double shift = 0.0;
+        for (int64_t j = 0; j < k; ++j) {
+            int64_t n = 0;
+            for (int p = 0; p < parts; ++p) {
+                n += counts[p * k + j];
+            }
+            if (n == 0) {
+                continue;
+            }
+            T* cj = c + j * dim;
+            double moved = 0.0;
+            for (int64_t i = 0; i < dim; ++i) {
+                double s = 0.0;
+                for (int p = 0; p < parts; ++p) {
+                    s += sums[(p * k + j) * dim + i];
+                }
+                T v = static_cast<T>(s / n);
+                moved += (static_cast<double>(v) - cj[i]) * (static_cast<double>(v) - cj[i]);
+                cj[i] = v;
+            }
+            shift = std::max(shift, moved);
+        }
+        // an empty cluster is moved to the row that is farthest from its
+        // centroid (that row then doesn't qualify for another empty cluster)
+        for (int64_t j = 0; j < k; ++j) {
+            int64_t n = 0;
+            for (int p = 0; p < parts; ++p) {
+                n += counts[p * k + j];
+            }
+            if (n != 0) {
+                continue;
+            }
+            int64_t far = std::max_element(dist, dist + rows) - dist;
+            std::copy(x + far * ldx, x + far * ldx + dim, c + j * dim);
+            dist[far] = T(0);
+            stats.emptyClusters += 1.0;
+        }
+        stats.shift = shift;
+        stats.iterations = it + 1.0;
+    }
+}
+
+void kmeans_double(double* x, int64_t rows, int64_t ldx, int64_t dim, int64_t k, int maxIterations,
+    double tolerance, uint64_t seed, double* centroids, int32_t* assignments, KMeansStats& stats) {
+    kmeans(x, rows, ldx, dim, k, maxIterations, tolerance, seed, centroids, assignments, stats);
+}
+
+void kmeans_float(float* x, int64_t rows, int64_t ldx, int64_t dim, int64_t k, int maxIterations,
+    double tolerance, uint64_t seed, float* centroids, int32_t* assignments, KMeansStats& stats) {
+    kmeans(x, rows, ldx, dim, k, maxIterations, tolerance, seed, centroids, assignments, stats);
+}
+
+double kmeans_assign_double(double* x, int64_t rows, int64_t dim, double* centroids, int64_t k,
+    int32_t* assignments) {
+    return assign(x, rows, dim, dim, centroids, k, assignments);
+}
+
+double kmeans_assign_float(float* x, int64_t rows, int64_t dim, float* centroids, int64_t k,
+    int32_t* assignments) {
+    return assign(x, rows, dim, dim, centroids, k, assignments);
+}
@@ -0,0 +1,342 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <limits>            // std::numeric_limits
+#include <algorithm>         // std::min, std::max, std::push_heap, std::pop_heap, std::sort_heap
+#include <new>               // placement new
+#include <jni.h>
+
+#ifndef VECTORIZE_INCLUDED_
+#include "vectorize.h"
+#endif /* VECTORIZE_INCLUDED_ */
+
+#ifndef PARALLEL_INCLUDED_
+#include "Parallel.h"
+#endif /* PARALLEL_INCLUDED_ */
+
+#ifndef ARENA_INCLUDED_
+#include "Arena.h"
+#endif /* ARENA_INCLUDED_ */
+
+#ifndef BYTEARRAY_INCLUDED_
+#include "ByteArray.h"
+#endif /* BYTEARRAY_INCLUDED_ */
+
+#ifndef FLOATARRAY_INCLUDED_
+#include "FloatArray.h"
+#endif /* FLOATARRAY_INCLUDED_ */
+
+#ifndef INTARRAY_INCLUDED_
+#include "IntArray.h"
+#endif /* INTARRAY_INCLUDED_ */
+
+#ifndef JEXCEPTION_INCLUDED_
+#include "JException.h"
+#endif /* JEXCEPTION_INCLUDED_ */
+
+#ifndef JEXCEPTIONUTILS_INCLUDED_
+#include "JExceptionUtils.h"
+#endif /* JEXCEPTIONUTILS_INCLUDED_ */
+
+
+// Exact brute-force k nearest neighbor search over the rows of a row-major
+// (rows x dim) float or int8 quantized matrix. The database is split into
+// contiguous row ranges (one per thread) and each range is processed in blocks
+// that stay in cache while the distances of a group of queries to the block
+// are evaluated. The candidates of a block are filtered against the current
+// k-th best distance of each query with a vector compare, only the survivors
+// enter a bounded heap. The per-thread heaps are merged at the end.
+
+// database bytes per block
+constexpr int64_t KNN_BLOCK_BYTES = 128 * 1024;
+// queries that share the scan of a block
+constexpr int64_t KNN_QUERY_GROUP = 32;
+// minimum number of distance evaluations (x dim) per thread
+constexpr int64_t KNN_MIN_WORK = 1 << 21;
+
+
+void knn_float(float* base, int64_t rows, int64_t dim, float* queries, int64_t queryCount, int k, int metric,
+    int32_t* indices, float* distances);
+void knn_int8(int8_t* base, float* scales, int64_t rows, int64_t dim, int8_t* queries, float* queryScales,
+    int64_t queryCount, int k, int metric, int32_t* indices, float* distances);
+
+
+static bool checkArguments(JNIEnv* env, const char* method, jint rows, jint dim, jint queryCount, jint k, jint metric) {
+    if (rows < 0 || dim < 0 || queryCount < 0 || k < 0) {
+        throwJavaRuntimeException(env, "%s - negative argument: rows = %d, dim = %d, queryCount = %d, k = %d",
+            method, rows, dim, queryCount, k);
+        return false;
+    }
+    if (metric < METRIC_L2_SQUARED || metric > METRIC_COSINE) {
+        throwJavaRuntimeException(env, "%s - unknown metric: %d", method, metric);
+        return false;
+    }
+    if (static_cast<int64_t>(rows) * dim > INT32_MAX || static_cast<int64_t>(queryCount) * dim > INT32_MAX
+        || static_cast<int64_t>(queryCount) * k > INT32_MAX) {
+        throwJavaRuntimeException(env, "%s - array size exceeds Integer.MAX_VALUE", method);
+        return false;
+    }
+    return true;
+}
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    /*
+     * Class:     net_cramer_simd_NearestNeighbors
+     * Method:    search_float_n
+     * Signature: ([FII[FIII[I[FZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_NearestNeighbors_search_1float_1n
+    (JNIEnv* env, jclass, jfloatArray base, jint rows, jint dim, jfloatArray queries, jint queryCount, jint k,
+        jint metric, jintArray indices, jfloatArray distances, jboolean useCrit) {
+        if (!checkArguments(env, "search_float", rows, dim, queryCount, k, metric)) {
+            return;
+        }
+        if (queryCount == 0 || k == 0 || queries == nullptr || indices == nullptr || distances == nullptr) {
+            return;
+        }
+        try {
+            FloatArray qq = FloatArray(env, queries, queryCount * dim, useCrit, true);
+            IntArray ii = IntArray(env, indices, queryCount * k, useCrit);
+            FloatArray dd = FloatArray(env, distances, queryCount * k, useCrit);
+            if (rows == 0 || base == nullptr) {
+                knn_float(nullptr, 0, dim, qq.ptr(), queryCount, k, metric, ii.ptr(), dd.ptr());
+            } else {
+                FloatArray bb = FloatArray(env, base, rows * dim, useCrit, true);
+                knn_float(bb.ptr(), rows, dim, qq.ptr(), queryCount, k, metric, ii.ptr(), dd.ptr());
+            }
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "search_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "search_float: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_NearestNeighbors
+     * Method:    search_int8_n
+     * Signature: ([B[FII[B[FIII[I[FZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_NearestNeighbors_search_1int8_1n
+    (JNIEnv* env, jclass, jbyteArray base, jfloatArray scales, jint rows, jint dim, jbyteArray queries,
+        jfloatArray queryScales, jint queryCount, jint k, jint metric, jintArray indices, jfloatArray distances,
+        jboolean useCrit) {
+        if (!checkArguments(env, "search_int8", rows, dim, queryCount, k, metric)) {
+            return;
+        }
+        if (queryCount == 0 || k == 0 || queries == nullptr || queryScales == nullptr || indices == nullptr
+            || distances == nullptr) {
+            return;
+        }
+        try {
+            ByteArray qq = ByteArray(env, queries, queryCount * dim, useCrit, true);
+            FloatArray qs = FloatArray(env, queryScales, queryCount, useCrit, true);
+            IntArray ii = IntArray(env, indices, queryCount * k, useCrit);
+            FloatArray dd = FloatArray(env, distances, queryCount * k, useCrit);
+            if (rows == 0 || base == nullptr || scales == nullptr) {
+                knn_int8(nullptr, nullptr, 0, dim, qq.ptr(), qs.ptr(), queryCount, k, metric, ii.ptr(), dd.ptr());
+            } else {
+                ByteArray bb = ByteArray(env, base, rows * dim, useCrit, true);
+                FloatArray ss = FloatArray(env, scales, rows, useCrit, true);
+                knn_int8(bb.ptr(), ss.ptr(), rows, dim, qq.ptr(), qs.ptr(), queryCount, k, metric, ii.ptr(),
+                    dd.ptr());
+            }
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "search_int8", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "search_int8: caught unknown exception");
+        }
+    }
+#ifdef __cplusplus
+}
+#endif
+
+
+struct Neighbor {
+    float key;
+    int32_t index;
+};
+
+// smaller keys are better, equal keys are ordered by index so that the result
+// doesn't depend on how the rows were distributed across threads
+static inline bool operator<(Neighbor const& a, Neighbor const& b) {
+    return a.key < b.key || (a.key == b.key && a.index < b.index);
+}
+
+// The k best neighbors seen so far as a max-heap (the worst one on top)
+class TopK {
+public:
+    TopK(Neighbor* heap, int k) : heap(heap), k(k), size(0) {
+    }
+
+    float threshold() const {
+        return size < k ? std::numeric_limits<float>::infinity() : heap[0].key;
+    }
+
+    void push(Neighbor const n) {
+        if (size < k) {
+            heap[size++] = n;
+            std::push_heap(heap, heap + size);
+        } else if (n < heap[0]) {
+            std::pop_heap(heap, heap + k);
+            heap[k - 1] = n;
+            std::push_heap(heap, heap + k);
+        }
+    }
+
+    void merge(TopK const& other) {
+        for (int i = 0; i < other.size; ++i) {
+            push(other.heap[i]);
+        }
+    }
+
+    // sorts the heap best first, returns the number of neighbors
+    int sort() {
+        std::sort_heap(heap, heap + size);
+        return size;
+    }
+
+    Neighbor* heap;
+    int k;
+    int size;
+};
+
+// offers the rows [first, first + count) with the distances d[0 .. count)
+// (keys are sign * d); NaN distances never qualify
+static inline void offer(TopK& top, float* d, int64_t count, int64_t first, float sign) {
+    Vec16f vd;
+    for (int64_t i = 0; i < count; i += STEP_16) {
+        int n = static_cast<int>(std::min(count - i, int64_t(STEP_16)));
+        if (n == STEP_16) {
+            vd.load(d + i);
+        } else {
+            vd.load_partial(n, d + i);
+        }
+        uint32_t bits = to_bits(vd * sign <= Vec16f(top.threshold())) & ((uint32_t(1) << n) - 1);
+        while (bits != 0) {
+            int j = bit_scan_forward(bits);
+            bits &= bits - 1;
+            top.push(Neighbor{ sign * d[i + j], static_cast<int32_t>(first + i + j) });
+        }
+    }
+}
+
+// distancesOf(q, b, bn, out) writes the metric of query q to the rows
+// [b, b + bn) to out[0 .. bn), elementSize is the bytes per matrix entry
+template <typename BlockDistances>
+static void knn(int64_t rows, int64_t dim, int64_t elementSize, int64_t queryCount, int k, int metric,
+    BlockDistances distancesOf, int32_t* indices, float* distances) {
+    if (queryCount == 0) {
+        return;
+    }
+    // similarities are turned into keys where smaller is better
+    const float sign = (metric == METRIC_L2_SQUARED) ? 1.0f : -1.0f;
+    const int64_t blockRows = std::max(int64_t(16),
+        std::min(int64_t(4096), KNN_BLOCK_BYTES / (std::max(dim, int64_t(1)) * elementSize)));
+
+    // The threads are started once per call: with enough query groups to
+    // keep them busy each part scans all rows for its groups, otherwise the
+    // rows are split and each part keeps its own heaps per query, merged at
+    // the end
+    const int64_t groups = (queryCount + KNN_QUERY_GROUP - 1) / KNN_QUERY_GROUP;
+    const int64_t qn = std::min(KNN_QUERY_GROUP, queryCount);
+    const bool splitQueries = groups >= max_threads();
+    const int64_t grain = std::max(blockRows, KNN_MIN_WORK / (std::max(dim, int64_t(1)) * qn));
+    const int parts = splitQueries ? parallel_parts(groups, 1) : parallel_parts(rows, grain);
+    const int rowParts = splitQueries ? 1 : parts;
+
+    // no heap holds more than rows neighbors, the slots past them are
+    // padded when the results are written
+    const int cap = static_cast<int>(std::min(int64_t(k), rows));
+    ArenaScope scope;
+    Arena& arena = Arena::local();
+    Neighbor* heaps = arena.allocate<Neighbor>(rowParts * queryCount * cap);
+    float* tiles = arena.allocate<float>(parts * qn * blockRows);
+    TopK* tops = arena.allocate<TopK>(rowParts * queryCount);
+    for (int64_t t = 0; t < rowParts * queryCount; ++t) {
+        new (tops + t) TopK(heaps + t * cap, cap);
+    }
+
+    // offers the rows [begin, end) to the queries [q0, q0 + n)
+    auto scan = [&](int64_t q0, int64_t n, int64_t begin, int64_t end, TopK* top, float* tile) {
+        for (int64_t b = begin; b < end; b += blockRows) {
+            int64_t bn = std::min(blockRows, end - b);
+            for (int64_t q = 0; q < n; ++q) {
+                distancesOf(q0 + q, b, bn, tile + q * blockRows);
+            }
+            for (int64_t q = 0; q < n; ++q) {
+                offer(top[q], tile + q * blockRows, bn, b, sign);
+            }
+        }
+    };
+
+    if (splitQueries) {
+        parallel_for(groups, 1, [&](int64_t begin, int64_t end, int part) {
+            float* tile = tiles + part * qn * blockRows;
+            for (int64_t g = begin; g < end; ++g) {
+                int64_t q0 = g * KNN_QUERY_GROUP;
+                scan(q0, std::min(KNN_QUERY_GROUP, queryCount - q0), 0, rows, tops + q0, tile);
+            }
+        });
+    } else {
+        parallel_for(rows, grain, [&](int64_t begin, int64_t end, int part) {
+            float* tile = tiles + part * qn * blockRows;
+            for (int64_t q0 = 0; q0 < queryCount; q0 += KNN_QUERY_GROUP) {
+                scan(q0, std::min(KNN_QUERY_GROUP, queryCount - q0), begin, end,
+                    tops + part * queryCount + q0, tile);
+            }
+        });
+    }
+
+    for (int64_t q = 0; q < queryCount; ++q) {
+        TopK& top = tops[q];
+        for (int part = 1; part < rowParts; ++part) {
+            top.merge(tops[part * queryCount + q]);
+        }
+        int found = top.sort();
+        int32_t* idx = indices + q * k;
+        float* dist = distances + q * k;
+        for (int j = 0; j < found; ++j) {
+            idx[j] = top.heap[j].index;
+            dist[j] = sign * top.heap[j].key;
+        }
+        // fewer than k rows (or NaN distances)
+        for (int j = found; j < k; ++j) {
+            idx[j] = -1;
+            dist[j] = sign * std::numeric_limits<float>::infinity();
+        }
+    }
+}
+
+void knn_float(float* base, int64_t rows, int64_t dim, float* queries, int64_t queryCount, int k, int metric,
+    int32_t* indices, float* distances) {
+    knn(rows, dim, sizeof(float), queryCount, k, metric, [=](int64_t q, int64_t b, int64_t bn, float* out) {
+        distances_float(queries + q * dim, base + b * dim, bn, dim, metric, out);
+    }, indices, distances);
+}
+
+void knn_int8(int8_t* base, float* scales, int64_t rows, int64_t dim, int8_t* queries, float* queryScales,
+    int64_t queryCount, int k, int metric, int32_t* indices, float* distances) {
+    knn(rows, dim, sizeof(int8_t), queryCount, k, metric, [=](int64_t q, int64_t b, int64_t bn, float* out) {
+        distances_int8(queries + q * dim, queryScales[q], base + b * dim, scales + b, bn, dim, metric, out);
+    }, indices, distances);
+}
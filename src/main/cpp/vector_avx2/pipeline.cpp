@@ -0,0 +1,551 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>             // std::isnan
+#include <algorithm>         // std::min, std::max, std::copy
+#include <limits>            // std::numeric_limits
+#include <optional>          // std::optional
+#include <jni.h>
+
+#ifndef VECTORIZE_INCLUDED_
+#include "vectorize.h"
+#endif /* VECTORIZE_INCLUDED_ */
+
+#include "vcl/vectormath_exp.h"
+#include "vcl/vectormath_hyp.h"
+
+#ifndef DOUBLEARRAY_INCLUDED_
+#include "DoubleArray.h"
+#endif /* DOUBLEARRAY_INCLUDED_ */
+
+#ifndef FLOATARRAY_INCLUDED_
+#include "FloatArray.h"
+#endif /* FLOATARRAY_INCLUDED_ */
+
+#ifndef ARENA_INCLUDED_
+#include "Arena.h"
+#endif /* ARENA_INCLUDED_ */
+
+#ifndef JEXCEPTION_INCLUDED_
+#include "JException.h"
+#endif /* JEXCEPTION_INCLUDED_ */
+
+#ifndef JEXCEPTIONUTILS_INCLUDED_
+#include "JExceptionUtils.h"
+#endif /* JEXCEPTIONUTILS_INCLUDED_ */
+
+
+// Fused elementwise pipelines: a postfix op list (built and checked by
+// Pipeline.java) over up to PIPELINE_MAX_INPUTS input arrays is evaluated
+// tile by tile. Each op runs over a whole tile of PIPELINE_TILE elements
+// (which amortizes the dispatch) and writes to the tile buffer of its stack
+// slot, so the intermediates of a tile stay in L1 / L2 and never make it to
+// memory. Input slots read the arrays in place and constants stay scalars
+// that get broadcast. The value left on the stack is written to the output
+// array and / or folded into the terminal reduction.
+
+// op codes (keep in sync with Pipeline.java)
+constexpr int PIPE_INPUT = 0;
+constexpr int PIPE_CONST = 1;
+constexpr int PIPE_ADD = 2;
+constexpr int PIPE_SUB = 3;
+constexpr int PIPE_MUL = 4;
+constexpr int PIPE_DIV = 5;
+constexpr int PIPE_MIN = 6;
+constexpr int PIPE_MAX = 7;
+constexpr int PIPE_FMA = 8;
+constexpr int PIPE_NEG = 9;
+constexpr int PIPE_ABS = 10;
+constexpr int PIPE_SQRT = 11;
+constexpr int PIPE_SQUARE = 12;
+constexpr int PIPE_EXP = 13;
+constexpr int PIPE_LOG = 14;
+constexpr int PIPE_TANH = 15;
+constexpr int PIPE_SIGMOID = 16;
+constexpr int PIPE_RECIPROCAL = 17;
+
+// terminal reductions (keep in sync with Pipeline.java)
+constexpr int PIPE_REDUCE_NONE = 0;
+constexpr int PIPE_REDUCE_SUM = 1;
+constexpr int PIPE_REDUCE_MIN = 2;
+constexpr int PIPE_REDUCE_MAX = 3;
+
+constexpr int PIPELINE_MAX_INPUTS = 3;
+constexpr int PIPELINE_MAX_STACK = 8;
+// elements per tile (all stack slots of a double tile: 64 KiB)
+constexpr int64_t PIPELINE_TILE = 1024;
+
+
+struct PipelineOp {
+    int op;
+    int arg;
+};
+
+bool pipeline_compile(const int32_t* code, int64_t length, int64_t nConstants, PipelineOp* ops, int64_t& nOps,
+    int& inputs);
+double pipeline_double(const PipelineOp* ops, int64_t nOps, const double* constants, double* const* inputs,
+    double* out, int64_t count, int reduction);
+double pipeline_float(const PipelineOp* ops, int64_t nOps, const float* constants, float* const* inputs,
+    float* out, int64_t count, int reduction);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    /*
+     * Class:     net_cramer_simd_Pipeline
+     * Method:    pipeline_double_n
+     * Signature: ([II[DI[D[D[D[DIIZ)D
+     */
+    JNIEXPORT jdouble JNICALL Java_net_cramer_simd_Pipeline_pipeline_1double_1n
+    (JNIEnv* env, jclass, jintArray code, jint codeLength, jdoubleArray constants, jint nConstants, jdoubleArray x, jdoubleArray y,
+        jdoubleArray z, jdoubleArray out, jint count, jint reduction, jboolean useCrit) {
+        if (code == nullptr || codeLength <= 0 || (nConstants > 0 && constants == nullptr)) {
+            throwJavaRuntimeException(env, "%s", "pipeline_double - empty op list");
+            return 0.0;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "pipeline_double - negative count argument:", count);
+            return 0.0;
+        }
+        if (nConstants < 0) {
+            throwJavaRuntimeException(env, "%s %d", "pipeline_double - negative nConstants argument:", nConstants);
+            return 0.0;
+        }
+        if (reduction < PIPE_REDUCE_NONE || reduction > PIPE_REDUCE_MAX) {
+            throwJavaRuntimeException(env, "%s %d", "pipeline_double - unknown reduction:", reduction);
+            return 0.0;
+        }
+        try {
+            Context* ctx = static_cast<Context*>(env);
+            ArenaScope scope;
+            Arena& arena = Arena::local();
+            jint* cc = arena.allocate<jint>(codeLength);
+            double* kk = arena.allocate<double>(nConstants);
+            ctx->GetIntArrayRegion(code, 0, codeLength, cc);
+            if (nConstants > 0) {
+                ctx->GetDoubleArrayRegion(constants, 0, nConstants, kk);
+            }
+            PipelineOp* ops = arena.allocate<PipelineOp>(codeLength);
+            int64_t nOps = 0;
+            int used = 0;
+            if (!pipeline_compile(cc, codeLength, nConstants, ops, nOps, used)) {
+                throw JException("- invalid op list");
+            }
+            jdoubleArray in[PIPELINE_MAX_INPUTS] = { x, y, z };
+            for (int k = 0; k < used; ++k) {
+                if (in[k] == nullptr) {
+                    throw JException("- missing input array");
+                }
+            }
+            // out is acquired first and hence released last (the inputs
+            // may alias it)
+            std::optional<DoubleArray> oo;
+            std::optional<DoubleArray> aa[PIPELINE_MAX_INPUTS];
+            double* ptrs[PIPELINE_MAX_INPUTS] = { nullptr, nullptr, nullptr };
+            if (out != nullptr && count > 0) {
+                oo.emplace(env, out, count, useCrit);
+            }
+            for (int k = 0; k < used && count > 0; ++k) {
+                aa[k].emplace(env, in[k], count, useCrit, true);
+                ptrs[k] = aa[k]->ptr();
+            }
+            return pipeline_double(ops, nOps, kk, ptrs, oo ? oo->ptr() : nullptr, count,
+                reduction);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "pipeline_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "pipeline_double: caught unknown exception");
+        }
+        return 0.0;
+    }
+
+    /*
+     * Class:     net_cramer_simd_Pipeline
+     * Method:    pipeline_float_n
+     * Signature: ([II[DI[F[F[F[FIIZ)F
+     */
+    JNIEXPORT jfloat JNICALL Java_net_cramer_simd_Pipeline_pipeline_1float_1n
+    (JNIEnv* env, jclass, jintArray code, jint codeLength, jdoubleArray constants, jint nConstants, jfloatArray x, jfloatArray y,
+        jfloatArray z, jfloatArray out, jint count, jint reduction, jboolean useCrit) {
+        if (code == nullptr || codeLength <= 0 || (nConstants > 0 && constants == nullptr)) {
+            throwJavaRuntimeException(env, "%s", "pipeline_float - empty op list");
+            return 0.0f;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "pipeline_float - negative count argument:", count);
+            return 0.0f;
+        }
+        if (nConstants < 0) {
+            throwJavaRuntimeException(env, "%s %d", "pipeline_float - negative nConstants argument:", nConstants);
+            return 0.0f;
+        }
+        if (reduction < PIPE_REDUCE_NONE || reduction > PIPE_REDUCE_MAX) {
+            throwJavaRuntimeException(env, "%s %d", "pipeline_float - unknown reduction:", reduction);
+            return 0.0f;
+        }
+        try {
+            Context* ctx = static_cast<Context*>(env);
+            ArenaScope scope;
+            Arena& arena = Arena::local();
+            jint* cc = arena.allocate<jint>(codeLength);
+            double* dk = arena.allocate<double>(nConstants);
+            ctx->GetIntArrayRegion(code, 0, codeLength, cc);
+            if (nConstants > 0) {
+                ctx->GetDoubleArrayRegion(constants, 0, nConstants, dk);
+            }
+            float* kk = arena.allocate<float>(nConstants);
+            std::copy(dk, dk + nConstants, kk);
+            PipelineOp* ops = arena.allocate<PipelineOp>(codeLength);
+            int64_t nOps = 0;
+            int used = 0;
+            if (!pipeline_compile(cc, codeLength, nConstants, ops, nOps, used)) {
+                throw JException("- invalid op list");
+            }
+            jfloatArray in[PIPELINE_MAX_INPUTS] = { x, y, z };
+            for (int k = 0; k < used; ++k) {
+                if (in[k] == nullptr) {
+                    throw JException("- missing input array");
+                }
+            }
+            // out is acquired first and hence released last (the inputs
+            // may alias it)
+            std::optional<FloatArray> oo;
+            std::optional<FloatArray> aa[PIPELINE_MAX_INPUTS];
+            float* ptrs[PIPELINE_MAX_INPUTS] = { nullptr, nullptr, nullptr };
+            if (out != nullptr && count > 0) {
+                oo.emplace(env, out, count, useCrit);
+            }
+            for (int k = 0; k < used && count > 0; ++k) {
+                aa[k].emplace(env, in[k], count, useCrit, true);
+                ptrs[k] = aa[k]->ptr();
+            }
+            return pipeline_float(ops, nOps, kk, ptrs, oo ? oo->ptr() : nullptr, count,
+                reduction);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "pipeline_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "pipeline_float: caught unknown exception");
+        }
+        return 0.0f;
+    }
+#ifdef __cplusplus
+}
+#endif
+
+
+template <typename T>
+struct PipeVec;
+
+#if INSTRSET >= 10
+template <> struct PipeVec<double> { typedef Vec8d V; };
+template <> struct PipeVec<float> { typedef Vec16f V; };
+#else
+template <> struct PipeVec<double> { typedef Vec4d V; };
+template <> struct PipeVec<float> { typedef Vec8f V; };
+#endif
+
+// number of operands an op pops (-1: unknown op)
+static int pipe_arity(int op) {
+    switch (op) {
+    case PIPE_INPUT:
+    case PIPE_CONST:
+        return 0;
+    case PIPE_NEG:
+    case PIPE_ABS:
+    case PIPE_SQRT:
+    case PIPE_SQUARE:
+    case PIPE_EXP:
+    case PIPE_LOG:
+    case PIPE_TANH:
+    case PIPE_SIGMOID:
+    case PIPE_RECIPROCAL:
+        return 1;
+    case PIPE_ADD:
+    case PIPE_SUB:
+    case PIPE_MUL:
+    case PIPE_DIV:
+    case PIPE_MIN:
+    case PIPE_MAX:
+        return 2;
+    case PIPE_FMA:
+        return 3;
+    default:
+        return -1;
+    }
+}
+
+// Decodes code[0 .. length) (an op code, followed by its operand for
+// PIPE_INPUT and PIPE_CONST) into the nOps entries of ops (room for length
+// is enough) and checks that it is a well-formed postfix expression that
+// fits into PIPELINE_MAX_STACK slots. inputs is set to 1 + the largest
+// input index used (0 if there is none).
+bool pipeline_compile(const int32_t* code, int64_t length, int64_t nConstants, PipelineOp* ops, int64_t& nOps,
+    int& inputs) {
+    nOps = 0;
+    inputs = 0;
+    int depth = 0;
+    for (int64_t i = 0; i < length; ++i) {
+        int op = code[i];
+        int arity = pipe_arity(op);
+        if (arity < 0) {
+            return false;
+        }
+        int arg = 0;
+        if (op == PIPE_INPUT || op == PIPE_CONST) {
+            if (++i == length) {
+                return false;
+            }
+            arg = code[i];
+            if (arg < 0 || (op == PIPE_INPUT && arg >= PIPELINE_MAX_INPUTS)
+                || (op == PIPE_CONST && arg >= nConstants)) {
+                return false;
+            }
+            if (op == PIPE_INPUT) {
+                inputs = std::max(inputs, arg + 1);
+            }
+        }
+        if (depth < arity) {
+            return false;
+        }
+        depth += 1 - arity;
+        if (depth > PIPELINE_MAX_STACK) {
+            return false;
+        }
+        ops[nOps++] = PipelineOp{ op, arg };
+    }
+    return depth == 1;
+}
+
+// A stack slot: an input array, a tile buffer or (ptr == nullptr) a scalar
+template <typename T>
+struct PipeSlot {
+    const T* ptr;
+    T value;
+    bool input;
+};
+
+// vector at tile offset i (n: elements in the tile, inputs must not be
+// read beyond it while the tile buffers are padded to whole vectors)
+template <typename V, typename T>
+static inline V pipe_load(const PipeSlot<T>& s, int64_t i, int64_t n) {
+    if (s.ptr == nullptr) {
+        return V(s.value);
+    }
+    if (!s.input || i + V::size() <= n) {
+        return V().load(s.ptr + i);
+    }
+    return V().load_partial(static_cast<int>(n - i), s.ptr + i);
+}
+
+template <typename T, typename F>
+static inline void pipe_unary(PipeSlot<T>& a, T* dst, int64_t n, F f) {
+    typedef typename PipeVec<T>::V V;
+    if (a.ptr == nullptr) {
+        a.value = f(V(a.value))[0];
+        return;
+    }
+    for (int64_t i = 0; i < n; i += V::size()) {
+        f(pipe_load<V>(a, i, n)).store(dst + i);
+    }
+    a = PipeSlot<T>{ dst, T(0), false };
+}
+
+template <typename T, typename F>
+static inline void pipe_binary(PipeSlot<T>& a, const PipeSlot<T>& b, T* dst, int64_t n, F f) {
+    typedef typename PipeVec<T>::V V;
+    if (a.ptr == nullptr && b.ptr == nullptr) {
+        a.value = f(V(a.value), V(b.value))[0];
+        return;
+    }
+    for (int64_t i = 0; i < n; i += V::size()) {
+        f(pipe_load<V>(a, i, n), pipe_load<V>(b, i, n)).store(dst + i);
+    }
+    a = PipeSlot<T>{ dst, T(0), false };
+}
+
+template <typename T>
+static inline void pipe_fma(PipeSlot<T>& a, const PipeSlot<T>& b, const PipeSlot<T>& c, T* dst, int64_t n) {
+    typedef typename PipeVec<T>::V V;
+    if (a.ptr == nullptr && b.ptr == nullptr && c.ptr == nullptr) {
+        a.value = mul_add(V(a.value), V(b.value), V(c.value))[0];
+        return;
+    }
+    for (int64_t i = 0; i < n; i += V::size()) {
+        mul_add(pipe_load<V>(a, i, n), pipe_load<V>(b, i, n), pipe_load<V>(c, i, n)).store(dst + i);
+    }
+    a = PipeSlot<T>{ dst, T(0), false };
+}
+
+// Evaluates the ops over the n <= PIPELINE_TILE elements of the tile
+// starting at element begin and returns the resulting slot
+template <typename T>
+static PipeSlot<T> pipe_tile(const PipelineOp* ops, int64_t nOps, const T* constants, T* const* inputs,
+    T* buffers, int64_t begin, int64_t n) {
+    typedef typename PipeVec<T>::V V;
+    PipeSlot<T> stack[PIPELINE_MAX_STACK];
+    int sp = 0;
+    for (int64_t k = 0; k < nOps; ++k) {
+        const PipelineOp& op = ops[k];
+        switch (op.op) {
+        case PIPE_INPUT:
+            stack[sp++] = PipeSlot<T>{ inputs[op.arg] + begin, T(0), true };
+            continue;
+        case PIPE_CONST:
+            stack[sp++] = PipeSlot<T>{ nullptr, constants[op.arg], false };
+            continue;
+        default:
+            break;
+        }
+        int arity = pipe_arity(op.op);
+        sp -= arity;
+        PipeSlot<T>& a = stack[sp];
+        T* dst = buffers + sp * PIPELINE_TILE;
+        switch (op.op) {
+        case PIPE_NEG:
+            pipe_unary(a, dst, n, [](V x) { return -x; });
+            break;
+        case PIPE_ABS:
+            pipe_unary(a, dst, n, [](V x) { return abs(x); });
+            break;
+        case PIPE_SQRT:
+            pipe_unary(a, dst, n, [](V x) { return sqrt(x); });
+            break;
+        case PIPE_SQUARE:
+            pipe_unary(a, dst, n, [](V x) { return square(x); });
+            break;
+        case PIPE_EXP:
+            pipe_unary(a, dst, n, [](V x) { return exp(x); });
+            break;
+        case PIPE_LOG:
+            pipe_unary(a, dst, n, [](V x) { return log(x); });
+            break;
+        case PIPE_TANH:
+            pipe_unary(a, dst, n, [](V x) { return tanh(x); });
+            break;
+        case PIPE_SIGMOID:
+            pipe_unary(a, dst, n, [](V x) { return V(T(1)) / (V(T(1)) + exp(-x)); });
+            break;
+        case PIPE_RECIPROCAL:
+            pipe_unary(a, dst, n, [](V x) { return V(T(1)) / x; });
+            break;
+        case PIPE_ADD:
+            pipe_binary(a, stack[sp + 1], dst, n, [](V x, V y) { return x + y; });
+            break;
+        case PIPE_SUB:
+            pipe_binary(a, stack[sp + 1], dst, n, [](V x, V y) { return x - y; });
+            break;
+        case PIPE_MUL:
+            pipe_binary(a, stack[sp + 1], dst, n, [](V x, V y) { return x * y; });
+            break;
+        case PIPE_DIV:
+            pipe_binary(a, stack[sp + 1], dst, n, [](V x, V y) { return x / y; });
+            break;
+        case PIPE_MIN:
+            pipe_binary(a, stack[sp + 1], dst, n, [](V x, V y) { return min(x, y); });
+            break;
+        case PIPE_MAX:
+            pipe_binary(a, stack[sp + 1], dst, n, [](V x, V y) { return max(x, y); });
+            break;
+        case PIPE_FMA:
+            pipe_fma(a, stack[sp + 1], stack[sp + 2], dst, n);
+            break;
+        default:
+            break;
+        }
+        ++sp;
+    }
+    return stack[0];
+}
+
+template <typename T>
+static double pipeline(const PipelineOp* ops, int64_t nOps, const T* constants, T* const* inputs, T* out,
+    int64_t count, int reduction) {
+    typedef typename PipeVec<T>::V V;
+    constexpr int L = V::size();
+    double result = 0.0;
+    if (reduction == PIPE_REDUCE_MIN) {
+        result = std::numeric_limits<double>::infinity();
+    } else if (reduction == PIPE_REDUCE_MAX) {
+        result = -std::numeric_limits<double>::infinity();
+    }
+    ArenaScope scope;
+    T* buffers = Arena::local().allocate<T>(PIPELINE_MAX_STACK * PIPELINE_TILE);
+    for (int64_t begin = 0; begin < count; begin += PIPELINE_TILE) {
+        const int64_t n = std::min(PIPELINE_TILE, count - begin);
+        const int64_t full = n - n % L;
+        PipeSlot<T> s = pipe_tile(ops, nOps, constants, inputs, buffers, begin, n);
+        if (out != nullptr) {
+            int64_t i = 0;
+            for (; i < full; i += L) {
+                pipe_load<V>(s, i, n).store(out + begin + i);
+            }
+            if (i < n) {
+                pipe_load<V>(s, i, n).store_partial(static_cast<int>(n - i), out + begin + i);
+            }
+        }
+        if (reduction == PIPE_REDUCE_NONE) {
+            continue;
+        }
+        // the tile is reduced in T and added to the double result
+        V acc;
+        switch (reduction) {
+        case PIPE_REDUCE_SUM:
+            acc = V(T(0));
+            for (int64_t i = 0; i < full; i += L) {
+                acc += pipe_load<V>(s, i, n);
+            }
+            result += horizontal_add(acc);
+            break;
+        case PIPE_REDUCE_MIN:
+            acc = V(std::numeric_limits<T>::infinity());
+            for (int64_t i = 0; i < full; i += L) {
+                acc = min(pipe_load<V>(s, i, n), acc);
+            }
+            result = std::min(result, static_cast<double>(horizontal_min1(acc)));
+            break;
+        default:
+            acc = V(-std::numeric_limits<T>::infinity());
+            for (int64_t i = 0; i < full; i += L) {
+                acc = max(pipe_load<V>(s, i, n), acc);
+            }
+            result = std::max(result, static_cast<double>(horizontal_max1(acc)));
+            break;
+        }
+        for (int64_t i = full; i < n; ++i) {
+            double x = (s.ptr == nullptr) ? s.value : s.ptr[i];
+            if (reduction == PIPE_REDUCE_SUM) {
+                result += x;
+            } else if (!std::isnan(x)) {
+                result = (reduction == PIPE_REDUCE_MIN) ? std::min(result, x) : std::max(result, x);
+            }
+        }
+    }
+    return result;
+}
+
+double pipeline_double(const PipelineOp* ops, int64_t nOps, const double* constants, double* const* inputs,
+    double* out, int64_t count, int reduction) {
+    return pipeline(ops, nOps, constants, inputs, out, count, reduction);
+}
+
+double pipeline_float(const PipelineOp* ops, int64_t nOps, const float* constants, float* const* inputs,
+    float* out, int64_t count, int reduction) {
+    return pipeline(ops, nOps, constants, inputs, out, count, reduction);
+}
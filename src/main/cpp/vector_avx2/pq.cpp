@@ -0,0 +1,524 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>             // std::lround
+#include <algorithm>         // std::min, std::max
+#include <limits>            // std::numeric_limits
+#include <jni.h>
+
+#ifndef VECTORIZE_INCLUDED_
+#include "vectorize.h"
+#endif /* VECTORIZE_INCLUDED_ */
+
+#ifndef PARALLEL_INCLUDED_
+#include "Parallel.h"
+#endif /* PARALLEL_INCLUDED_ */
+
+#ifndef ARENA_INCLUDED_
+#include "Arena.h"
+#endif /* ARENA_INCLUDED_ */
+
+#ifndef BYTEARRAY_INCLUDED_
+#include "ByteArray.h"
+#endif /* BYTEARRAY_INCLUDED_ */
+
+#ifndef FLOATARRAY_INCLUDED_
+#include "FloatArray.h"
+#endif /* FLOATARRAY_INCLUDED_ */
+
+#ifndef JEXCEPTION_INCLUDED_
+#include "JException.h"
+#endif /* JEXCEPTION_INCLUDED_ */
+
+#ifndef JEXCEPTIONUTILS_INCLUDED_
+#include "JExceptionUtils.h"
+#endif /* JEXCEPTIONUTILS_INCLUDED_ */
+
+
+// Product quantization: a dim-dimensional vector is split into m sub-vectors
+// of dsub = dim / m components, each sub-vector is replaced by the index of
+// its nearest centroid in the codebook of its subspace (ksub <= 256
+// centroids, one byte per code). The codebooks are a (m x ksub x dsub) float
+// array.
+//
+// A query is compared to the codes by asymmetric distance computation (ADC):
+// the (m x ksub) table of the metric between each query sub-vector and each
+// centroid is computed once per query (with the float kernels of
+// vectorize.cpp) and the distance to a code is the sum of m table entries.
+//
+// For ksub = 16 the codes can be packed two per byte into blocks of
+// PQ4_BLOCK rows ("fast scan"). The table is then quantized to 8 bit so
+// that the table of a subspace fits into a 128 bit register and the lookup
+// of PQ4_BLOCK codes is a single vpshufb (two subspaces per vpshufb on
+// AVX-512). The sums are accumulated in 16 bit lanes.
+
+// rows of a block of packed 4 bit codes
+constexpr int64_t PQ4_BLOCK = 32;
+// code bytes per thread (at least)
+constexpr int64_t PQ_MIN_WORK = 1 << 18;
+// seed of the k-means++ seeding of subspace 0 (subspace j uses seed + j)
+constexpr uint64_t PQ_TRAIN_SEED = 0x9E3779B97F4A7C15ULL;
+
+
+void pq_train(float* x, int64_t rows, int64_t dim, int64_t m, int64_t ksub, int iterations, float* codebooks);
+void pq_encode(float* x, int64_t rows, int64_t dim, int64_t m, int64_t ksub, float* codebooks, uint8_t* codes);
+void pq_distance_table(float* query, int64_t dim, int64_t m, int64_t ksub, float* codebooks, int metric,
+    float* table);
+void pq_scan(float* table, int64_t m, int64_t ksub, uint8_t* codes, int64_t rows, float* out);
+int64_t pq_check_codes(uint8_t* codes, int64_t count, int64_t ksub);
+void pq_pack4(uint8_t* codes, int64_t rows, int64_t m, uint8_t* packed);
+void pq_scan4(float* table, int64_t m, uint8_t* packed, int64_t rows, float* out);
+
+
+static inline int64_t packed4_length(int64_t rows, int64_t m) {
+    return ((rows + PQ4_BLOCK - 1) / PQ4_BLOCK) * m * (PQ4_BLOCK / 2);
+}
+
+static bool checkCodebooks(JNIEnv* env, const char* method, jint dim, jint m, jint ksub) {
+    if (m <= 0 || dim <= 0 || dim % m != 0) {
+        throwJavaRuntimeException(env, "%s - dim must be a positive multiple of m: dim = %d, m = %d", method, dim, m);
+        return false;
+    }
+    if (ksub < 1 || ksub > 256) {
+        throwJavaRuntimeException(env, "%s - ksub must be in [1, 256]: %d", method, ksub);
+        return false;
+    }
+    if (static_cast<int64_t>(ksub) * dim > INT32_MAX) {
+        throwJavaRuntimeException(env, "%s - ksub * dim too large: ksub = %d, dim = %d", method, ksub, dim);
+        return false;
+    }
+    return true;
+}
+
+static bool checkRows(JNIEnv* env, const char* method, jint rows, jint width) {
+    if (rows < 0) {
+        throwJavaRuntimeException(env, "%s %s %d", method, "- negative rows argument:", rows);
+        return false;
+    }
+    if (static_cast<int64_t>(rows) * width > INT32_MAX) {
+        throwJavaRuntimeException(env, "%s - rows too large: %d", method, rows);
+        return false;
+    }
+    return true;
+}
+
+// rows of packed 4 bit codes: the packed array covers rows rounded up to a
+// multiple of PQ4_BLOCK
+static bool checkPackedRows(JNIEnv* env, const char* method, jint rows, jint m) {
+    if (!checkRows(env, method, rows, m)) {
+        return false;
+    }
+    int64_t padded = (static_cast<int64_t>(rows) + PQ4_BLOCK - 1) / PQ4_BLOCK * PQ4_BLOCK;
+    if (padded * m > INT32_MAX) {
+        throwJavaRuntimeException(env, "%s - rows too large: %d", method, rows);
+        return false;
+    }
+    return true;
+}
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    /*
+     * Class:     net_cramer_simd_ProductQuantization
+     * Method:    train_n
+     * Signature: ([FIIIII[FZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_ProductQuantization_train_1n
+    (JNIEnv* env, jclass, jfloatArray x, jint rows, jint dim, jint m, jint ksub, jint iterations,
+        jfloatArray codebooks, jboolean useCrit) {
+        if (!checkCodebooks(env, "train", dim, m, ksub) || !checkRows(env, "train", rows, dim)) {
+            return;
+        }
+        if (rows < ksub || iterations < 0) {
+            throwJavaRuntimeException(env, "%s - need rows >= ksub and iterations >= 0: rows = %d, ksub = %d, "
+                "iterations = %d", "train", rows, ksub, iterations);
+            return;
+        }
+        if (x == nullptr || codebooks == nullptr) {
+            return;
+        }
+        try {
+            FloatArray xx = FloatArray(env, x, rows * dim, useCrit, true);
+            FloatArray cc = FloatArray(env, codebooks, ksub * dim, useCrit);
+            pq_train(xx.ptr(), rows, dim, m, ksub, iterations, cc.ptr());
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "train", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "train: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_ProductQuantization
+     * Method:    encode_n
+     * Signature: ([FIIII[F[BZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_ProductQuantization_encode_1n
+    (JNIEnv* env, jclass, jfloatArray x, jint rows, jint dim, jint m, jint ksub, jfloatArray codebooks,
+        jbyteArray codes, jboolean useCrit) {
+        if (!checkCodebooks(env, "encode", dim, m, ksub) || !checkRows(env, "encode", rows, dim)) {
+            return;
+        }
+        if (rows == 0 || x == nullptr || codebooks == nullptr || codes == nullptr) {
+            return;
+        }
+        try {
+            FloatArray xx = FloatArray(env, x, rows * dim, useCrit, true);
+            FloatArray cc = FloatArray(env, codebooks, ksub * dim, useCrit, true);
+            ByteArray oo = ByteArray(env, codes, rows * m, useCrit);
+            pq_encode(xx.ptr(), rows, dim, m, ksub, cc.ptr(), reinterpret_cast<uint8_t*>(oo.ptr()));
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "encode", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "encode: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_ProductQuantization
+     * Method:    distance_table_n
+     * Signature: ([FIII[FI[FZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_ProductQuantization_distance_1table_1n
+    (JNIEnv* env, jclass, jfloatArray query, jint dim, jint m, jint ksub, jfloatArray codebooks, jint metric,
+        jfloatArray table, jboolean useCrit) {
+        if (!checkCodebooks(env, "distance_table", dim, m, ksub)) {
+            return;
+        }
+        if (metric != METRIC_L2_SQUARED && metric != METRIC_INNER_PRODUCT) {
+            throwJavaRuntimeException(env, "%s %d", "distance_table - unsupported metric:", metric);
+            return;
+        }
+        if (query == nullptr || codebooks == nullptr || table == nullptr) {
+            return;
+        }
+        try {
+            FloatArray qq = FloatArray(env, query, dim, useCrit, true);
+            FloatArray cc = FloatArray(env, codebooks, ksub * dim, useCrit, true);
+            FloatArray tt = FloatArray(env, table, m * ksub, useCrit);
+            pq_distance_table(qq.ptr(), dim, m, ksub, cc.ptr(), metric, tt.ptr());
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "distance_table", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "distance_table: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_ProductQuantization
+     * Method:    scan_n
+     * Signature: ([FII[BI[FZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_ProductQuantization_scan_1n
+    (JNIEnv* env, jclass, jfloatArray table, jint m, jint ksub, jbyteArray codes, jint rows, jfloatArray out,
+        jboolean useCrit) {
+        if (!checkCodebooks(env, "scan", m, m, ksub) || !checkRows(env, "scan", rows, m)) {
+            return;
+        }
+        if (rows == 0 || table == nullptr || codes == nullptr || out == nullptr) {
+            return;
+        }
+        try {
+            FloatArray tt = FloatArray(env, table, m * ksub, useCrit, true);
+            ByteArray cc = ByteArray(env, codes, rows * m, useCrit, true);
+            if (pq_check_codes(reinterpret_cast<uint8_t*>(cc.ptr()), int64_t(rows) * m, ksub) >= 0) {
+                throw JException("- codes must be < ksub");
+            }
+            FloatArray oo = FloatArray(env, out, rows, useCrit);
+            pq_scan(tt.ptr(), m, ksub, reinterpret_cast<uint8_t*>(cc.ptr()), rows, oo.ptr());
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "scan", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "scan: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_ProductQuantization
+     * Method:    pack4_n
+     * Signature: ([BII[BZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_ProductQuantization_pack4_1n
+    (JNIEnv* env, jclass, jbyteArray codes, jint rows, jint m, jbyteArray packed, jboolean useCrit) {
+        if (!checkCodebooks(env, "pack4", m, m, 16) || !checkPackedRows(env, "pack4", rows, m)) {
+            return;
+        }
+        if (rows == 0 || codes == nullptr || packed == nullptr) {
+            return;
+        }
+        try {
+            ByteArray cc = ByteArray(env, codes, rows * m, useCrit, true);
+            ByteArray pp = ByteArray(env, packed, static_cast<long>(packed4_length(rows, m)), useCrit);
+            pq_pack4(reinterpret_cast<uint8_t*>(cc.ptr()), rows, m, reinterpret_cast<uint8_t*>(pp.ptr()));
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "pack4", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "pack4: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_ProductQuantization
+     * Method:    scan4_n
+     * Signature: ([FI[BI[FZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_ProductQuantization_scan4_1n
+    (JNIEnv* env, jclass, jfloatArray table, jint m, jbyteArray packed, jint rows, jfloatArray out,
+        jboolean useCrit) {
+        if (!checkCodebooks(env, "scan4", m, m, 16) || !checkPackedRows(env, "scan4", rows, m)) {
+            return;
+        }
+        if (rows == 0 || table == nullptr || packed == nullptr || out == nullptr) {
+            return;
+        }
+        try {
+            FloatArray tt = FloatArray(env, table, m * 16, useCrit, true);
+            ByteArray pp = ByteArray(env, packed, static_cast<long>(packed4_length(rows, m)), useCrit, true);
+            FloatArray oo = FloatArray(env, out, rows, useCrit);
+            pq_scan4(tt.ptr(), m, reinterpret_cast<uint8_t*>(pp.ptr()), rows, oo.ptr());
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "scan4", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "scan4: caught unknown exception");
+        }
+    }
+#ifdef __cplusplus
+}
+#endif
+
+
+// index of the smallest of the n values (the first one on ties)
+static inline int argmin(float* d, int64_t n) {
+    int best = 0;
+    for (int k = 1; k < n; ++k) {
+        if (d[k] < d[best]) {
+            best = k;
+        }
+    }
+    return best;
+}
+
+// The codebook of each subspace is trained with the k-means engine of
+// kmeans.cpp on the (strided) sub-vectors of the training rows, seeded with
+// a fixed seed so that training is repeatable.
+void pq_train(float* x, int64_t rows, int64_t dim, int64_t m, int64_t ksub, int iterations, float* codebooks) {
+    const int64_t dsub = dim / m;
+    ArenaScope scope;
+    int32_t* assignments = Arena::local().allocate<int32_t>(rows);
+    KMeansStats stats;
+    for (int64_t j = 0; j < m; ++j) {
+        kmeans_float(x + j * dsub, rows, dim, dsub, ksub, iterations, 0.0, PQ_TRAIN_SEED + j,
+            codebooks + j * ksub * dsub, assignments, stats);
+    }
+}
+
+void pq_encode(float* x, int64_t rows, int64_t dim, int64_t m, int64_t ksub, float* codebooks, uint8_t* codes) {
+    const int64_t dsub = dim / m;
+    const int64_t grain = std::max(int64_t(1), PQ_MIN_WORK / (ksub * dim));
+    ArenaScope scope;
+    float* dist = Arena::local().allocate<float>(parallel_parts(rows, grain) * ksub);
+    parallel_for(rows, grain, [&](int64_t begin, int64_t end, int part) {
+        float* d = dist + part * ksub;
+        for (int64_t r = begin; r < end; ++r) {
+            for (int64_t j = 0; j < m; ++j) {
+                distances_float(x + r * dim + j * dsub, codebooks + j * ksub * dsub, ksub, dsub, METRIC_L2_SQUARED, d);
+                codes[r * m + j] = static_cast<uint8_t>(argmin(d, ksub));
+            }
+        }
+    });
+}
+
+void pq_distance_table(float* query, int64_t dim, int64_t m, int64_t ksub, float* codebooks, int metric,
+    float* table) {
+    const int64_t dsub = dim / m;
+    for (int64_t j = 0; j < m; ++j) {
+        distances_float(query + j * dsub, codebooks + j * ksub * dsub, ksub, dsub, metric, table + j * ksub);
+    }
+}
+
+// Index of the first code >= ksub or -1 (the table lookups of pq_scan are
+// not bounds checked)
+int64_t pq_check_codes(uint8_t* codes, int64_t count, int64_t ksub) {
+    if (ksub >= 256) {
+        return -1;
+    }
+    const uint8_t limit = static_cast<uint8_t>(ksub);
+    for (int64_t begin = 0; begin < count; begin += 4096) {
+        const int64_t end = std::min(count, begin + 4096);
+        uint8_t max = 0;
+        for (int64_t i = begin; i < end; ++i) {
+            max = std::max(max, codes[i]);
+        }
+        if (max >= limit) {
+            for (int64_t i = begin; i < end; ++i) {
+                if (codes[i] >= limit) {
+                    return i;
+                }
+            }
+        }
+    }
+    return -1;
+}
+
+// sum of the table entries selected by the m codes of a row (4 partial sums)
+static inline float adc(float* table, int64_t m, int64_t ksub, uint8_t* code) {
+    float s0 = 0.0f;
+    float s1 = 0.0f;
+    float s2 = 0.0f;
+    float s3 = 0.0f;
+    int64_t j = 0;
+    for (; j <= m - 4; j += 4) {
+        s0 += table[j * ksub + code[j]];
+        s1 += table[(j + 1) * ksub + code[j + 1]];
+        s2 += table[(j + 2) * ksub + code[j + 2]];
+        s3 += table[(j + 3) * ksub + code[j + 3]];
+    }
+    for (; j < m; ++j) {
+        s0 += table[j * ksub + code[j]];
+    }
+    return (s0 + s1) + (s2 + s3);
+}
+
+void pq_scan(float* table, int64_t m, int64_t ksub, uint8_t* codes, int64_t rows, float* out) {
+    parallel_for(rows, std::max(int64_t(1), PQ_MIN_WORK / m), [&](int64_t begin, int64_t end, int) {
+        for (int64_t r = begin; r < end; ++r) {
+            out[r] = adc(table, m, ksub, codes + r * m);
+        }
+    });
+}
+
+// Packed layout: for each block of PQ4_BLOCK rows and each subspace j, 16
+// bytes where byte i holds the code of row i of the block in the low nibble
+// and the code of row i + 16 in the high nibble (missing rows of the last
+// block are 0)
+void pq_pack4(uint8_t* codes, int64_t rows, int64_t m, uint8_t* packed) {
+    const int64_t half = PQ4_BLOCK / 2;
+    for (int64_t b = 0; b < rows; b += PQ4_BLOCK) {
+        for (int64_t j = 0; j < m; ++j) {
+            uint8_t* dst = packed + (b / PQ4_BLOCK * m + j) * half;
+            for (int64_t i = 0; i < half; ++i) {
+                uint8_t lo = (b + i < rows) ? (codes[(b + i) * m + j] & 0x0F) : 0;
+                uint8_t hi = (b + i + half < rows) ? (codes[(b + i + half) * m + j] & 0x0F) : 0;
+                dst[i] = static_cast<uint8_t>(lo | (hi << 4));
+            }
+        }
+    }
+}
+
+// Quantizes the (m x 16) float table to 8 bit: q = round((t - min_j) * scale)
+// with a common scale such that each entry fits into 8 bit and the sum of m
+// entries into 16 bit. Returns the scale, bias is the sum of the min_j.
+static float quantize_table(float* table, int64_t m, uint8_t* qtable, float& bias) {
+    ArenaScope scope;
+    float* mins = Arena::local().allocate<float>(m);
+    float maxRange = 0.0f;
+    double sumRange = 0.0;
+    double sumMin = 0.0;
+    for (int64_t j = 0; j < m; ++j) {
+        float lo = *std::min_element(table + j * 16, table + j * 16 + 16);
+        float hi = *std::max_element(table + j * 16, table + j * 16 + 16);
+        mins[j] = lo;
+        maxRange = std::max(maxRange, hi - lo);
+        sumRange += hi - lo;
+        sumMin += lo;
+    }
+    float scale = 1.0f;
+    if (maxRange > 0.0f) {
+        scale = static_cast<float>(std::min(255.0 / maxRange, 65535.0 / sumRange));
+    }
+    for (int64_t j = 0; j < m; ++j) {
+        for (int k = 0; k < 16; ++k) {
+            long q = std::lround((table[j * 16 + k] - mins[j]) * scale);
+            qtable[j * 16 + k] = static_cast<uint8_t>(std::min(q, 255L));
+        }
+    }
+    bias = static_cast<float>(sumMin);
+    return scale;
+}
+
+// 16 lookups of the 16 byte table in each 128 bit lane
+static inline Vec32uc lookup16x2(Vec32uc const index, Vec16uc const table) {
+    return _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(table), index);
+}
+
+// Accumulates the quantized table entries of the PQ4_BLOCK rows of a block.
+// The lookup result of a row pair (2i, 2i + 1) shares a 16 bit lane, the
+// even rows are summed in 'even', the odd rows in 'odd' (with saturation).
+static inline void scan4_block(uint8_t* qtable, int64_t m, uint8_t* block, uint16_t* sums) {
+    Vec16us even = Vec16us(0);
+    Vec16us odd = Vec16us(0);
+    int64_t j = 0;
+#if INSTRSET >= 10
+    // two subspaces per vpshufb: lanes (lo j, hi j, lo j + 1, hi j + 1)
+    Vec32us even2 = Vec32us(0);
+    Vec32us odd2 = Vec32us(0);
+    for (; j <= m - 2; j += 2) {
+        __m512i c = _mm512_castsi256_si512(Vec32uc().load(block + j * 16));
+        __m512i t = _mm512_castsi256_si512(Vec32uc().load(qtable + j * 16));
+        __m512i lo = _mm512_and_si512(c, _mm512_set1_epi8(0x0F));
+        __m512i hi = _mm512_and_si512(_mm512_srli_epi16(c, 4), _mm512_set1_epi8(0x0F));
+        __m512i index = _mm512_shuffle_i64x2(lo, hi, _MM_SHUFFLE(1, 0, 1, 0));
+        index = _mm512_shuffle_i64x2(index, index, _MM_SHUFFLE(3, 1, 2, 0));
+        Vec32us r = _mm512_shuffle_epi8(_mm512_shuffle_i64x2(t, t, _MM_SHUFFLE(1, 1, 0, 0)), index);
+        even2 = add_saturated(even2, r & Vec32us(0x00FF));
+        odd2 = add_saturated(odd2, r >> 8);
+    }
+    even = add_saturated(even2.get_low(), even2.get_high());
+    odd = add_saturated(odd2.get_low(), odd2.get_high());
+#endif
+    for (; j < m; ++j) {
+        Vec16uc c = Vec16uc().load(block + j * 16);
+        Vec16us r = Vec16us(lookup16x2(Vec32uc(c & Vec16uc(0x0F), c >> 4), Vec16uc().load(qtable + j * 16)));
+        even = add_saturated(even, r & Vec16us(0x00FF));
+        odd = add_saturated(odd, r >> 8);
+    }
+    // rows 2i and 2i + 1 are in lane i (rows 16 .. 31 in the upper 128 bits)
+    blend16<0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23>(even, odd).store(sums);
+    blend16<8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31>(even, odd).store(sums + 16);
+}
+
+void pq_scan4(float* table, int64_t m, uint8_t* packed, int64_t rows, float* out) {
+    ArenaScope scope;
+    uint8_t* qtable = Arena::local().allocate<uint8_t>(m * 16);
+    float bias = 0.0f;
+    const float inv = 1.0f / quantize_table(table, m, qtable, bias);
+    const int64_t blocks = (rows + PQ4_BLOCK - 1) / PQ4_BLOCK;
+    const int64_t grain = std::max(int64_t(1), PQ_MIN_WORK / (m * PQ4_BLOCK / 2));
+    parallel_for(blocks, grain, [&](int64_t begin, int64_t end, int) {
+        alignas(64) uint16_t sums[PQ4_BLOCK];
+        for (int64_t b = begin; b < end; ++b) {
+            scan4_block(qtable, m, packed + b * m * (PQ4_BLOCK / 2), sums);
+            int64_t n = std::min(PQ4_BLOCK, rows - b * PQ4_BLOCK);
+            for (int64_t i = 0; i < n; ++i) {
+                out[b * PQ4_BLOCK + i] = sums[i] * inv + bias;
+            }
+        }
+    });
+}
@@ -0,0 +1,516 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>             // std::sqrt
+#include <algorithm>         // std::min, std::max
+#include <limits>            // std::numeric_limits
+#include <jni.h>
+
+#ifndef VECTORIZE_INCLUDED_
+#include "vectorize.h"
+#endif /* VECTORIZE_INCLUDED_ */
+
+#ifndef BYTEARRAY_INCLUDED_
+#include "ByteArray.h"
+#endif /* BYTEARRAY_INCLUDED_ */
+
+#ifndef FLOATARRAY_INCLUDED_
+#include "FloatArray.h"
+#endif /* FLOATARRAY_INCLUDED_ */
+
+#ifndef JEXCEPTION_INCLUDED_
+#include "JException.h"
+#endif /* JEXCEPTION_INCLUDED_ */
+
+#ifndef JEXCEPTIONUTILS_INCLUDED_
+#include "JExceptionUtils.h"
+#endif /* JEXCEPTIONUTILS_INCLUDED_ */
+
+
+// Scalar quantization of the rows of a row-major (rows x dim) float matrix
+// to 8 bit with a per-row scale (int8, symmetric: x = scale * q with q in
+// [-127, 127]) or a per-row scale and offset (uint8: x = scale * q + offset
+// with q in [0, 255]), and the integer dot product / squared distance
+// kernels on the quantized data.
+//
+// The integer kernels widen the bytes to 16 bit and multiply-add adjacent
+// pairs into 32 bit lanes (vpmaddwd, or vpdpwssd where AVX512-VNNI is
+// available). The lanes are flushed to a 64 bit sum every BYTES_CHUNK
+// elements so that they cannot overflow.
+
+constexpr int64_t BYTES_CHUNK = 1 << 16;
+
+
+void quantize_int8(float* x, int64_t rows, int64_t dim, int8_t* q, float* scales);
+void quantize_uint8(float* x, int64_t rows, int64_t dim, uint8_t* q, float* scales, float* offsets);
+void dequantize_int8(int8_t* q, float* scales, int64_t rows, int64_t dim, float* x);
+void dequantize_uint8(uint8_t* q, float* scales, float* offsets, int64_t rows, int64_t dim, float* x);
+int64_t dot_int8(int8_t* a, int8_t* b, int64_t count);
+int64_t dot_uint8(uint8_t* a, uint8_t* b, int64_t count);
+int64_t squared_distance_int8(int8_t* a, int8_t* b, int64_t count);
+int64_t squared_distance_uint8(uint8_t* a, uint8_t* b, int64_t count);
+
+
+static bool checkShape(JNIEnv* env, const char* method, jint rows, jint dim) {
+    if (rows < 0 || dim < 0) {
+        throwJavaRuntimeException(env, "%s - negative argument: rows = %d, dim = %d", method, rows, dim);
+        return false;
+    }
+    if (static_cast<int64_t>(rows) * dim > INT32_MAX) {
+        throwJavaRuntimeException(env, "%s - rows * dim too large: rows = %d, dim = %d", method, rows, dim);
+        return false;
+    }
+    return true;
+}
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    /*
+     * Class:     net_cramer_simd_Quantization
+     * Method:    quantize_n
+     * Signature: ([FII[B[F[FZZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Quantization_quantize_1n
+    (JNIEnv* env, jclass, jfloatArray x, jint rows, jint dim, jbyteArray q, jfloatArray scales, jfloatArray offsets,
+        jboolean isUnsigned, jboolean useCrit) {
+        if (!checkShape(env, "quantize", rows, dim)) {
+            return;
+        }
+        if (rows == 0 || x == nullptr || q == nullptr || scales == nullptr || (isUnsigned && offsets == nullptr)) {
+            return;
+        }
+        try {
+            FloatArray xx = FloatArray(env, x, rows * dim, useCrit, true);
+            ByteArray qq = ByteArray(env, q, rows * dim, useCrit);
+            FloatArray ss = FloatArray(env, scales, rows, useCrit);
+            if (isUnsigned) {
+                FloatArray oo = FloatArray(env, offsets, rows, useCrit);
+                quantize_uint8(xx.ptr(), rows, dim, reinterpret_cast<uint8_t*>(qq.ptr()), ss.ptr(), oo.ptr());
+            } else {
+                quantize_int8(xx.ptr(), rows, dim, qq.ptr(), ss.ptr());
+            }
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "quantize", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "quantize: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_Quantization
+     * Method:    dequantize_n
+     * Signature: ([B[F[FII[FZZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Quantization_dequantize_1n
+    (JNIEnv* env, jclass, jbyteArray q, jfloatArray scales, jfloatArray offsets, jint rows, jint dim, jfloatArray x,
+        jboolean isUnsigned, jboolean useCrit) {
+        if (!checkShape(env, "dequantize", rows, dim)) {
+            return;
+        }
+        if (rows == 0 || x == nullptr || q == nullptr || scales == nullptr || (isUnsigned && offsets == nullptr)) {
+            return;
+        }
+        try {
+            ByteArray qq = ByteArray(env, q, rows * dim, useCrit, true);
+            FloatArray ss = FloatArray(env, scales, rows, useCrit, true);
+            FloatArray xx = FloatArray(env, x, rows * dim, useCrit);
+            if (isUnsigned) {
+                FloatArray oo = FloatArray(env, offsets, rows, useCrit, true);
+                dequantize_uint8(reinterpret_cast<uint8_t*>(qq.ptr()), ss.ptr(), oo.ptr(), rows, dim, xx.ptr());
+            } else {
+                dequantize_int8(qq.ptr(), ss.ptr(), rows, dim, xx.ptr());
+            }
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "dequantize", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "dequantize: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_Quantization
+     * Method:    dot_n
+     * Signature: ([B[BIZZ)J
+     */
+    JNIEXPORT jlong JNICALL Java_net_cramer_simd_Quantization_dot_1n
+    (JNIEnv* env, jclass, jbyteArray a, jbyteArray b, jint count, jboolean isUnsigned, jboolean useCrit) {
+        if (count == 0 || a == nullptr || b == nullptr) {
+            return 0;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "dot - negative count argument:", count);
+            return 0;
+        }
+        try {
+            ByteArray aa = ByteArray(env, a, count, useCrit, true);
+            ByteArray bb = ByteArray(env, b, count, useCrit, true);
+            if (isUnsigned) {
+                return dot_uint8(reinterpret_cast<uint8_t*>(aa.ptr()), reinterpret_cast<uint8_t*>(bb.ptr()), count);
+            }
+            return dot_int8(aa.ptr(), bb.ptr(), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "dot", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "dot: caught unknown exception");
+        }
+        return 0;
+    }
+
+    /*
+     * Class:     net_cramer_simd_Quantization
+     * Method:    squared_distance_n
+     * Signature: ([B[BIZZ)J
+     */
+    JNIEXPORT jlong JNICALL Java_net_cramer_simd_Quantization_squared_1distance_1n
+    (JNIEnv* env, jclass, jbyteArray a, jbyteArray b, jint count, jboolean isUnsigned, jboolean useCrit) {
+        if (count == 0 || a == nullptr || b == nullptr) {
+            return 0;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "squared_distance - negative count argument:", count);
+            return 0;
+        }
+        try {
+            ByteArray aa = ByteArray(env, a, count, useCrit, true);
+            ByteArray bb = ByteArray(env, b, count, useCrit, true);
+            if (isUnsigned) {
+                return squared_distance_uint8(reinterpret_cast<uint8_t*>(aa.ptr()),
+                    reinterpret_cast<uint8_t*>(bb.ptr()), count);
+            }
+            return squared_distance_int8(aa.ptr(), bb.ptr(), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "squared_distance", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "squared_distance: caught unknown exception");
+        }
+        return 0;
+    }
+
+    /*
+     * Class:     net_cramer_simd_Quantization
+     * Method:    distances_int8_n
+     * Signature: ([BF[B[FIII[FZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Quantization_distances_1int8_1n
+    (JNIEnv* env, jclass, jbyteArray query, jfloat queryScale, jbyteArray base, jfloatArray scales, jint rows,
+        jint dim, jint metric, jfloatArray out, jboolean useCrit) {
+        if (!checkShape(env, "distances_int8", rows, dim)) {
+            return;
+        }
+        if (metric < METRIC_L2_SQUARED || metric > METRIC_COSINE) {
+            throwJavaRuntimeException(env, "%s %d", "distances_int8 - unknown metric:", metric);
+            return;
+        }
+        if (rows == 0 || query == nullptr || base == nullptr || scales == nullptr || out == nullptr) {
+            return;
+        }
+        try {
+            ByteArray qq = ByteArray(env, query, dim, useCrit, true);
+            ByteArray bb = ByteArray(env, base, rows * dim, useCrit, true);
+            FloatArray ss = FloatArray(env, scales, rows, useCrit, true);
+            FloatArray oo = FloatArray(env, out, rows, useCrit);
+            distances_int8(qq.ptr(), queryScale, bb.ptr(), ss.ptr(), rows, dim, metric, oo.ptr());
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "distances_int8", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "distances_int8: caught unknown exception");
+        }
+    }
+#ifdef __cplusplus
+}
+#endif
+
+
+#if INSTRSET >= 10
+typedef Vec64c VecB;
+typedef Vec64uc VecUB;
+typedef Vec32s VecS;
+typedef Vec16i VecI;
+
+// acc + the sums of the products of adjacent 16 bit pairs
+static inline VecI madd(VecI const acc, VecS const a, VecS const b) {
+#if defined(__AVX512VNNI__)
+    return _mm512_dpwssd_epi32(acc, a, b);
+#else
+    return acc + VecI(_mm512_madd_epi16(a, b));
+#endif
+}
+#else
+typedef Vec32c VecB;
+typedef Vec32uc VecUB;
+typedef Vec16s VecS;
+typedef Vec8i VecI;
+
+// acc + the sums of the products of adjacent 16 bit pairs
+static inline VecI madd(VecI const acc, VecS const a, VecS const b) {
+    return acc + VecI(_mm256_madd_epi16(a, b));
+}
+#endif
+
+template <typename V, typename T>
+static inline int64_t dot_bytes(T* a, T* b, int64_t count) {
+    constexpr int N = V::size();
+    int64_t sum = 0;
+    V va;
+    V vb;
+
+    for (int64_t chunk = 0; chunk < count; chunk += BYTES_CHUNK) {
+        int64_t end = std::min(count, chunk + BYTES_CHUNK);
+        VecI acc0 = VecI(0);
+        VecI acc1 = VecI(0);
+        int64_t i;
+        for (i = chunk; i < end - (N - 1); i += N) {
+            va.load(a + i);
+            vb.load(b + i);
+            acc0 = madd(acc0, VecS(extend_low(va)), VecS(extend_low(vb)));
+            acc1 = madd(acc1, VecS(extend_high(va)), VecS(extend_high(vb)));
+        }
+        if (i < end) {
+            va.load_partial(static_cast<int>(end - i), a + i);
+            vb.load_partial(static_cast<int>(end - i), b + i);
+            acc0 = madd(acc0, VecS(extend_low(va)), VecS(extend_low(vb)));
+            acc1 = madd(acc1, VecS(extend_high(va)), VecS(extend_high(vb)));
+        }
+        sum += horizontal_add_x(acc0) + horizontal_add_x(acc1);
+    }
+    return sum;
+}
+
+template <typename V, typename T>
+static inline int64_t squared_distance_bytes(T* a, T* b, int64_t count) {
+    constexpr int N = V::size();
+    int64_t sum = 0;
+    V va;
+    V vb;
+    VecS d0;
+    VecS d1;
+
+    for (int64_t chunk = 0; chunk < count; chunk += BYTES_CHUNK) {
+        int64_t end = std::min(count, chunk + BYTES_CHUNK);
+        VecI acc0 = VecI(0);
+        VecI acc1 = VecI(0);
+        int64_t i;
+        for (i = chunk; i < end - (N - 1); i += N) {
+            va.load(a + i);
+            vb.load(b + i);
+            d0 = VecS(extend_low(va)) - VecS(extend_low(vb));
+            d1 = VecS(extend_high(va)) - VecS(extend_high(vb));
+            acc0 = madd(acc0, d0, d0);
+            acc1 = madd(acc1, d1, d1);
+        }
+        if (i < end) {
+            va.load_partial(static_cast<int>(end - i), a + i);
+            vb.load_partial(static_cast<int>(end - i), b + i);
+            d0 = VecS(extend_low(va)) - VecS(extend_low(vb));
+            d1 = VecS(extend_high(va)) - VecS(extend_high(vb));
+            acc0 = madd(acc0, d0, d0);
+            acc1 = madd(acc1, d1, d1);
+        }
+        sum += horizontal_add_x(acc0) + horizontal_add_x(acc1);
+    }
+    return sum;
+}
+
+// a.b and b.b in one pass
+static inline void dot_norm_int8(int8_t* a, int8_t* b, int64_t count, int64_t& ab, int64_t& bb) {
+    constexpr int N = VecB::size();
+    VecB va;
+    VecB vb;
+    ab = 0;
+    bb = 0;
+
+    for (int64_t chunk = 0; chunk < count; chunk += BYTES_CHUNK) {
+        int64_t end = std::min(count, chunk + BYTES_CHUNK);
+        VecI accAB = VecI(0);
+        VecI accBB = VecI(0);
+        int64_t i;
+        for (i = chunk; i < end; i += N) {
+            if (i < end - (N - 1)) {
+                va.load(a + i);
+                vb.load(b + i);
+            } else {
+                va.load_partial(static_cast<int>(end - i), a + i);
+                vb.load_partial(static_cast<int>(end - i), b + i);
+            }
+            VecS al = extend_low(va);
+            VecS ah = extend_high(va);
+            VecS bl = extend_low(vb);
+            VecS bh = extend_high(vb);
+            accAB = madd(madd(accAB, al, bl), ah, bh);
+            accBB = madd(madd(accBB, bl, bl), bh, bh);
+        }
+        ab += horizontal_add_x(accAB);
+        bb += horizontal_add_x(accBB);
+    }
+}
+
+int64_t dot_int8(int8_t* a, int8_t* b, int64_t count) {
+    return dot_bytes<VecB>(a, b, count);
+}
+
+int64_t dot_uint8(uint8_t* a, uint8_t* b, int64_t count) {
+    return dot_bytes<VecUB>(a, b, count);
+}
+
+int64_t squared_distance_int8(int8_t* a, int8_t* b, int64_t count) {
+    return squared_distance_bytes<VecB>(a, b, count);
+}
+
+int64_t squared_distance_uint8(uint8_t* a, uint8_t* b, int64_t count) {
+    return squared_distance_bytes<VecUB>(a, b, count);
+}
+
+// The metric of the int8 query (x = queryScale * q) against each of the rows
+// of the row-major rows x dim int8 matrix base (row r: x = scales[r] * q),
+// computed from the exact integer sums, written to out[0 .. rows)
+void distances_int8(int8_t* query, float queryScale, int8_t* base, float* scales, int64_t rows, int64_t dim,
+    int metric, float* out) {
+    const double qs = queryScale;
+    const double qq = static_cast<double>(dot_int8(query, query, dim));
+    for (int64_t r = 0; r < rows; ++r) {
+        PREFETCH(base + (r + 1) * dim);
+        int64_t qr;
+        int64_t rr;
+        dot_norm_int8(query, base + r * dim, dim, qr, rr);
+        const double s = scales[r];
+        switch (metric) {
+        case METRIC_L2_SQUARED:
+            out[r] = static_cast<float>(std::max(0.0, qs * qs * qq + s * s * rr - 2.0 * qs * s * qr));
+            break;
+        case METRIC_INNER_PRODUCT:
+            out[r] = static_cast<float>(qs * s * qr);
+            break;
+        default:
+            // the (non-negative) scales cancel out
+            out[r] = (qq == 0.0 || rr == 0) ? 0.0f : static_cast<float>(qr / std::sqrt(qq * rr));
+            break;
+        }
+    }
+}
+
+// The low bytes of the 16 float lanes clamped to [lo, hi] and rounded
+static inline Vec16c to_bytes(Vec16f const v, float lo, float hi) {
+    Vec16i qi = roundi(min(max(v, Vec16f(lo)), Vec16f(hi)));
+    return compress(compress_saturated(qi));
+}
+
+template <typename T>
+static inline void quantize_row(float* x, int64_t dim, float inv, float offset, float lo, float hi, T* q) {
+    Vec16f vx;
+    Vec16f vInv = Vec16f(inv);
+    Vec16f vOffset = Vec16f(offset);
+
+    int64_t i;
+    for (i = 0; i < dim - (STEP_16 - 1); i += STEP_16) {
+        vx.load(x + i);
+        to_bytes((vx - vOffset) * vInv, lo, hi).store(q + i);
+    }
+    if (i < dim) {
+        int rest = static_cast<int>(dim - i);
+        vx.load_partial(rest, x + i);
+        to_bytes((vx - vOffset) * vInv, lo, hi).store_partial(rest, q + i);
+    }
+}
+
+template <typename VB, typename T>
+static inline void dequantize_row(T* q, int64_t dim, float scale, float offset, float* x) {
+    VB vq;
+    Vec16f vScale = Vec16f(scale);
+    Vec16f vOffset = Vec16f(offset);
+
+    int64_t i;
+    for (i = 0; i < dim - (STEP_16 - 1); i += STEP_16) {
+        vq.load(q + i);
+        mul_add(to_float(Vec16i(extend(extend(vq)))), vScale, vOffset).store(x + i);
+    }
+    if (i < dim) {
+        int rest = static_cast<int>(dim - i);
+        vq.load_partial(rest, q + i);
+        mul_add(to_float(Vec16i(extend(extend(vq)))), vScale, vOffset).store_partial(rest, x + i);
+    }
+}
+
+// min and max of x[0 .. dim) (0 for dim == 0)
+static inline void min_max(float* x, int64_t dim, float& lo, float& hi) {
+    if (dim == 0) {
+        lo = 0.0f;
+        hi = 0.0f;
+        return;
+    }
+    Vec16f vmin = Vec16f(std::numeric_limits<float>::infinity());
+    Vec16f vmax = Vec16f(-std::numeric_limits<float>::infinity());
+    Vec16f vx;
+
+    int64_t i;
+    for (i = 0; i < dim - (STEP_16 - 1); i += STEP_16) {
+        vx.load(x + i);
+        vmin = min(vmin, vx);
+        vmax = max(vmax, vx);
+    }
+    lo = horizontal_min(vmin);
+    hi = horizontal_max(vmax);
+    for (; i < dim; ++i) {
+        lo = std::min(lo, x[i]);
+        hi = std::max(hi, x[i]);
+    }
+}
+
+void quantize_int8(float* x, int64_t rows, int64_t dim, int8_t* q, float* scales) {
+    for (int64_t r = 0; r < rows; ++r) {
+        float lo;
+        float hi;
+        min_max(x + r * dim, dim, lo, hi);
+        float m = std::max(std::abs(lo), std::abs(hi));
+        scales[r] = m / 127.0f;
+        quantize_row(x + r * dim, dim, m > 0.0f ? 127.0f / m : 0.0f, 0.0f, -127.0f, 127.0f, q + r * dim);
+    }
+}
+
+void quantize_uint8(float* x, int64_t rows, int64_t dim, uint8_t* q, float* scales, float* offsets) {
+    for (int64_t r = 0; r < rows; ++r) {
+        float lo;
+        float hi;
+        min_max(x + r * dim, dim, lo, hi);
+        float range = hi - lo;
+        scales[r] = range / 255.0f;
+        offsets[r] = lo;
+        quantize_row(x + r * dim, dim, range > 0.0f ? 255.0f / range : 0.0f, lo, 0.0f, 255.0f, q + r * dim);
+    }
+}
+
+void dequantize_int8(int8_t* q, float* scales, int64_t rows, int64_t dim, float* x) {
+    for (int64_t r = 0; r < rows; ++r) {
+        dequantize_row<Vec16c>(q + r * dim, dim, scales[r], 0.0f, x + r * dim);
+    }
+}
+
+void dequantize_uint8(uint8_t* q, float* scales, float* offsets, int64_t rows, int64_t dim, float* x) {
+    for (int64_t r = 0; r < rows; ++r) {
+        dequantize_row<Vec16uc>(q + r * dim, dim, scales[r], offsets[r], x + r * dim);
+    }
+}
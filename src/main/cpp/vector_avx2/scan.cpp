@@ -0,0 +1,505 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>         // std::min, std::max
+#include <utility>           // std::index_sequence
+#include <vector>            // std::vector
+#include <jni.h>
+
+#ifndef VECTORIZE_INCLUDED_
+#include "vectorize.h"
+#endif /* VECTORIZE_INCLUDED_ */
+
+#ifndef PARALLEL_INCLUDED_
+#include "Parallel.h"
+#endif /* PARALLEL_INCLUDED_ */
+
+#ifndef DOUBLEARRAY_INCLUDED_
+#include "DoubleArray.h"
+#endif /* DOUBLEARRAY_INCLUDED_ */
+
+#ifndef FLOATARRAY_INCLUDED_
+#include "FloatArray.h"
+#endif /* FLOATARRAY_INCLUDED_ */
+
+#ifndef INTARRAY_INCLUDED_
+#include "IntArray.h"
+#endif /* INTARRAY_INCLUDED_ */
+
+#ifndef LONGARRAY_INCLUDED_
+#include "LongArray.h"
+#endif /* LONGARRAY_INCLUDED_ */
+
+#ifndef JEXCEPTION_INCLUDED_
+#include "JException.h"
+#endif /* JEXCEPTION_INCLUDED_ */
+
+#ifndef JEXCEPTIONUTILS_INCLUDED_
+#include "JExceptionUtils.h"
+#endif /* JEXCEPTIONUTILS_INCLUDED_ */
+
+
+// Inclusive / exclusive prefix sums and cumulative products. Each vector is
+// scanned in registers in log2(L) steps (add the vector shifted up by 1, 2,
+// 4, ... lanes, the shifts are VCL blends) and combined with the running
+// total of the preceding vectors, broadcast from the last lane. Note that
+// the floating-point results differ from a sequential loop in the rounding.
+
+// elements per chunk of the scan
+constexpr int64_t SCAN_CHUNK = 16 * 1024;
+// elements per thread (at least)
+constexpr int64_t SCAN_MIN_WORK = 1 << 21;
+
+
+void prefix_sum_double(double* in, double* out, int64_t count, bool exclusive);
+void prefix_sum_float(float* in, float* out, int64_t count, bool exclusive);
+void prefix_sum_int(int32_t* in, int32_t* out, int64_t count, bool exclusive);
+void prefix_sum_long(int64_t* in, int64_t* out, int64_t count, bool exclusive);
+void cumulative_product_double(double* in, double* out, int64_t count);
+void cumulative_product_float(float* in, float* out, int64_t count);
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    /*
+     * Class:     net_cramer_simd_Scan
+     * Method:    prefix_sum_double_n
+     * Signature: ([D[DIZZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Scan_prefix_1sum_1double_1n
+    (JNIEnv* env, jclass, jdoubleArray x, jdoubleArray y, jint count, jboolean exclusive, jboolean useCrit) {
+        if (count == 0 || x == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "prefix_sum_double - negative count argument:", count);
+            return;
+        }
+        try {
+            DoubleArray xx = DoubleArray(env, x, count, useCrit, y != nullptr);
+            if (y == nullptr) {
+                prefix_sum_double(xx.ptr(), xx.ptr(), count, exclusive);
+            } else {
+                DoubleArray yy = DoubleArray(env, y, count, useCrit);
+                prefix_sum_double(xx.ptr(), yy.ptr(), count, exclusive);
+            }
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "prefix_sum_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "prefix_sum_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_Scan
+     * Method:    prefix_sum_float_n
+     * Signature: ([F[FIZZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Scan_prefix_1sum_1float_1n
+    (JNIEnv* env, jclass, jfloatArray x, jfloatArray y, jint count, jboolean exclusive, jboolean useCrit) {
+        if (count == 0 || x == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "prefix_sum_float - negative count argument:", count);
+            return;
+        }
+        try {
+            FloatArray xx = FloatArray(env, x, count, useCrit, y != nullptr);
+            if (y == nullptr) {
+                prefix_sum_float(xx.ptr(), xx.ptr(), count, exclusive);
+            } else {
+                FloatArray yy = FloatArray(env, y, count, useCrit);
+                prefix_sum_float(xx.ptr(), yy.ptr(), count, exclusive);
+            }
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "prefix_sum_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "prefix_sum_float: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_Scan
+     * Method:    prefix_sum_int_n
+     * Signature: ([I[IIZZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Scan_prefix_1sum_1int_1n
+    (JNIEnv* env, jclass, jintArray x, jintArray y, jint count, jboolean exclusive, jboolean useCrit) {
+        if (count == 0 || x == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "prefix_sum_int - negative count argument:", count);
+            return;
+        }
+        try {
+            IntArray xx = IntArray(env, x, count, useCrit, y != nullptr);
+            if (y == nullptr) {
+                prefix_sum_int(xx.ptr(), xx.ptr(), count, exclusive);
+            } else {
+                IntArray yy = IntArray(env, y, count, useCrit);
+                prefix_sum_int(xx.ptr(), yy.ptr(), count, exclusive);
+            }
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "prefix_sum_int", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "prefix_sum_int: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_Scan
+     * Method:    prefix_sum_long_n
+     * Signature: ([J[JIZZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Scan_prefix_1sum_1long_1n
+    (JNIEnv* env, jclass, jlongArray x, jlongArray y, jint count, jboolean exclusive, jboolean useCrit) {
+        if (count == 0 || x == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "prefix_sum_long - negative count argument:", count);
+            return;
+        }
+        try {
+            LongArray xx = LongArray(env, x, count, useCrit, y != nullptr);
+            if (y == nullptr) {
+                prefix_sum_long(reinterpret_cast<int64_t*>(xx.ptr()), reinterpret_cast<int64_t*>(xx.ptr()), count, exclusive);
+            } else {
+                LongArray yy = LongArray(env, y, count, useCrit);
+                prefix_sum_long(reinterpret_cast<int64_t*>(xx.ptr()), reinterpret_cast<int64_t*>(yy.ptr()), count, exclusive);
+            }
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "prefix_sum_long", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "prefix_sum_long: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_Scan
+     * Method:    cumulative_product_double_n
+     * Signature: ([D[DIZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Scan_cumulative_1product_1double_1n
+    (JNIEnv* env, jclass, jdoubleArray x, jdoubleArray y, jint count, jboolean useCrit) {
+        if (count == 0 || x == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "cumulative_product_double - negative count argument:", count);
+            return;
+        }
+        try {
+            DoubleArray xx = DoubleArray(env, x, count, useCrit, y != nullptr);
+            if (y == nullptr) {
+                cumulative_product_double(xx.ptr(), xx.ptr(), count);
+            } else {
+                DoubleArray yy = DoubleArray(env, y, count, useCrit);
+                cumulative_product_double(xx.ptr(), yy.ptr(), count);
+            }
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "cumulative_product_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "cumulative_product_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_Scan
+     * Method:    cumulative_product_float_n
+     * Signature: ([F[FIZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Scan_cumulative_1product_1float_1n
+    (JNIEnv* env, jclass, jfloatArray x, jfloatArray y, jint count, jboolean useCrit) {
+        if (count == 0 || x == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "cumulative_product_float - negative count argument:", count);
+            return;
+        }
+        try {
+            FloatArray xx = FloatArray(env, x, count, useCrit, y != nullptr);
+            if (y == nullptr) {
+                cumulative_product_float(xx.ptr(), xx.ptr(), count);
+            } else {
+                FloatArray yy = FloatArray(env, y, count, useCrit);
+                cumulative_product_float(xx.ptr(), yy.ptr(), count);
+            }
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "cumulative_product_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "cumulative_product_float: caught unknown exception");
+        }
+    }
+#ifdef __cplusplus
+}
+#endif
+
+
+#if INSTRSET >= 10
+typedef Vec8d ScanVecD;
+typedef Vec16f ScanVecF;
+typedef Vec16i ScanVecI;
+typedef Vec8q ScanVecL;
+#else
+typedef Vec4d ScanVecD;
+typedef Vec8f ScanVecF;
+typedef Vec8i ScanVecI;
+typedef Vec4q ScanVecL;
+#endif
+
+template <typename T>
+struct ScanVec;
+
+template <>
+struct ScanVec<double> {
+    typedef ScanVecD V;
+};
+
+template <>
+struct ScanVec<float> {
+    typedef ScanVecF V;
+};
+
+template <>
+struct ScanVec<int32_t> {
+    typedef ScanVecI V;
+};
+
+template <>
+struct ScanVec<int64_t> {
+    typedef ScanVecL V;
+};
+
+struct ScanAdd {
+    template <typename T>
+    static inline T identity() {
+        return T(0);
+    }
+
+    template <typename V>
+    static inline V apply(V const a, V const b) {
+        return a + b;
+    }
+
+    // the integer sums wrap around as in Java (and as the vector lanes do)
+    static inline int32_t apply(int32_t a, int32_t b) {
+        return static_cast<int32_t>(static_cast<uint32_t>(a) + static_cast<uint32_t>(b));
+    }
+
+    static inline int64_t apply(int64_t a, int64_t b) {
+        return static_cast<int64_t>(static_cast<uint64_t>(a) + static_cast<uint64_t>(b));
+    }
+};
+
+struct ScanMul {
+    template <typename T>
+    static inline T identity() {
+        return T(1);
+    }
+
+    template <typename V>
+    static inline V apply(V const a, V const b) {
+        return a * b;
+    }
+};
+
+template <int... I>
+static inline Vec4d blend(Vec4d const a, Vec4d const b) {
+    return blend4<I...>(a, b);
+}
+
+template <int... I>
+static inline Vec8d blend(Vec8d const a, Vec8d const b) {
+    return blend8<I...>(a, b);
+}
+
+template <int... I>
+static inline Vec8f blend(Vec8f const a, Vec8f const b) {
+    return blend8<I...>(a, b);
+}
+
+template <int... I>
+static inline Vec16f blend(Vec16f const a, Vec16f const b) {
+    return blend16<I...>(a, b);
+}
+
+template <int... I>
+static inline Vec8i blend(Vec8i const a, Vec8i const b) {
+    return blend8<I...>(a, b);
+}
+
+template <int... I>
+static inline Vec16i blend(Vec16i const a, Vec16i const b) {
+    return blend16<I...>(a, b);
+}
+
+template <int... I>
+static inline Vec4q blend(Vec4q const a, Vec4q const b) {
+    return blend4<I...>(a, b);
+}
+
+template <int... I>
+static inline Vec8q blend(Vec8q const a, Vec8q const b) {
+    return blend8<I...>(a, b);
+}
+
+// lane i <- v[i - K] for i >= K, fill[i] otherwise
+template <int K, typename V, size_t... I>
+static inline V shift_up(V const v, V const fill, std::index_sequence<I...>) {
+    return blend<(int(I) < K ? int(I) + V::size() : int(I) - K)...>(v, fill);
+}
+
+template <int K, typename V>
+static inline V shift_up(V const v, V const fill) {
+    return shift_up<K>(v, fill, std::make_index_sequence<V::size()>());
+}
+
+// all lanes <- v[L - 1]
+template <typename V, size_t... I>
+static inline V broadcast_last(V const v, std::index_sequence<I...>) {
+    return blend<(int(I) * 0 + V::size() - 1)...>(v, v);
+}
+
+template <typename V>
+static inline V broadcast_last(V const v) {
+    return broadcast_last(v, std::make_index_sequence<V::size()>());
+}
+
+// in-register inclusive scan in log2(L) shift-and-combine steps
+template <typename Op, int K = 1, typename V>
+static inline V scan_lanes(V v, V const identity) {
+    if constexpr (K < V::size()) {
+        v = Op::apply(v, shift_up<K>(v, identity));
+        return scan_lanes<Op, 2 * K>(v, identity);
+    } else {
+        return v;
+    }
+}
+
+// Scans in[0 .. n) relative to the start of the range and writes
+// offset op (inclusive or exclusive local scan) to out[0 .. n) if
+// STORE. Returns the local total (in == out is allowed).
+template <typename Op, bool STORE, typename T>
+static T scan_chunk(T* in, T* out, int64_t n, T offset, bool exclusive) {
+    typedef typename ScanVec<T>::V V;
+    constexpr int L = V::size();
+    const V identity = V(Op::template identity<T>());
+    const V off = V(offset);
+    V run = identity;
+    int64_t i;
+    for (i = 0; i <= n - L; i += L) {
+        V p = scan_lanes<Op>(V().load(in + i), identity);
+        V incl = Op::apply(run, p);
+        if (STORE) {
+            V local = exclusive ? Op::apply(run, shift_up<1>(p, identity)) : incl;
+            Op::apply(local, off).store(out + i);
+        }
+        run = broadcast_last(incl);
+    }
+    if (i < n) {
+        int rest = static_cast<int>(n - i);
+        V p = scan_lanes<Op>(V().load_partial(rest, in + i), identity);
+        V incl = Op::apply(run, p);
+        if (STORE) {
+            V local = exclusive ? Op::apply(run, shift_up<1>(p, identity)) : incl;
+            Op::apply(local, off).store_partial(rest, out + i);
+        }
+        return incl[rest - 1];
+    }
+    return run[0];
+}
+
+// The scan is computed per chunk of SCAN_CHUNK elements, relative to the
+// chunk start, and the result is combined with the total of all preceding
+// chunks (which are combined in order). A large input is scanned in two
+// passes: the chunk totals first, in parallel, and then the chunks with
+// their offsets, in parallel again. Since a chunk's total is computed the
+// same way in both cases the results don't depend on the number of threads.
+template <typename Op, typename T>
+static void scan(T* in, T* out, int64_t count, bool exclusive) {
+    const int64_t chunks = (count + SCAN_CHUNK - 1) / SCAN_CHUNK;
+    const int64_t grain = std::max(int64_t(1), SCAN_MIN_WORK / SCAN_CHUNK);
+    if (parallel_parts(chunks, grain) == 1) {
+        T offset = Op::template identity<T>();
+        for (int64_t c = 0; c < chunks; ++c) {
+            const int64_t begin = c * SCAN_CHUNK;
+            const int64_t n = std::min(SCAN_CHUNK, count - begin);
+            T total = scan_chunk<Op, true>(in + begin, out + begin, n, offset, exclusive);
+            offset = Op::apply(offset, total);
+        }
+        return;
+    }
+    std::vector<T> offsets(chunks);
+    parallel_for(chunks, grain, [&](int64_t begin, int64_t end, int) {
+        for (int64_t c = begin; c < end; ++c) {
+            const int64_t n = std::min(SCAN_CHUNK, count - c * SCAN_CHUNK);
+            offsets[c] = scan_chunk<Op, false>(in + c * SCAN_CHUNK, static_cast<T*>(nullptr), n, T(0), false);
+        }
+    });
+    T offset = Op::template identity<T>();
+    for (int64_t c = 0; c < chunks; ++c) {
+        T total = offsets[c];
+        offsets[c] = offset;
+        offset = Op::apply(offset, total);
+    }
+    parallel_for(chunks, grain, [&](int64_t begin, int64_t end, int) {
+        for (int64_t c = begin; c < end; ++c) {
+            const int64_t n = std::min(SCAN_CHUNK, count - c * SCAN_CHUNK);
+            scan_chunk<Op, true>(in + c * SCAN_CHUNK, out + c * SCAN_CHUNK, n, offsets[c], exclusive);
+        }
+    });
+}
+
+void prefix_sum_double(double* in, double* out, int64_t count, bool exclusive) {
+    scan<ScanAdd>(in, out, count, exclusive);
+}
+
+void prefix_sum_float(float* in, float* out, int64_t count, bool exclusive) {
+    scan<ScanAdd>(in, out, count, exclusive);
+}
+
+void prefix_sum_int(int32_t* in, int32_t* out, int64_t count, bool exclusive) {
+    scan<ScanAdd>(in, out, count, exclusive);
+}
+
+void prefix_sum_long(int64_t* in, int64_t* out, int64_t count, bool exclusive) {
+    scan<ScanAdd>(in, out, count, exclusive);
+}
+
+void cumulative_product_double(double* in, double* out, int64_t count) {
+    scan<ScanMul>(in, out, count, false);
+}
+
+void cumulative_product_float(float* in, float* out, int64_t count) {
+    scan<ScanMul>(in, out, count, false);
+}
@@ -0,0 +1,378 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>             // std::log, std::exp
+#include <limits>            // std::numeric_limits
+#include <algorithm>         // std::max
+#include <jni.h>
+
+#ifndef VECTORIZE_INCLUDED_
+#include "vectorize.h"
+#endif /* VECTORIZE_INCLUDED_ */
+
+#include "vcl/vectormath_exp.h"
+
+#ifndef DOUBLEARRAY_INCLUDED_
+#include "DoubleArray.h"
+#endif /* DOUBLEARRAY_INCLUDED_ */
+
+#ifndef FLOATARRAY_INCLUDED_
+#include "FloatArray.h"
+#endif /* FLOATARRAY_INCLUDED_ */
+
+#ifndef JEXCEPTION_INCLUDED_
+#include "JException.h"
+#endif /* JEXCEPTION_INCLUDED_ */
+
+#ifndef JEXCEPTIONUTILS_INCLUDED_
+#include "JExceptionUtils.h"
+#endif /* JEXCEPTIONUTILS_INCLUDED_ */
+
+
+// Softmax and log-sum-exp over rows of a row-major (rows x cols) matrix.
+// log-sum-exp reads each row twice: one pass for the maximum and one fused
+// pass that computes exp(x - max) and accumulates the sum. softmax stores the
+// exponentials in that second pass and needs a third one to normalize them.
+
+
+void softmax_rows_double(double* x, double* y, int64_t rows, int64_t cols);
+void softmax_rows_float(float* x, float* y, int64_t rows, int64_t cols);
+double logsumexp_double(double* x, int64_t count);
+float logsumexp_float(float* x, int64_t count);
+
+
+static bool checkShape(JNIEnv* env, const char* method, jint rows, jint cols) {
+    if (rows < 0 || cols < 0) {
+        throwJavaRuntimeException(env, "%s - negative dimension argument: rows = %d, cols = %d", method, rows, cols);
+        return false;
+    }
+    if (static_cast<int64_t>(rows) * cols > INT32_MAX) {
+        throwJavaRuntimeException(env, "%s - rows * cols too large: rows = %d, cols = %d", method, rows, cols);
+        return false;
+    }
+    return true;
+}
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    /*
+     * Class:     net_cramer_simd_VectorMath
+     * Method:    softmax_double_n
+     * Signature: ([D[DIIZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_VectorMath_softmax_1double_1n
+    (JNIEnv* env, jclass, jdoubleArray x, jdoubleArray y, jint rows, jint cols, jboolean useCrit) {
+        if (!checkShape(env, "softmax_double", rows, cols)) {
+            return;
+        }
+        if (rows == 0 || cols == 0 || x == nullptr) {
+            return;
+        }
+        jint count = rows * cols;
+        try {
+            DoubleArray xx = DoubleArray(env, x, count, useCrit, y != nullptr);
+            if (y == nullptr) {
+                softmax_rows_double(xx.ptr(), xx.ptr(), rows, cols);
+            } else {
+                DoubleArray yy = DoubleArray(env, y, count, useCrit);
+                softmax_rows_double(xx.ptr(), yy.ptr(), rows, cols);
+            }
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "softmax_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "softmax_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_VectorMath
+     * Method:    softmax_float_n
+     * Signature: ([F[FIIZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_VectorMath_softmax_1float_1n
+    (JNIEnv* env, jclass, jfloatArray x, jfloatArray y, jint rows, jint cols, jboolean useCrit) {
+        if (!checkShape(env, "softmax_float", rows, cols)) {
+            return;
+        }
+        if (rows == 0 || cols == 0 || x == nullptr) {
+            return;
+        }
+        jint count = rows * cols;
+        try {
+            FloatArray xx = FloatArray(env, x, count, useCrit, y != nullptr);
+            if (y == nullptr) {
+                softmax_rows_float(xx.ptr(), xx.ptr(), rows, cols);
+            } else {
+                FloatArray yy = FloatArray(env, y, count, useCrit);
+                softmax_rows_float(xx.ptr(), yy.ptr(), rows, cols);
+            }
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "softmax_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "softmax_float: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_VectorMath
+     * Method:    logsumexp_double_n
+     * Signature: ([DIZ)D
+     */
+    JNIEXPORT jdouble JNICALL Java_net_cramer_simd_VectorMath_logsumexp_1double_1n
+    (JNIEnv* env, jclass, jdoubleArray x, jint count, jboolean useCrit) {
+        if (count == 0 || x == nullptr) {
+            return -std::numeric_limits<double>::infinity();
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "logsumexp_double - negative count argument:", count);
+            return NOT_REACHED_D;
+        }
+        try {
+            DoubleArray xx = DoubleArray(env, x, count, useCrit, true);
+            return logsumexp_double(xx.ptr(), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "logsumexp_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "logsumexp_double: caught unknown exception");
+        }
+        return NOT_REACHED_D;
+    }
+
+    /*
+     * Class:     net_cramer_simd_VectorMath
+     * Method:    logsumexp_float_n
+     * Signature: ([FIZ)F
+     */
+    JNIEXPORT jfloat JNICALL Java_net_cramer_simd_VectorMath_logsumexp_1float_1n
+    (JNIEnv* env, jclass, jfloatArray x, jint count, jboolean useCrit) {
+        if (count == 0 || x == nullptr) {
+            return -std::numeric_limits<float>::infinity();
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "logsumexp_float - negative count argument:", count);
+            return NOT_REACHED_F;
+        }
+        try {
+            FloatArray xx = FloatArray(env, x, count, useCrit, true);
+            return logsumexp_float(xx.ptr(), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "logsumexp_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "logsumexp_float: caught unknown exception");
+        }
+        return NOT_REACHED_F;
+    }
+
+    /*
+     * Class:     net_cramer_simd_VectorMath
+     * Method:    logsumexp_rows_double_n
+     * Signature: ([D[DIIZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_VectorMath_logsumexp_1rows_1double_1n
+    (JNIEnv* env, jclass, jdoubleArray x, jdoubleArray lse, jint rows, jint cols, jboolean useCrit) {
+        if (!checkShape(env, "logsumexp_rows_double", rows, cols)) {
+            return;
+        }
+        if (rows == 0 || x == nullptr || lse == nullptr) {
+            return;
+        }
+        try {
+            DoubleArray xx = DoubleArray(env, x, rows * cols, useCrit, true);
+            DoubleArray ll = DoubleArray(env, lse, rows, useCrit);
+            double* px = xx.ptr();
+            double* pl = ll.ptr();
+            for (jint row = 0; row < rows; ++row) {
+                pl[row] = logsumexp_double(px + static_cast<int64_t>(row) * cols, cols);
+            }
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "logsumexp_rows_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "logsumexp_rows_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_VectorMath
+     * Method:    logsumexp_rows_float_n
+     * Signature: ([F[FIIZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_VectorMath_logsumexp_1rows_1float_1n
+    (JNIEnv* env, jclass, jfloatArray x, jfloatArray lse, jint rows, jint cols, jboolean useCrit) {
+        if (!checkShape(env, "logsumexp_rows_float", rows, cols)) {
+            return;
+        }
+        if (rows == 0 || x == nullptr || lse == nullptr) {
+            return;
+        }
+        try {
+            FloatArray xx = FloatArray(env, x, rows * cols, useCrit, true);
+            FloatArray ll = FloatArray(env, lse, rows, useCrit);
+            float* px = xx.ptr();
+            float* pl = ll.ptr();
+            for (jint row = 0; row < rows; ++row) {
+                pl[row] = logsumexp_float(px + static_cast<int64_t>(row) * cols, cols);
+            }
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "logsumexp_rows_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "logsumexp_rows_float: caught unknown exception");
+        }
+    }
+#ifdef __cplusplus
+}
+#endif
+
+
+template <typename V, typename T>
+static inline T max_of(T* x, int64_t count) {
+    constexpr int N = V::size();
+    V vmax = V(-std::numeric_limits<T>::infinity());
+    V vx;
+
+    int64_t i;
+    for (i = 0; i < count - (N - 1); i += N) {
+        PREFETCH(x + i + 63 * N);
+        vx.load(x + i);
+        vmax = max(vmax, vx);
+    }
+    T m = horizontal_max(vmax);
+    for (; i < count; ++i) {
+        m = std::max(m, x[i]);
+    }
+    return m;
+}
+
+// Sum of exp(x - m). If y != nullptr the exponentials are also stored in y
+template <typename V, typename T>
+static inline T sum_exp(T* x, T* y, T m, int64_t count) {
+    constexpr int N = V::size();
+    V vm = V(m);
+    V vsum = V(T(0));
+    V vx;
+
+    int64_t i;
+    for (i = 0; i < count - (N - 1); i += N) {
+        vx.load(x + i);
+        vx = exp(vx - vm);
+        if (y != nullptr) {
+            vx.store(y + i);
+        }
+        vsum += vx;
+    }
+    if (i < count) {
+        int rest = static_cast<int>(count - i);
+        vx.load_partial(rest, x + i);
+        vx = exp(vx - vm).cutoff(rest);
+        if (y != nullptr) {
+            vx.store_partial(rest, y + i);
+        }
+        vsum += vx;
+    }
+    return horizontal_add(vsum);
+}
+
+template <typename V, typename T>
+static inline void scale(T* y, T factor, int64_t count) {
+    constexpr int N = V::size();
+    V vf = V(factor);
+    V vy;
+
+    int64_t i;
+    for (i = 0; i < count - (N - 1); i += N) {
+        vy.load(y + i);
+        (vy * vf).store(y + i);
+    }
+    if (i < count) {
+        int rest = static_cast<int>(count - i);
+        vy.load_partial(rest, y + i);
+        (vy * vf).store_partial(rest, y + i);
+    }
+}
+
+// The limit of softmax for a row whose maximum is +Infinity: the +Infinity
+// entries share the mass equally, all other entries get 0
+template <typename T>
+static inline void softmax_infinite(T* x, T* y, int64_t count) {
+    constexpr T inf = std::numeric_limits<T>::infinity();
+    int64_t k = 0;
+    for (int64_t i = 0; i < count; ++i) {
+        k += (x[i] == inf);
+    }
+    T share = T(1) / static_cast<T>(k);
+    for (int64_t i = 0; i < count; ++i) {
+        y[i] = (x[i] == inf) ? share : T(0);
+    }
+}
+
+template <typename V, typename T>
+static inline void softmax_rows(T* x, T* y, int64_t rows, int64_t cols) {
+    for (int64_t row = 0; row < rows; ++row) {
+        T* xr = x + row * cols;
+        T* yr = y + row * cols;
+        T m = max_of<V>(xr, cols);
+        if (m == -std::numeric_limits<T>::infinity()) {
+            // all entries are -Infinity, there is no meaningful distribution
+            scale<V>(yr, std::numeric_limits<T>::quiet_NaN(), cols);
+            continue;
+        }
+        if (m == std::numeric_limits<T>::infinity()) {
+            // exp(x - m) would be NaN for the +Infinity entries
+            softmax_infinite(xr, yr, cols);
+            continue;
+        }
+        T sum = sum_exp<V>(xr, yr, m, cols);
+        scale<V>(yr, T(1) / sum, cols);
+    }
+}
+
+template <typename V, typename T>
+static inline T logsumexp(T* x, int64_t count) {
+    T m = max_of<V>(x, count);
+    if (m == -std::numeric_limits<T>::infinity() || m == std::numeric_limits<T>::infinity()) {
+        return m;
+    }
+    return m + std::log(sum_exp<V>(x, static_cast<T*>(nullptr), m, count));
+}
+
+void softmax_rows_double(double* x, double* y, int64_t rows, int64_t cols) {
+    softmax_rows<Vec8d>(x, y, rows, cols);
+}
+
+void softmax_rows_float(float* x, float* y, int64_t rows, int64_t cols) {
+    softmax_rows<Vec16f>(x, y, rows, cols);
+}
+
+double logsumexp_double(double* x, int64_t count) {
+    return logsumexp<Vec8d>(x, count);
+}
+
+float logsumexp_float(float* x, int64_t count) {
+    return logsumexp<Vec16f>(x, count);
+}
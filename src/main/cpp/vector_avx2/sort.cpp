@@ -0,0 +1,1773 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>         // std::sort, std::min, std::max
+#include <cmath>             // std::cbrt, std::sqrt
+#include <limits>            // std::numeric_limits
+#include <utility>           // std::index_sequence, std::pair
+#include <vector>            // std::vector
+#include <string.h>          // memcpy
+#include <jni.h>
+
+#ifndef VECTORIZE_INCLUDED_
+#include "vectorize.h"
+#endif /* VECTORIZE_INCLUDED_ */
+
+#ifndef DOUBLEARRAY_INCLUDED_
+#include "DoubleArray.h"
+#endif /* DOUBLEARRAY_INCLUDED_ */
+
+#ifndef FLOATARRAY_INCLUDED_
+#include "FloatArray.h"
+#endif /* FLOATARRAY_INCLUDED_ */
+
+#ifndef INTARRAY_INCLUDED_
+#include "IntArray.h"
+#endif /* INTARRAY_INCLUDED_ */
+
+#ifndef LONGARRAY_INCLUDED_
+#include "LongArray.h"
+#endif /* LONGARRAY_INCLUDED_ */
+
+#ifndef DIRECTBUFFER_INCLUDED_
+#include "DirectBuffer.h"
+#endif /* DIRECTBUFFER_INCLUDED_ */
+
+#ifndef ARENA_INCLUDED_
+#include "Arena.h"
+#endif /* ARENA_INCLUDED_ */
+
+#ifndef JEXCEPTION_INCLUDED_
+#include "JException.h"
+#endif /* JEXCEPTION_INCLUDED_ */
+
+#ifndef JEXCEPTIONUTILS_INCLUDED_
+#include "JExceptionUtils.h"
+#endif /* JEXCEPTIONUTILS_INCLUDED_ */
+
+
+// Sorting and argsort of double / float / int / long arrays in the style of
+// x86-simd-sort: a quicksort whose partition step compresses each vector of
+// keys into the "smaller" and "larger" halves (vpcompress on AVX-512, a
+// permutation table on AVX2) and whose small ranges are sorted by a bitonic
+// network in SORT_SMALL_REGISTERS vector registers. Floating-point keys are
+// sorted as integers: the NaNs are moved to the end first, the remaining
+// bit patterns are mapped to signed integers of the same order (which puts
+// -0.0 in front of 0.0, as Arrays.sort does) and mapped back afterwards.
+// Argsort sorts (key, index) pairs and is not stable. The selection routines
+// (k-th element, top-k and quantiles) use the same partition step to narrow
+// the range down to the wanted ranks without sorting the rest.
+
+
+void sort_double(double* a, int64_t count);
+void sort_float(float* a, int64_t count);
+void sort_int(int32_t* a, int64_t count);
+void sort_long(int64_t* a, int64_t count);
+void argsort_double(double* a, int64_t count, int32_t* indices);
+void argsort_float(float* a, int64_t count, int32_t* indices);
+void argsort_int(int32_t* a, int64_t count, int32_t* indices);
+void argsort_long(int64_t* a, int64_t count, int32_t* indices);
+double nth_element_double(double* a, int64_t count, int64_t k);
+float nth_element_float(float* a, int64_t count, int64_t k);
+int32_t nth_element_int(int32_t* a, int64_t count, int64_t k);
+int64_t nth_element_long(int64_t* a, int64_t count, int64_t k);
+void top_k_double(double* a, int64_t count, int64_t k, double* values, int32_t* indices);
+void top_k_float(float* a, int64_t count, int64_t k, float* values, int32_t* indices);
+void top_k_int(int32_t* a, int64_t count, int64_t k, int32_t* values, int32_t* indices);
+void top_k_long(int64_t* a, int64_t count, int64_t k, int64_t* values, int32_t* indices);
+bool quantiles_double(double* a, int64_t count, double* probs, int64_t nProbs, double* out);
+bool quantiles_float(float* a, int64_t count, double* probs, int64_t nProbs, double* out);
+bool quantiles_int(int32_t* a, int64_t count, double* probs, int64_t nProbs, double* out);
+bool quantiles_long(int64_t* a, int64_t count, double* probs, int64_t nProbs, double* out);
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    /*
+     * Class:     net_cramer_simd_Sort
+     * Method:    sort_double_n
+     * Signature: ([DIZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Sort_sort_1double_1n
+    (JNIEnv* env, jclass, jdoubleArray a, jint count, jboolean useCrit) {
+        if (count == 0 || a == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "sort_double - negative count argument:", count);
+            return;
+        }
+        try {
+            DoubleArray aa = DoubleArray(env, a, count, useCrit);
+            sort_double(aa.ptr(), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "sort_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "sort_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_Sort
+     * Method:    argsort_double_n
+     * Signature: ([DI[IZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Sort_argsort_1double_1n
+    (JNIEnv* env, jclass, jdoubleArray a, jint count, jintArray indices, jboolean useCrit) {
+        if (count == 0 || a == nullptr || indices == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "argsort_double - negative count argument:", count);
+            return;
+        }
+        try {
+            DoubleArray aa = DoubleArray(env, a, count, useCrit, true);
+            IntArray ii = IntArray(env, indices, count, useCrit);
+            argsort_double(aa.ptr(), count, ii.ptr());
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "argsort_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "argsort_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_Sort
+     * Method:    sort_float_n
+     * Signature: ([FIZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Sort_sort_1float_1n
+    (JNIEnv* env, jclass, jfloatArray a, jint count, jboolean useCrit) {
+        if (count == 0 || a == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "sort_float - negative count argument:", count);
+            return;
+        }
+        try {
+            FloatArray aa = FloatArray(env, a, count, useCrit);
+            sort_float(aa.ptr(), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "sort_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "sort_float: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_Sort
+     * Method:    argsort_float_n
+     * Signature: ([FI[IZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Sort_argsort_1float_1n
+    (JNIEnv* env, jclass, jfloatArray a, jint count, jintArray indices, jboolean useCrit) {
+        if (count == 0 || a == nullptr || indices == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "argsort_float - negative count argument:", count);
+            return;
+        }
+        try {
+            FloatArray aa = FloatArray(env, a, count, useCrit, true);
+            IntArray ii = IntArray(env, indices, count, useCrit);
+            argsort_float(aa.ptr(), count, ii.ptr());
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "argsort_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "argsort_float: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_Sort
+     * Method:    sort_int_n
+     * Signature: ([IIZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Sort_sort_1int_1n
+    (JNIEnv* env, jclass, jintArray a, jint count, jboolean useCrit) {
+        if (count == 0 || a == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "sort_int - negative count argument:", count);
+            return;
+        }
+        try {
+            IntArray aa = IntArray(env, a, count, useCrit);
+            sort_int(aa.ptr(), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "sort_int", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "sort_int: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_Sort
+     * Method:    argsort_int_n
+     * Signature: ([II[IZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Sort_argsort_1int_1n
+    (JNIEnv* env, jclass, jintArray a, jint count, jintArray indices, jboolean useCrit) {
+        if (count == 0 || a == nullptr || indices == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "argsort_int - negative count argument:", count);
+            return;
+        }
+        try {
+            IntArray aa = IntArray(env, a, count, useCrit, true);
+            IntArray ii = IntArray(env, indices, count, useCrit);
+            argsort_int(aa.ptr(), count, ii.ptr());
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "argsort_int", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "argsort_int: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_Sort
+     * Method:    sort_long_n
+     * Signature: ([JIZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Sort_sort_1long_1n
+    (JNIEnv* env, jclass, jlongArray a, jint count, jboolean useCrit) {
+        if (count == 0 || a == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "sort_long - negative count argument:", count);
+            return;
+        }
+        try {
+            LongArray aa = LongArray(env, a, count, useCrit);
+            sort_long(reinterpret_cast<int64_t*>(aa.ptr()), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "sort_long", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "sort_long: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_Sort
+     * Method:    argsort_long_n
+     * Signature: ([JI[IZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Sort_argsort_1long_1n
+    (JNIEnv* env, jclass, jlongArray a, jint count, jintArray indices, jboolean useCrit) {
+        if (count == 0 || a == nullptr || indices == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "argsort_long - negative count argument:", count);
+            return;
+        }
+        try {
+            LongArray aa = LongArray(env, a, count, useCrit, true);
+            IntArray ii = IntArray(env, indices, count, useCrit);
+            argsort_long(reinterpret_cast<int64_t*>(aa.ptr()), count, ii.ptr());
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "argsort_long", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "argsort_long: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_Sort
+     * Method:    sort_double_b
+     * Signature: (Ljava/nio/DoubleBuffer;I)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Sort_sort_1double_1b
+    (JNIEnv* env, jclass, jobject a, jint count) {
+        if (count == 0 || a == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "sort_double - negative count argument:", count);
+            return;
+        }
+        try {
+            DirectBuffer aa = DirectBuffer(env, a, count);
+            sort_double(aa.doublePtr(), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "sort_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "sort_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_Sort
+     * Method:    argsort_double_b
+     * Signature: (Ljava/nio/DoubleBuffer;ILjava/nio/IntBuffer;)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Sort_argsort_1double_1b
+    (JNIEnv* env, jclass, jobject a, jint count, jobject indices) {
+        if (count == 0 || a == nullptr || indices == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "argsort_double - negative count argument:", count);
+            return;
+        }
+        try {
+            DirectBuffer aa = DirectBuffer(env, a, count);
+            DirectBuffer ii = DirectBuffer(env, indices, count);
+            argsort_double(aa.doublePtr(), count, ii.intPtr());
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "argsort_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "argsort_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_Sort
+     * Method:    sort_float_b
+     * Signature: (Ljava/nio/FloatBuffer;I)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Sort_sort_1float_1b
+    (JNIEnv* env, jclass, jobject a, jint count) {
+        if (count == 0 || a == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "sort_float - negative count argument:", count);
+            return;
+        }
+        try {
+            DirectBuffer aa = DirectBuffer(env, a, count);
+            sort_float(aa.floatPtr(), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "sort_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "sort_float: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_Sort
+     * Method:    argsort_float_b
+     * Signature: (Ljava/nio/FloatBuffer;ILjava/nio/IntBuffer;)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Sort_argsort_1float_1b
+    (JNIEnv* env, jclass, jobject a, jint count, jobject indices) {
+        if (count == 0 || a == nullptr || indices == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "argsort_float - negative count argument:", count);
+            return;
+        }
+        try {
+            DirectBuffer aa = DirectBuffer(env, a, count);
+            DirectBuffer ii = DirectBuffer(env, indices, count);
+            argsort_float(aa.floatPtr(), count, ii.intPtr());
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "argsort_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "argsort_float: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_Sort
+     * Method:    sort_int_b
+     * Signature: (Ljava/nio/IntBuffer;I)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Sort_sort_1int_1b
+    (JNIEnv* env, jclass, jobject a, jint count) {
+        if (count == 0 || a == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "sort_int - negative count argument:", count);
+            return;
+        }
+        try {
+            DirectBuffer aa = DirectBuffer(env, a, count);
+            sort_int(aa.intPtr(), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "sort_int", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "sort_int: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_Sort
+     * Method:    argsort_int_b
+     * Signature: (Ljava/nio/IntBuffer;ILjava/nio/IntBuffer;)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Sort_argsort_1int_1b
+    (JNIEnv* env, jclass, jobject a, jint count, jobject indices) {
+        if (count == 0 || a == nullptr || indices == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "argsort_int - negative count argument:", count);
+            return;
+        }
+        try {
+            DirectBuffer aa = DirectBuffer(env, a, count);
+            DirectBuffer ii = DirectBuffer(env, indices, count);
+            argsort_int(aa.intPtr(), count, ii.intPtr());
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "argsort_int", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "argsort_int: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_Sort
+     * Method:    sort_long_b
+     * Signature: (Ljava/nio/LongBuffer;I)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Sort_sort_1long_1b
+    (JNIEnv* env, jclass, jobject a, jint count) {
+        if (count == 0 || a == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "sort_long - negative count argument:", count);
+            return;
+        }
+        try {
+            DirectBuffer aa = DirectBuffer(env, a, count);
+            sort_long(aa.longPtr(), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "sort_long", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "sort_long: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_Sort
+     * Method:    argsort_long_b
+     * Signature: (Ljava/nio/LongBuffer;ILjava/nio/IntBuffer;)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Sort_argsort_1long_1b
+    (JNIEnv* env, jclass, jobject a, jint count, jobject indices) {
+        if (count == 0 || a == nullptr || indices == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "argsort_long - negative count argument:", count);
+            return;
+        }
+        try {
+            DirectBuffer aa = DirectBuffer(env, a, count);
+            DirectBuffer ii = DirectBuffer(env, indices, count);
+            argsort_long(aa.longPtr(), count, ii.intPtr());
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "argsort_long", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "argsort_long: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_Selection
+     * Method:    nth_element_double_n
+     * Signature: ([DIIZ)D
+     */
+    JNIEXPORT jdouble JNICALL Java_net_cramer_simd_Selection_nth_1element_1double_1n
+    (JNIEnv* env, jclass, jdoubleArray a, jint count, jint k, jboolean useCrit) {
+        if (count == 0 || a == nullptr) {
+            return 0.0;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "nth_element_double - negative count argument:", count);
+            return NOT_REACHED_D;
+        }
+        if (k < 0 || k >= count) {
+            throwJavaRuntimeException(env, "%s - k out of range: k = %d, count = %d", "nth_element_double", k, count);
+            return NOT_REACHED_D;
+        }
+        try {
+            DoubleArray aa = DoubleArray(env, a, count, useCrit);
+            return nth_element_double(aa.ptr(), count, k);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "nth_element_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "nth_element_double: caught unknown exception");
+        }
+        return NOT_REACHED_D;
+    }
+
+    /*
+     * Class:     net_cramer_simd_Selection
+     * Method:    nth_element_float_n
+     * Signature: ([FIIZ)F
+     */
+    JNIEXPORT jfloat JNICALL Java_net_cramer_simd_Selection_nth_1element_1float_1n
+    (JNIEnv* env, jclass, jfloatArray a, jint count, jint k, jboolean useCrit) {
+        if (count == 0 || a == nullptr) {
+            return 0.0f;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "nth_element_float - negative count argument:", count);
+            return NOT_REACHED_F;
+        }
+        if (k < 0 || k >= count) {
+            throwJavaRuntimeException(env, "%s - k out of range: k = %d, count = %d", "nth_element_float", k, count);
+            return NOT_REACHED_F;
+        }
+        try {
+            FloatArray aa = FloatArray(env, a, count, useCrit);
+            return nth_element_float(aa.ptr(), count, k);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "nth_element_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "nth_element_float: caught unknown exception");
+        }
+        return NOT_REACHED_F;
+    }
+
+    /*
+     * Class:     net_cramer_simd_Selection
+     * Method:    nth_element_int_n
+     * Signature: ([IIIZ)I
+     */
+    JNIEXPORT jint JNICALL Java_net_cramer_simd_Selection_nth_1element_1int_1n
+    (JNIEnv* env, jclass, jintArray a, jint count, jint k, jboolean useCrit) {
+        if (count == 0 || a == nullptr) {
+            return 0;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "nth_element_int - negative count argument:", count);
+            return -1;
+        }
+        if (k < 0 || k >= count) {
+            throwJavaRuntimeException(env, "%s - k out of range: k = %d, count = %d", "nth_element_int", k, count);
+            return -1;
+        }
+        try {
+            IntArray aa = IntArray(env, a, count, useCrit);
+            return nth_element_int(aa.ptr(), count, k);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "nth_element_int", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "nth_element_int: caught unknown exception");
+        }
+        return -1;
+    }
+
+    /*
+     * Class:     net_cramer_simd_Selection
+     * Method:    nth_element_long_n
+     * Signature: ([JIIZ)J
+     */
+    JNIEXPORT jlong JNICALL Java_net_cramer_simd_Selection_nth_1element_1long_1n
+    (JNIEnv* env, jclass, jlongArray a, jint count, jint k, jboolean useCrit) {
+        if (count == 0 || a == nullptr) {
+            return 0L;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "nth_element_long - negative count argument:", count);
+            return -1L;
+        }
+        if (k < 0 || k >= count) {
+            throwJavaRuntimeException(env, "%s - k out of range: k = %d, count = %d", "nth_element_long", k, count);
+            return -1L;
+        }
+        try {
+            LongArray aa = LongArray(env, a, count, useCrit);
+            return nth_element_long(reinterpret_cast<int64_t*>(aa.ptr()), count, k);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "nth_element_long", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "nth_element_long: caught unknown exception");
+        }
+        return -1L;
+    }
+
+    /*
+     * Class:     net_cramer_simd_Selection
+     * Method:    top_k_double_n
+     * Signature: ([DII[D[IZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Selection_top_1k_1double_1n
+    (JNIEnv* env, jclass, jdoubleArray a, jint count, jint k, jdoubleArray values, jintArray indices, jboolean useCrit) {
+        if (count == 0 || k == 0 || a == nullptr || values == nullptr || indices == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "top_k_double - negative count argument:", count);
+            return;
+        }
+        if (k < 0 || k > count) {
+            throwJavaRuntimeException(env, "%s - k out of range: k = %d, count = %d", "top_k_double", k, count);
+            return;
+        }
+        try {
+            DoubleArray aa = DoubleArray(env, a, count, useCrit, true);
+            DoubleArray vv = DoubleArray(env, values, k, useCrit);
+            IntArray ii = IntArray(env, indices, k, useCrit);
+            top_k_double(aa.ptr(), count, k, vv.ptr(), ii.ptr());
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "top_k_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "top_k_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_Selection
+     * Method:    top_k_float_n
+     * Signature: ([FII[F[IZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Selection_top_1k_1float_1n
+    (JNIEnv* env, jclass, jfloatArray a, jint count, jint k, jfloatArray values, jintArray indices, jboolean useCrit) {
+        if (count == 0 || k == 0 || a == nullptr || values == nullptr || indices == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "top_k_float - negative count argument:", count);
+            return;
+        }
+        if (k < 0 || k > count) {
+            throwJavaRuntimeException(env, "%s - k out of range: k = %d, count = %d", "top_k_float", k, count);
+            return;
+        }
+        try {
+            FloatArray aa = FloatArray(env, a, count, useCrit, true);
+            FloatArray vv = FloatArray(env, values, k, useCrit);
+            IntArray ii = IntArray(env, indices, k, useCrit);
+            top_k_float(aa.ptr(), count, k, vv.ptr(), ii.ptr());
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "top_k_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "top_k_float: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_Selection
+     * Method:    top_k_int_n
+     * Signature: ([III[I[IZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Selection_top_1k_1int_1n
+    (JNIEnv* env, jclass, jintArray a, jint count, jint k, jintArray values, jintArray indices, jboolean useCrit) {
+        if (count == 0 || k == 0 || a == nullptr || values == nullptr || indices == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "top_k_int - negative count argument:", count);
+            return;
+        }
+        if (k < 0 || k > count) {
+            throwJavaRuntimeException(env, "%s - k out of range: k = %d, count = %d", "top_k_int", k, count);
+            return;
+        }
+        try {
+            IntArray aa = IntArray(env, a, count, useCrit, true);
+            IntArray vv = IntArray(env, values, k, useCrit);
+            IntArray ii = IntArray(env, indices, k, useCrit);
+            top_k_int(aa.ptr(), count, k, vv.ptr(), ii.ptr());
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "top_k_int", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "top_k_int: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_Selection
+     * Method:    top_k_long_n
+     * Signature: ([JII[J[IZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Selection_top_1k_1long_1n
+    (JNIEnv* env, jclass, jlongArray a, jint count, jint k, jlongArray values, jintArray indices, jboolean useCrit) {
+        if (count == 0 || k == 0 || a == nullptr || values == nullptr || indices == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "top_k_long - negative count argument:", count);
+            return;
+        }
+        if (k < 0 || k > count) {
+            throwJavaRuntimeException(env, "%s - k out of range: k = %d, count = %d", "top_k_long", k, count);
+            return;
+        }
+        try {
+            LongArray aa = LongArray(env, a, count, useCrit, true);
+            LongArray vv = LongArray(env, values, k, useCrit);
+            IntArray ii = IntArray(env, indices, k, useCrit);
+            top_k_long(reinterpret_cast<int64_t*>(aa.ptr()), count, k, reinterpret_cast<int64_t*>(vv.ptr()), ii.ptr());
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "top_k_long", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "top_k_long: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_Selection
+     * Method:    quantiles_double_n
+     * Signature: ([DI[DI[DZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Selection_quantiles_1double_1n
+    (JNIEnv* env, jclass, jdoubleArray a, jint count, jdoubleArray probs, jint nProbs, jdoubleArray out, jboolean useCrit) {
+        if (count == 0 || nProbs == 0 || a == nullptr || probs == nullptr || out == nullptr) {
+            return;
+        }
+        if (count < 0 || nProbs < 0) {
+            throwJavaRuntimeException(env, "%s - negative argument: count = %d, nProbs = %d", "quantiles_double",
+                count, nProbs);
+            return;
+        }
+        try {
+            DoubleArray aa = DoubleArray(env, a, count, useCrit, true);
+            DoubleArray pp = DoubleArray(env, probs, nProbs, useCrit, true);
+            DoubleArray oo = DoubleArray(env, out, nProbs, useCrit);
+            if (!quantiles_double(aa.ptr(), count, pp.ptr(), nProbs, oo.ptr())) {
+                throw JException("- probability not in [0, 1]");
+            }
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "quantiles_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "quantiles_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_Selection
+     * Method:    quantiles_float_n
+     * Signature: ([FI[DI[DZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Selection_quantiles_1float_1n
+    (JNIEnv* env, jclass, jfloatArray a, jint count, jdoubleArray probs, jint nProbs, jdoubleArray out, jboolean useCrit) {
+        if (count == 0 || nProbs == 0 || a == nullptr || probs == nullptr || out == nullptr) {
+            return;
+        }
+        if (count < 0 || nProbs < 0) {
+            throwJavaRuntimeException(env, "%s - negative argument: count = %d, nProbs = %d", "quantiles_float",
+                count, nProbs);
+            return;
+        }
+        try {
+            FloatArray aa = FloatArray(env, a, count, useCrit, true);
+            DoubleArray pp = DoubleArray(env, probs, nProbs, useCrit, true);
+            DoubleArray oo = DoubleArray(env, out, nProbs, useCrit);
+            if (!quantiles_float(aa.ptr(), count, pp.ptr(), nProbs, oo.ptr())) {
+                throw JException("- probability not in [0, 1]");
+            }
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "quantiles_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "quantiles_float: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_Selection
+     * Method:    quantiles_int_n
+     * Signature: ([II[DI[DZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Selection_quantiles_1int_1n
+    (JNIEnv* env, jclass, jintArray a, jint count, jdoubleArray probs, jint nProbs, jdoubleArray out, jboolean useCrit) {
+        if (count == 0 || nProbs == 0 || a == nullptr || probs == nullptr || out == nullptr) {
+            return;
+        }
+        if (count < 0 || nProbs < 0) {
+            throwJavaRuntimeException(env, "%s - negative argument: count = %d, nProbs = %d", "quantiles_int",
+                count, nProbs);
+            return;
+        }
+        try {
+            IntArray aa = IntArray(env, a, count, useCrit, true);
+            DoubleArray pp = DoubleArray(env, probs, nProbs, useCrit, true);
+            DoubleArray oo = DoubleArray(env, out, nProbs, useCrit);
+            if (!quantiles_int(aa.ptr(), count, pp.ptr(), nProbs, oo.ptr())) {
+                throw JException("- probability not in [0, 1]");
+            }
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "quantiles_int", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "quantiles_int: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_Selection
+     * Method:    quantiles_long_n
+     * Signature: ([JI[DI[DZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_Selection_quantiles_1long_1n
+    (JNIEnv* env, jclass, jlongArray a, jint count, jdoubleArray probs, jint nProbs, jdoubleArray out, jboolean useCrit) {
+        if (count == 0 || nProbs == 0 || a == nullptr || probs == nullptr || out == nullptr) {
+            return;
+        }
+        if (count < 0 || nProbs < 0) {
+            throwJavaRuntimeException(env, "%s - negative argument: count = %d, nProbs = %d", "quantiles_long",
+                count, nProbs);
+            return;
+        }
+        try {
+            LongArray aa = LongArray(env, a, count, useCrit, true);
+            DoubleArray pp = DoubleArray(env, probs, nProbs, useCrit, true);
+            DoubleArray oo = DoubleArray(env, out, nProbs, useCrit);
+            if (!quantiles_long(reinterpret_cast<int64_t*>(aa.ptr()), count, pp.ptr(), nProbs, oo.ptr())) {
+                throw JException("- probability not in [0, 1]");
+            }
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "quantiles_long", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "quantiles_long: caught unknown exception");
+        }
+    }
+#ifdef __cplusplus
+}
+#endif
+
+
+#if INSTRSET >= 10
+typedef Vec16i VecI32;
+typedef Vec8q VecI64;
+#else
+typedef Vec8i VecI32;
+typedef Vec4q VecI64;
+#endif
+
+template <typename V>
+struct Lanes;
+
+template <>
+struct Lanes<VecI32> {
+    typedef int32_t T;
+};
+
+template <>
+struct Lanes<VecI64> {
+    typedef int64_t T;
+};
+
+
+// lane i <- lane i ^ J
+template <int... I>
+static inline Vec16i perm(Vec16i const v) {
+    return permute16<I...>(v);
+}
+
+template <int... I>
+static inline Vec8i perm(Vec8i const v) {
+    return permute8<I...>(v);
+}
+
+template <int... I>
+static inline Vec8q perm(Vec8q const v) {
+    return permute8<I...>(v);
+}
+
+template <int... I>
+static inline Vec4q perm(Vec4q const v) {
+    return permute4<I...>(v);
+}
+
+template <int J, typename V, size_t... I>
+static inline V swap_lanes(V const v, std::index_sequence<I...>) {
+    return perm<int(I ^ J)...>(v);
+}
+
+template <typename V>
+static inline V swap_lanes(V const v, int j) {
+    constexpr int L = V::size();
+    switch (j) {
+    case 1:
+        return swap_lanes<1>(v, std::make_index_sequence<L>());
+    case 2:
+        return swap_lanes<2>(v, std::make_index_sequence<L>());
+    case 4:
+        if constexpr (L > 4) {
+            return swap_lanes<4>(v, std::make_index_sequence<L>());
+        }
+    default:
+        if constexpr (L > 8) {
+            return swap_lanes<8>(v, std::make_index_sequence<L>());
+        }
+    }
+    return v;
+}
+
+template <typename V>
+static inline V lane_index() {
+    typedef typename Lanes<V>::T T;
+    T idx[V::size()];
+    for (int i = 0; i < V::size(); ++i) {
+        idx[i] = T(i);
+    }
+    return V().load(idx);
+}
+
+// Bitonic sorting network over the R * L lanes of the registers k[0 .. R)
+// (R a power of 2), the payload registers p (if KV) follow their keys.
+// Lane i of the whole is sorted ascending in the stages of a given 'size'
+// iff (i & size) == 0, so the last stage sorts everything ascending.
+template <typename V, bool KV>
+static inline void bitonic_sort(V* k, V* p, int R) {
+    constexpr int L = V::size();
+    const V lane = lane_index<V>();
+    for (int size = 2; size <= R * L; size *= 2) {
+        for (int j = size / 2; j > 0; j /= 2) {
+            if (j >= L) {
+                const int jr = j / L;
+                for (int r = 0; r < R; ++r) {
+                    if ((r & jr) != 0) {
+                        continue;
+                    }
+                    const int s = r | jr;
+                    const bool descending = ((r * L) & size) != 0;
+                    if (KV) {
+                        auto swap = descending ? (k[r] < k[s]) : (k[s] < k[r]);
+                        V kr = select(swap, k[s], k[r]);
+                        V pr = select(swap, p[s], p[r]);
+                        k[s] = select(swap, k[r], k[s]);
+                        p[s] = select(swap, p[r], p[s]);
+                        k[r] = kr;
+                        p[r] = pr;
+                    } else {
+                        V lo = min(k[r], k[s]);
+                        V hi = max(k[r], k[s]);
+                        k[r] = descending ? hi : lo;
+                        k[s] = descending ? lo : hi;
+                    }
+                }
+            } else {
+                for (int r = 0; r < R; ++r) {
+                    // lane i keeps the larger one of the pair (i, i ^ j) iff
+                    // it is the upper lane of an ascending pair or the lower
+                    // lane of a descending one
+                    auto takeHi = ((lane & j) != 0) ^ (((lane + r * L) & size) != 0);
+                    V sw = swap_lanes(k[r], j);
+                    if (KV) {
+                        auto take = (takeHi & (sw > k[r])) | (~takeHi & (sw < k[r]));
+                        k[r] = select(take, sw, k[r]);
+                        p[r] = select(take, swap_lanes(p[r], j), p[r]);
+                    } else {
+                        k[r] = select(takeHi, max(k[r], sw), min(k[r], sw));
+                    }
+                }
+            }
+        }
+    }
+}
+
+#if INSTRSET < 10
+// For the AVX2 partition: the 32 bit lane permutation that moves the lanes
+// with a clear mask bit to the front and the lanes with a set bit to the back
+// (8 x 32 bit lanes, and 4 x 64 bit lanes as pairs of 32 bit lanes)
+struct PartitionPermutations {
+    int32_t lanes8[256][8];
+    int32_t lanes4[16][8];
+
+    constexpr PartitionPermutations() : lanes8(), lanes4() {
+        for (int m = 0; m < 256; ++m) {
+            int k = 0;
+            for (int i = 0; i < 8; ++i) {
+                if (((m >> i) & 1) == 0) {
+                    lanes8[m][k++] = i;
+                }
+            }
+            for (int i = 0; i < 8; ++i) {
+                if (((m >> i) & 1) != 0) {
+                    lanes8[m][k++] = i;
+                }
+            }
+        }
+        for (int m = 0; m < 16; ++m) {
+            int k = 0;
+            for (int i = 0; i < 4; ++i) {
+                if (((m >> i) & 1) == 0) {
+                    lanes4[m][k++] = 2 * i;
+                    lanes4[m][k++] = 2 * i + 1;
+                }
+            }
+            for (int i = 0; i < 4; ++i) {
+                if (((m >> i) & 1) != 0) {
+                    lanes4[m][k++] = 2 * i;
+                    lanes4[m][k++] = 2 * i + 1;
+                }
+            }
+        }
+    }
+};
+
+static constexpr PartitionPermutations PARTITION_PERMUTATIONS = PartitionPermutations();
+
+static inline Vec8i partition_permute(Vec8i const v, uint32_t right) {
+    return _mm256_permutevar8x32_epi32(v, Vec8i().load(PARTITION_PERMUTATIONS.lanes8[right]));
+}
+
+static inline Vec4q partition_permute(Vec4q const v, uint32_t right) {
+    return _mm256_permutevar8x32_epi32(v, Vec8i().load(PARTITION_PERMUTATIONS.lanes4[right]));
+}
+#endif
+
+// Writes the lanes of v with a clear bit in 'right' to dst[left ..) and the
+// ones with a set bit to dst[.. right). AVX2 stores the whole permuted vector
+// at both ends, which requires at least L free slots at each end.
+template <typename V>
+static inline void store_partitioned(V const v, uint32_t rightBits, typename Lanes<V>::T* left,
+    typename Lanes<V>::T* rightEnd) {
+    constexpr int L = V::size();
+#if INSTRSET >= 10
+    const int nRight = static_cast<int>(vml_popcnt(rightBits));
+    if constexpr (L == 16) {
+        _mm512_mask_compressstoreu_epi32(left, __mmask16(~rightBits), v);
+        _mm512_mask_compressstoreu_epi32(rightEnd - nRight, __mmask16(rightBits), v);
+    } else {
+        _mm512_mask_compressstoreu_epi64(left, __mmask8(~rightBits), v);
+        _mm512_mask_compressstoreu_epi64(rightEnd - nRight, __mmask8(rightBits), v);
+    }
+#else
+    V w = partition_permute(v, rightBits);
+    w.store(left);
+    w.store(rightEnd - L);
+#endif
+}
+
+// Moves the keys that belong to the left side (keys < pivot, or <= pivot if
+// LE) in front of the other ones and returns the index of the first key of
+// the right side. The first and the last L keys are held in registers
+// until the end so that there is always room to write at both ends.
+template <typename V, bool KV, bool LE>
+static int64_t partition(typename Lanes<V>::T* keys, typename Lanes<V>::T* vals, int64_t n,
+    typename Lanes<V>::T pivot) {
+    typedef typename Lanes<V>::T T;
+    constexpr int L = V::size();
+    auto goesRight = [pivot](T x) {
+        return LE ? (x > pivot) : (x >= pivot);
+    };
+    if (n < 2 * L) {
+        int64_t left = 0;
+        for (int64_t i = 0; i < n; ++i) {
+            if (!goesRight(keys[i])) {
+                std::swap(keys[left], keys[i]);
+                if (KV) {
+                    std::swap(vals[left], vals[i]);
+                }
+                ++left;
+            }
+        }
+        return left;
+    }
+    const V vpivot = V(pivot);
+    auto rightMask = [&vpivot](V const v) {
+        return static_cast<uint32_t>(to_bits(LE ? (v > vpivot) : (v >= vpivot)));
+    };
+    auto store = [&](V const kv, V const pv, int64_t& left, int64_t& right) {
+        uint32_t bits = rightMask(kv);
+        int nRight = static_cast<int>(vml_popcnt(bits));
+        store_partitioned(kv, bits, keys + left, keys + right);
+        if (KV) {
+            store_partitioned(pv, bits, vals + left, vals + right);
+        }
+        left += L - nRight;
+        right -= nRight;
+    };
+
+    const V firstK = V().load(keys);
+    const V lastK = V().load(keys + n - L);
+    V firstP = V(0);
+    V lastP = V(0);
+    if (KV) {
+        firstP = V().load(vals);
+        lastP = V().load(vals + n - L);
+    }
+    int64_t left = 0;
+    int64_t right = n;
+    int64_t readL = L;
+    int64_t readR = n - L;
+    while (readR - readL >= L) {
+        V kv, pv = V(0);
+        // read from the end that has less room
+        if (readL - left <= right - readR) {
+            kv = V().load(keys + readL);
+            if (KV) {
+                pv = V().load(vals + readL);
+            }
+            readL += L;
+        } else {
+            readR -= L;
+            kv = V().load(keys + readR);
+            if (KV) {
+                pv = V().load(vals + readR);
+            }
+        }
+        store(kv, pv, left, right);
+    }
+    // fewer than L unread keys remain
+    T restK[L];
+    T restP[L];
+    const int rest = static_cast<int>(readR - readL);
+    for (int i = 0; i < rest; ++i) {
+        restK[i] = keys[readL + i];
+        if (KV) {
+            restP[i] = vals[readL + i];
+        }
+    }
+    for (int i = 0; i < rest; ++i) {
+        int64_t dst = goesRight(restK[i]) ? --right : left++;
+        keys[dst] = restK[i];
+        if (KV) {
+            vals[dst] = restP[i];
+        }
+    }
+    store(firstK, firstP, left, right);
+    store(lastK, lastP, left, right);
+    return left;
+}
+
+// registers of the small sort
+constexpr int SORT_SMALL_REGISTERS = 16;
+
+// Sorts n <= SORT_SMALL_REGISTERS * L elements in registers, the unused lanes
+// are padded with the largest key
+template <typename V, bool KV>
+static inline void small_sort(typename Lanes<V>::T* keys, typename Lanes<V>::T* vals, int64_t n) {
+    typedef typename Lanes<V>::T T;
+    constexpr int L = V::size();
+    if (KV) {
+        // the pad keys could otherwise take the place of (and drop the
+        // payload of) the keys equal to them, so these go last
+        n = partition<V, KV, false>(keys, vals, n, std::numeric_limits<T>::max());
+    }
+    if (n < 2) {
+        return;
+    }
+    V k[SORT_SMALL_REGISTERS];
+    V p[SORT_SMALL_REGISTERS];
+    const int used = static_cast<int>((n + L - 1) / L);
+    int R = 1;
+    while (R < used) {
+        R *= 2;
+    }
+    const V pad = V(std::numeric_limits<T>::max());
+    const V lane = lane_index<V>();
+    for (int r = 0; r < R; ++r) {
+        int64_t rest = n - int64_t(r) * L;
+        if (rest >= L) {
+            k[r] = V().load(keys + r * L);
+            if (KV) {
+                p[r] = V().load(vals + r * L);
+            }
+        } else if (rest > 0) {
+            k[r] = select(lane < T(rest), V().load_partial(int(rest), keys + r * L), pad);
+            if (KV) {
+                p[r] = V().load_partial(int(rest), vals + r * L);
+            }
+        } else {
+            k[r] = pad;
+            if (KV) {
+                p[r] = V(0);
+            }
+        }
+    }
+    bitonic_sort<V, KV>(k, p, R);
+    for (int r = 0; r < used; ++r) {
+        int64_t rest = n - int64_t(r) * L;
+        if (rest >= L) {
+            k[r].store(keys + r * L);
+            if (KV) {
+                p[r].store(vals + r * L);
+            }
+        } else {
+            k[r].store_partial(int(rest), keys + r * L);
+            if (KV) {
+                p[r].store_partial(int(rest), vals + r * L);
+            }
+        }
+    }
+}
+
+template <typename T>
+static inline T median3(T a, T b, T c) {
+    return std::max(std::min(a, b), std::min(std::max(a, b), c));
+}
+
+template <typename T>
+static inline T choose_pivot(T* keys, int64_t n) {
+    if (n < 1024) {
+        return median3(keys[0], keys[n / 2], keys[n - 1]);
+    }
+    const int64_t s = n / 8;
+    return median3(median3(keys[0], keys[s], keys[2 * s]), median3(keys[3 * s], keys[4 * s], keys[5 * s]),
+        median3(keys[6 * s], keys[7 * s], keys[n - 1]));
+}
+
+template <typename T, bool KV>
+static void fallback_sort(T* keys, T* vals, int64_t n) {
+    if (!KV) {
+        std::sort(keys, keys + n);
+        return;
+    }
+    std::vector<std::pair<T, T>> pairs(n);
+    for (int64_t i = 0; i < n; ++i) {
+        pairs[i] = std::make_pair(keys[i], vals[i]);
+    }
+    std::sort(pairs.begin(), pairs.end());
+    for (int64_t i = 0; i < n; ++i) {
+        keys[i] = pairs[i].first;
+        vals[i] = pairs[i].second;
+    }
+}
+
+// Quicksort with the vectorized partition down to SORT_SMALL_REGISTERS
+// registers, which are sorted by the bitonic network. The recursion goes into
+// the smaller part, the depth is bounded by falling back to std::sort.
+template <typename V, bool KV>
+static void quicksort(typename Lanes<V>::T* keys, typename Lanes<V>::T* vals, int64_t n, int depth) {
+    typedef typename Lanes<V>::T T;
+    constexpr int64_t SMALL = SORT_SMALL_REGISTERS * V::size();
+    while (n > SMALL) {
+        if (depth-- == 0) {
+            fallback_sort<T, KV>(keys, vals, n);
+            return;
+        }
+        const T pivot = choose_pivot(keys, n);
+        int64_t mid = partition<V, KV, false>(keys, vals, n, pivot);
+        if (mid == 0) {
+            // the pivot is the smallest key, the keys equal to it are done
+            mid = partition<V, KV, true>(keys, vals, n, pivot);
+            keys += mid;
+            if (KV) {
+                vals += mid;
+            }
+            n -= mid;
+            continue;
+        }
+        if (mid < n - mid) {
+            quicksort<V, KV>(keys, vals, mid, depth);
+            keys += mid;
+            if (KV) {
+                vals += mid;
+            }
+            n -= mid;
+        } else {
+            quicksort<V, KV>(keys + mid, KV ? vals + mid : vals, n - mid, depth);
+            n = mid;
+        }
+    }
+    small_sort<V, KV>(keys, vals, n);
+}
+
+template <typename V, bool KV>
+static void sort_keys(typename Lanes<V>::T* keys, typename Lanes<V>::T* vals, int64_t n) {
+    int depth = 0;
+    for (int64_t m = n; m > 1; m >>= 1) {
+        depth += 2;
+    }
+    quicksort<V, KV>(keys, vals, n, depth);
+}
+
+// keys per Floyd-Rivest sample (at least)
+constexpr int64_t SELECT_SAMPLE_MIN = 4096;
+
+// Reorders keys[0 .. n) (and the payload) such that keys[k] is the key that
+// would be there if the range was sorted, the keys in front of it are not
+// larger and the keys behind it are not smaller. Large ranges are narrowed in
+// the manner of Floyd-Rivest: two pivots that bracket rank k are selected
+// from a sample of the range, so that usually only the small range between
+// them remains after two partition passes. Otherwise this is a quickselect
+// that shares the partition and the pivot choice with the quicksort.
+template <typename V, bool KV>
+static void select(typename Lanes<V>::T* keys, typename Lanes<V>::T* vals, int64_t n, int64_t k) {
+    typedef typename Lanes<V>::T T;
+    constexpr int64_t SMALL = SORT_SMALL_REGISTERS * V::size();
+    int depth = 0;
+    for (int64_t m = n; m > 1; m >>= 1) {
+        depth += 2;
+    }
+    std::vector<T> sample;
+    while (n > SMALL) {
+        if (depth-- == 0) {
+            fallback_sort<T, KV>(keys, vals, n);
+            return;
+        }
+        int64_t begin = 0;
+        int64_t end = n;
+        if (n >= 4 * SELECT_SAMPLE_MIN) {
+            // sample size ~ n^(2/3), pivots at the sample ranks k * s / n -+ sqrt(s)
+            int64_t s = std::max(SELECT_SAMPLE_MIN, static_cast<int64_t>(std::cbrt(double(n) * double(n))));
+            s = std::min(s, n / 4);
+            const int64_t stride = n / s;
+            sample.resize(s);
+            for (int64_t i = 0; i < s; ++i) {
+                sample[i] = keys[i * stride];
+            }
+            const int64_t delta = static_cast<int64_t>(std::sqrt(double(s)));
+            const int64_t r = static_cast<int64_t>(double(k) * double(s) / double(n));
+            const int64_t rLo = std::max(int64_t(0), r - delta);
+            const int64_t rHi = std::min(s - 1, r + delta);
+            select<V, false>(sample.data(), nullptr, s, rLo);
+            const T lo = sample[rLo];
+            select<V, false>(sample.data() + rLo, nullptr, s - rLo, rHi - rLo);
+            const T hi = sample[rHi];
+            // [< lo | lo <= x <= hi | > hi]
+            int64_t mid = partition<V, KV, false>(keys, vals, n, lo);
+            if (k < mid) {
+                end = mid;
+            } else {
+                begin = mid;
+                mid += partition<V, KV, true>(keys + mid, KV ? vals + mid : vals, n - mid, hi);
+                if (k < mid) {
+                    end = mid;
+                    if (lo == hi) {
+                        // all keys in [begin, end) are equal
+                        return;
+                    }
+                } else {
+                    begin = mid;
+                }
+            }
+        }
+        if (end - begin == n) {
+            // no progress from the sample (or too small for it)
+            const T pivot = choose_pivot(keys, n);
+            int64_t mid = partition<V, KV, false>(keys, vals, n, pivot);
+            if (mid == 0) {
+                mid = partition<V, KV, true>(keys, vals, n, pivot);
+                if (k < mid) {
+                    // the keys equal to the pivot
+                    return;
+                }
+            }
+            if (k < mid) {
+                end = mid;
+            } else {
+                begin = mid;
+            }
+        }
+        keys += begin;
+        if (KV) {
+            vals += begin;
+        }
+        k -= begin;
+        n = end - begin;
+    }
+    small_sort<V, KV>(keys, vals, n);
+}
+
+// Selects the (sorted) ranks[r0 .. r1) of keys[0 .. n) by selecting the
+// middle one and recursing into both sides
+template <typename V>
+static void multi_select(typename Lanes<V>::T* keys, int64_t n, const int64_t* ranks, int64_t r0, int64_t r1,
+    int64_t offset) {
+    if (r0 >= r1) {
+        return;
+    }
+    const int64_t rm = (r0 + r1) / 2;
+    const int64_t k = ranks[rm] - offset;
+    select<V, false>(keys, nullptr, n, k);
+    multi_select<V>(keys, k, ranks, r0, rm, offset);
+    multi_select<V>(keys + k + 1, n - k - 1, ranks, rm + 1, r1, offset + k + 1);
+}
+
+// Moves the NaNs to the end (keeping their bit patterns) and returns the
+// number of the other keys
+template <typename T>
+static int64_t move_nans_last(T* a, int64_t count) {
+    int64_t m = 0;
+    for (int64_t i = 0; i < count; ++i) {
+        if (a[i] == a[i]) {
+            std::swap(a[m++], a[i]);
+        }
+    }
+    return m;
+}
+
+// Maps the bit patterns of non-NaN floating-point keys to signed integers of
+// the same order and back (the mapping is its own inverse): the magnitude
+// bits of negative keys get flipped
+template <typename V>
+static void flip_negative(typename Lanes<V>::T* a, int64_t count) {
+    typedef typename Lanes<V>::T T;
+    constexpr int L = V::size();
+    constexpr int SHIFT = 8 * sizeof(T) - 1;
+    const V magnitude = V(std::numeric_limits<T>::max());
+    int64_t i;
+    for (i = 0; i <= count - L; i += L) {
+        V v = V().load(a + i);
+        (v ^ ((v >> SHIFT) & magnitude)).store(a + i);
+    }
+    if (i < count) {
+        int n = static_cast<int>(count - i);
+        V v = V().load_partial(n, a + i);
+        (v ^ ((v >> SHIFT) & magnitude)).store_partial(n, a + i);
+    }
+}
+
+void sort_double(double* a, int64_t count) {
+    int64_t m = move_nans_last(a, count);
+    int64_t* keys = reinterpret_cast<int64_t*>(a);
+    flip_negative<VecI64>(keys, m);
+    sort_keys<VecI64, false>(keys, nullptr, m);
+    flip_negative<VecI64>(keys, m);
+}
+
+void sort_float(float* a, int64_t count) {
+    int64_t m = move_nans_last(a, count);
+    int32_t* keys = reinterpret_cast<int32_t*>(a);
+    flip_negative<VecI32>(keys, m);
+    sort_keys<VecI32, false>(keys, nullptr, m);
+    flip_negative<VecI32>(keys, m);
+}
+
+void sort_int(int32_t* a, int64_t count) {
+    sort_keys<VecI32, false>(a, nullptr, count);
+}
+
+void sort_long(int64_t* a, int64_t count) {
+    sort_keys<VecI64, false>(a, nullptr, count);
+}
+
+// Copies the non-NaN keys (as integers) and their indices to keys / vals
+// and the indices of the NaNs (in ascending order) to the end of vals.
+// Returns the number of non-NaN keys.
+template <typename F, typename T>
+static int64_t split_nans(F* a, int64_t count, T* keys, T* vals) {
+    int64_t m = 0;
+    int64_t nan = count;
+    for (int64_t i = count - 1; i >= 0; --i) {
+        if (a[i] != a[i]) {
+            vals[--nan] = T(i);
+        }
+    }
+    for (int64_t i = 0; i < count; ++i) {
+        if (a[i] == a[i]) {
+            memcpy(&keys[m], &a[i], sizeof(T));
+            vals[m++] = T(i);
+        }
+    }
+    return m;
+}
+
+void argsort_double(double* a, int64_t count, int32_t* indices) {
+    ArenaScope scope;
+    int64_t* keys = Arena::local().allocate<int64_t>(count);
+    int64_t* vals = Arena::local().allocate<int64_t>(count);
+    int64_t m = split_nans(a, count, keys, vals);
+    flip_negative<VecI64>(keys, m);
+    sort_keys<VecI64, true>(keys, vals, m);
+    for (int64_t i = 0; i < count; ++i) {
+        indices[i] = static_cast<int32_t>(vals[i]);
+    }
+}
+
+void argsort_float(float* a, int64_t count, int32_t* indices) {
+    ArenaScope scope;
+    int32_t* keys = Arena::local().allocate<int32_t>(count);
+    int64_t m = split_nans(a, count, keys, indices);
+    flip_negative<VecI32>(keys, m);
+    sort_keys<VecI32, true>(keys, indices, m);
+}
+
+void argsort_int(int32_t* a, int64_t count, int32_t* indices) {
+    ArenaScope scope;
+    int32_t* keys = Arena::local().allocate<int32_t>(count);
+    memcpy(keys, a, count * sizeof(int32_t));
+    for (int64_t i = 0; i < count; ++i) {
+        indices[i] = static_cast<int32_t>(i);
+    }
+    sort_keys<VecI32, true>(keys, indices, count);
+}
+
+void argsort_long(int64_t* a, int64_t count, int32_t* indices) {
+    ArenaScope scope;
+    int64_t* keys = Arena::local().allocate<int64_t>(count);
+    int64_t* vals = Arena::local().allocate<int64_t>(count);
+    memcpy(keys, a, count * sizeof(int64_t));
+    for (int64_t i = 0; i < count; ++i) {
+        vals[i] = i;
+    }
+    sort_keys<VecI64, true>(keys, vals, count);
+    for (int64_t i = 0; i < count; ++i) {
+        indices[i] = static_cast<int32_t>(vals[i]);
+    }
+}
+
+// The integer keys the elements of type F are sorted by
+template <typename F>
+struct SortKey;
+
+template <>
+struct SortKey<double> {
+    typedef int64_t T;
+    typedef VecI64 V;
+    static constexpr bool FP = true;
+};
+
+template <>
+struct SortKey<float> {
+    typedef int32_t T;
+    typedef VecI32 V;
+    static constexpr bool FP = true;
+};
+
+template <>
+struct SortKey<int32_t> {
+    typedef int32_t T;
+    typedef VecI32 V;
+    static constexpr bool FP = false;
+};
+
+template <>
+struct SortKey<int64_t> {
+    typedef int64_t T;
+    typedef VecI64 V;
+    static constexpr bool FP = false;
+};
+
+// Copies the non-NaN elements of a[0 .. count) as keys (and their indices
+// if vals isn't nullptr) to the front of keys / vals, the indices of the
+// NaNs go to the end of vals. Returns the number of non-NaN elements.
+template <typename F>
+static int64_t to_keys(F* a, int64_t count, typename SortKey<F>::T* keys, typename SortKey<F>::T* vals) {
+    typedef typename SortKey<F>::T T;
+    int64_t m = 0;
+    int64_t nan = count;
+    for (int64_t i = 0; i < count; ++i) {
+        if (a[i] == a[i]) {
+            memcpy(&keys[m], &a[i], sizeof(T));
+            if (vals != nullptr) {
+                vals[m] = T(i);
+            }
+            ++m;
+        }
+    }
+    if (SortKey<F>::FP && vals != nullptr) {
+        for (int64_t i = count - 1; i >= 0; --i) {
+            if (a[i] != a[i]) {
+                vals[--nan] = T(i);
+            }
+        }
+    }
+    if (SortKey<F>::FP) {
+        flip_negative<typename SortKey<F>::V>(keys, m);
+    }
+    return m;
+}
+
+template <typename F>
+static inline F from_key(typename SortKey<F>::T key) {
+    typedef typename SortKey<F>::T T;
+    if (SortKey<F>::FP) {
+        key ^= (key >> (8 * sizeof(T) - 1)) & std::numeric_limits<T>::max();
+    }
+    F x;
+    memcpy(&x, &key, sizeof(T));
+    return x;
+}
+
+template <typename F>
+static F nth_element_t(F* a, int64_t count, int64_t k) {
+    typedef typename SortKey<F>::T T;
+    typedef typename SortKey<F>::V V;
+    T* keys = reinterpret_cast<T*>(a);
+    int64_t m = SortKey<F>::FP ? move_nans_last(a, count) : count;
+    if (k >= m) {
+        return a[k];
+    }
+    if (SortKey<F>::FP) {
+        flip_negative<V>(keys, m);
+    }
+    select<V, false>(keys, nullptr, m, k);
+    if (SortKey<F>::FP) {
+        flip_negative<V>(keys, m);
+    }
+    return a[k];
+}
+
+template <typename F>
+static void top_k_t(F* a, int64_t count, int64_t k, F* values, int32_t* indices) {
+    typedef typename SortKey<F>::T T;
+    typedef typename SortKey<F>::V V;
+    ArenaScope scope;
+    T* keys = Arena::local().allocate<T>(count);
+    T* vals = Arena::local().allocate<T>(count);
+    const int64_t m = to_keys(a, count, keys, vals);
+    // the NaNs are the largest elements
+    int64_t j = 0;
+    for (int64_t i = m; i < count && j < k; ++i, ++j) {
+        values[j] = a[vals[i]];
+        indices[j] = static_cast<int32_t>(vals[i]);
+    }
+    const int64_t rest = k - j;
+    if (rest > 0) {
+        select<V, true>(keys, vals, m, m - rest);
+        sort_keys<V, true>(keys + m - rest, vals + m - rest, rest);
+        for (int64_t i = m - 1; i >= m - rest; --i, ++j) {
+            values[j] = a[vals[i]];
+            indices[j] = static_cast<int32_t>(vals[i]);
+        }
+    }
+}
+
+template <typename F>
+static bool quantiles_t(F* a, int64_t count, double* probs, int64_t nProbs, double* out) {
+    typedef typename SortKey<F>::T T;
+    typedef typename SortKey<F>::V V;
+    for (int64_t i = 0; i < nProbs; ++i) {
+        if (!(probs[i] >= 0.0 && probs[i] <= 1.0)) {
+            return false;
+        }
+    }
+    ArenaScope scope;
+    T* keys = Arena::local().allocate<T>(count);
+    const int64_t m = to_keys(a, count, keys, static_cast<T*>(nullptr));
+    // linear interpolation between the closest ranks h = p * (count - 1)
+    std::vector<int64_t> ranks;
+    ranks.reserve(2 * nProbs);
+    for (int64_t i = 0; i < nProbs; ++i) {
+        const int64_t lo = static_cast<int64_t>(probs[i] * double(count - 1));
+        const int64_t hi = std::min(lo + 1, count - 1);
+        if (lo < m) {
+            ranks.push_back(lo);
+        }
+        if (hi < m) {
+            ranks.push_back(hi);
+        }
+    }
+    std::sort(ranks.begin(), ranks.end());
+    ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+    multi_select<V>(keys, m, ranks.data(), 0, static_cast<int64_t>(ranks.size()), 0);
+    auto value = [&](int64_t r) {
+        return r < m ? static_cast<double>(from_key<F>(keys[r])) : std::numeric_limits<double>::quiet_NaN();
+    };
+    for (int64_t i = 0; i < nProbs; ++i) {
+        const double h = probs[i] * double(count - 1);
+        const int64_t lo = static_cast<int64_t>(h);
+        const double frac = h - double(lo);
+        const double x = value(lo);
+        out[i] = (frac > 0.0) ? x + frac * (value(std::min(lo + 1, count - 1)) - x) : x;
+    }
+    return true;
+}
+
+double nth_element_double(double* a, int64_t count, int64_t k) {
+    return nth_element_t(a, count, k);
+}
+
+float nth_element_float(float* a, int64_t count, int64_t k) {
+    return nth_element_t(a, count, k);
+}
+
+int32_t nth_element_int(int32_t* a, int64_t count, int64_t k) {
+    return nth_element_t(a, count, k);
+}
+
+int64_t nth_element_long(int64_t* a, int64_t count, int64_t k) {
+    return nth_element_t(a, count, k);
+}
+
+void top_k_double(double* a, int64_t count, int64_t k, double* values, int32_t* indices) {
+    top_k_t(a, count, k, values, indices);
+}
+
+void top_k_float(float* a, int64_t count, int64_t k, float* values, int32_t* indices) {
+    top_k_t(a, count, k, values, indices);
+}
+
+void top_k_int(int32_t* a, int64_t count, int64_t k, int32_t* values, int32_t* indices) {
+    top_k_t(a, count, k, values, indices);
+}
+
+void top_k_long(int64_t* a, int64_t count, int64_t k, int64_t* values, int32_t* indices) {
+    top_k_t(a, count, k, values, indices);
+}
+
+bool quantiles_double(double* a, int64_t count, double* probs, int64_t nProbs, double* out) {
+    return quantiles_t(a, count, probs, nProbs, out);
+}
+
+bool quantiles_float(float* a, int64_t count, double* probs, int64_t nProbs, double* out) {
+    return quantiles_t(a, count, probs, nProbs, out);
+}
+
+bool quantiles_int(int32_t* a, int64_t count, double* probs, int64_t nProbs, double* out) {
+    return quantiles_t(a, count, probs, nProbs, out);
+}
+
+bool quantiles_long(int64_t* a, int64_t count, double* probs, int64_t nProbs, double* out) {
+    return quantiles_t(a, count, probs, nProbs, out);
+}
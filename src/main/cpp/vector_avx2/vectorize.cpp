@@ -14,12 +14,15 @@
  * limitations under the License.
  */
 
-#include <float.h>           // DBL_MAX
 #include <cmath>             // std::sqrt
 #include <algorithm>         // std::max, std::min
-#include "vcl/vectorclass.h"
+#include <limits>            // std::numeric_limits
 #include <jni.h>
 
+#ifndef VECTORIZE_INCLUDED_
+#include "vectorize.h"
+#endif /* VECTORIZE_INCLUDED_ */
+
 #ifndef DOUBLEARRAY_INCLUDED_
 #include "DoubleArray.h"
 #endif /* DOUBLEARRAY_INCLUDED_ */
@@ -28,6 +31,22 @@
 #include "FloatArray.h"
 #endif /* FLOATARRAY_INCLUDED_ */
 
+#ifndef LONGARRAY_INCLUDED_
+#include "LongArray.h"
+#endif /* LONGARRAY_INCLUDED_ */
+
+#ifndef ARENA_INCLUDED_
+#include "Arena.h"
+#endif /* ARENA_INCLUDED_ */
+
+#ifndef ARRAYACCESS_INCLUDED_
+#include "ArrayAccess.h"
+#endif /* ARRAYACCESS_INCLUDED_ */
+
+#ifndef ALIGNEDBUFFER_INCLUDED_
+#include "AlignedBuffer.h"
+#endif /* ALIGNEDBUFFER_INCLUDED_ */
+
 #ifndef JEXCEPTION_INCLUDED_
 #include "JException.h"
 #endif /* JEXCEPTION_INCLUDED_ */
@@ -36,35 +55,6 @@
 #include "JExceptionUtils.h"
 #endif /* JEXCEPTIONUTILS_INCLUDED_ */
 
-constexpr double NOT_REACHED_D = -10000.0;
-constexpr float NOT_REACHED_F = -10000.0f;
-constexpr double DBL_MIN_VALUE = -DBL_MAX;
-constexpr int STEP_8 = 8;
-constexpr int STEP_16 = 16;
-constexpr int MM_HINT_NTA = 0;
-constexpr int MM_HINT_T0 = 1;
-constexpr int MM_HINT_T1 = 2;
-
-// TODO : should we have a version of the macro which does nothing?
-#if defined (_WIN64) || defined (_WIN32)
-// Windows version
-// Fetch into all levels of the cache hierarchy
-#define PREFETCH(address) (_mm_prefetch((const char*) (address), MM_HINT_T0))
-#else
-// Linux version
-// Fetch into all levels of the cache hierarchy
-#define PREFETCH(address) (_mm_prefetch((address), MM_HINT_T0))
-#endif
-
-
-
-float l2_norm_float(float* f, int64_t count);
-double l2_norm_double(double* d, int64_t count);
-bool approx_equal_double(double* a, double* b, int64_t count, double relTol, double absTol);
-bool approx_equal_float(float* a, float* b, int64_t count, float relTol, float absTol);
-double l1_norm_double(double* a, double* b, int64_t count);
-float l1_norm_float(float* a, float* b, int64_t count);
-
 
 #ifdef __cplusplus
 extern "C" {
@@ -72,10 +62,10 @@ extern "C" {
     /*
      * Class:     net_cramer_simd_SIMD
      * Method:    l2norm_double_n
-     * Signature: ([DIZ)D
+     * Signature: ([DIZZ)D
      */
     JNIEXPORT jdouble JNICALL Java_net_cramer_simd_SIMD_l2norm_1double_1n
-    (JNIEnv* env, jclass, jdoubleArray array, jint count, jboolean useCrit) {
+    (JNIEnv* env, jclass, jdoubleArray array, jint count, jboolean useCrit, jboolean reproducible) {
         if (count == 0 || array == nullptr) {
             return 0.0;
         }
@@ -84,7 +74,10 @@ extern "C" {
             return NOT_REACHED_D;
         }
         try {
-            DoubleArray a = DoubleArray(env, array, count, useCrit);
+            DoubleArray a = DoubleArray(env, array, count, useCrit, true);
+            if (reproducible) {
+                return l2_norm_double_repro(a.ptr(), count);
+            }
             return l2_norm_double(a.ptr(), count);
         }
         catch (const JException& ex) {
@@ -99,10 +92,10 @@ extern "C" {
     /*
      * Class:     net_cramer_simd_SIMD
      * Method:    l2norm_float_n
-     * Signature: ([FIZ)F
+     * Signature: ([FIZZ)F
      */
     JNIEXPORT jfloat JNICALL Java_net_cramer_simd_SIMD_l2norm_1float_1n
-    (JNIEnv* env, jclass, jfloatArray array, jint count, jboolean useCrit) {
+    (JNIEnv* env, jclass, jfloatArray array, jint count, jboolean useCrit, jboolean reproducible) {
         if (count == 0 || array == nullptr) {
             return 0.0f;
         }
@@ -111,7 +104,10 @@ extern "C" {
             return NOT_REACHED_F;
         }
         try {
-            FloatArray a = FloatArray(env, array, count, useCrit);
+            FloatArray a = FloatArray(env, array, count, useCrit, true);
+            if (reproducible) {
+                return l2_norm_float_repro(a.ptr(), count);
+            }
             return l2_norm_float(a.ptr(), count);
         }
         catch (const JException& ex) {
@@ -149,8 +145,8 @@ extern "C" {
             return JNI_TRUE;
         }
         try {
-            DoubleArray aa = DoubleArray(env, a, count, useCrit);
-            DoubleArray bb = DoubleArray(env, b, count, useCrit);
+            DoubleArray aa = DoubleArray(env, a, count, useCrit, true);
+            DoubleArray bb = DoubleArray(env, b, count, useCrit, true);
             return approx_equal_double(aa.ptr(), bb.ptr(), count, relTol, absTol) ? JNI_TRUE : JNI_FALSE;
         }
         catch (const JException& ex) {
@@ -188,8 +184,8 @@ extern "C" {
             return JNI_TRUE;
         }
         try {
-            FloatArray aa = FloatArray(env, a, count, useCrit);
-            FloatArray bb = FloatArray(env, b, count, useCrit);
+            FloatArray aa = FloatArray(env, a, count, useCrit, true);
+            FloatArray bb = FloatArray(env, b, count, useCrit, true);
             return approx_equal_float(aa.ptr(), bb.ptr(), count, relTol, absTol) ? JNI_TRUE : JNI_FALSE;
         }
         catch (const JException& ex) {
@@ -201,13 +197,161 @@ extern "C" {
         return JNI_FALSE;
     }
 
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    mismatch_double_n
+     * Signature: ([D[DIDDZ[JZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_mismatch_1double_1n
+    (JNIEnv* env, jclass, jdoubleArray a, jdoubleArray b, jint count, jdouble relTol, jdouble absTol, jboolean firstOnly, jlongArray result, jboolean useCrit) {
+        if (count == 0 || a == nullptr || b == nullptr || result == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "mismatch_double - negative count argument:", count);
+            return;
+        }
+        if (relTol < 0.0) {
+            throwJavaRuntimeException(env, "%s %f", "mismatch_double - relTol < 0.0 :", relTol);
+            return;
+        }
+        if (absTol < 0.0) {
+            throwJavaRuntimeException(env, "%s %f", "mismatch_double - absTol < 0.0 :", absTol);
+            return;
+        }
+        try {
+            jlong res[2];
+            {
+                DoubleArray aa = DoubleArray(env, a, count, useCrit, true);
+                DoubleArray bb = DoubleArray(env, b, count, useCrit, true);
+                res[0] = mismatch_double(aa.ptr(), bb.ptr(), count, relTol, absTol, firstOnly == JNI_TRUE, res[1]);
+            }
+            static_cast<Context*>(env)->SetLongArrayRegion(result, 0, 2, res);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "mismatch_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "mismatch_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    mismatch_float_n
+     * Signature: ([F[FIFFZ[JZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_mismatch_1float_1n
+    (JNIEnv* env, jclass, jfloatArray a, jfloatArray b, jint count, jfloat relTol, jfloat absTol, jboolean firstOnly, jlongArray result, jboolean useCrit) {
+        if (count == 0 || a == nullptr || b == nullptr || result == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "mismatch_float - negative count argument:", count);
+            return;
+        }
+        if (relTol < 0.0f) {
+            throwJavaRuntimeException(env, "%s %f", "mismatch_float - relTol < 0.0f :", relTol);
+            return;
+        }
+        if (absTol < 0.0f) {
+            throwJavaRuntimeException(env, "%s %f", "mismatch_float - absTol < 0.0f :", absTol);
+            return;
+        }
+        try {
+            jlong res[2];
+            {
+                FloatArray aa = FloatArray(env, a, count, useCrit, true);
+                FloatArray bb = FloatArray(env, b, count, useCrit, true);
+                res[0] = mismatch_float(aa.ptr(), bb.ptr(), count, relTol, absTol, firstOnly == JNI_TRUE, res[1]);
+            }
+            static_cast<Context*>(env)->SetLongArrayRegion(result, 0, 2, res);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "mismatch_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "mismatch_float: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    mismatch_ulp_double_n
+     * Signature: ([D[DIJZ[JZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_mismatch_1ulp_1double_1n
+    (JNIEnv* env, jclass, jdoubleArray a, jdoubleArray b, jint count, jlong maxUlps, jboolean firstOnly, jlongArray result, jboolean useCrit) {
+        if (count == 0 || a == nullptr || b == nullptr || result == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "mismatch_ulp_double - negative count argument:", count);
+            return;
+        }
+        if (maxUlps < 0) {
+            throwJavaRuntimeException(env, "%s %lld", "mismatch_ulp_double - negative maxUlps argument:", (long long) maxUlps);
+            return;
+        }
+        try {
+            jlong res[2];
+            {
+                DoubleArray aa = DoubleArray(env, a, count, useCrit, true);
+                DoubleArray bb = DoubleArray(env, b, count, useCrit, true);
+                res[0] = mismatch_ulp_double(aa.ptr(), bb.ptr(), count, (uint64_t) maxUlps, firstOnly == JNI_TRUE, res[1]);
+            }
+            static_cast<Context*>(env)->SetLongArrayRegion(result, 0, 2, res);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "mismatch_ulp_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "mismatch_ulp_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    mismatch_ulp_float_n
+     * Signature: ([F[FIIZ[JZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_mismatch_1ulp_1float_1n
+    (JNIEnv* env, jclass, jfloatArray a, jfloatArray b, jint count, jint maxUlps, jboolean firstOnly, jlongArray result, jboolean useCrit) {
+        if (count == 0 || a == nullptr || b == nullptr || result == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "mismatch_ulp_float - negative count argument:", count);
+            return;
+        }
+        if (maxUlps < 0) {
+            throwJavaRuntimeException(env, "%s %d", "mismatch_ulp_float - negative maxUlps argument:", maxUlps);
+            return;
+        }
+        try {
+            jlong res[2];
+            {
+                FloatArray aa = FloatArray(env, a, count, useCrit, true);
+                FloatArray bb = FloatArray(env, b, count, useCrit, true);
+                res[0] = mismatch_ulp_float(aa.ptr(), bb.ptr(), count, (uint32_t) maxUlps, firstOnly == JNI_TRUE, res[1]);
+            }
+            static_cast<Context*>(env)->SetLongArrayRegion(result, 0, 2, res);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "mismatch_ulp_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "mismatch_ulp_float: caught unknown exception");
+        }
+    }
+
     /*
      * Class:     net_cramer_simd_SIMD
      * Method:    distance_double_n
-     * Signature: ([D[DIZ)D
+     * Signature: ([D[DIZZ)D
      */
     JNIEXPORT jdouble JNICALL Java_net_cramer_simd_SIMD_distance_1double_1n
-    (JNIEnv* env, jclass, jdoubleArray a, jdoubleArray b, jint count, jboolean useCrit) {
+    (JNIEnv* env, jclass, jdoubleArray a, jdoubleArray b, jint count, jboolean useCrit, jboolean reproducible) {
         if (count == 0 || a == nullptr || b == nullptr || a == b) {
             return 0.0;
         }
@@ -216,8 +360,11 @@ extern "C" {
             return NOT_REACHED_D;
         }
         try {
-            DoubleArray aa = DoubleArray(env, a, count, useCrit);
-            DoubleArray bb = DoubleArray(env, b, count, useCrit);
+            DoubleArray aa = DoubleArray(env, a, count, useCrit, true);
+            DoubleArray bb = DoubleArray(env, b, count, useCrit, true);
+            if (reproducible) {
+                return l1_norm_double_repro(aa.ptr(), bb.ptr(), count);
+            }
             return l1_norm_double(aa.ptr(), bb.ptr(), count);
         }
         catch (const JException& ex) {
@@ -232,10 +379,10 @@ extern "C" {
     /*
      * Class:     net_cramer_simd_SIMD
      * Method:    distance_float_n
-     * Signature: ([F[FIZ)F
+     * Signature: ([F[FIZZ)F
      */
     JNIEXPORT jfloat JNICALL Java_net_cramer_simd_SIMD_distance_1float_1n
-    (JNIEnv* env, jclass, jfloatArray a, jfloatArray b, jint count, jboolean useCrit) {
+    (JNIEnv* env, jclass, jfloatArray a, jfloatArray b, jint count, jboolean useCrit, jboolean reproducible) {
         if (count == 0 || a == nullptr || b == nullptr || a == b) {
             return 0.0f;
         }
@@ -244,8 +391,11 @@ extern "C" {
             return NOT_REACHED_F;
         }
         try {
-            FloatArray aa = FloatArray(env, a, count, useCrit);
-            FloatArray bb = FloatArray(env, b, count, useCrit);
+            FloatArray aa = FloatArray(env, a, count, useCrit, true);
+            FloatArray bb = FloatArray(env, b, count, useCrit, true);
+            if (reproducible) {
+                return l1_norm_float_repro(aa.ptr(), bb.ptr(), count);
+            }
             return l1_norm_float(aa.ptr(), bb.ptr(), count);
         }
         catch (const JException& ex) {
@@ -256,176 +406,1589 @@ extern "C" {
         }
         return NOT_REACHED_F;
     }
-#ifdef __cplusplus
-}
-#endif
-
-
-// precondition: count must be even!
-double l2_norm_double(double* d, int64_t count) {
-    double scale = 0.0;
-    Vec8d vector;
 
-    int i;
-    for (i = 0; i < count - 7; i += STEP_8) {
-        PREFETCH(d + i + 63 * STEP_8);
-        vector.load(d + i);
-        scale = std::max(scale, horizontal_add(abs(vector)));
-    }
-    for (; i < count; i += 2) {
-        double xr = d[i];
-        double xi = d[i + 1];
-        if (xr != 0.0 || xi != 0.0) {
-            scale = std::max(scale, std::abs(xr) + std::abs(xi));
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    squared_distance_float_n
+     * Signature: ([F[FIZ)F
+     */
+    JNIEXPORT jfloat JNICALL Java_net_cramer_simd_SIMD_squared_1distance_1float_1n
+    (JNIEnv* env, jclass, jfloatArray a, jfloatArray b, jint count, jboolean useCrit) {
+        if (count == 0 || a == nullptr || b == nullptr) {
+            return 0.0f;
         }
-    }
-    if (scale == 0.0) {
-        return 0.0;
-    }
-    PREFETCH(d);
-    while (scale <= 1.1) {
-        scale = scale * 1000.0;
-    }
-    scale = 1.0 / scale;
-    Vec8d factor = Vec8d(scale);
-    Vec8d sumsquaredVec = Vec8d(0.0);
-    Vec8d scaled;
-    for (i = 0; i < count - 7; i += STEP_8) {
-        PREFETCH(d + i + 63 * STEP_8);
-        vector.load(d + i);
-        scaled = factor * vector;
-        sumsquaredVec += square(scaled);
-    }
-    double sumsquared = horizontal_add(sumsquaredVec);
-    for (; i < count; ++i) {
-        double x = d[i];
-        if (x != 0.0) {
-            double tmp = scale * x;
-            sumsquared += (tmp * tmp);
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "squared_distance_float - negative count argument:", count);
+            return NOT_REACHED_F;
         }
-    }
-
-    return std::sqrt(sumsquared) / scale;
-}
-
-// precondition: count must be even!
-float l2_norm_float(float* f, int64_t count) {
-    float scale = 0.0f;
-    Vec16f vector;
-
-    int i;
-    for (i = 0; i < count - 15; i += STEP_16) {
-        PREFETCH(f + i + 63 * STEP_16);
-        vector.load(f + i);
-        scale = std::max(scale, horizontal_add(abs(vector)));
-    }
-    for (; i < count; i += 2) {
-        float xr = f[i];
-        float xi = f[i + 1];
-        if (xr != 0.0f || xi != 0.0f) {
-            scale = std::max(scale, std::abs(xr) + std::abs(xi));
+        try {
+            FloatArray aa = FloatArray(env, a, count, useCrit, true);
+            FloatArray bb = FloatArray(env, b, count, useCrit, true);
+            return squared_distance_float(aa.ptr(), bb.ptr(), count);
         }
-    }
-    if (scale == 0.0f) {
-        return 0.0f;
-    }
-    PREFETCH(f);
-    while (scale <= 1.1f) {
-        scale = scale * 1000.0f;
-    }
-    scale = 1.0f / scale;
-    Vec16f factor = Vec16f(scale);
-    Vec16f sumsquaredVec = Vec16f(0.0f);
-    Vec16f scaled;
-    for (i = 0; i < count - 15; i += STEP_16) {
-        PREFETCH(f + i + 63 * STEP_16);
-        vector.load(f + i);
-        scaled = factor * vector;
-        sumsquaredVec += square(scaled);
-    }
-    float sumsquared = horizontal_add(sumsquaredVec);
-    for (; i < count; ++i) {
-        float x = f[i];
-        if (x != 0.0f) {
-            float tmp = scale * x;
-            sumsquared += (tmp * tmp);
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "squared_distance_float", ex.what());
         }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "squared_distance_float: caught unknown exception");
+        }
+        return NOT_REACHED_F;
     }
 
-    return std::sqrt(sumsquared) / scale;
-}
-
-bool approx_equal_double(double* a, double* b, int64_t count, double relTol, double absTol) {
-    Vec8d vAbsTol = Vec8d(absTol);
-    Vec8d vecA;
-    Vec8d vecB;
-
-    int i;
-    for (i = 0; i < count - 7; i += STEP_8) {
-        PREFETCH(a + i + 63 * STEP_8);
-        PREFETCH(b + i + 63 * STEP_8);
-        vecA.load(a + i);
-        vecB.load(b + i);
-        if (horizontal_or(vecA != vecB)) {
-            Vec8d absdiff = abs(vecA - vecB);
-            if (horizontal_add(select(absdiff <= vAbsTol, Vec8d(0.0), select(absdiff <= relTol * max(abs(vecA), abs(vecB)), Vec8d(0.0), Vec8d(1.0)))) > 0.0) {
-                return false;
-            }
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    inner_product_float_n
+     * Signature: ([F[FIZ)F
+     */
+    JNIEXPORT jfloat JNICALL Java_net_cramer_simd_SIMD_inner_1product_1float_1n
+    (JNIEnv* env, jclass, jfloatArray a, jfloatArray b, jint count, jboolean useCrit) {
+        if (count == 0 || a == nullptr || b == nullptr) {
+            return 0.0f;
         }
-    }
-    for (; i < count; ++i) {
-        double ai = a[i];
-        double bi = b[i];
-        if (ai != bi) {
-            double absdiff = std::abs(ai - bi);
-            if (!(absdiff <= absTol || absdiff <= relTol * std::max(std::abs(ai), std::abs(bi)))) {
-                return false;
-            }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "inner_product_float - negative count argument:", count);
+            return NOT_REACHED_F;
         }
-    }
-    return true;
-}
-
-bool approx_equal_float(float* a, float* b, int64_t count, float relTol, float absTol) {
-    Vec16f vAbsTol = Vec16f(absTol);
-    Vec16f vecA;
-    Vec16f vecB;
-
-    int i;
-    for (i = 0; i < count - 15; i += STEP_16) {
-        PREFETCH(a + i + 63 * STEP_16);
-        PREFETCH(b + i + 63 * STEP_16);
-        vecA.load(a + i);
-        vecB.load(b + i);
-        if (horizontal_or(vecA != vecB)) {
-            Vec16f absdiff = abs(vecA - vecB);
-            if (horizontal_add(select(absdiff <= vAbsTol, Vec16f(0.0f), select(absdiff <= relTol * max(abs(vecA), abs(vecB)), Vec16f(0.0f), Vec16f(1.0f)))) > 0.0f) {
-                return false;
-            }
+        try {
+            FloatArray aa = FloatArray(env, a, count, useCrit, true);
+            FloatArray bb = FloatArray(env, b, count, useCrit, true);
+            return dot_float(aa.ptr(), bb.ptr(), count);
         }
-    }
-    for (; i < count; ++i) {
-        float ai = a[i];
-        float bi = b[i];
-        if (ai != bi) {
-            float absdiff = std::abs(ai - bi);
-            if (!(absdiff <= absTol || absdiff <= relTol * std::max(std::abs(ai), std::abs(bi)))) {
-                return false;
-            }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "inner_product_float", ex.what());
         }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "inner_product_float: caught unknown exception");
+        }
+        return NOT_REACHED_F;
     }
-    return true;
-}
 
-double l1_norm_double(double* a, double* b, int64_t count) {
-    Vec8d vecA;
-    Vec8d vecB;
-    double d1 = 0.0;
-
-    int i;
-    for (i = 0; i < count - 7; i += STEP_8) {
-        PREFETCH(a + i + 63 * STEP_8);
-        PREFETCH(b + i + 63 * STEP_8);
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    cosine_float_n
+     * Signature: ([F[FIZ)F
+     */
+    JNIEXPORT jfloat JNICALL Java_net_cramer_simd_SIMD_cosine_1float_1n
+    (JNIEnv* env, jclass, jfloatArray a, jfloatArray b, jint count, jboolean useCrit) {
+        if (count == 0 || a == nullptr || b == nullptr) {
+            return 0.0f;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "cosine_float - negative count argument:", count);
+            return NOT_REACHED_F;
+        }
+        try {
+            FloatArray aa = FloatArray(env, a, count, useCrit, true);
+            FloatArray bb = FloatArray(env, b, count, useCrit, true);
+            return cosine_float(aa.ptr(), bb.ptr(), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "cosine_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "cosine_float: caught unknown exception");
+        }
+        return NOT_REACHED_F;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    distances_float_n
+     * Signature: ([F[FIII[FZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_distances_1float_1n
+    (JNIEnv* env, jclass, jfloatArray query, jfloatArray base, jint rows, jint dim, jint metric, jfloatArray out, jboolean useCrit) {
+        if (rows == 0 || query == nullptr || base == nullptr || out == nullptr) {
+            return;
+        }
+        if (rows < 0 || dim < 0) {
+            throwJavaRuntimeException(env, "%s %d %d", "distances_float - negative rows / dim argument:", rows, dim);
+            return;
+        }
+        if (metric < METRIC_L2_SQUARED || metric > METRIC_COSINE) {
+            throwJavaRuntimeException(env, "%s %d", "distances_float - unknown metric:", metric);
+            return;
+        }
+        if ((jlong) rows * dim > INT32_MAX) {
+            throwJavaRuntimeException(env, "%s %d %d", "distances_float - rows * dim too large:", rows, dim);
+            return;
+        }
+        try {
+            FloatArray qq = FloatArray(env, query, dim, useCrit, true);
+            FloatArray bb = FloatArray(env, base, rows * dim, useCrit, true);
+            FloatArray oo = FloatArray(env, out, rows, useCrit);
+            distances_float(qq.ptr(), bb.ptr(), rows, dim, metric, oo.ptr());
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "distances_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "distances_float: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    stats_double_n
+     * Signature: ([DI[DZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_stats_1double_1n
+    (JNIEnv* env, jclass, jdoubleArray a, jint count, jdoubleArray state, jboolean useCrit) {
+        if (count == 0 || a == nullptr || state == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "stats_double - negative count argument:", count);
+            return;
+        }
+        try {
+            DoubleArray aa = DoubleArray(env, a, count, useCrit, true);
+            DoubleArray ss = DoubleArray(env, state, RUNNING_STATS_LENGTH, useCrit);
+            stats_double(aa.ptr(), count, *reinterpret_cast<RunningStats*>(ss.ptr()));
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "stats_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "stats_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    stats_float_n
+     * Signature: ([FI[DZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_stats_1float_1n
+    (JNIEnv* env, jclass, jfloatArray a, jint count, jdoubleArray state, jboolean useCrit) {
+        if (count == 0 || a == nullptr || state == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "stats_float - negative count argument:", count);
+            return;
+        }
+        try {
+            FloatArray aa = FloatArray(env, a, count, useCrit, true);
+            DoubleArray ss = DoubleArray(env, state, RUNNING_STATS_LENGTH, useCrit);
+            stats_float(aa.ptr(), count, *reinterpret_cast<RunningStats*>(ss.ptr()));
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "stats_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "stats_float: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    compensated_sum_double_n
+     * Signature: ([DIZ)D
+     */
+    JNIEXPORT jdouble JNICALL Java_net_cramer_simd_SIMD_compensated_1sum_1double_1n
+    (JNIEnv* env, jclass, jdoubleArray a, jint count, jboolean useCrit) {
+        if (count == 0 || a == nullptr) {
+            return 0.0;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "compensated_sum_double - negative count argument:", count);
+            return NOT_REACHED_D;
+        }
+        try {
+            DoubleArray aa = DoubleArray(env, a, count, useCrit, true);
+            return compensated_sum_double(aa.ptr(), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "compensated_sum_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "compensated_sum_double: caught unknown exception");
+        }
+        return NOT_REACHED_D;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    compensated_sum_float_n
+     * Signature: ([FIZ)F
+     */
+    JNIEXPORT jfloat JNICALL Java_net_cramer_simd_SIMD_compensated_1sum_1float_1n
+    (JNIEnv* env, jclass, jfloatArray a, jint count, jboolean useCrit) {
+        if (count == 0 || a == nullptr) {
+            return 0.0f;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "compensated_sum_float - negative count argument:", count);
+            return NOT_REACHED_F;
+        }
+        try {
+            FloatArray aa = FloatArray(env, a, count, useCrit, true);
+            return compensated_sum_float(aa.ptr(), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "compensated_sum_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "compensated_sum_float: caught unknown exception");
+        }
+        return NOT_REACHED_F;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    compensated_sum_float_d_n
+     * Signature: ([FIZ)D
+     */
+    JNIEXPORT jdouble JNICALL Java_net_cramer_simd_SIMD_compensated_1sum_1float_1d_1n
+    (JNIEnv* env, jclass, jfloatArray a, jint count, jboolean useCrit) {
+        if (count == 0 || a == nullptr) {
+            return 0.0;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "compensated_sum_float_d - negative count argument:", count);
+            return NOT_REACHED_D;
+        }
+        try {
+            FloatArray aa = FloatArray(env, a, count, useCrit, true);
+            return compensated_sum_float_d(aa.ptr(), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "compensated_sum_float_d", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "compensated_sum_float_d: caught unknown exception");
+        }
+        return NOT_REACHED_D;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    compensated_dot_double_n
+     * Signature: ([D[DIZ)D
+     */
+    JNIEXPORT jdouble JNICALL Java_net_cramer_simd_SIMD_compensated_1dot_1double_1n
+    (JNIEnv* env, jclass, jdoubleArray a, jdoubleArray b, jint count, jboolean useCrit) {
+        if (count == 0 || a == nullptr || b == nullptr) {
+            return 0.0;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "compensated_dot_double - negative count argument:", count);
+            return NOT_REACHED_D;
+        }
+        try {
+            DoubleArray aa = DoubleArray(env, a, count, useCrit, true);
+            DoubleArray bb = DoubleArray(env, b, count, useCrit, true);
+            return compensated_dot_double(aa.ptr(), bb.ptr(), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "compensated_dot_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "compensated_dot_double: caught unknown exception");
+        }
+        return NOT_REACHED_D;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    compensated_dot_float_n
+     * Signature: ([F[FIZ)F
+     */
+    JNIEXPORT jfloat JNICALL Java_net_cramer_simd_SIMD_compensated_1dot_1float_1n
+    (JNIEnv* env, jclass, jfloatArray a, jfloatArray b, jint count, jboolean useCrit) {
+        if (count == 0 || a == nullptr || b == nullptr) {
+            return 0.0f;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "compensated_dot_float - negative count argument:", count);
+            return NOT_REACHED_F;
+        }
+        try {
+            FloatArray aa = FloatArray(env, a, count, useCrit, true);
+            FloatArray bb = FloatArray(env, b, count, useCrit, true);
+            return compensated_dot_float(aa.ptr(), bb.ptr(), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "compensated_dot_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "compensated_dot_float: caught unknown exception");
+        }
+        return NOT_REACHED_F;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    compensated_dot_float_d_n
+     * Signature: ([F[FIZ)D
+     */
+    JNIEXPORT jdouble JNICALL Java_net_cramer_simd_SIMD_compensated_1dot_1float_1d_1n
+    (JNIEnv* env, jclass, jfloatArray a, jfloatArray b, jint count, jboolean useCrit) {
+        if (count == 0 || a == nullptr || b == nullptr) {
+            return 0.0;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "compensated_dot_float_d - negative count argument:", count);
+            return NOT_REACHED_D;
+        }
+        try {
+            FloatArray aa = FloatArray(env, a, count, useCrit, true);
+            FloatArray bb = FloatArray(env, b, count, useCrit, true);
+            return compensated_dot_float_d(aa.ptr(), bb.ptr(), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "compensated_dot_float_d", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "compensated_dot_float_d: caught unknown exception");
+        }
+        return NOT_REACHED_D;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    arena_stats_n
+     * Signature: ([J)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_arena_1stats_1n
+    (JNIEnv* env, jclass, jlongArray state) {
+        if (state == nullptr) {
+            return;
+        }
+        try {
+            ArenaStats st;
+            Arena::stats(st);
+            static_cast<Context*>(env)->SetLongArrayRegion(state, 0, ARENA_STATS_LENGTH,
+                reinterpret_cast<jlong*>(&st));
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "arena_stats", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "arena_stats: caught unknown exception");
+        }
+    }
+
+    // calibrates the adaptive access policy (see ArrayAccess.h) once when
+    // the library gets loaded, before any kernel can hold a critical region
+    JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void*) {
+        JNIEnv* env = nullptr;
+        if (vm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_8) != JNI_OK) {
+            return JNI_ERR;
+        }
+        calibrate_access(env);
+        return JNI_VERSION_1_8;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    set_max_pin_micros_n
+     * Signature: (J)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_set_1max_1pin_1micros_1n
+    (JNIEnv* env, jclass, jlong micros) {
+        try {
+            set_max_pin_micros(micros);
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "set_max_pin_micros: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    max_pin_micros_n
+     * Signature: ()J
+     */
+    JNIEXPORT jlong JNICALL Java_net_cramer_simd_SIMD_max_1pin_1micros_1n
+    (JNIEnv*, jclass) {
+        return max_pin_micros();
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    set_adaptive_access_n
+     * Signature: (Z)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_set_1adaptive_1access_1n
+    (JNIEnv* env, jclass, jboolean enabled) {
+        set_adaptive_access(env, enabled == JNI_TRUE);
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    access_policy_n
+     * Signature: ([D)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_access_1policy_1n
+    (JNIEnv* env, jclass, jdoubleArray state) {
+        if (state == nullptr) {
+            return;
+        }
+        try {
+            AccessPolicyInfo info;
+            access_policy(info);
+            static_cast<Context*>(env)->SetDoubleArrayRegion(state, 0, ACCESS_POLICY_LENGTH,
+                reinterpret_cast<jdouble*>(&info));
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "access_policy", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "access_policy: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    l2norm_double_a
+     * Signature: (JJZ)D
+     */
+    JNIEXPORT jdouble JNICALL Java_net_cramer_simd_SIMD_l2norm_1double_1a
+    (JNIEnv* env, jclass, jlong a, jlong count, jboolean reproducible) {
+        if (count == 0 || a == 0) {
+            return 0.0;
+        }
+        if (count < 0 || (count & 1) == 1) {
+            throwJavaRuntimeException(env, "%s %lld", "l2norm_double - invalid count argument:", static_cast<long long>(count));
+            return NOT_REACHED_D;
+        }
+        try {
+            if (reproducible) {
+                return l2_norm_double_repro(address_ptr<double>(a), count);
+            }
+            return l2_norm_double(address_ptr<double>(a), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "l2norm_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "l2norm_double: caught unknown exception");
+        }
+        return NOT_REACHED_D;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    l2norm_float_a
+     * Signature: (JJZ)F
+     */
+    JNIEXPORT jfloat JNICALL Java_net_cramer_simd_SIMD_l2norm_1float_1a
+    (JNIEnv* env, jclass, jlong a, jlong count, jboolean reproducible) {
+        if (count == 0 || a == 0) {
+            return 0.0f;
+        }
+        if (count < 0 || (count & 1) == 1) {
+            throwJavaRuntimeException(env, "%s %lld", "l2norm_float - invalid count argument:", static_cast<long long>(count));
+            return NOT_REACHED_F;
+        }
+        try {
+            if (reproducible) {
+                return l2_norm_float_repro(address_ptr<float>(a), count);
+            }
+            return l2_norm_float(address_ptr<float>(a), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "l2norm_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "l2norm_float: caught unknown exception");
+        }
+        return NOT_REACHED_F;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    approx_equal_double_a
+     * Signature: (JJJDD)Z
+     */
+    JNIEXPORT jboolean JNICALL Java_net_cramer_simd_SIMD_approx_1equal_1double_1a
+    (JNIEnv* env, jclass, jlong a, jlong b, jlong count, jdouble relTol, jdouble absTol) {
+        if (count == 0 || a == 0 || b == 0) {
+            return JNI_FALSE;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %lld", "approx_equal_double - negative count argument:", static_cast<long long>(count));
+            return JNI_FALSE;
+        }
+        if (relTol < 0.0) {
+            throwJavaRuntimeException(env, "%s %f", "approx_equal_double - relTol < 0.0 :", relTol);
+            return JNI_FALSE;
+        }
+        if (absTol < 0.0) {
+            throwJavaRuntimeException(env, "%s %f", "approx_equal_double - absTol < 0.0 :", absTol);
+            return JNI_FALSE;
+        }
+        try {
+            return approx_equal_double(address_ptr<double>(a), address_ptr<double>(b), count, relTol, absTol) ? JNI_TRUE : JNI_FALSE;
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "approx_equal_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "approx_equal_double: caught unknown exception");
+        }
+        return JNI_FALSE;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    approx_equal_float_a
+     * Signature: (JJJFF)Z
+     */
+    JNIEXPORT jboolean JNICALL Java_net_cramer_simd_SIMD_approx_1equal_1float_1a
+    (JNIEnv* env, jclass, jlong a, jlong b, jlong count, jfloat relTol, jfloat absTol) {
+        if (count == 0 || a == 0 || b == 0) {
+            return JNI_FALSE;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %lld", "approx_equal_float - negative count argument:", static_cast<long long>(count));
+            return JNI_FALSE;
+        }
+        if (relTol < 0.0f) {
+            throwJavaRuntimeException(env, "%s %f", "approx_equal_float - relTol < 0.0f :", relTol);
+            return JNI_FALSE;
+        }
+        if (absTol < 0.0f) {
+            throwJavaRuntimeException(env, "%s %f", "approx_equal_float - absTol < 0.0f :", absTol);
+            return JNI_FALSE;
+        }
+        try {
+            return approx_equal_float(address_ptr<float>(a), address_ptr<float>(b), count, relTol, absTol) ? JNI_TRUE : JNI_FALSE;
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "approx_equal_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "approx_equal_float: caught unknown exception");
+        }
+        return JNI_FALSE;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    mismatch_double_a
+     * Signature: (JJJDDZ[J)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_mismatch_1double_1a
+    (JNIEnv* env, jclass, jlong a, jlong b, jlong count, jdouble relTol, jdouble absTol, jboolean firstOnly, jlongArray result) {
+        if (count == 0 || a == 0 || b == 0 || result == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %lld", "mismatch_double - negative count argument:", static_cast<long long>(count));
+            return;
+        }
+        if (relTol < 0.0) {
+            throwJavaRuntimeException(env, "%s %f", "mismatch_double - relTol < 0.0 :", relTol);
+            return;
+        }
+        if (absTol < 0.0) {
+            throwJavaRuntimeException(env, "%s %f", "mismatch_double - absTol < 0.0 :", absTol);
+            return;
+        }
+        try {
+            jlong res[2];
+            res[0] = mismatch_double(address_ptr<double>(a), address_ptr<double>(b), count, relTol, absTol, firstOnly == JNI_TRUE, res[1]);
+            static_cast<Context*>(env)->SetLongArrayRegion(result, 0, 2, res);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "mismatch_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "mismatch_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    mismatch_float_a
+     * Signature: (JJJFFZ[J)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_mismatch_1float_1a
+    (JNIEnv* env, jclass, jlong a, jlong b, jlong count, jfloat relTol, jfloat absTol, jboolean firstOnly, jlongArray result) {
+        if (count == 0 || a == 0 || b == 0 || result == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %lld", "mismatch_float - negative count argument:", static_cast<long long>(count));
+            return;
+        }
+        if (relTol < 0.0f) {
+            throwJavaRuntimeException(env, "%s %f", "mismatch_float - relTol < 0.0f :", relTol);
+            return;
+        }
+        if (absTol < 0.0f) {
+            throwJavaRuntimeException(env, "%s %f", "mismatch_float - absTol < 0.0f :", absTol);
+            return;
+        }
+        try {
+            jlong res[2];
+            res[0] = mismatch_float(address_ptr<float>(a), address_ptr<float>(b), count, relTol, absTol, firstOnly == JNI_TRUE, res[1]);
+            static_cast<Context*>(env)->SetLongArrayRegion(result, 0, 2, res);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "mismatch_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "mismatch_float: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    distance_double_a
+     * Signature: (JJJZ)D
+     */
+    JNIEXPORT jdouble JNICALL Java_net_cramer_simd_SIMD_distance_1double_1a
+    (JNIEnv* env, jclass, jlong a, jlong b, jlong count, jboolean reproducible) {
+        if (count == 0 || a == 0 || b == 0 || a == b) {
+            return 0.0;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %lld", "distance_double - negative count argument:", static_cast<long long>(count));
+            return NOT_REACHED_D;
+        }
+        try {
+            if (reproducible) {
+                return l1_norm_double_repro(address_ptr<double>(a), address_ptr<double>(b), count);
+            }
+            return l1_norm_double(address_ptr<double>(a), address_ptr<double>(b), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "distance_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "distance_double: caught unknown exception");
+        }
+        return NOT_REACHED_D;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    distance_float_a
+     * Signature: (JJJZ)F
+     */
+    JNIEXPORT jfloat JNICALL Java_net_cramer_simd_SIMD_distance_1float_1a
+    (JNIEnv* env, jclass, jlong a, jlong b, jlong count, jboolean reproducible) {
+        if (count == 0 || a == 0 || b == 0 || a == b) {
+            return 0.0f;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %lld", "distance_float - negative count argument:", static_cast<long long>(count));
+            return NOT_REACHED_F;
+        }
+        try {
+            if (reproducible) {
+                return l1_norm_float_repro(address_ptr<float>(a), address_ptr<float>(b), count);
+            }
+            return l1_norm_float(address_ptr<float>(a), address_ptr<float>(b), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "distance_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "distance_float: caught unknown exception");
+        }
+        return NOT_REACHED_F;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    squared_distance_float_a
+     * Signature: (JJJ)F
+     */
+    JNIEXPORT jfloat JNICALL Java_net_cramer_simd_SIMD_squared_1distance_1float_1a
+    (JNIEnv* env, jclass, jlong a, jlong b, jlong count) {
+        if (count == 0 || a == 0 || b == 0) {
+            return 0.0f;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %lld", "squared_distance_float - negative count argument:", static_cast<long long>(count));
+            return NOT_REACHED_F;
+        }
+        try {
+            return squared_distance_float(address_ptr<float>(a), address_ptr<float>(b), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "squared_distance_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "squared_distance_float: caught unknown exception");
+        }
+        return NOT_REACHED_F;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    inner_product_float_a
+     * Signature: (JJJ)F
+     */
+    JNIEXPORT jfloat JNICALL Java_net_cramer_simd_SIMD_inner_1product_1float_1a
+    (JNIEnv* env, jclass, jlong a, jlong b, jlong count) {
+        if (count == 0 || a == 0 || b == 0) {
+            return 0.0f;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %lld", "inner_product_float - negative count argument:", static_cast<long long>(count));
+            return NOT_REACHED_F;
+        }
+        try {
+            return dot_float(address_ptr<float>(a), address_ptr<float>(b), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "inner_product_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "inner_product_float: caught unknown exception");
+        }
+        return NOT_REACHED_F;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    cosine_float_a
+     * Signature: (JJJ)F
+     */
+    JNIEXPORT jfloat JNICALL Java_net_cramer_simd_SIMD_cosine_1float_1a
+    (JNIEnv* env, jclass, jlong a, jlong b, jlong count) {
+        if (count == 0 || a == 0 || b == 0) {
+            return 0.0f;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %lld", "cosine_float - negative count argument:", static_cast<long long>(count));
+            return NOT_REACHED_F;
+        }
+        try {
+            return cosine_float(address_ptr<float>(a), address_ptr<float>(b), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "cosine_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "cosine_float: caught unknown exception");
+        }
+        return NOT_REACHED_F;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    distances_float_a
+     * Signature: (JJJJIJ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_distances_1float_1a
+    (JNIEnv* env, jclass, jlong query, jlong base, jlong rows, jlong dim, jint metric, jlong out) {
+        if (rows == 0 || query == 0 || base == 0 || out == 0) {
+            return;
+        }
+        if (rows < 0 || dim < 0) {
+            throwJavaRuntimeException(env, "%s %lld %lld", "distances_float - negative rows / dim argument:",
+                static_cast<long long>(rows), static_cast<long long>(dim));
+            return;
+        }
+        if (metric < METRIC_L2_SQUARED || metric > METRIC_COSINE) {
+            throwJavaRuntimeException(env, "%s %d", "distances_float - unknown metric:", metric);
+            return;
+        }
+        try {
+            distances_float(address_ptr<float>(query), address_ptr<float>(base), rows, dim, metric, address_ptr<float>(out));
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "distances_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "distances_float: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    stats_double_a
+     * Signature: (JJ[D)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_stats_1double_1a
+    (JNIEnv* env, jclass, jlong a, jlong count, jdoubleArray state) {
+        if (count == 0 || a == 0 || state == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %lld", "stats_double - negative count argument:", static_cast<long long>(count));
+            return;
+        }
+        try {
+            DoubleArray ss = DoubleArray(env, state, RUNNING_STATS_LENGTH, JNI_FALSE);
+            stats_double(address_ptr<double>(a), count, *reinterpret_cast<RunningStats*>(ss.ptr()));
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "stats_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "stats_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    stats_float_a
+     * Signature: (JJ[D)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_stats_1float_1a
+    (JNIEnv* env, jclass, jlong a, jlong count, jdoubleArray state) {
+        if (count == 0 || a == 0 || state == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %lld", "stats_float - negative count argument:", static_cast<long long>(count));
+            return;
+        }
+        try {
+            DoubleArray ss = DoubleArray(env, state, RUNNING_STATS_LENGTH, JNI_FALSE);
+            stats_float(address_ptr<float>(a), count, *reinterpret_cast<RunningStats*>(ss.ptr()));
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "stats_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "stats_float: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    compensated_sum_double_a
+     * Signature: (JJ)D
+     */
+    JNIEXPORT jdouble JNICALL Java_net_cramer_simd_SIMD_compensated_1sum_1double_1a
+    (JNIEnv* env, jclass, jlong a, jlong count) {
+        if (count == 0 || a == 0) {
+            return 0.0;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %lld", "compensated_sum_double - negative count argument:", static_cast<long long>(count));
+            return NOT_REACHED_D;
+        }
+        try {
+            return compensated_sum_double(address_ptr<double>(a), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "compensated_sum_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "compensated_sum_double: caught unknown exception");
+        }
+        return NOT_REACHED_D;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    compensated_sum_float_a
+     * Signature: (JJ)F
+     */
+    JNIEXPORT jfloat JNICALL Java_net_cramer_simd_SIMD_compensated_1sum_1float_1a
+    (JNIEnv* env, jclass, jlong a, jlong count) {
+        if (count == 0 || a == 0) {
+            return 0.0f;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %lld", "compensated_sum_float - negative count argument:", static_cast<long long>(count));
+            return NOT_REACHED_F;
+        }
+        try {
+            return compensated_sum_float(address_ptr<float>(a), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "compensated_sum_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "compensated_sum_float: caught unknown exception");
+        }
+        return NOT_REACHED_F;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    compensated_sum_float_d_a
+     * Signature: (JJ)D
+     */
+    JNIEXPORT jdouble JNICALL Java_net_cramer_simd_SIMD_compensated_1sum_1float_1d_1a
+    (JNIEnv* env, jclass, jlong a, jlong count) {
+        if (count == 0 || a == 0) {
+            return 0.0;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %lld", "compensated_sum_float_d - negative count argument:", static_cast<long long>(count));
+            return NOT_REACHED_D;
+        }
+        try {
+            return compensated_sum_float_d(address_ptr<float>(a), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "compensated_sum_float_d", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "compensated_sum_float_d: caught unknown exception");
+        }
+        return NOT_REACHED_D;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    compensated_dot_double_a
+     * Signature: (JJJ)D
+     */
+    JNIEXPORT jdouble JNICALL Java_net_cramer_simd_SIMD_compensated_1dot_1double_1a
+    (JNIEnv* env, jclass, jlong a, jlong b, jlong count) {
+        if (count == 0 || a == 0 || b == 0) {
+            return 0.0;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %lld", "compensated_dot_double - negative count argument:", static_cast<long long>(count));
+            return NOT_REACHED_D;
+        }
+        try {
+            return compensated_dot_double(address_ptr<double>(a), address_ptr<double>(b), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "compensated_dot_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "compensated_dot_double: caught unknown exception");
+        }
+        return NOT_REACHED_D;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    compensated_dot_float_a
+     * Signature: (JJJ)F
+     */
+    JNIEXPORT jfloat JNICALL Java_net_cramer_simd_SIMD_compensated_1dot_1float_1a
+    (JNIEnv* env, jclass, jlong a, jlong b, jlong count) {
+        if (count == 0 || a == 0 || b == 0) {
+            return 0.0f;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %lld", "compensated_dot_float - negative count argument:", static_cast<long long>(count));
+            return NOT_REACHED_F;
+        }
+        try {
+            return compensated_dot_float(address_ptr<float>(a), address_ptr<float>(b), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "compensated_dot_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "compensated_dot_float: caught unknown exception");
+        }
+        return NOT_REACHED_F;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    compensated_dot_float_d_a
+     * Signature: (JJJ)D
+     */
+    JNIEXPORT jdouble JNICALL Java_net_cramer_simd_SIMD_compensated_1dot_1float_1d_1a
+    (JNIEnv* env, jclass, jlong a, jlong b, jlong count) {
+        if (count == 0 || a == 0 || b == 0) {
+            return 0.0;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %lld", "compensated_dot_float_d - negative count argument:", static_cast<long long>(count));
+            return NOT_REACHED_D;
+        }
+        try {
+            return compensated_dot_float_d(address_ptr<float>(a), address_ptr<float>(b), count);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "compensated_dot_float_d", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "compensated_dot_float_d: caught unknown exception");
+        }
+        return NOT_REACHED_D;
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    l2norm_accept_double_n
+     * Signature: ([DI[DZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_l2norm_1accept_1double_1n
+    (JNIEnv* env, jclass, jdoubleArray a, jint count, jdoubleArray state, jboolean useCrit) {
+        if (count == 0 || a == nullptr || state == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "l2norm_accept_double - negative count argument:", count);
+            return;
+        }
+        try {
+            DoubleArray aa = DoubleArray(env, a, count, useCrit, true);
+            DoubleArray ss = DoubleArray(env, state, RUNNING_NORM_LENGTH, useCrit);
+            l2_norm_accept_double(aa.ptr(), count, *reinterpret_cast<RunningNorm*>(ss.ptr()));
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "l2norm_accept_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "l2norm_accept_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    l2norm_accept_double_a
+     * Signature: (JJ[D)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_l2norm_1accept_1double_1a
+    (JNIEnv* env, jclass, jlong a, jlong count, jdoubleArray state) {
+        if (count == 0 || a == 0 || state == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %lld", "l2norm_accept_double - negative count argument:", static_cast<long long>(count));
+            return;
+        }
+        try {
+            DoubleArray ss = DoubleArray(env, state, RUNNING_NORM_LENGTH, JNI_FALSE);
+            l2_norm_accept_double(address_ptr<double>(a), count, *reinterpret_cast<RunningNorm*>(ss.ptr()));
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "l2norm_accept_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "l2norm_accept_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    l2norm_accept_float_n
+     * Signature: ([FI[DZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_l2norm_1accept_1float_1n
+    (JNIEnv* env, jclass, jfloatArray a, jint count, jdoubleArray state, jboolean useCrit) {
+        if (count == 0 || a == nullptr || state == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "l2norm_accept_float - negative count argument:", count);
+            return;
+        }
+        try {
+            FloatArray aa = FloatArray(env, a, count, useCrit, true);
+            DoubleArray ss = DoubleArray(env, state, RUNNING_NORM_LENGTH, useCrit);
+            l2_norm_accept_float(aa.ptr(), count, *reinterpret_cast<RunningNorm*>(ss.ptr()));
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "l2norm_accept_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "l2norm_accept_float: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    l2norm_accept_float_a
+     * Signature: (JJ[D)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_l2norm_1accept_1float_1a
+    (JNIEnv* env, jclass, jlong a, jlong count, jdoubleArray state) {
+        if (count == 0 || a == 0 || state == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %lld", "l2norm_accept_float - negative count argument:", static_cast<long long>(count));
+            return;
+        }
+        try {
+            DoubleArray ss = DoubleArray(env, state, RUNNING_NORM_LENGTH, JNI_FALSE);
+            l2_norm_accept_float(address_ptr<float>(a), count, *reinterpret_cast<RunningNorm*>(ss.ptr()));
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "l2norm_accept_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "l2norm_accept_float: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    distance_accept_double_n
+     * Signature: ([D[DI[DZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_distance_1accept_1double_1n
+    (JNIEnv* env, jclass, jdoubleArray a, jdoubleArray b, jint count, jdoubleArray state, jboolean useCrit) {
+        if (count == 0 || a == nullptr || b == nullptr || state == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "distance_accept_double - negative count argument:", count);
+            return;
+        }
+        try {
+            DoubleArray aa = DoubleArray(env, a, count, useCrit, true);
+            DoubleArray bb = DoubleArray(env, b, count, useCrit, true);
+            DoubleArray ss = DoubleArray(env, state, RUNNING_SUM_LENGTH, useCrit);
+            l1_norm_accept_double(aa.ptr(), bb.ptr(), count, *reinterpret_cast<RunningSum*>(ss.ptr()));
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "distance_accept_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "distance_accept_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    distance_accept_double_a
+     * Signature: (JJJ[D)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_distance_1accept_1double_1a
+    (JNIEnv* env, jclass, jlong a, jlong b, jlong count, jdoubleArray state) {
+        if (count == 0 || a == 0 || b == 0 || state == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %lld", "distance_accept_double - negative count argument:", static_cast<long long>(count));
+            return;
+        }
+        try {
+            DoubleArray ss = DoubleArray(env, state, RUNNING_SUM_LENGTH, JNI_FALSE);
+            l1_norm_accept_double(address_ptr<double>(a), address_ptr<double>(b), count, *reinterpret_cast<RunningSum*>(ss.ptr()));
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "distance_accept_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "distance_accept_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    distance_accept_float_n
+     * Signature: ([F[FI[DZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_distance_1accept_1float_1n
+    (JNIEnv* env, jclass, jfloatArray a, jfloatArray b, jint count, jdoubleArray state, jboolean useCrit) {
+        if (count == 0 || a == nullptr || b == nullptr || state == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "distance_accept_float - negative count argument:", count);
+            return;
+        }
+        try {
+            FloatArray aa = FloatArray(env, a, count, useCrit, true);
+            FloatArray bb = FloatArray(env, b, count, useCrit, true);
+            DoubleArray ss = DoubleArray(env, state, RUNNING_SUM_LENGTH, useCrit);
+            l1_norm_accept_float(aa.ptr(), bb.ptr(), count, *reinterpret_cast<RunningSum*>(ss.ptr()));
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "distance_accept_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "distance_accept_float: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    distance_accept_float_a
+     * Signature: (JJJ[D)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_distance_1accept_1float_1a
+    (JNIEnv* env, jclass, jlong a, jlong b, jlong count, jdoubleArray state) {
+        if (count == 0 || a == 0 || b == 0 || state == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %lld", "distance_accept_float - negative count argument:", static_cast<long long>(count));
+            return;
+        }
+        try {
+            DoubleArray ss = DoubleArray(env, state, RUNNING_SUM_LENGTH, JNI_FALSE);
+            l1_norm_accept_float(address_ptr<float>(a), address_ptr<float>(b), count, *reinterpret_cast<RunningSum*>(ss.ptr()));
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "distance_accept_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "distance_accept_float: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    approx_equal_accept_double_n
+     * Signature: ([D[DIDD[JZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_approx_1equal_1accept_1double_1n
+    (JNIEnv* env, jclass, jdoubleArray a, jdoubleArray b, jint count, jdouble relTol, jdouble absTol, jlongArray state, jboolean useCrit) {
+        if (count == 0 || a == nullptr || b == nullptr || state == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "approx_equal_accept_double - negative count argument:", count);
+            return;
+        }
+        if (relTol < 0.0) {
+            throwJavaRuntimeException(env, "%s %f", "approx_equal_accept_double - relTol < 0.0 :", relTol);
+            return;
+        }
+        if (absTol < 0.0) {
+            throwJavaRuntimeException(env, "%s %f", "approx_equal_accept_double - absTol < 0.0 :", absTol);
+            return;
+        }
+        try {
+            LongArray ss = LongArray(env, state, RUNNING_COMPARE_LENGTH, useCrit);
+            RunningCompare& st = *reinterpret_cast<RunningCompare*>(ss.ptr());
+            DoubleArray aa = DoubleArray(env, a, count, useCrit, true);
+            DoubleArray bb = DoubleArray(env, b, count, useCrit, true);
+            approx_equal_accept_double(aa.ptr(), bb.ptr(), count, relTol, absTol, st);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "approx_equal_accept_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "approx_equal_accept_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    approx_equal_accept_double_a
+     * Signature: (JJJDD[J)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_approx_1equal_1accept_1double_1a
+    (JNIEnv* env, jclass, jlong a, jlong b, jlong count, jdouble relTol, jdouble absTol, jlongArray state) {
+        if (count == 0 || a == 0 || b == 0 || state == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %lld", "approx_equal_accept_double - negative count argument:", static_cast<long long>(count));
+            return;
+        }
+        if (relTol < 0.0) {
+            throwJavaRuntimeException(env, "%s %f", "approx_equal_accept_double - relTol < 0.0 :", relTol);
+            return;
+        }
+        if (absTol < 0.0) {
+            throwJavaRuntimeException(env, "%s %f", "approx_equal_accept_double - absTol < 0.0 :", absTol);
+            return;
+        }
+        try {
+            LongArray ss = LongArray(env, state, RUNNING_COMPARE_LENGTH, JNI_FALSE);
+            RunningCompare& st = *reinterpret_cast<RunningCompare*>(ss.ptr());
+            approx_equal_accept_double(address_ptr<double>(a), address_ptr<double>(b), count, relTol, absTol, st);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "approx_equal_accept_double", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "approx_equal_accept_double: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    approx_equal_accept_float_n
+     * Signature: ([F[FIFF[JZ)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_approx_1equal_1accept_1float_1n
+    (JNIEnv* env, jclass, jfloatArray a, jfloatArray b, jint count, jfloat relTol, jfloat absTol, jlongArray state, jboolean useCrit) {
+        if (count == 0 || a == nullptr || b == nullptr || state == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %d", "approx_equal_accept_float - negative count argument:", count);
+            return;
+        }
+        if (relTol < 0.0f) {
+            throwJavaRuntimeException(env, "%s %f", "approx_equal_accept_float - relTol < 0.0f :", relTol);
+            return;
+        }
+        if (absTol < 0.0f) {
+            throwJavaRuntimeException(env, "%s %f", "approx_equal_accept_float - absTol < 0.0f :", absTol);
+            return;
+        }
+        try {
+            LongArray ss = LongArray(env, state, RUNNING_COMPARE_LENGTH, useCrit);
+            RunningCompare& st = *reinterpret_cast<RunningCompare*>(ss.ptr());
+            FloatArray aa = FloatArray(env, a, count, useCrit, true);
+            FloatArray bb = FloatArray(env, b, count, useCrit, true);
+            approx_equal_accept_float(aa.ptr(), bb.ptr(), count, relTol, absTol, st);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "approx_equal_accept_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "approx_equal_accept_float: caught unknown exception");
+        }
+    }
+
+    /*
+     * Class:     net_cramer_simd_SIMD
+     * Method:    approx_equal_accept_float_a
+     * Signature: (JJJFF[J)V
+     */
+    JNIEXPORT void JNICALL Java_net_cramer_simd_SIMD_approx_1equal_1accept_1float_1a
+    (JNIEnv* env, jclass, jlong a, jlong b, jlong count, jfloat relTol, jfloat absTol, jlongArray state) {
+        if (count == 0 || a == 0 || b == 0 || state == nullptr) {
+            return;
+        }
+        if (count < 0) {
+            throwJavaRuntimeException(env, "%s %lld", "approx_equal_accept_float - negative count argument:", static_cast<long long>(count));
+            return;
+        }
+        if (relTol < 0.0f) {
+            throwJavaRuntimeException(env, "%s %f", "approx_equal_accept_float - relTol < 0.0f :", relTol);
+            return;
+        }
+        if (absTol < 0.0f) {
+            throwJavaRuntimeException(env, "%s %f", "approx_equal_accept_float - absTol < 0.0f :", absTol);
+            return;
+        }
+        try {
+            LongArray ss = LongArray(env, state, RUNNING_COMPARE_LENGTH, JNI_FALSE);
+            RunningCompare& st = *reinterpret_cast<RunningCompare*>(ss.ptr());
+            approx_equal_accept_float(address_ptr<float>(a), address_ptr<float>(b), count, relTol, absTol, st);
+        }
+        catch (const JException& ex) {
+            throwJavaRuntimeException(env, "%s %s", "approx_equal_accept_float", ex.what());
+        }
+        catch (...) {
+            throwJavaRuntimeException(env, "%s", "approx_equal_accept_float: caught unknown exception");
+        }
+    }
+#ifdef __cplusplus
+}
+#endif
+
+
+// precondition: count must be even!
+double l2_norm_double(double* d, int64_t count) {
+    double scale = 0.0;
+    Vec8d vector;
+
+    int64_t i;
+    for (i = 0; i < count - 7; i += STEP_8) {
+        PREFETCH(d + i + 63 * STEP_8);
+        vector.load(d + i);
+        scale = std::max(scale, horizontal_add(abs(vector)));
+    }
+    for (; i < count; i += 2) {
+        double xr = d[i];
+        double xi = d[i + 1];
+        if (xr != 0.0 || xi != 0.0) {
+            scale = std::max(scale, std::abs(xr) + std::abs(xi));
+        }
+    }
+    if (scale == 0.0) {
+        return 0.0;
+    }
+    PREFETCH(d);
+    while (scale <= 1.1) {
+        scale = scale * 1000.0;
+    }
+    scale = 1.0 / scale;
+    Vec8d factor = Vec8d(scale);
+    Vec8d sumsquaredVec = Vec8d(0.0);
+    Vec8d scaled;
+    for (i = 0; i < count - 7; i += STEP_8) {
+        PREFETCH(d + i + 63 * STEP_8);
+        vector.load(d + i);
+        scaled = factor * vector;
+        sumsquaredVec += square(scaled);
+    }
+    double sumsquared = horizontal_add(sumsquaredVec);
+    for (; i < count; ++i) {
+        double x = d[i];
+        if (x != 0.0) {
+            double tmp = scale * x;
+            sumsquared += (tmp * tmp);
+        }
+    }
+
+    return std::sqrt(sumsquared) / scale;
+}
+
+// precondition: count must be even!
+float l2_norm_float(float* f, int64_t count) {
+    float scale = 0.0f;
+    Vec16f vector;
+
+    int64_t i;
+    for (i = 0; i < count - 15; i += STEP_16) {
+        PREFETCH(f + i + 63 * STEP_16);
+        vector.load(f + i);
+        scale = std::max(scale, horizontal_add(abs(vector)));
+    }
+    for (; i < count; i += 2) {
+        float xr = f[i];
+        float xi = f[i + 1];
+        if (xr != 0.0f || xi != 0.0f) {
+            scale = std::max(scale, std::abs(xr) + std::abs(xi));
+        }
+    }
+    if (scale == 0.0f) {
+        return 0.0f;
+    }
+    PREFETCH(f);
+    while (scale <= 1.1f) {
+        scale = scale * 1000.0f;
+    }
+    scale = 1.0f / scale;
+    Vec16f factor = Vec16f(scale);
+    Vec16f sumsquaredVec = Vec16f(0.0f);
+    Vec16f scaled;
+    for (i = 0; i < count - 15; i += STEP_16) {
+        PREFETCH(f + i + 63 * STEP_16);
+        vector.load(f + i);
+        scaled = factor * vector;
+        sumsquaredVec += square(scaled);
+    }
+    float sumsquared = horizontal_add(sumsquaredVec);
+    for (; i < count; ++i) {
+        float x = f[i];
+        if (x != 0.0f) {
+            float tmp = scale * x;
+            sumsquared += (tmp * tmp);
+        }
+    }
+
+    return std::sqrt(sumsquared) / scale;
+}
+
+// bitfield of the lanes where a and b are not within relTol / absTol of each
+// other (a NaN is never within tolerance, not even of itself)
+template <typename V>
+static inline uint32_t tol_mismatch(V const a, V const b, V const relTol, V const absTol) {
+    V absdiff = abs(a - b);
+    return to_bits((a != b) & !((absdiff <= absTol) | (absdiff <= relTol * max(abs(a), abs(b)))));
+}
+
+// maps the bit pattern to an integer that is monotone in the floating point
+// value (-0.0 and 0.0 both map to 0), so that the difference of two mapped
+// values is their distance in ULPs
+static inline Vec8q ordered_bits(Vec8d const x) {
+    Vec8q bits = reinterpret_i(x);
+    return select(bits < 0, Vec8q(INT64_MIN) - bits, bits);
+}
+
+static inline Vec16i ordered_bits(Vec16f const x) {
+    Vec16i bits = reinterpret_i(x);
+    return select(bits < 0, Vec16i(INT32_MIN) - bits, bits);
+}
+
+// bitfield of the lanes where a and b are more than maxUlps apart (or NaN)
+template <typename V, typename VU>
+static inline uint32_t ulp_mismatch(V const a, V const b, VU const maxUlps) {
+    auto oa = ordered_bits(a);
+    auto ob = ordered_bits(b);
+    VU dist = VU(select(oa > ob, oa - ob, ob - oa));
+    return to_bits(dist > maxUlps) | to_bits(is_nan(a)) | to_bits(is_nan(b));
+}
+
+// Returns the index of the first lane for which mismatch(a, b) is set (or -1)
+// and the number of such lanes in found. If firstOnly is true the scan stops
+// at the first mismatch (and found is 1 then).
+template <typename V, typename T, typename Mismatch>
+static inline int64_t scan_mismatch(T* a, T* b, int64_t count, bool firstOnly, int64_t& found, Mismatch mismatch) {
+    constexpr int n = V::size();
+    int64_t first = -1;
+    found = 0;
+    V vecA;
+    V vecB;
+
+    int64_t i;
+    for (i = 0; i <= count - n; i += n) {
+        PREFETCH(a + i + 63 * n);
+        PREFETCH(b + i + 63 * n);
+        vecA.load(a + i);
+        vecB.load(b + i);
+        uint32_t bits = mismatch(vecA, vecB);
+        if (bits != 0) {
+            if (first < 0) {
+                first = i + bit_scan_forward(bits);
+                if (firstOnly) {
+                    found = 1;
+                    return first;
+                }
+            }
+            found += vml_popcnt(bits);
+        }
+    }
+    if (i < count) {
+        // zero padded lanes always compare equal
+        vecA.load_partial(int(count - i), a + i);
+        vecB.load_partial(int(count - i), b + i);
+        uint32_t bits = mismatch(vecA, vecB);
+        if (bits != 0) {
+            if (first < 0) {
+                first = i + bit_scan_forward(bits);
+            }
+            found = firstOnly ? 1 : found + vml_popcnt(bits);
+        }
+    }
+    return first;
+}
+
+int64_t mismatch_double(double* a, double* b, int64_t count, double relTol, double absTol, bool firstOnly, int64_t& found) {
+    Vec8d vRelTol = Vec8d(relTol);
+    Vec8d vAbsTol = Vec8d(absTol);
+    return scan_mismatch<Vec8d>(a, b, count, firstOnly, found, [=](Vec8d const x, Vec8d const y) {
+        return tol_mismatch(x, y, vRelTol, vAbsTol);
+    });
+}
+
+int64_t mismatch_float(float* a, float* b, int64_t count, float relTol, float absTol, bool firstOnly, int64_t& found) {
+    Vec16f vRelTol = Vec16f(relTol);
+    Vec16f vAbsTol = Vec16f(absTol);
+    return scan_mismatch<Vec16f>(a, b, count, firstOnly, found, [=](Vec16f const x, Vec16f const y) {
+        return tol_mismatch(x, y, vRelTol, vAbsTol);
+    });
+}
+
+int64_t mismatch_ulp_double(double* a, double* b, int64_t count, uint64_t maxUlps, bool firstOnly, int64_t& found) {
+    Vec8uq vMaxUlps = Vec8uq(maxUlps);
+    return scan_mismatch<Vec8d>(a, b, count, firstOnly, found, [=](Vec8d const x, Vec8d const y) {
+        return ulp_mismatch(x, y, vMaxUlps);
+    });
+}
+
+int64_t mismatch_ulp_float(float* a, float* b, int64_t count, uint32_t maxUlps, bool firstOnly, int64_t& found) {
+    Vec16ui vMaxUlps = Vec16ui(maxUlps);
+    return scan_mismatch<Vec16f>(a, b, count, firstOnly, found, [=](Vec16f const x, Vec16f const y) {
+        return ulp_mismatch(x, y, vMaxUlps);
+    });
+}
+
+bool approx_equal_double(double* a, double* b, int64_t count, double relTol, double absTol) {
+    int64_t found;
+    return mismatch_double(a, b, count, relTol, absTol, true, found) < 0;
+}
+
+bool approx_equal_float(float* a, float* b, int64_t count, float relTol, float absTol) {
+    int64_t found;
+    return mismatch_float(a, b, count, relTol, absTol, true, found) < 0;
+}
+
+double l1_norm_double(double* a, double* b, int64_t count) {
+    Vec8d vecA;
+    Vec8d vecB;
+    double d1 = 0.0;
+
+    int64_t i;
+    for (i = 0; i < count - 7; i += STEP_8) {
+        PREFETCH(a + i + 63 * STEP_8);
+        PREFETCH(b + i + 63 * STEP_8);
         vecA.load(a + i);
         vecB.load(b + i);
         if (horizontal_or(vecA != vecB)) {
@@ -447,7 +2010,7 @@ float l1_norm_float(float* a, float* b, int64_t count) {
     Vec16f vecB;
     float d1 = 0.0f;
 
-    int i;
+    int64_t i;
     for (i = 0; i < count - 15; i += STEP_16) {
         PREFETCH(a + i + 63 * STEP_16);
         PREFETCH(b + i + 63 * STEP_16);
@@ -466,3 +2029,644 @@ float l1_norm_float(float* a, float* b, int64_t count) {
     }
     return d1;
 }
+
+// The embedding kernels below keep 4 independent accumulators so that
+// consecutive FMAs don't wait on each other
+float squared_distance_float(float* a, float* b, int64_t count) {
+    Vec16f acc0 = Vec16f(0.0f);
+    Vec16f acc1 = Vec16f(0.0f);
+    Vec16f acc2 = Vec16f(0.0f);
+    Vec16f acc3 = Vec16f(0.0f);
+    Vec16f d0, d1, d2, d3;
+
+    int64_t i;
+    for (i = 0; i <= count - 4 * STEP_16; i += 4 * STEP_16) {
+        d0 = Vec16f().load(a + i) - Vec16f().load(b + i);
+        d1 = Vec16f().load(a + i + STEP_16) - Vec16f().load(b + i + STEP_16);
+        d2 = Vec16f().load(a + i + 2 * STEP_16) - Vec16f().load(b + i + 2 * STEP_16);
+        d3 = Vec16f().load(a + i + 3 * STEP_16) - Vec16f().load(b + i + 3 * STEP_16);
+        acc0 = mul_add(d0, d0, acc0);
+        acc1 = mul_add(d1, d1, acc1);
+        acc2 = mul_add(d2, d2, acc2);
+        acc3 = mul_add(d3, d3, acc3);
+    }
+    for (; i <= count - STEP_16; i += STEP_16) {
+        d0 = Vec16f().load(a + i) - Vec16f().load(b + i);
+        acc0 = mul_add(d0, d0, acc0);
+    }
+    if (i < count) {
+        d1 = Vec16f().load_partial(int(count - i), a + i) - Vec16f().load_partial(int(count - i), b + i);
+        acc1 = mul_add(d1, d1, acc1);
+    }
+    return horizontal_add((acc0 + acc1) + (acc2 + acc3));
+}
+
+float dot_float(float* a, float* b, int64_t count) {
+    Vec16f acc0 = Vec16f(0.0f);
+    Vec16f acc1 = Vec16f(0.0f);
+    Vec16f acc2 = Vec16f(0.0f);
+    Vec16f acc3 = Vec16f(0.0f);
+
+    int64_t i;
+    for (i = 0; i <= count - 4 * STEP_16; i += 4 * STEP_16) {
+        acc0 = mul_add(Vec16f().load(a + i), Vec16f().load(b + i), acc0);
+        acc1 = mul_add(Vec16f().load(a + i + STEP_16), Vec16f().load(b + i + STEP_16), acc1);
+        acc2 = mul_add(Vec16f().load(a + i + 2 * STEP_16), Vec16f().load(b + i + 2 * STEP_16), acc2);
+        acc3 = mul_add(Vec16f().load(a + i + 3 * STEP_16), Vec16f().load(b + i + 3 * STEP_16), acc3);
+    }
+    for (; i <= count - STEP_16; i += STEP_16) {
+        acc0 = mul_add(Vec16f().load(a + i), Vec16f().load(b + i), acc0);
+    }
+    if (i < count) {
+        acc1 = mul_add(Vec16f().load_partial(int(count - i), a + i), Vec16f().load_partial(int(count - i), b + i), acc1);
+    }
+    return horizontal_add((acc0 + acc1) + (acc2 + acc3));
+}
+
+// a.b and b.b in one pass (2 x 2 accumulators)
+static inline void dot_norm_float(float* a, float* b, int64_t count, float& ab, float& bb) {
+    Vec16f ab0 = Vec16f(0.0f);
+    Vec16f ab1 = Vec16f(0.0f);
+    Vec16f bb0 = Vec16f(0.0f);
+    Vec16f bb1 = Vec16f(0.0f);
+    Vec16f va0, vb0, va1, vb1;
+
+    int64_t i;
+    for (i = 0; i <= count - 2 * STEP_16; i += 2 * STEP_16) {
+        va0.load(a + i);
+        vb0.load(b + i);
+        va1.load(a + i + STEP_16);
+        vb1.load(b + i + STEP_16);
+        ab0 = mul_add(va0, vb0, ab0);
+        bb0 = mul_add(vb0, vb0, bb0);
+        ab1 = mul_add(va1, vb1, ab1);
+        bb1 = mul_add(vb1, vb1, bb1);
+    }
+    for (; i < count; i += STEP_16) {
+        int n = int(std::min(count - i, int64_t(STEP_16)));
+        va0.load_partial(n, a + i);
+        vb0.load_partial(n, b + i);
+        ab0 = mul_add(va0, vb0, ab0);
+        bb0 = mul_add(vb0, vb0, bb0);
+    }
+    ab = horizontal_add(ab0 + ab1);
+    bb = horizontal_add(bb0 + bb1);
+}
+
+static inline float cosine(float ab, float aa, float bb) {
+    // a zero vector has no direction, report it as orthogonal to everything
+    if (aa == 0.0f || bb == 0.0f) {
+        return 0.0f;
+    }
+    return ab / (std::sqrt(aa) * std::sqrt(bb));
+}
+
+float cosine_float(float* a, float* b, int64_t count) {
+    float ab, bb;
+    dot_norm_float(a, b, count, ab, bb);
+    return cosine(ab, dot_float(a, a, count), bb);
+}
+
+// The metric of query against each of the rows of the row-major rows x dim
+// matrix base, written to out[0 .. rows)
+void distances_float(float* query, float* base, int64_t rows, int64_t dim, int metric, float* out) {
+    switch (metric) {
+    case METRIC_L2_SQUARED:
+        for (int64_t r = 0; r < rows; ++r) {
+            PREFETCH(base + (r + 1) * dim);
+            out[r] = squared_distance_float(query, base + r * dim, dim);
+        }
+        break;
+    case METRIC_INNER_PRODUCT:
+        for (int64_t r = 0; r < rows; ++r) {
+            PREFETCH(base + (r + 1) * dim);
+            out[r] = dot_float(query, base + r * dim, dim);
+        }
+        break;
+    case METRIC_COSINE: {
+        float qq = dot_float(query, query, dim);
+        for (int64_t r = 0; r < rows; ++r) {
+            PREFETCH(base + (r + 1) * dim);
+            float ab, bb;
+            dot_norm_float(query, base + r * dim, dim, ab, bb);
+            out[r] = cosine(ab, qq, bb);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+// Exact power of two scale factor for the largest absolute value m (m > 0),
+// so that scaling doesn't introduce any rounding (the exponent is clamped
+// for tiny m since the reciprocal of the scale factor must stay finite)
+template <typename T>
+static inline T pow2_scale(T m) {
+    int exp;
+    std::frexp(m, &exp);
+    exp = std::max(exp, -(std::numeric_limits<T>::max_exponent - 24));
+    return std::ldexp(T(1), -exp);
+}
+
+template <typename V, typename T>
+static inline T max_abs(T* d, int64_t count) {
+    constexpr int N = V::size();
+    V vmax = V(T(0));
+    V vector;
+
+    int64_t i;
+    for (i = 0; i < count - (N - 1); i += N) {
+        PREFETCH(d + i + 63 * N);
+        vector.load(d + i);
+        vmax = max(vmax, abs(vector));
+    }
+    T m = horizontal_max(vmax);
+    for (; i < count; ++i) {
+        m = std::max(m, std::abs(d[i]));
+    }
+    return m;
+}
+
+// Sum of squares of (scale * x) in the reproducible chunk order
+template <typename V, typename T>
+static inline T sum_squares_repro(T* d, T scale, int64_t count) {
+    constexpr int N = V::size();
+    V factor = V(scale);
+    V vector;
+    ChunkTree<T> tree;
+
+    for (int64_t chunk = 0; chunk < count; chunk += REPRO_CHUNK) {
+        int64_t end = std::min(chunk + REPRO_CHUNK, count);
+        V sumsquaredVec = V(T(0));
+        int64_t i;
+        for (i = chunk; i < end - (N - 1); i += N) {
+            PREFETCH(d + i + 63 * N);
+            vector.load(d + i);
+            vector *= factor;
+            sumsquaredVec = mul_add(vector, vector, sumsquaredVec);
+        }
+        if (i < end) {
+            vector.load_partial(static_cast<int>(end - i), d + i);
+            vector *= factor;
+            sumsquaredVec = mul_add(vector, vector, sumsquaredVec);
+        }
+        tree.add(fold_lanes_fixed<V, T>(sumsquaredVec));
+    }
+    return tree.sum();
+}
+
+template <typename V, typename T>
+static inline T sum_abs_diff_repro(T* a, T* b, int64_t count) {
+    constexpr int N = V::size();
+    V vecA;
+    V vecB;
+    ChunkTree<T> tree;
+
+    for (int64_t chunk = 0; chunk < count; chunk += REPRO_CHUNK) {
+        int64_t end = std::min(chunk + REPRO_CHUNK, count);
+        V d1 = V(T(0));
+        int64_t i;
+        for (i = chunk; i < end - (N - 1); i += N) {
+            PREFETCH(a + i + 63 * N);
+            PREFETCH(b + i + 63 * N);
+            vecA.load(a + i);
+            vecB.load(b + i);
+            d1 += abs(vecA - vecB);
+        }
+        if (i < end) {
+            int rest = static_cast<int>(end - i);
+            vecA.load_partial(rest, a + i);
+            vecB.load_partial(rest, b + i);
+            d1 += abs(vecA - vecB);
+        }
+        tree.add(fold_lanes_fixed<V, T>(d1));
+    }
+    return tree.sum();
+}
+
+template <typename V, typename T>
+static inline T l2_norm_repro(T* d, int64_t count) {
+    T m = max_abs<V>(d, count);
+    if (m == T(0) || !std::isfinite(m)) {
+        // 0, Infinity or NaN
+        return (m == T(0)) ? T(0) : m + sum_squares_repro<V>(d, T(1), count);
+    }
+    T scale = pow2_scale(m);
+    return std::sqrt(sum_squares_repro<V>(d, scale, count)) / scale;
+}
+
+double l2_norm_double_repro(double* d, int64_t count) {
+    return l2_norm_repro<Vec8d>(d, count);
+}
+
+float l2_norm_float_repro(float* f, int64_t count) {
+    return l2_norm_repro<Vec16f>(f, count);
+}
+
+double l1_norm_double_repro(double* a, double* b, int64_t count) {
+    return sum_abs_diff_repro<Vec8d>(a, b, count);
+}
+
+float l1_norm_float_repro(float* a, float* b, int64_t count) {
+    return sum_abs_diff_repro<Vec16f>(a, b, count);
+}
+
+void stats_init(RunningStats& st) {
+    st.count = 0.0;
+    st.nanCount = 0.0;
+    st.sum = 0.0;
+    st.mean = 0.0;
+    st.m2 = 0.0;
+    st.min = std::numeric_limits<double>::infinity();
+    st.max = -std::numeric_limits<double>::infinity();
+}
+
+// Chan et al. pairwise update
+void stats_merge(RunningStats& st, const RunningStats& other) {
+    st.nanCount += other.nanCount;
+    if (other.count == 0.0) {
+        return;
+    }
+    if (st.count == 0.0) {
+        double nanCount = st.nanCount;
+        st = other;
+        st.nanCount = nanCount;
+        return;
+    }
+    double n = st.count + other.count;
+    double delta = other.mean - st.mean;
+    st.mean += delta * (other.count / n);
+    st.m2 += other.m2 + delta * delta * (st.count * (other.count / n));
+    st.sum += other.sum;
+    st.count = n;
+    st.min = std::min(st.min, other.min);
+    st.max = std::max(st.max, other.max);
+}
+
+// Welford update for a single value
+static inline void stats_add(RunningStats& st, double x) {
+    if (std::isnan(x)) {
+        st.nanCount += 1.0;
+        return;
+    }
+    st.count += 1.0;
+    double delta = x - st.mean;
+    st.mean += delta / st.count;
+    st.m2 += delta * (x - st.mean);
+    st.sum += x;
+    st.min = std::min(st.min, x);
+    st.max = std::max(st.max, x);
+}
+
+// Every lane runs its own Welford recurrence (all lanes see the same number
+// of values) and the lanes get merged at the end. Blocks that contain a NaN
+// are rare and take the scalar path.
+class LaneStats {
+public:
+    LaneStats() : n(0.0), mean(0.0), m2(0.0), sum(0.0),
+        vmin(std::numeric_limits<double>::infinity()), vmax(-std::numeric_limits<double>::infinity()) {
+    }
+
+    inline void add(Vec8d x) {
+        n += 1.0;
+        Vec8d delta = x - mean;
+        mean += delta * (1.0 / n);
+        m2 = mul_add(delta, x - mean, m2);
+        sum += x;
+        vmin = min(vmin, x);
+        vmax = max(vmax, x);
+    }
+
+    void mergeInto(RunningStats& st) {
+        if (n == 0.0) {
+            return;
+        }
+        for (int lane = 0; lane < Vec8d::size(); ++lane) {
+            RunningStats ls = { n, 0.0, sum[lane], mean[lane], m2[lane], vmin[lane], vmax[lane] };
+            stats_merge(st, ls);
+        }
+    }
+
+private:
+    double n;
+    Vec8d mean;
+    Vec8d m2;
+    Vec8d sum;
+    Vec8d vmin;
+    Vec8d vmax;
+};
+
+void stats_double(double* a, int64_t count, RunningStats& st) {
+    LaneStats lanes;
+    RunningStats chunk;
+    stats_init(chunk);
+    Vec8d vecA;
+
+    int64_t i;
+    for (i = 0; i < count - 7; i += STEP_8) {
+        PREFETCH(a + i + 63 * STEP_8);
+        vecA.load(a + i);
+        if (horizontal_or(is_nan(vecA))) {
+            for (int j = 0; j < STEP_8; ++j) {
+                stats_add(chunk, a[i + j]);
+            }
+        } else {
+            lanes.add(vecA);
+        }
+    }
+    for (; i < count; ++i) {
+        stats_add(chunk, a[i]);
+    }
+    lanes.mergeInto(st);
+    stats_merge(st, chunk);
+}
+
+// float input, double accumulation
+void stats_float(float* a, int64_t count, RunningStats& st) {
+    LaneStats lanes;
+    RunningStats chunk;
+    stats_init(chunk);
+    Vec16f vecA;
+
+    int64_t i;
+    for (i = 0; i < count - 15; i += STEP_16) {
+        PREFETCH(a + i + 63 * STEP_16);
+        vecA.load(a + i);
+        if (horizontal_or(is_nan(vecA))) {
+            for (int j = 0; j < STEP_16; ++j) {
+                stats_add(chunk, a[i + j]);
+            }
+        } else {
+            lanes.add(to_double(vecA.get_low()));
+            lanes.add(to_double(vecA.get_high()));
+        }
+    }
+    for (; i < count; ++i) {
+        stats_add(chunk, a[i]);
+    }
+    lanes.mergeInto(st);
+    stats_merge(st, chunk);
+}
+
+// Error-free transformation of s + x (Knuth's TwoSum): s receives the rounded
+// sum and the rounding error gets accumulated in c. Branch-free, so it works
+// lane-wise and, unlike Kahan's variant, also when |x| > |s| (Neumaier).
+template <typename V>
+static inline void two_sum(V& s, V& c, V const x) {
+    V t = s + x;
+    V z = t - s;
+    c += (s - (t - z)) + (x - z);
+    s = t;
+}
+
+// Accumulates a * b into (s, c) using the exact product error of an FMA (Dot2
+// of Ogita, Rump and Oishi)
+template <typename V>
+static inline void two_prod_sum(V& s, V& c, V const a, V const b) {
+    V p = a * b;
+    c += mul_sub_x(a, b, p);
+    two_sum(s, c, p);
+}
+
+// Compensated sum of the per-lane sums and error terms
+template <typename V, typename T>
+static inline T fold_lanes(V const s, V const c, T sum, T err) {
+    for (int lane = 0; lane < V::size(); ++lane) {
+        T x = s[lane];
+        T t = sum + x;
+        T z = t - sum;
+        err += (sum - (t - z)) + (x - z) + c[lane];
+        sum = t;
+    }
+    return sum + err;
+}
+
+double compensated_sum_double(double* a, int64_t count) {
+    Vec8d s = Vec8d(0.0);
+    Vec8d c = Vec8d(0.0);
+    Vec8d vecA;
+
+    int64_t i;
+    for (i = 0; i < count - 7; i += STEP_8) {
+        PREFETCH(a + i + 63 * STEP_8);
+        vecA.load(a + i);
+        two_sum(s, c, vecA);
+    }
+    if (i < count) {
+        vecA.load_partial(static_cast<int>(count - i), a + i);
+        two_sum(s, c, vecA);
+    }
+    return fold_lanes(s, c, 0.0, 0.0);
+}
+
+float compensated_sum_float(float* a, int64_t count) {
+    Vec16f s = Vec16f(0.0f);
+    Vec16f c = Vec16f(0.0f);
+    Vec16f vecA;
+
+    int64_t i;
+    for (i = 0; i < count - 15; i += STEP_16) {
+        PREFETCH(a + i + 63 * STEP_16);
+        vecA.load(a + i);
+        two_sum(s, c, vecA);
+    }
+    if (i < count) {
+        vecA.load_partial(static_cast<int>(count - i), a + i);
+        two_sum(s, c, vecA);
+    }
+    return fold_lanes(s, c, 0.0f, 0.0f);
+}
+
+// float input, compensated double accumulation
+double compensated_sum_float_d(float* a, int64_t count) {
+    Vec8d s = Vec8d(0.0);
+    Vec8d c = Vec8d(0.0);
+    Vec16f vecA;
+
+    int64_t i;
+    for (i = 0; i < count - 15; i += STEP_16) {
+        PREFETCH(a + i + 63 * STEP_16);
+        vecA.load(a + i);
+        two_sum(s, c, to_double(vecA.get_low()));
+        two_sum(s, c, to_double(vecA.get_high()));
+    }
+    if (i < count) {
+        vecA.load_partial(static_cast<int>(count - i), a + i);
+        two_sum(s, c, to_double(vecA.get_low()));
+        two_sum(s, c, to_double(vecA.get_high()));
+    }
+    return fold_lanes(s, c, 0.0, 0.0);
+}
+
+double compensated_dot_double(double* a, double* b, int64_t count) {
+    Vec8d s = Vec8d(0.0);
+    Vec8d c = Vec8d(0.0);
+    Vec8d vecA;
+    Vec8d vecB;
+
+    int64_t i;
+    for (i = 0; i < count - 7; i += STEP_8) {
+        PREFETCH(a + i + 63 * STEP_8);
+        PREFETCH(b + i + 63 * STEP_8);
+        vecA.load(a + i);
+        vecB.load(b + i);
+        two_prod_sum(s, c, vecA, vecB);
+    }
+    if (i < count) {
+        int rest = static_cast<int>(count - i);
+        vecA.load_partial(rest, a + i);
+        vecB.load_partial(rest, b + i);
+        two_prod_sum(s, c, vecA, vecB);
+    }
+    return fold_lanes(s, c, 0.0, 0.0);
+}
+
+float compensated_dot_float(float* a, float* b, int64_t count) {
+    Vec16f s = Vec16f(0.0f);
+    Vec16f c = Vec16f(0.0f);
+    Vec16f vecA;
+    Vec16f vecB;
+
+    int64_t i;
+    for (i = 0; i < count - 15; i += STEP_16) {
+        PREFETCH(a + i + 63 * STEP_16);
+        PREFETCH(b + i + 63 * STEP_16);
+        vecA.load(a + i);
+        vecB.load(b + i);
+        two_prod_sum(s, c, vecA, vecB);
+    }
+    if (i < count) {
+        int rest = static_cast<int>(count - i);
+        vecA.load_partial(rest, a + i);
+        vecB.load_partial(rest, b + i);
+        two_prod_sum(s, c, vecA, vecB);
+    }
+    return fold_lanes(s, c, 0.0f, 0.0f);
+}
+
+// float input, compensated double accumulation (the product of two floats
+// is exact in double precision, only the summation needs compensation)
+double compensated_dot_float_d(float* a, float* b, int64_t count) {
+    Vec8d s = Vec8d(0.0);
+    Vec8d c = Vec8d(0.0);
+    Vec16f vecA;
+    Vec16f vecB;
+
+    int64_t i;
+    for (i = 0; i < count - 15; i += STEP_16) {
+        PREFETCH(a + i + 63 * STEP_16);
+        PREFETCH(b + i + 63 * STEP_16);
+        vecA.load(a + i);
+        vecB.load(b + i);
+        two_sum(s, c, to_double(vecA.get_low()) * to_double(vecB.get_low()));
+        two_sum(s, c, to_double(vecA.get_high()) * to_double(vecB.get_high()));
+    }
+    if (i < count) {
+        int rest = static_cast<int>(count - i);
+        vecA.load_partial(rest, a + i);
+        vecB.load_partial(rest, b + i);
+        two_sum(s, c, to_double(vecA.get_low()) * to_double(vecB.get_low()));
+        two_sum(s, c, to_double(vecA.get_high()) * to_double(vecB.get_high()));
+    }
+    return fold_lanes(s, c, 0.0, 0.0);
+}
+
+
+// Streaming reductions: the state of the reduction lives in a Java object
+// and gets updated chunk by chunk. Every chunk is reduced in the fixed
+// order of the reproducible kernels, so the result depends only on the
+// data and on the chunking.
+
+// Adds the sum of squares ssq of values scaled by the power of two scale
+// to the running norm (exact, up to underflow of negligible terms, as the
+// rescaling is by powers of two)
+static inline void norm_add(RunningNorm& st, double scale, double ssq) {
+    if (st.ssq == 0.0) {
+        st.scale = scale;
+        st.ssq = ssq;
+    } else if (scale < st.scale) {
+        double r = scale / st.scale;
+        st.ssq = st.ssq * (r * r) + ssq;
+        st.scale = scale;
+    } else {
+        double r = st.scale / scale;
+        st.ssq += ssq * (r * r);
+    }
+}
+
+template <typename V, typename T>
+static inline void l2_norm_accept(T* d, int64_t count, RunningNorm& st) {
+    st.count += static_cast<double>(count);
+    T m = max_abs<V>(d, count);
+    if (m == T(0)) {
+        return;
+    }
+    if (!std::isfinite(m)) {
+        // Infinity or NaN
+        st.nonFinite += m + sum_squares_repro<V>(d, T(1), count);
+        return;
+    }
+    T scale = pow2_scale(m);
+    T ssq = sum_squares_repro<V>(d, scale, count);
+    if (ssq != T(0)) {
+        norm_add(st, scale, ssq);
+    }
+}
+
+void l2_norm_accept_double(double* a, int64_t count, RunningNorm& st) {
+    l2_norm_accept<Vec8d>(a, count, st);
+}
+
+void l2_norm_accept_float(float* a, int64_t count, RunningNorm& st) {
+    l2_norm_accept<Vec16f>(a, count, st);
+}
+
+static inline void neumaier_add(RunningSum& st, double x) {
+    double t = st.sum + x;
+    if (!std::isfinite(t)) {
+        st.sum = t;
+        return;
+    }
+    if (std::abs(st.sum) >= std::abs(x)) {
+        st.compensation += (st.sum - t) + x;
+    } else {
+        st.compensation += (x - t) + st.sum;
+    }
+    st.sum = t;
+}
+
+void l1_norm_accept_double(double* a, double* b, int64_t count, RunningSum& st) {
+    st.count += static_cast<double>(count);
+    neumaier_add(st, sum_abs_diff_repro<Vec8d>(a, b, count));
+}
+
+void l1_norm_accept_float(float* a, float* b, int64_t count, RunningSum& st) {
+    st.count += static_cast<double>(count);
+    neumaier_add(st, sum_abs_diff_repro<Vec16f>(a, b, count));
+}
+
+// once a mismatch has been found the remaining chunks are only counted
+void approx_equal_accept_double(double* a, double* b, int64_t count, double relTol, double absTol,
+    RunningCompare& st) {
+    if (st.firstMismatch < 0) {
+        int64_t found;
+        int64_t first = mismatch_double(a, b, count, relTol, absTol, true, found);
+        if (first >= 0) {
+            st.firstMismatch = st.count + first;
+        }
+    }
+    st.count += count;
+}
+
+void approx_equal_accept_float(float* a, float* b, int64_t count, float relTol, float absTol,
+    RunningCompare& st) {
+    if (st.firstMismatch < 0) {
+        int64_t found;
+        int64_t first = mismatch_float(a, b, count, relTol, absTol, true, found);
+        if (first >= 0) {
+            st.firstMismatch = st.count + first;
+        }
+    }
+    st.count += count;
+}
@@ -0,0 +1,230 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VECTORIZE_INCLUDED_
+#define VECTORIZE_INCLUDED_
+
+#include <float.h>           // DBL_MAX
+#include <stdint.h>          // int64_t
+#include "vcl/vectorclass.h"
+
+constexpr double NOT_REACHED_D = -10000.0;
+constexpr float NOT_REACHED_F = -10000.0f;
+constexpr double DBL_MIN_VALUE = -DBL_MAX;
+constexpr int STEP_8 = 8;
+constexpr int STEP_16 = 16;
+constexpr int MM_HINT_NTA = 0;
+constexpr int MM_HINT_T0 = 1;
+constexpr int MM_HINT_T1 = 2;
+
+// TODO : should we have a version of the macro which does nothing?
+#if defined (_WIN64) || defined (_WIN32)
+// Windows version
+// Fetch into all levels of the cache hierarchy
+#define PREFETCH(address) (_mm_prefetch((const char*) (address), MM_HINT_T0))
+#else
+// Linux version
+// Fetch into all levels of the cache hierarchy
+#define PREFETCH(address) (_mm_prefetch((address), MM_HINT_T0))
+#endif
+
+
+// Running (mergeable) summary statistics of the non-NaN values
+// seen so far. The layout must be kept in sync with Statistics.java
+struct RunningStats {
+    double count;
+    double nanCount;
+    double sum;
+    double mean;
+    double m2;
+    double min;
+    double max;
+};
+
+constexpr int RUNNING_STATS_LENGTH = 7;
+
+
+// Running state of a streaming l2 norm: the sum of squares of the finite
+// values scaled by a power of two (0 while empty) and the sum of the
+// non-finite ones. The layout must be kept in sync with L2Norm.java
+struct RunningNorm {
+    double count;
+    double scale;
+    double ssq;
+    double nonFinite;
+};
+
+constexpr int RUNNING_NORM_LENGTH = 4;
+
+
+// Running state of a streaming (Neumaier compensated) sum. The layout must
+// be kept in sync with L1Distance.java
+struct RunningSum {
+    double count;
+    double sum;
+    double compensation;
+};
+
+constexpr int RUNNING_SUM_LENGTH = 3;
+
+
+// Running state of a streaming approximate comparison. The layout must be
+// kept in sync with ApproxEqual.java
+struct RunningCompare {
+    int64_t count;
+    int64_t firstMismatch;
+};
+
+constexpr int RUNNING_COMPARE_LENGTH = 2;
+
+
+// Result of a k-means run. The layout must be kept in sync with
+// KMeansResult.java
+struct KMeansStats {
+    double iterations;
+    double inertia;
+    double reassigned;
+    double shift;
+    double emptyClusters;
+    double converged;
+};
+
+constexpr int KMEANS_STATS_LENGTH = 6;
+
+
+// metrics of the embedding distance kernels (see SIMD.java)
+constexpr int METRIC_L2_SQUARED = 0;
+constexpr int METRIC_INNER_PRODUCT = 1;
+constexpr int METRIC_COSINE = 2;
+
+
+// Reproducible reductions: the input is split into chunks of REPRO_CHUNK
+// elements, each chunk is accumulated lane-wise with a fixed number of lanes
+// (8 for double, 16 for float, the logical width of Vec8d / Vec16f on every
+// ISA), the lanes are folded in a fixed pairwise order and the chunk results
+// are combined in a fixed pairwise tree over the chunk index. Hence the
+// result depends only on the data, neither on the instruction set nor on how
+// the chunks are distributed across threads.
+constexpr int64_t REPRO_CHUNK = 4096;
+
+// ((v0 + v1) + (v2 + v3)) + ((v4 + v5) + (v6 + v7)) + ...
+template <typename V, typename T>
+static inline T fold_lanes_fixed(V const v) {
+    T tmp[V::size()];
+    v.store(tmp);
+    for (int width = V::size() / 2; width > 0; width /= 2) {
+        for (int j = 0; j < width; ++j) {
+            tmp[j] = tmp[2 * j] + tmp[2 * j + 1];
+        }
+    }
+    return tmp[0];
+}
+
+// Pairwise summation of the chunk results in the order of the chunk index
+// (a binary counter: two partial sums get combined as soon as they cover
+// subtrees of equal size)
+template <typename T>
+class ChunkTree {
+public:
+    ChunkTree() : n(0) {
+    }
+
+    void add(T x) {
+        int level = 0;
+        for (uint64_t k = n++; (k & 1) != 0; k >>= 1) {
+            x = partial[level++] + x;
+        }
+        partial[level] = x;
+    }
+
+    T sum() const {
+        T result = T(0);
+        bool first = true;
+        for (int level = 0; level < 64; ++level) {
+            if (((n >> level) & 1) != 0) {
+                result = first ? partial[level] : partial[level] + result;
+                first = false;
+            }
+        }
+        return result;
+    }
+
+private:
+    uint64_t n;
+    T partial[64];
+};
+
+
+// kernels implemented in vectorize.cpp
+float l2_norm_float(float* f, int64_t count);
+double l2_norm_double(double* d, int64_t count);
+bool approx_equal_double(double* a, double* b, int64_t count, double relTol, double absTol);
+bool approx_equal_float(float* a, float* b, int64_t count, float relTol, float absTol);
+int64_t mismatch_double(double* a, double* b, int64_t count, double relTol, double absTol, bool firstOnly, int64_t& found);
+int64_t mismatch_float(float* a, float* b, int64_t count, float relTol, float absTol, bool firstOnly, int64_t& found);
+int64_t mismatch_ulp_double(double* a, double* b, int64_t count, uint64_t maxUlps, bool firstOnly, int64_t& found);
+int64_t mismatch_ulp_float(float* a, float* b, int64_t count, uint32_t maxUlps, bool firstOnly, int64_t& found);
+double l1_norm_double(double* a, double* b, int64_t count);
+float l1_norm_float(float* a, float* b, int64_t count);
+double l2_norm_double_repro(double* d, int64_t count);
+float l2_norm_float_repro(float* f, int64_t count);
+float squared_distance_float(float* a, float* b, int64_t count);
+float dot_float(float* a, float* b, int64_t count);
+float cosine_float(float* a, float* b, int64_t count);
+void distances_float(float* query, float* base, int64_t rows, int64_t dim, int metric, float* out);
+double l1_norm_double_repro(double* a, double* b, int64_t count);
+float l1_norm_float_repro(float* a, float* b, int64_t count);
+void stats_init(RunningStats& st);
+void stats_merge(RunningStats& st, const RunningStats& other);
+void stats_double(double* a, int64_t count, RunningStats& st);
+void stats_float(float* a, int64_t count, RunningStats& st);
+double compensated_sum_double(double* a, int64_t count);
+float compensated_sum_float(float* a, int64_t count);
+double compensated_sum_float_d(float* a, int64_t count);
+double compensated_dot_double(double* a, double* b, int64_t count);
+float compensated_dot_float(float* a, float* b, int64_t count);
+double compensated_dot_float_d(float* a, float* b, int64_t count);
+void l2_norm_accept_double(double* a, int64_t count, RunningNorm& st);
+void l2_norm_accept_float(float* a, int64_t count, RunningNorm& st);
+void l1_norm_accept_double(double* a, double* b, int64_t count, RunningSum& st);
+void l1_norm_accept_float(float* a, float* b, int64_t count, RunningSum& st);
+void approx_equal_accept_double(double* a, double* b, int64_t count, double relTol, double absTol,
+    RunningCompare& st);
+void approx_equal_accept_float(float* a, float* b, int64_t count, float relTol, float absTol,
+    RunningCompare& st);
+
+// kernels implemented in quantize.cpp
+void distances_int8(int8_t* query, float queryScale, int8_t* base, float* scales, int64_t rows, int64_t dim,
+    int metric, float* out);
+
+// kernels implemented in half.cpp
+void encode_half(float* x, uint16_t* h, int64_t count, int format);
+void decode_half(uint16_t* h, float* x, int64_t count, int format);
+float dot_half(uint16_t* a, uint16_t* b, int64_t count, int format);
+float squared_distance_half(uint16_t* a, uint16_t* b, int64_t count, int format);
+void distances_half(float* query, uint16_t* base, int64_t rows, int64_t dim, int format, int metric, float* out);
+
+// kernels implemented in kmeans.cpp
+void kmeans_double(double* x, int64_t rows, int64_t ldx, int64_t dim, int64_t k, int maxIterations,
+    double tolerance, uint64_t seed, double* centroids, int32_t* assignments, KMeansStats& stats);
+void kmeans_float(float* x, int64_t rows, int64_t ldx, int64_t dim, int64_t k, int maxIterations,
+    double tolerance, uint64_t seed, float* centroids, int32_t* assignments, KMeansStats& stats);
+double kmeans_assign_double(double* x, int64_t rows, int64_t dim, double* centroids, int64_t k,
+    int32_t* assignments);
+double kmeans_assign_float(float* x, int64_t rows, int64_t dim, float* centroids, int64_t k,
+    int32_t* assignments);
+
+#endif /* VECTORIZE_INCLUDED_ */
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package net.cramer.simd;
+
+/**
+ * Snapshot of the policy by which the native code accesses {@code double[]}
+ * and {@code float[]} arrays. Which of pinning the array (a critical
+ * region), {@code Get<Type>ArrayElements} or a region copy into native
+ * scratch memory is cheapest depends on the JVM and on the array size. On
+ * first use the three strategies are benchmarked for a range of size
+ * classes and from then on the fastest one is used per class. A bound set
+ * with {@link SIMD#setMaxPinMicros(long)} takes precedence.
+ */
+public final class AccessPolicy {
+
+    /** The array is pinned ({@code GetPrimitiveArrayCritical}). */
+    public static final int CRITICAL = 0;
+    /** The array is accessed through {@code Get<Type>ArrayElements}. */
+    public static final int ELEMENTS = 1;
+    /** The array is copied with {@code Get<Type>ArrayRegion}. */
+    public static final int REGION = 2;
+
+    // layout must be kept in sync with struct AccessPolicyInfo in ArrayAccess.h
+    private static final int ADAPTIVE = 0;
+    private static final int CALIBRATED = 1;
+    private static final int MAX_PIN_BYTES = 2;
+    private static final int CLASSES = 3;
+    private static final int CLASS_LENGTH = 5;
+    private static final int MAX_BYTES = 0;
+    private static final int MODE = 1;
+    private static final int NANOS = 2;
+    static final int SIZE_CLASSES = 8;
+    static final int LENGTH = CLASSES + CLASS_LENGTH * SIZE_CLASSES;
+
+    final double[] state = new double[LENGTH];
+
+    AccessPolicy() {
+    }
+
+    public boolean isAdaptive() {
+        return state[ADAPTIVE] != 0.0;
+    }
+
+    /**
+     * Whether the benchmark has run (successfully). Until then, or if the
+     * adaptive policy is disabled, arrays are pinned.
+     */
+    public boolean isCalibrated() {
+        return state[CALIBRATED] != 0.0;
+    }
+
+    /**
+     * Arrays larger than this are always copied in bounded slices ({@code 0}
+     * if there is no bound), see {@link SIMD#setMaxPinMicros(long)}.
+     */
+    public long maxPinBytes() {
+        return (long) state[MAX_PIN_BYTES];
+    }
+
+    public int sizeClasses() {
+        return SIZE_CLASSES;
+    }
+
+    /**
+     * The largest array (in bytes) of size class {@code k}, the size that
+     * was benchmarked. The last class also holds all larger arrays.
+     */
+    public long maxBytes(int k) {
+        return (long) state[index(k) + MAX_BYTES];
+    }
+
+    /**
+     * The strategy ({@link #CRITICAL}, {@link #ELEMENTS} or {@link #REGION})
+     * used for size class {@code k}.
+     */
+    public int mode(int k) {
+        return (int) state[index(k) + MODE];
+    }
+
+    /**
+     * The measured cost of one access (acquire, one read per cache line,
+     * release) of an array of {@link #maxBytes(int)} bytes with the given
+     * strategy in nanoseconds ({@code 0} if not calibrated).
+     */
+    public double nanos(int k, int mode) {
+        if (mode < CRITICAL || mode > REGION) {
+            throw new IllegalArgumentException("unknown mode: " + mode);
+        }
+        return state[index(k) + NANOS + mode];
+    }
+
+    private static int index(int k) {
+        if (k < 0 || k >= SIZE_CLASSES) {
+            throw new IndexOutOfBoundsException("size class: " + k);
+        }
+        return CLASSES + k * CLASS_LENGTH;
+    }
+
+    private static String modeName(int mode) {
+        switch (mode) {
+        case CRITICAL:
+            return "critical";
+        case ELEMENTS:
+            return "elements";
+        default:
+            return "region";
+        }
+    }
+
+    @Override
+    public String toString() {
+        StringBuilder sb = new StringBuilder("AccessPolicy[adaptive=").append(isAdaptive()).append(", calibrated=")
+                .append(isCalibrated()).append(", maxPinBytes=").append(maxPinBytes());
+        for (int k = 0; k < SIZE_CLASSES; ++k) {
+            sb.append(k == 0 ? ", classes=[" : ", ").append(maxBytes(k)).append(": ").append(modeName(mode(k)));
+            if (isCalibrated()) {
+                sb.append(" (").append(nanos(k, CRITICAL)).append(" / ").append(nanos(k, ELEMENTS)).append(" / ")
+                        .append(nanos(k, REGION)).append(" ns)");
+            }
+        }
+        return sb.append("]]").toString();
+    }
+}
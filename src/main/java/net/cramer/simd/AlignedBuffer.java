@@ -0,0 +1,304 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package net.cramer.simd;
+
+import java.lang.ref.PhantomReference;
+import java.lang.ref.Reference;
+import java.lang.ref.ReferenceQueue;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.DoubleBuffer;
+import java.nio.FloatBuffer;
+import java.nio.IntBuffer;
+import java.nio.LongBuffer;
+import java.nio.ReadOnlyBufferException;
+import java.util.Set;
+import java.util.concurrent.ConcurrentHashMap;
+
+/**
+ * Zero-initialized native memory outside of the Java heap, aligned to (at
+ * least) a page and hence to a cache line, or the data of a memory-mapped
+ * {@link MappedMatrix} file. The {@code SIMD} and {@code RNG}
+ * routines that accept an {@code AlignedBuffer} operate on it in place: no
+ * pinning, no copying and counts beyond {@code Integer.MAX_VALUE}. Like the
+ * direct buffer variants they always start at the beginning of the buffer.
+ * <p>
+ * The memory is not managed by the garbage collector, it must be released
+ * with {@link #free()} (or {@link #close()}). Afterwards the buffer can't be
+ * passed to a kernel anymore, but kernels still running on it (in other
+ * threads) and views obtained from {@link #asByteBuffer()} and friends keep
+ * the memory alive: it is released when the last of these calls has
+ * returned and the last view has become unreachable (and been collected).
+ * Views therefore stay safe to use after {@code free()}, they just delay the
+ * release of the memory.
+ */
+public final class AlignedBuffer implements AutoCloseable {
+
+    // allocation flags, must be kept in sync with AlignedBuffer.h
+    private static final int LOCK = 1;
+    private static final int HUGE_PAGES = 2;
+
+    static {
+        try {
+            System.loadLibrary("vector_avx2");
+        } catch (Throwable t) {
+            t.printStackTrace();
+            throw t;
+        }
+    }
+
+    // start and length of the allocation (or mapping) the buffer lives in
+    private final long base;
+    private final long reserved;
+    private final long length;
+    private final int flags;
+    private final boolean mapped;
+    private final boolean readOnly;
+    private volatile long address;
+    // kernel calls in flight plus reachable views (guarded by this)
+    private int users;
+
+    // the views that have not been collected yet, each one counts as a user
+    // of its buffer until it has become unreachable
+    private static final ReferenceQueue<ByteBuffer> collectedViews = new ReferenceQueue<>();
+    private static final Set<View> views = ConcurrentHashMap.newKeySet();
+
+    private static final class View extends PhantomReference<ByteBuffer> {
+        final AlignedBuffer buffer;
+
+        View(ByteBuffer view, AlignedBuffer buffer) {
+            super(view, collectedViews);
+            this.buffer = buffer;
+        }
+    }
+
+    private AlignedBuffer(long base, long reserved, long offset, long length, int flags, boolean mapped,
+            boolean readOnly) {
+        this.base = base;
+        this.reserved = reserved;
+        this.address = base + offset;
+        this.length = length;
+        this.flags = flags;
+        this.mapped = mapped;
+        this.readOnly = readOnly;
+    }
+
+    /**
+     * The {@code length} bytes at {@code offset} of a file mapping, freeing
+     * the buffer unmaps the whole file.
+     */
+    static AlignedBuffer mapped(long base, long mappedLength, long offset, long length, boolean readOnly) {
+        return new AlignedBuffer(base, mappedLength, offset, length, 0, true, readOnly);
+    }
+
+    public static AlignedBuffer allocate(long bytes) {
+        return allocate(bytes, false, false);
+    }
+
+    /**
+     * Allocates {@code bytes} bytes of native memory. With {@code lock} the
+     * memory gets locked into physical memory ({@code mlock} /
+     * {@code VirtualLock}), with {@code hugePages} it gets backed by
+     * (transparent) huge pages, on Windows this needs the "Lock pages in
+     * memory" privilege. Both are best effort, see {@link #isLocked()} and
+     * {@link #isHugePages()}.
+     *
+     * @throws OutOfMemoryError
+     *             if the memory can't be allocated
+     */
+    public static AlignedBuffer allocate(long bytes, boolean lock, boolean hugePages) {
+        if (bytes <= 0L) {
+            throw new IllegalArgumentException("bytes must be positive: " + bytes);
+        }
+        releaseCollectedViews();
+        long[] info = new long[2];
+        long address = allocate_n(bytes, (lock ? LOCK : 0) | (hugePages ? HUGE_PAGES : 0), info);
+        if (address == 0L) {
+            throw new OutOfMemoryError("Cannot allocate " + bytes + " bytes of native memory");
+        }
+        return new AlignedBuffer(address, info[0], 0L, bytes, (int) info[1], false, false);
+    }
+
+    /**
+     * Length in bytes.
+     */
+    public long length() {
+        return length;
+    }
+
+    public boolean isLocked() {
+        return (flags & LOCK) != 0;
+    }
+
+    public boolean isHugePages() {
+        return (flags & HUGE_PAGES) != 0;
+    }
+
+    public boolean isMapped() {
+        return mapped;
+    }
+
+    /**
+     * Whether the buffer is a read-only file mapping. Its views are
+     * read-only and it can't be used as the output of a kernel.
+     */
+    public boolean isReadOnly() {
+        return readOnly;
+    }
+
+    public boolean isFreed() {
+        return address == 0L;
+    }
+
+    /**
+     * A direct {@code ByteBuffer} in native byte order over the whole buffer
+     * (which must not be longer than {@code Integer.MAX_VALUE} bytes).
+     */
+    public ByteBuffer asByteBuffer() {
+        if (length > Integer.MAX_VALUE) {
+            throw new UnsupportedOperationException("buffer too large for a ByteBuffer view: " + length);
+        }
+        return view(0L, (int) length);
+    }
+
+    /**
+     * A direct {@code ByteBuffer} in native byte order over the
+     * {@code bytes} bytes starting at {@code offset}. The view (and the
+     * buffers derived from it) keeps the memory alive after {@link #free()}
+     * until it gets collected.
+     */
+    public ByteBuffer view(long offset, int bytes) {
+        releaseCollectedViews();
+        long a = acquire(offset, bytes, 1);
+        ByteBuffer view;
+        try {
+            view = view_n(a, bytes);
+        } catch (RuntimeException | Error e) {
+            release();
+            throw e;
+        }
+        // derived buffers (read-only, typed, slices) reference the view
+        views.add(new View(view, this));
+        return (readOnly ? view.asReadOnlyBuffer() : view).order(ByteOrder.nativeOrder());
+    }
+
+    public DoubleBuffer asDoubleBuffer() {
+        return asByteBuffer().asDoubleBuffer();
+    }
+
+    public FloatBuffer asFloatBuffer() {
+        return asByteBuffer().asFloatBuffer();
+    }
+
+    public IntBuffer asIntBuffer() {
+        return asByteBuffer().asIntBuffer();
+    }
+
+    public LongBuffer asLongBuffer() {
+        return asByteBuffer().asLongBuffer();
+    }
+
+    /**
+     * Releases the native memory (unmaps the file), or marks it for release
+     * when the kernel calls still running on it have returned and its views
+     * have been collected. Calling it more than once has no effect.
+     */
+    public void free() {
+        synchronized (this) {
+            if (address != 0L) {
+                address = 0L;
+                if (users == 0) {
+                    releaseMemory();
+                }
+            }
+        }
+        releaseCollectedViews();
+    }
+
+    @Override
+    public void close() {
+        free();
+    }
+
+    /**
+     * Address of the elements {@code [offset, offset + count)} of size
+     * {@code elementBytes}, checked against the bounds of the buffer. The
+     * memory stays valid until the matching {@link #release()}, which must
+     * be called in a {@code finally} block.
+     */
+    synchronized long acquire(long offset, long count, int elementBytes) {
+        long a = address;
+        if (a == 0L) {
+            throw new IllegalStateException("AlignedBuffer has already been freed");
+        }
+        if (offset < 0L || count < 0L || offset > length / elementBytes - count) {
+            throw new IndexOutOfBoundsException("offset: " + offset + ", count: " + count + ", capacity: "
+                    + (length / elementBytes));
+        }
+        ++users;
+        return a + offset * elementBytes;
+    }
+
+    long acquire(long count, int elementBytes) {
+        return acquire(0L, count, elementBytes);
+    }
+
+    /**
+     * Like {@link #acquire(long, long, int)} for elements that get written.
+     */
+    long acquireWritable(long offset, long count, int elementBytes) {
+        if (readOnly) {
+            throw new ReadOnlyBufferException();
+        }
+        return acquire(offset, count, elementBytes);
+    }
+
+    synchronized void release() {
+        if (--users == 0 && address == 0L) {
+            releaseMemory();
+        }
+    }
+
+    private void releaseMemory() {
+        if (mapped) {
+            MappedMatrix.unmap(base, reserved);
+        } else {
+            free_n(base, reserved);
+        }
+    }
+
+    private static void releaseCollectedViews() {
+        Reference<? extends ByteBuffer> ref;
+        while ((ref = collectedViews.poll()) != null) {
+            View view = (View) ref;
+            views.remove(view);
+            view.buffer.release();
+        }
+    }
+
+    @Override
+    public String toString() {
+        return "AlignedBuffer[length=" + length + ", reserved=" + reserved + ", locked=" + isLocked()
+                + ", hugePages=" + isHugePages() + ", mapped=" + mapped + ", readOnly=" + readOnly + ", freed="
+                + isFreed() + "]";
+    }
+
+    private static native long allocate_n(long bytes, int flags, long[] info);
+
+    private static native void free_n(long address, long reserved);
+
+    private static native ByteBuffer view_n(long address, long bytes);
+}
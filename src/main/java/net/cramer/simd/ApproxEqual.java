@@ -0,0 +1,95 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package net.cramer.simd;
+
+/**
+ * Streaming version of {@link SIMD#approxEqualDouble(double[], double[], int, double, double)}
+ * that remembers the position of the first mismatch among the pairs of values
+ * seen so far. Once a mismatch has been found the following chunks are only
+ * counted, not compared. Passing the same array as {@code a} and {@code b}
+ * still compares its elements, so a NaN is always reported as a mismatch.
+ * Not thread-safe.
+ */
+public final class ApproxEqual {
+
+    // layout must be kept in sync with struct RunningCompare in vectorize.h
+    private static final int COUNT = 0;
+    private static final int FIRST_MISMATCH = 1;
+    static final int LENGTH = 2;
+
+    final long[] state = new long[LENGTH];
+    final double relTol;
+    final double absTol;
+
+    public ApproxEqual(double relTol, double absTol) {
+        if (!(relTol >= 0.0) || !(absTol >= 0.0)) {
+            throw new IllegalArgumentException("relTol / absTol must be >= 0: " + relTol + " / " + absTol);
+        }
+        this.relTol = relTol;
+        this.absTol = absTol;
+        state[FIRST_MISMATCH] = -1L;
+    }
+
+    public ApproxEqual accept(double[] a, double[] b, int count) {
+        SIMD.approxEqualDouble(a, b, count, this);
+        return this;
+    }
+
+    /**
+     * Compares in single precision with the tolerances rounded to float.
+     */
+    public ApproxEqual accept(float[] a, float[] b, int count) {
+        SIMD.approxEqualFloat(a, b, count, this);
+        return this;
+    }
+
+    /**
+     * Accepts the first {@code count} doubles of {@code a} and {@code b}.
+     */
+    public ApproxEqual acceptDouble(AlignedBuffer a, AlignedBuffer b, long count) {
+        SIMD.approxEqualDoubleAligned(a, b, count, this);
+        return this;
+    }
+
+    /**
+     * Accepts the first {@code count} floats of {@code a} and {@code b}.
+     */
+    public ApproxEqual acceptFloat(AlignedBuffer a, AlignedBuffer b, long count) {
+        SIMD.approxEqualFloatAligned(a, b, count, this);
+        return this;
+    }
+
+    public long count() {
+        return state[COUNT];
+    }
+
+    public boolean isEqual() {
+        return state[FIRST_MISMATCH] < 0L;
+    }
+
+    /**
+     * The index (counted over all accepted chunks) of the first pair that
+     * doesn't match or -1 if all pairs seen so far match.
+     */
+    public long firstMismatch() {
+        return state[FIRST_MISMATCH];
+    }
+
+    @Override
+    public String toString() {
+        return "ApproxEqual[count=" + count() + ", firstMismatch=" + firstMismatch() + "]";
+    }
+}
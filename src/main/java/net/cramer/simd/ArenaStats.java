@@ -0,0 +1,99 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package net.cramer.simd;
+
+/**
+ * Snapshot of the usage of the native scratch memory arenas. Each thread
+ * that calls into a kernel needing temporary memory owns an arena of
+ * 64-byte aligned blocks which is reset at the end of every native call and
+ * keeps up to 64 MiB of blocks for reuse. The per-thread values refer to the
+ * thread that took the snapshot.
+ */
+public final class ArenaStats {
+
+    // layout must be kept in sync with Arena.h
+    private static final int THREAD_IN_USE = 0;
+    private static final int THREAD_HIGH_WATER = 1;
+    private static final int THREAD_RESERVED = 2;
+    private static final int HIGH_WATER = 3;
+    private static final int RESERVED = 4;
+    private static final int PEAK_RESERVED = 5;
+    private static final int HUGE_RESERVED = 6;
+    static final int LENGTH = 7;
+
+    final long[] state = new long[LENGTH];
+
+    ArenaStats() {
+    }
+
+    /**
+     * Bytes currently allocated from the calling thread's arena (normally
+     * {@code 0} between native calls).
+     */
+    public long threadInUse() {
+        return state[THREAD_IN_USE];
+    }
+
+    /**
+     * Most bytes that were ever allocated at the same time from the calling
+     * thread's arena.
+     */
+    public long threadHighWater() {
+        return state[THREAD_HIGH_WATER];
+    }
+
+    /**
+     * Bytes of the blocks the calling thread's arena holds.
+     */
+    public long threadReserved() {
+        return state[THREAD_RESERVED];
+    }
+
+    /**
+     * Largest high-water mark of all arenas so far.
+     */
+    public long highWater() {
+        return state[HIGH_WATER];
+    }
+
+    /**
+     * Bytes of the blocks all arenas hold together.
+     */
+    public long reserved() {
+        return state[RESERVED];
+    }
+
+    /**
+     * Most bytes all arenas ever held together.
+     */
+    public long peakReserved() {
+        return state[PEAK_RESERVED];
+    }
+
+    /**
+     * Part of {@link #reserved()} that is backed by (transparent) huge pages.
+     */
+    public long hugeReserved() {
+        return state[HUGE_RESERVED];
+    }
+
+    @Override
+    public String toString() {
+        return "ArenaStats[threadInUse=" + threadInUse() + ", threadHighWater=" + threadHighWater()
+                + ", threadReserved=" + threadReserved() + ", highWater=" + highWater() + ", reserved="
+                + reserved() + ", peakReserved=" + peakReserved() + ", hugeReserved=" + hugeReserved() + "]";
+    }
+}
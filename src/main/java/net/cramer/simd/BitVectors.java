@@ -0,0 +1,86 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package net.cramer.simd;
+
+/**
+ * Popcount and Hamming distance of bit vectors (binary signatures) stored as
+ * {@code words} consecutive {@code long}s each, a set of {@code rows} bit
+ * vectors being the row-major {@code rows x words} matrix in one
+ * {@code long[]} array. Signatures of 256 bits ({@code words = 4}) and 512
+ * bits ({@code words = 8}) take a specialized path.
+ */
+public final class BitVectors {
+
+    private static final boolean USE_CRITICAL = true;
+
+    static {
+        try {
+            System.loadLibrary("vector_avx2");
+        } catch (Throwable t) {
+            t.printStackTrace();
+            throw t;
+        }
+    }
+
+    /**
+     * Number of set bits in {@code a[0 .. words)}.
+     */
+    public static long popcount(long[] a, int words) {
+        return popcount_n(a, words, USE_CRITICAL);
+    }
+
+    /**
+     * Number of bits that differ between {@code a[0 .. words)} and
+     * {@code b[0 .. words)}.
+     */
+    public static long hammingDistance(long[] a, long[] b, int words) {
+        return distance_n(a, b, words, USE_CRITICAL);
+    }
+
+    /**
+     * Hamming distances of the bit vector {@code query} to each of the
+     * {@code rows} bit vectors in {@code base}, written to
+     * {@code out[0 .. rows)}.
+     */
+    public static void hammingDistances(long[] query, long[] base, int rows, int words, int[] out) {
+        distances_n(query, base, rows, words, out, USE_CRITICAL);
+    }
+
+    /**
+     * Hamming distances of each of the {@code rowsA} bit vectors in {@code a}
+     * to each of the {@code rowsB} bit vectors in {@code b}, written to the
+     * row-major {@code rowsA x rowsB} matrix {@code out}, i.e. the distance
+     * of row {@code i} of {@code a} to row {@code j} of {@code b} is
+     * {@code out[i * rowsB + j]}.
+     */
+    public static void hammingDistancesPairwise(long[] a, int rowsA, long[] b, int rowsB, int words, int[] out) {
+        pairwise_n(a, rowsA, b, rowsB, words, out, USE_CRITICAL);
+    }
+
+    private static native long popcount_n(long[] a, int words, boolean useCriticalRegion);
+
+    private static native long distance_n(long[] a, long[] b, int words, boolean useCriticalRegion);
+
+    private static native void distances_n(long[] query, long[] base, int rows, int words, int[] out,
+            boolean useCriticalRegion);
+
+    private static native void pairwise_n(long[] a, int rowsA, long[] b, int rowsB, int words, int[] out,
+            boolean useCriticalRegion);
+
+    private BitVectors() {
+        throw new AssertionError();
+    }
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package net.cramer.simd;
+
+import java.nio.Buffer;
+import java.nio.ByteOrder;
+import java.nio.DoubleBuffer;
+import java.nio.FloatBuffer;
+import java.nio.IntBuffer;
+import java.nio.LongBuffer;
+import java.util.Objects;
+
+/**
+ * Argument checks for the direct buffer variants of the native routines.
+ * Note that the native routines always start at index 0 of a buffer, its
+ * position is ignored (use {@code slice()} to operate on a sub-range).
+ */
+final class Buffers {
+
+    static DoubleBuffer checkDirect(DoubleBuffer buf, String name) {
+        checkDirect((Buffer) buf, name);
+        checkOrder(buf.order(), name);
+        return buf;
+    }
+
+    static FloatBuffer checkDirect(FloatBuffer buf, String name) {
+        checkDirect((Buffer) buf, name);
+        checkOrder(buf.order(), name);
+        return buf;
+    }
+
+    static IntBuffer checkDirect(IntBuffer buf, String name) {
+        checkDirect((Buffer) buf, name);
+        checkOrder(buf.order(), name);
+        return buf;
+    }
+
+    static LongBuffer checkDirect(LongBuffer buf, String name) {
+        checkDirect((Buffer) buf, name);
+        checkOrder(buf.order(), name);
+        return buf;
+    }
+
+    private static void checkDirect(Buffer buf, String name) {
+        if (!Objects.requireNonNull(buf, name).isDirect()) {
+            throw new IllegalArgumentException(name + " must be a direct buffer");
+        }
+    }
+
+    private static void checkOrder(ByteOrder order, String name) {
+        if (order != ByteOrder.nativeOrder()) {
+            throw new IllegalArgumentException(name + " must use the native byte order");
+        }
+    }
+
+    private Buffers() {
+        throw new AssertionError();
+    }
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package net.cramer.simd;
+
+/**
+ * 16 bit floating point storage formats: IEEE 754 half precision
+ * ({@code float16}) and {@code bfloat16} (the upper 16 bits of a
+ * {@code float}), both held in {@code short} arrays.
+ * <p>
+ * Encoding rounds to nearest even ({@code float16} overflows to infinity,
+ * NaNs stay NaNs), decoding is exact. The kernels convert to {@code float}
+ * in registers and do all arithmetic and accumulation in {@code float}, so
+ * halving the storage (and the memory bandwidth) doesn't cost precision
+ * beyond the rounding of the stored values.
+ */
+public final class HalfPrecision {
+
+    private static final boolean USE_CRITICAL = true;
+
+    // must be kept in sync with half.cpp
+    private static final int FORMAT_FP16 = 0;
+    private static final int FORMAT_BF16 = 1;
+
+    // must be kept in sync with the metrics in vectorize.h
+    private static final int METRIC_L2_SQUARED = 0;
+    private static final int METRIC_INNER_PRODUCT = 1;
+    private static final int METRIC_COSINE = 2;
+
+    static {
+        try {
+            System.loadLibrary("vector_avx2");
+        } catch (Throwable t) {
+            t.printStackTrace();
+            throw t;
+        }
+    }
+
+    public static void encodeFloat16(float[] x, short[] h, int count) {
+        encode_n(x, h, count, FORMAT_FP16, USE_CRITICAL);
+    }
+
+    public static void decodeFloat16(short[] h, float[] x, int count) {
+        decode_n(h, x, count, FORMAT_FP16, USE_CRITICAL);
+    }
+
+    public static void encodeBFloat16(float[] x, short[] h, int count) {
+        encode_n(x, h, count, FORMAT_BF16, USE_CRITICAL);
+    }
+
+    public static void decodeBFloat16(short[] h, float[] x, int count) {
+        decode_n(h, x, count, FORMAT_BF16, USE_CRITICAL);
+    }
+
+    public static float dotFloat16(short[] a, short[] b, int count) {
+        return dot_n(a, b, count, FORMAT_FP16, USE_CRITICAL);
+    }
+
+    public static float squaredDistanceFloat16(short[] a, short[] b, int count) {
+        return squared_distance_n(a, b, count, FORMAT_FP16, USE_CRITICAL);
+    }
+
+    public static float dotBFloat16(short[] a, short[] b, int count) {
+        return dot_n(a, b, count, FORMAT_BF16, USE_CRITICAL);
+    }
+
+    public static float squaredDistanceBFloat16(short[] a, short[] b, int count) {
+        return squared_distance_n(a, b, count, FORMAT_BF16, USE_CRITICAL);
+    }
+
+    /**
+     * Squared euclidean distances of the float {@code query} to each of the
+     * {@code rows} float16 rows of the row-major {@code rows x dim} matrix
+     * {@code base}, written to {@code out[0 .. rows)}.
+     */
+    public static void squaredDistancesFloat16(float[] query, short[] base, int rows, int dim, float[] out) {
+        distances_n(query, base, rows, dim, FORMAT_FP16, METRIC_L2_SQUARED, out, USE_CRITICAL);
+    }
+
+    /**
+     * Inner products of the float {@code query} with each of the {@code rows}
+     * float16 rows of {@code base}, written to {@code out[0 .. rows)}.
+     */
+    public static void innerProductsFloat16(float[] query, short[] base, int rows, int dim, float[] out) {
+        distances_n(query, base, rows, dim, FORMAT_FP16, METRIC_INNER_PRODUCT, out, USE_CRITICAL);
+    }
+
+    /**
+     * Cosine similarities of the float {@code query} to each of the
+     * {@code rows} float16 rows of {@code base}, written to
+     * {@code out[0 .. rows)}. A zero vector has similarity 0 to everything.
+     */
+    public static void cosineSimilaritiesFloat16(float[] query, short[] base, int rows, int dim, float[] out) {
+        distances_n(query, base, rows, dim, FORMAT_FP16, METRIC_COSINE, out, USE_CRITICAL);
+    }
+
+    /**
+     * Squared euclidean distances of the float {@code query} to each of the
+     * {@code rows} bfloat16 rows of the row-major {@code rows x dim} matrix
+     * {@code base}, written to {@code out[0 .. rows)}.
+     */
+    public static void squaredDistancesBFloat16(float[] query, short[] base, int rows, int dim, float[] out) {
+        distances_n(query, base, rows, dim, FORMAT_BF16, METRIC_L2_SQUARED, out, USE_CRITICAL);
+    }
+
+    /**
+     * Inner products of the float {@code query} with each of the {@code rows}
+     * bfloat16 rows of {@code base}, written to {@code out[0 .. rows)}.
+     */
+    public static void innerProductsBFloat16(float[] query, short[] base, int rows, int dim, float[] out) {
+        distances_n(query, base, rows, dim, FORMAT_BF16, METRIC_INNER_PRODUCT, out, USE_CRITICAL);
+    }
+
+    /**
+     * Cosine similarities of the float {@code query} to each of the
+     * {@code rows} bfloat16 rows of {@code base}, written to
+     * {@code out[0 .. rows)}. A zero vector has similarity 0 to everything.
+     */
+    public static void cosineSimilaritiesBFloat16(float[] query, short[] base, int rows, int dim, float[] out) {
+        distances_n(query, base, rows, dim, FORMAT_BF16, METRIC_COSINE, out, USE_CRITICAL);
+    }
+
+    private static native void encode_n(float[] x, short[] h, int count, int format, boolean useCriticalRegion);
+
+    private static native void decode_n(short[] h, float[] x, int count, int format, boolean useCriticalRegion);
+
+    private static native float dot_n(short[] a, short[] b, int count, int format, boolean useCriticalRegion);
+
+    private static native float squared_distance_n(short[] a, short[] b, int count, int format,
+            boolean useCriticalRegion);
+
+    private static native void distances_n(float[] query, short[] base, int rows, int dim, int format, int metric,
+            float[] out, boolean useCriticalRegion);
+
+    private HalfPrecision() {
+        throw new AssertionError();
+    }
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package net.cramer.simd;
+
+/**
+ * k-means clustering (Lloyd iterations) of the rows of a row-major
+ * {@code rows x dim} matrix.
+ * <p>
+ * The centroids are seeded with k-means++ from the given {@code seed}, each
+ * iteration assigns every row to its nearest centroid (squared euclidean
+ * distance, ties go to the smaller centroid index) and moves the centroids to
+ * the mean of their rows. An empty cluster is re-seeded with the row that is
+ * farthest from its centroid. The iterations stop when no assignment changes,
+ * when the inertia improves by no more than {@code tolerance} relative to the
+ * previous iteration or after {@code maxIterations} updates. The final
+ * assignments are always those of the returned centroids.
+ */
+public final class KMeans {
+
+    private static final boolean USE_CRITICAL = true;
+
+    static {
+        try {
+            System.loadLibrary("vector_avx2");
+        } catch (Throwable t) {
+            t.printStackTrace();
+            throw t;
+        }
+    }
+
+    /**
+     * Clusters the {@code rows} rows of {@code x} into {@code 0 < k <= rows}
+     * clusters. The centroids are written to {@code centroids} (length
+     * {@code k * dim}), the cluster index of each row to
+     * {@code assignments[0 .. rows)}.
+     */
+    public static KMeansResult clusterDouble(double[] x, int rows, int dim, int k, int maxIterations,
+            double tolerance, long seed, double[] centroids, int[] assignments) {
+        KMeansResult result = new KMeansResult();
+        cluster_double_n(x, rows, dim, k, maxIterations, tolerance, seed, centroids, assignments, result.state,
+                USE_CRITICAL);
+        return result;
+    }
+
+    /**
+     * Clusters the {@code rows} rows of {@code x} into {@code 0 < k <= rows}
+     * clusters. The centroids are written to {@code centroids} (length
+     * {@code k * dim}), the cluster index of each row to
+     * {@code assignments[0 .. rows)}.
+     */
+    public static KMeansResult clusterFloat(float[] x, int rows, int dim, int k, int maxIterations,
+            double tolerance, long seed, float[] centroids, int[] assignments) {
+        KMeansResult result = new KMeansResult();
+        cluster_float_n(x, rows, dim, k, maxIterations, tolerance, seed, centroids, assignments, result.state,
+                USE_CRITICAL);
+        return result;
+    }
+
+    /**
+     * Assigns each of the {@code rows} rows of {@code x} to the nearest of the
+     * {@code k} {@code centroids} and returns the inertia (the sum of the
+     * squared distances to the assigned centroids).
+     */
+    public static double assignDouble(double[] x, int rows, int dim, double[] centroids, int k, int[] assignments) {
+        return assign_double_n(x, rows, dim, centroids, k, assignments, USE_CRITICAL);
+    }
+
+    /**
+     * Assigns each of the {@code rows} rows of {@code x} to the nearest of the
+     * {@code k} {@code centroids} and returns the inertia (the sum of the
+     * squared distances to the assigned centroids).
+     */
+    public static double assignFloat(float[] x, int rows, int dim, float[] centroids, int k, int[] assignments) {
+        return assign_float_n(x, rows, dim, centroids, k, assignments, USE_CRITICAL);
+    }
+
+    private static native void cluster_double_n(double[] x, int rows, int dim, int k, int maxIterations,
+            double tolerance, long seed, double[] centroids, int[] assignments, double[] stats,
+            boolean useCriticalRegion);
+
+    private static native void cluster_float_n(float[] x, int rows, int dim, int k, int maxIterations,
+            double tolerance, long seed, float[] centroids, int[] assignments, double[] stats,
+            boolean useCriticalRegion);
+
+    private static native double assign_double_n(double[] x, int rows, int dim, double[] centroids, int k,
+            int[] assignments, boolean useCriticalRegion);
+
+    private static native double assign_float_n(float[] x, int rows, int dim, float[] centroids, int k,
+            int[] assignments, boolean useCriticalRegion);
+
+    private KMeans() {
+        throw new AssertionError();
+    }
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package net.cramer.simd;
+
+/**
+ * Convergence statistics of a {@link KMeans} run.
+ */
+public final class KMeansResult {
+
+    // the layout must be kept in sync with KMeansStats in vectorize.h
+    private static final int ITERATIONS = 0;
+    private static final int INERTIA = 1;
+    private static final int REASSIGNED = 2;
+    private static final int SHIFT = 3;
+    private static final int EMPTY_CLUSTERS = 4;
+    private static final int CONVERGED = 5;
+    static final int LENGTH = 6;
+
+    final double[] state = new double[LENGTH];
+
+    KMeansResult() {
+    }
+
+    /**
+     * Number of centroid updates that were performed.
+     */
+    public int iterations() {
+        return (int) state[ITERATIONS];
+    }
+
+    /**
+     * Sum of the squared distances of the rows to their assigned centroid.
+     */
+    public double inertia() {
+        return state[INERTIA];
+    }
+
+    /**
+     * Number of rows whose assignment changed in the last assignment step.
+     */
+    public long reassigned() {
+        return (long) state[REASSIGNED];
+    }
+
+    /**
+     * Largest squared distance a centroid moved in the last update.
+     */
+    public double shift() {
+        return state[SHIFT];
+    }
+
+    /**
+     * Number of times an empty cluster had to be re-seeded.
+     */
+    public int emptyClusters() {
+        return (int) state[EMPTY_CLUSTERS];
+    }
+
+    /**
+     * Whether the run stopped because the assignments became stable or the
+     * relative inertia improvement fell below the tolerance (rather than
+     * because {@code maxIterations} was reached).
+     */
+    public boolean converged() {
+        return state[CONVERGED] != 0.0;
+    }
+
+    @Override
+    public String toString() {
+        return "KMeansResult[iterations=" + iterations() + ", inertia=" + inertia() + ", reassigned=" + reassigned()
+                + ", shift=" + shift() + ", emptyClusters=" + emptyClusters() + ", converged=" + converged() + "]";
+    }
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package net.cramer.simd;
+
+/**
+ * Streaming L1 distance (the sum of the absolute differences) of the pairs
+ * of values seen so far. Every chunk is reduced with the reproducible kernel
+ * and the chunk results are accumulated with Neumaier's compensated
+ * summation. Partial results (e.g. from different threads) can be combined
+ * with {@link #merge(L1Distance)}. Not thread-safe.
+ */
+public final class L1Distance {
+
+    // layout must be kept in sync with struct RunningSum in vectorize.h
+    private static final int COUNT = 0;
+    private static final int SUM = 1;
+    private static final int COMPENSATION = 2;
+    static final int LENGTH = 3;
+
+    final double[] state = new double[LENGTH];
+
+    public L1Distance accept(double[] a, double[] b, int count) {
+        SIMD.distanceDouble(a, b, count, this);
+        return this;
+    }
+
+    public L1Distance accept(float[] a, float[] b, int count) {
+        SIMD.distanceFloat(a, b, count, this);
+        return this;
+    }
+
+    /**
+     * Accepts the first {@code count} doubles of {@code a} and {@code b}.
+     */
+    public L1Distance acceptDouble(AlignedBuffer a, AlignedBuffer b, long count) {
+        SIMD.distanceDoubleAligned(a, b, count, this);
+        return this;
+    }
+
+    /**
+     * Accepts the first {@code count} floats of {@code a} and {@code b}.
+     */
+    public L1Distance acceptFloat(AlignedBuffer a, AlignedBuffer b, long count) {
+        SIMD.distanceFloatAligned(a, b, count, this);
+        return this;
+    }
+
+    public L1Distance merge(L1Distance other) {
+        double[] o = other.state;
+        state[COUNT] += o[COUNT];
+        add(o[SUM]);
+        state[COMPENSATION] += o[COMPENSATION];
+        return this;
+    }
+
+    // must match neumaier_add in vectorize.cpp
+    private void add(double x) {
+        double sum = state[SUM];
+        double t = sum + x;
+        if (Double.isFinite(t)) {
+            if (Math.abs(sum) >= Math.abs(x)) {
+                state[COMPENSATION] += (sum - t) + x;
+            } else {
+                state[COMPENSATION] += (x - t) + sum;
+            }
+        }
+        state[SUM] = t;
+    }
+
+    public long count() {
+        return (long) state[COUNT];
+    }
+
+    public double value() {
+        double sum = state[SUM];
+        return Double.isFinite(sum) ? sum + state[COMPENSATION] : sum;
+    }
+
+    @Override
+    public String toString() {
+        return "L1Distance[count=" + count() + ", value=" + value() + "]";
+    }
+}
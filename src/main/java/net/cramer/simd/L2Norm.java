@@ -0,0 +1,105 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package net.cramer.simd;
+
+/**
+ * Streaming Euclidean norm of the values seen so far. The chunks are reduced
+ * with the reproducible kernel and combined through a scale factor that is a
+ * power of two, so the norm neither overflows nor underflows for inputs
+ * whose squares would, and the result depends only on the data and on the
+ * chunking. Partial results (e.g. from different threads) can be combined
+ * with {@link #merge(L2Norm)}. Not thread-safe.
+ */
+public final class L2Norm {
+
+    // layout must be kept in sync with struct RunningNorm in vectorize.h
+    private static final int COUNT = 0;
+    private static final int SCALE = 1;
+    private static final int SSQ = 2;
+    private static final int NON_FINITE = 3;
+    static final int LENGTH = 4;
+
+    final double[] state = new double[LENGTH];
+
+    public L2Norm accept(double[] a, int count) {
+        SIMD.l2normDouble(a, count, this);
+        return this;
+    }
+
+    public L2Norm accept(float[] a, int count) {
+        SIMD.l2normFloat(a, count, this);
+        return this;
+    }
+
+    /**
+     * Accepts the first {@code count} doubles of {@code a}.
+     */
+    public L2Norm acceptDouble(AlignedBuffer a, long count) {
+        SIMD.l2normDoubleAligned(a, count, this);
+        return this;
+    }
+
+    /**
+     * Accepts the first {@code count} floats of {@code a}.
+     */
+    public L2Norm acceptFloat(AlignedBuffer a, long count) {
+        SIMD.l2normFloatAligned(a, count, this);
+        return this;
+    }
+
+    public L2Norm merge(L2Norm other) {
+        double[] o = other.state;
+        state[COUNT] += o[COUNT];
+        state[NON_FINITE] += o[NON_FINITE];
+        double scale = o[SCALE];
+        double ssq = o[SSQ];
+        if (ssq == 0.0) {
+            return this;
+        }
+        if (state[SSQ] == 0.0) {
+            state[SCALE] = scale;
+            state[SSQ] = ssq;
+        } else if (scale < state[SCALE]) {
+            double r = scale / state[SCALE];
+            state[SSQ] = state[SSQ] * (r * r) + ssq;
+            state[SCALE] = scale;
+        } else {
+            double r = state[SCALE] / scale;
+            state[SSQ] += ssq * (r * r);
+        }
+        return this;
+    }
+
+    public long count() {
+        return (long) state[COUNT];
+    }
+
+    /**
+     * The l2 norm of the values seen so far (infinity if any of them was
+     * infinite, NaN if any was NaN).
+     */
+    public double value() {
+        if (state[NON_FINITE] != 0.0) {
+            return state[NON_FINITE];
+        }
+        return state[SSQ] == 0.0 ? 0.0 : Math.sqrt(state[SSQ]) / state[SCALE];
+    }
+
+    @Override
+    public String toString() {
+        return "L2Norm[count=" + count() + ", value=" + value() + "]";
+    }
+}
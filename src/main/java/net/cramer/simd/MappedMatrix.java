@@ -0,0 +1,355 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package net.cramer.simd;
+
+import java.io.IOException;
+import java.io.RandomAccessFile;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.file.Path;
+
+/**
+ * A row-major matrix (or a vector) of primitive values in a file that gets
+ * memory-mapped instead of being read onto the Java heap. The
+ * {@link #data()} of a mapped file is an {@link AlignedBuffer}, so all
+ * kernels that accept one run directly over the mapped pages, which the OS
+ * pages in on demand (see {@link #advise(int)}).
+ * <p>
+ * File layout (little-endian), a 64 byte header
+ *
+ * <pre>
+ *  0  magic "SIMDMAT1"
+ *  8  int  version (1)
+ * 12  int  dtype (one of the DTYPE_ constants)
+ * 16  int  element size in bytes
+ * 20  int  rank (1 for a vector, 2 for a matrix)
+ * 24  long rows (the length of a vector)
+ * 32  long cols (1 for a vector)
+ * 40  long row stride in elements (at least cols)
+ * 48  long data offset in bytes (a multiple of the alignment)
+ * 56  long alignment in bytes (a power of two, at least 64)
+ * </pre>
+ *
+ * followed by zero padding up to the data offset and the
+ * {@code rows * rowStride} elements (the last row is padded as well).
+ */
+public final class MappedMatrix implements AutoCloseable {
+
+    // element types
+    public static final int DTYPE_FLOAT64 = 0;
+    public static final int DTYPE_FLOAT32 = 1;
+    public static final int DTYPE_INT64 = 2;
+    public static final int DTYPE_INT32 = 3;
+    public static final int DTYPE_INT16 = 4;
+    public static final int DTYPE_INT8 = 5;
+
+    // access pattern hints, must be kept in sync with MappedMatrix.cpp
+    public static final int ADVICE_NORMAL = 0;
+    public static final int ADVICE_SEQUENTIAL = 1;
+    public static final int ADVICE_RANDOM = 2;
+    public static final int ADVICE_WILLNEED = 3;
+    public static final int ADVICE_DONTNEED = 4;
+
+    private static final long MAGIC = 0x3154414d444d4953L; // "SIMDMAT1"
+    private static final int VERSION = 1;
+    private static final int HEADER_BYTES = 64;
+    // the data starts on a page of its own, rows are optionally padded to
+    // full cache lines
+    private static final long DATA_ALIGNMENT = 4096L;
+    private static final long ROW_ALIGNMENT = 64L;
+    private static final int[] ELEMENT_BYTES = { 8, 4, 8, 4, 2, 1 };
+
+    static {
+        try {
+            System.loadLibrary("vector_avx2");
+        } catch (Throwable t) {
+            t.printStackTrace();
+            throw t;
+        }
+    }
+
+    private final Path file;
+    private final int dtype;
+    private final int rank;
+    private final long rows;
+    private final long cols;
+    private final long rowStride;
+    private final long base;
+    private final long fileLength;
+    private final boolean writable;
+    private final AlignedBuffer data;
+
+    private MappedMatrix(Path file, int dtype, int rank, long rows, long cols, long rowStride, long dataOffset,
+            long base, long fileLength, boolean writable) {
+        this.file = file;
+        this.dtype = dtype;
+        this.rank = rank;
+        this.rows = rows;
+        this.cols = cols;
+        this.rowStride = rowStride;
+        this.base = base;
+        this.fileLength = fileLength;
+        this.writable = writable;
+        this.data = AlignedBuffer.mapped(base, fileLength, dataOffset, rows * rowStride * ELEMENT_BYTES[dtype],
+                !writable);
+    }
+
+    /**
+     * Creates (or overwrites) {@code file} with a zero-filled
+     * {@code rows x cols} matrix and maps it writable. With
+     * {@code alignRows} each row starts on a cache line (the row stride then
+     * may exceed {@code cols}, so the kernels that expect dense rows can't
+     * run over the whole matrix at once).
+     */
+    public static MappedMatrix create(Path file, int dtype, long rows, long cols, boolean alignRows)
+            throws IOException {
+        if (rows < 0L || cols < 0L) {
+            throw new IllegalArgumentException("negative rows / cols: " + rows + " / " + cols);
+        }
+        return create(file, dtype, 2, rows, cols, alignRows);
+    }
+
+    /**
+     * Creates (or overwrites) {@code file} with a zero-filled vector of
+     * {@code length} elements and maps it writable.
+     */
+    public static MappedMatrix createVector(Path file, int dtype, long length) throws IOException {
+        if (length < 0L) {
+            throw new IllegalArgumentException("negative length: " + length);
+        }
+        return create(file, dtype, 1, length, 1L, false);
+    }
+
+    /**
+     * Maps {@code file} read-only, advising sequential access.
+     */
+    public static MappedMatrix open(Path file) throws IOException {
+        return open(file, false, ADVICE_SEQUENTIAL);
+    }
+
+    /**
+     * Maps {@code file} and passes {@code advice} (one of the
+     * {@code ADVICE_} constants) to {@link #advise(int)}.
+     */
+    public static MappedMatrix open(Path file, boolean writable, int advice) throws IOException {
+        long[] info = new long[2];
+        long base = map_n(file.toAbsolutePath().toString(), writable, info);
+        if (base == 0L) {
+            if (info[1] != 0L) {
+                throw new IOException("Cannot map " + file + " (error " + info[1] + ")");
+            }
+            throw new IOException("Not a matrix file (empty): " + file);
+        }
+        try {
+            MappedMatrix matrix = parse(file, base, info[0], writable);
+            if (advice != ADVICE_NORMAL) {
+                matrix.advise(advice);
+            }
+            return matrix;
+        } catch (IOException | RuntimeException e) {
+            unmap_n(base, info[0]);
+            throw e;
+        }
+    }
+
+    public int dtype() {
+        return dtype;
+    }
+
+    /**
+     * 1 for a vector, 2 for a matrix.
+     */
+    public int rank() {
+        return rank;
+    }
+
+    public long rows() {
+        return rows;
+    }
+
+    public long cols() {
+        return cols;
+    }
+
+    /**
+     * Distance in elements between the starts of two consecutive rows.
+     */
+    public long rowStride() {
+        return rowStride;
+    }
+
+    /**
+     * Whether the rows are stored without padding, i.e. the data is a dense
+     * {@code rows x cols} (or vector) array.
+     */
+    public boolean isDense() {
+        return rowStride == cols;
+    }
+
+    public boolean isWritable() {
+        return writable;
+    }
+
+    /**
+     * The {@code rows * rowStride} elements of the file in native byte
+     * order, read-only unless the file was mapped writable. Freeing it (or
+     * closing this matrix) unmaps the file.
+     */
+    public AlignedBuffer data() {
+        return data;
+    }
+
+    /**
+     * A direct {@code ByteBuffer} over the {@code cols} elements of
+     * {@code row}.
+     */
+    public ByteBuffer rowView(long row) {
+        if (row < 0L || row >= rows) {
+            throw new IndexOutOfBoundsException("row: " + row + ", rows: " + rows);
+        }
+        int elementBytes = ELEMENT_BYTES[dtype];
+        return data.view(row * rowStride * elementBytes, Math.toIntExact(cols * elementBytes));
+    }
+
+    /**
+     * Passes an access pattern hint for the whole file to the OS
+     * ({@code madvise}). Returns {@code false} if the hint wasn't accepted
+     * (on Windows only {@link #ADVICE_WILLNEED} has an effect).
+     */
+    public boolean advise(int advice) {
+        checkMapped();
+        // keeps the mapping alive if another thread closes the matrix
+        data.acquire(0L, 1);
+        try {
+            return advise_n(base, fileLength, advice);
+        } finally {
+            data.release();
+        }
+    }
+
+    /**
+     * Writes modified pages back to the file ({@code msync}).
+     */
+    public boolean force() {
+        checkMapped();
+        data.acquire(0L, 1);
+        try {
+            return writable && force_n(base, fileLength);
+        } finally {
+            data.release();
+        }
+    }
+
+    @Override
+    public void close() {
+        data.free();
+    }
+
+    @Override
+    public String toString() {
+        return "MappedMatrix[file=" + file + ", dtype=" + dtype + ", rank=" + rank + ", rows=" + rows + ", cols="
+                + cols + ", rowStride=" + rowStride + ", writable=" + writable + ", closed=" + data.isFreed() + "]";
+    }
+
+    static void unmap(long base, long length) {
+        unmap_n(base, length);
+    }
+
+    private void checkMapped() {
+        if (data.isFreed()) {
+            throw new IllegalStateException("MappedMatrix has already been closed");
+        }
+    }
+
+    private static MappedMatrix create(Path file, int dtype, int rank, long rows, long cols, boolean alignRows)
+            throws IOException {
+        int elementBytes = elementBytes(dtype);
+        long rowStride = cols;
+        if (alignRows) {
+            long rowBytes = (cols * elementBytes + ROW_ALIGNMENT - 1L) & -ROW_ALIGNMENT;
+            rowStride = rowBytes / elementBytes;
+        }
+        long dataBytes = Math.multiplyExact(Math.multiplyExact(rows, rowStride), (long) elementBytes);
+        ByteBuffer header = ByteBuffer.allocate(HEADER_BYTES).order(ByteOrder.LITTLE_ENDIAN);
+        header.putLong(MAGIC).putInt(VERSION).putInt(dtype).putInt(elementBytes).putInt(rank);
+        header.putLong(rows).putLong(cols).putLong(rowStride).putLong(DATA_ALIGNMENT).putLong(DATA_ALIGNMENT);
+        try (RandomAccessFile raf = new RandomAccessFile(file.toFile(), "rw")) {
+            raf.setLength(0L);
+            raf.write(header.array());
+            raf.setLength(DATA_ALIGNMENT + dataBytes);
+        }
+        return open(file, true, ADVICE_NORMAL);
+    }
+
+    private static MappedMatrix parse(Path file, long base, long fileLength, boolean writable) throws IOException {
+        if (fileLength < HEADER_BYTES) {
+            throw new IOException("Not a matrix file (too short): " + file);
+        }
+        ByteBuffer header = AlignedBuffer.mapped(base, fileLength, 0L, HEADER_BYTES, true).view(0L, HEADER_BYTES)
+                .order(ByteOrder.LITTLE_ENDIAN);
+        if (header.getLong() != MAGIC) {
+            throw new IOException("Not a matrix file (bad magic): " + file);
+        }
+        int version = header.getInt();
+        int dtype = header.getInt();
+        int elementBytes = header.getInt();
+        int rank = header.getInt();
+        long rows = header.getLong();
+        long cols = header.getLong();
+        long rowStride = header.getLong();
+        long dataOffset = header.getLong();
+        long alignment = header.getLong();
+        if (version != VERSION) {
+            throw new IOException("Unsupported matrix file version " + version + ": " + file);
+        }
+        if (dtype < DTYPE_FLOAT64 || dtype > DTYPE_INT8 || elementBytes != ELEMENT_BYTES[dtype]) {
+            throw new IOException("Invalid dtype " + dtype + " / element size " + elementBytes + ": " + file);
+        }
+        if (rows < 0L || cols < 0L || rowStride < cols || (rank != 1 && rank != 2)
+                || (rank == 1 && (cols != 1L || rowStride != 1L))) {
+            throw new IOException("Invalid shape: rank " + rank + ", " + rows + " x " + cols + ", row stride "
+                    + rowStride + ": " + file);
+        }
+        if (alignment < ROW_ALIGNMENT || Long.bitCount(alignment) != 1 || dataOffset < HEADER_BYTES
+                || (dataOffset & (alignment - 1L)) != 0L) {
+            throw new IOException("Invalid data offset " + dataOffset + " / alignment " + alignment + ": " + file);
+        }
+        try {
+            long dataBytes = Math.multiplyExact(Math.multiplyExact(rows, rowStride), (long) elementBytes);
+            if (Math.addExact(dataOffset, dataBytes) > fileLength) {
+                throw new IOException("Truncated matrix file (" + fileLength + " bytes): " + file);
+            }
+        } catch (ArithmeticException e) {
+            throw new IOException("Invalid shape: " + rows + " x " + rowStride + ": " + file, e);
+        }
+        return new MappedMatrix(file, dtype, rank, rows, cols, rowStride, dataOffset, base, fileLength, writable);
+    }
+
+    private static int elementBytes(int dtype) {
+        if (dtype < DTYPE_FLOAT64 || dtype > DTYPE_INT8) {
+            throw new IllegalArgumentException("unknown dtype: " + dtype);
+        }
+        return ELEMENT_BYTES[dtype];
+    }
+
+    private static native long map_n(String path, boolean writable, long[] info);
+
+    private static native void unmap_n(long address, long length);
+
+    private static native boolean advise_n(long address, long length, int advice);
+
+    private static native boolean force_n(long address, long length);
+}
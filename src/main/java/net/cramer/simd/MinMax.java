@@ -0,0 +1,96 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package net.cramer.simd;
+
+/**
+ * Result of a combined minimum / maximum search: the extremal values and the
+ * index of their first occurrence. For floating-point inputs the values are
+ * {@code NaN} and the indices {@code -1} if there are no (non-NaN) elements;
+ * if NaNs get propagated and the input contains one, both values are
+ * {@code NaN} and both indices are the index of the first NaN. For integer
+ * inputs an empty range yields the indices {@code -1} and the largest /
+ * smallest value of the type as minimum / maximum.
+ */
+public final class MinMax {
+
+    // layout must be kept in sync with extrema.cpp
+    private static final int MIN_INDEX = 0;
+    private static final int MAX_INDEX = 1;
+    private static final int MIN = 2;
+    private static final int MAX = 3;
+    static final int LENGTH = 4;
+
+    final long[] state = new long[LENGTH];
+    private final boolean floating;
+
+    MinMax(boolean floating) {
+        this.floating = floating;
+        state[MIN_INDEX] = -1L;
+        state[MAX_INDEX] = -1L;
+    }
+
+    /**
+     * Index of the first minimum or {@code -1} if there is none.
+     */
+    public long minIndex() {
+        return state[MIN_INDEX];
+    }
+
+    /**
+     * Index of the first maximum or {@code -1} if there is none.
+     */
+    public long maxIndex() {
+        return state[MAX_INDEX];
+    }
+
+    public boolean isEmpty() {
+        return state[MIN_INDEX] < 0L;
+    }
+
+    public double min() {
+        return floating ? Double.longBitsToDouble(state[MIN]) : state[MIN];
+    }
+
+    public double max() {
+        return floating ? Double.longBitsToDouble(state[MAX]) : state[MAX];
+    }
+
+    /**
+     * Minimum of an integer input (exact also for {@code long} values that
+     * are not representable as a {@code double}).
+     */
+    public long minLong() {
+        return floating ? (long) min() : state[MIN];
+    }
+
+    /**
+     * Maximum of an integer input (exact also for {@code long} values that
+     * are not representable as a {@code double}).
+     */
+    public long maxLong() {
+        return floating ? (long) max() : state[MAX];
+    }
+
+    @Override
+    public String toString() {
+        if (floating) {
+            return "MinMax[minIndex=" + minIndex() + ", maxIndex=" + maxIndex() + ", min=" + min() + ", max="
+                    + max() + "]";
+        }
+        return "MinMax[minIndex=" + minIndex() + ", maxIndex=" + maxIndex() + ", min=" + minLong() + ", max="
+                + maxLong() + "]";
+    }
+}
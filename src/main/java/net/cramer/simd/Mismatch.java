@@ -0,0 +1,54 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package net.cramer.simd;
+
+/**
+ * Result of a mismatch scan: the index of the first element pair that is not
+ * (approximately) equal and the number of such pairs. If the scan was asked to
+ * stop at the first mismatch {@link #count()} is at most {@code 1}.
+ */
+public final class Mismatch {
+
+    private static final int FIRST_INDEX = 0;
+    private static final int COUNT = 1;
+    static final int LENGTH = 2;
+
+    final long[] state = new long[LENGTH];
+
+    Mismatch() {
+        state[FIRST_INDEX] = -1L;
+    }
+
+    /**
+     * Index of the first mismatch or {@code -1} if there is none.
+     */
+    public long firstIndex() {
+        return state[FIRST_INDEX];
+    }
+
+    public long count() {
+        return state[COUNT];
+    }
+
+    public boolean isEmpty() {
+        return state[FIRST_INDEX] < 0L;
+    }
+
+    @Override
+    public String toString() {
+        return "Mismatch[firstIndex=" + firstIndex() + ", count=" + count() + "]";
+    }
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package net.cramer.simd;
+
+/**
+ * Exact (brute-force) k nearest neighbor search over the rows of a row-major
+ * {@code rows x dim} float matrix. The result of query {@code q} occupies
+ * {@code indices[q * k .. q * k + k)} and {@code distances[q * k .. q * k + k)}
+ * ordered best first (equal distances by row index). If there are fewer than
+ * {@code k} candidates the remaining slots get index {@code -1}. The database
+ * is scanned in parallel. The {@code Int8} variants search an int8 quantized
+ * database (see {@link Quantization#quantizeInt8}) with int8 quantized
+ * queries.
+ */
+public final class NearestNeighbors {
+
+    private static final boolean USE_CRITICAL = true;
+
+    // must be kept in sync with the metrics in vectorize.h
+    private static final int METRIC_L2_SQUARED = 0;
+    private static final int METRIC_INNER_PRODUCT = 1;
+    private static final int METRIC_COSINE = 2;
+
+    static {
+        try {
+            System.loadLibrary("vector_avx2");
+        } catch (Throwable t) {
+            t.printStackTrace();
+            throw t;
+        }
+    }
+
+    /**
+     * The {@code k} rows of {@code base} with the smallest squared euclidean
+     * distance to each of the {@code queryCount} rows of the row-major
+     * {@code queryCount x dim} matrix {@code queries}.
+     */
+    public static void searchL2SquaredFloat(float[] base, int rows, int dim, float[] queries, int queryCount, int k,
+            int[] indices, float[] distances) {
+        search_float_n(base, rows, dim, queries, queryCount, k, METRIC_L2_SQUARED, indices, distances, USE_CRITICAL);
+    }
+
+    /**
+     * The {@code k} rows of {@code base} with the largest inner product with
+     * each of the {@code queryCount} rows of the row-major
+     * {@code queryCount x dim} matrix {@code queries}.
+     */
+    public static void searchInnerProductFloat(float[] base, int rows, int dim, float[] queries, int queryCount,
+            int k, int[] indices, float[] distances) {
+        search_float_n(base, rows, dim, queries, queryCount, k, METRIC_INNER_PRODUCT, indices, distances,
+                USE_CRITICAL);
+    }
+
+    /**
+     * The {@code k} rows of {@code base} with the largest cosine similarity to
+     * each of the {@code queryCount} rows of the row-major
+     * {@code queryCount x dim} matrix {@code queries}.
+     */
+    public static void searchCosineFloat(float[] base, int rows, int dim, float[] queries, int queryCount, int k,
+            int[] indices, float[] distances) {
+        search_float_n(base, rows, dim, queries, queryCount, k, METRIC_COSINE, indices, distances, USE_CRITICAL);
+    }
+
+    public static void searchL2SquaredInt8(byte[] base, float[] scales, int rows, int dim, byte[] queries,
+            float[] queryScales, int queryCount, int k, int[] indices, float[] distances) {
+        search_int8_n(base, scales, rows, dim, queries, queryScales, queryCount, k, METRIC_L2_SQUARED, indices,
+                distances, USE_CRITICAL);
+    }
+
+    public static void searchInnerProductInt8(byte[] base, float[] scales, int rows, int dim, byte[] queries,
+            float[] queryScales, int queryCount, int k, int[] indices, float[] distances) {
+        search_int8_n(base, scales, rows, dim, queries, queryScales, queryCount, k, METRIC_INNER_PRODUCT, indices,
+                distances, USE_CRITICAL);
+    }
+
+    public static void searchCosineInt8(byte[] base, float[] scales, int rows, int dim, byte[] queries,
+            float[] queryScales, int queryCount, int k, int[] indices, float[] distances) {
+        search_int8_n(base, scales, rows, dim, queries, queryScales, queryCount, k, METRIC_COSINE, indices,
+                distances, USE_CRITICAL);
+    }
+
+    private static native void search_float_n(float[] base, int rows, int dim, float[] queries, int queryCount,
+            int k, int metric, int[] indices, float[] distances, boolean useCriticalRegion);
+
+    private static native void search_int8_n(byte[] base, float[] scales, int rows, int dim, byte[] queries,
+            float[] queryScales, int queryCount, int k, int metric, int[] indices, float[] distances,
+            boolean useCriticalRegion);
+
+    private NearestNeighbors() {
+        throw new AssertionError();
+    }
+}
@@ -0,0 +1,333 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package net.cramer.simd;
+
+import java.util.Arrays;
+
+/**
+ * A fused elementwise expression over up to {@link #MAX_INPUTS} input arrays,
+ * optionally followed by a terminal reduction. The expression is described
+ * once with a {@link Builder} (in postfix order, like an RPN calculator) and
+ * then evaluated natively in cache-sized tiles, so chains like
+ * {@code exp(a * x + b)} or {@code sum(exp(a * x + b))} don't allocate a
+ * temporary array per step and the intermediates never leave the cache:
+ *
+ * <pre>{@code
+ * Pipeline p = Pipeline.builder().input(0).constant(a).mul().constant(b).add().exp().build();
+ * double s = p.applyAndSumDouble(z, count, x); // z = exp(a * x + b), s = sum(z)
+ * }</pre>
+ *
+ * Instances are immutable and may be shared between threads. The output
+ * array may be one of the input arrays. Sums of float pipelines are
+ * accumulated in double precision, {@code min} and {@code max} reductions
+ * skip NaNs and return {@code +Infinity} / {@code -Infinity} if there is
+ * nothing to reduce.
+ */
+public final class Pipeline {
+
+    private static final boolean USE_CRITICAL = true;
+
+    /** Maximal number of input arrays of a pipeline. */
+    public static final int MAX_INPUTS = 3;
+    /** Maximal number of values on the evaluation stack. */
+    public static final int MAX_STACK = 8;
+
+    // op codes, must be kept in sync with pipeline.cpp
+    private static final int INPUT = 0;
+    private static final int CONST = 1;
+    private static final int ADD = 2;
+    private static final int SUB = 3;
+    private static final int MUL = 4;
+    private static final int DIV = 5;
+    private static final int MIN = 6;
+    private static final int MAX = 7;
+    private static final int FMA = 8;
+    private static final int NEG = 9;
+    private static final int ABS = 10;
+    private static final int SQRT = 11;
+    private static final int SQUARE = 12;
+    private static final int EXP = 13;
+    private static final int LOG = 14;
+    private static final int TANH = 15;
+    private static final int SIGMOID = 16;
+    private static final int RECIPROCAL = 17;
+
+    // terminal reductions, must be kept in sync with pipeline.cpp
+    private static final int REDUCE_NONE = 0;
+    private static final int REDUCE_SUM = 1;
+    private static final int REDUCE_MIN = 2;
+    private static final int REDUCE_MAX = 3;
+
+    static {
+        try {
+            System.loadLibrary("vector_avx2");
+        } catch (Throwable t) {
+            t.printStackTrace();
+            throw t;
+        }
+    }
+
+    private final int[] code;
+    private final double[] constants;
+    private final int inputs;
+
+    private Pipeline(int[] code, double[] constants, int inputs) {
+        this.code = code;
+        this.constants = constants;
+        this.inputs = inputs;
+    }
+
+    public static Builder builder() {
+        return new Builder();
+    }
+
+    /**
+     * Number of input arrays the pipeline reads (1 + the largest input index
+     * used).
+     */
+    public int inputs() {
+        return inputs;
+    }
+
+    /**
+     * Returns a pipeline with the same ops whose {@code index}-th constant (in
+     * the order of the {@link Builder#constant} calls) is {@code value}.
+     */
+    public Pipeline withConstant(int index, double value) {
+        double[] k = constants.clone();
+        k[index] = value;
+        return new Pipeline(code, k, inputs);
+    }
+
+    /**
+     * {@code out[i] = f(inputs[0][i], inputs[1][i], ...)} for {@code i < count}.
+     */
+    public void applyDouble(double[] out, int count, double[]... inputs) {
+        evaluateDouble(out, count, REDUCE_NONE, inputs);
+    }
+
+    /**
+     * Writes {@code f} to {@code out} as in {@link #applyDouble} and returns
+     * its sum.
+     */
+    public double applyAndSumDouble(double[] out, int count, double[]... inputs) {
+        return evaluateDouble(out, count, REDUCE_SUM, inputs);
+    }
+
+    public double sumDouble(int count, double[]... inputs) {
+        return evaluateDouble(null, count, REDUCE_SUM, inputs);
+    }
+
+    public double minDouble(int count, double[]... inputs) {
+        return evaluateDouble(null, count, REDUCE_MIN, inputs);
+    }
+
+    public double maxDouble(int count, double[]... inputs) {
+        return evaluateDouble(null, count, REDUCE_MAX, inputs);
+    }
+
+    public void applyFloat(float[] out, int count, float[]... inputs) {
+        evaluateFloat(out, count, REDUCE_NONE, inputs);
+    }
+
+    public float applyAndSumFloat(float[] out, int count, float[]... inputs) {
+        return evaluateFloat(out, count, REDUCE_SUM, inputs);
+    }
+
+    public float sumFloat(int count, float[]... inputs) {
+        return evaluateFloat(null, count, REDUCE_SUM, inputs);
+    }
+
+    public float minFloat(int count, float[]... inputs) {
+        return evaluateFloat(null, count, REDUCE_MIN, inputs);
+    }
+
+    public float maxFloat(int count, float[]... inputs) {
+        return evaluateFloat(null, count, REDUCE_MAX, inputs);
+    }
+
+    private double evaluateDouble(double[] out, int count, int reduction, double[][] in) {
+        checkInputs(in.length);
+        return pipeline_double_n(code, code.length, constants, constants.length, input(in, 0), input(in, 1),
+                input(in, 2), out, count, reduction, USE_CRITICAL);
+    }
+
+    private float evaluateFloat(float[] out, int count, int reduction, float[][] in) {
+        checkInputs(in.length);
+        return pipeline_float_n(code, code.length, constants, constants.length, input(in, 0), input(in, 1),
+                input(in, 2), out, count, reduction, USE_CRITICAL);
+    }
+
+    private void checkInputs(int length) {
+        if (length < inputs || length > MAX_INPUTS) {
+            throw new IllegalArgumentException("expected " + inputs + " input arrays but got " + length);
+        }
+    }
+
+    private static double[] input(double[][] in, int k) {
+        return k < in.length ? in[k] : null;
+    }
+
+    private static float[] input(float[][] in, int k) {
+        return k < in.length ? in[k] : null;
+    }
+
+    @Override
+    public String toString() {
+        return "Pipeline[code=" + Arrays.toString(code) + ", constants=" + Arrays.toString(constants) + "]";
+    }
+
+    /**
+     * Builds the op list of a {@link Pipeline} in postfix order: operands are
+     * pushed by {@link #input} and {@link #constant}, each op replaces its
+     * operands on the stack by its result. Binary ops take the value pushed
+     * first as their left operand, i.e. {@code input(0).input(1).sub()} is
+     * {@code x - y}.
+     */
+    public static final class Builder {
+
+        private int[] code = new int[16];
+        private int length;
+        private double[] constants = new double[4];
+        private int nConstants;
+        private int depth;
+        private int inputs;
+
+        private Builder() {
+        }
+
+        /** Pushes the elements of the {@code index}-th input array. */
+        public Builder input(int index) {
+            if (index < 0 || index >= MAX_INPUTS) {
+                throw new IllegalArgumentException("input index: " + index);
+            }
+            inputs = Math.max(inputs, index + 1);
+            return push(INPUT, 0).arg(index);
+        }
+
+        public Builder constant(double value) {
+            if (nConstants == constants.length) {
+                constants = Arrays.copyOf(constants, 2 * nConstants);
+            }
+            constants[nConstants] = value;
+            return push(CONST, 0).arg(nConstants++);
+        }
+
+        public Builder add() {
+            return push(ADD, 2);
+        }
+
+        public Builder sub() {
+            return push(SUB, 2);
+        }
+
+        public Builder mul() {
+            return push(MUL, 2);
+        }
+
+        public Builder div() {
+            return push(DIV, 2);
+        }
+
+        public Builder min() {
+            return push(MIN, 2);
+        }
+
+        public Builder max() {
+            return push(MAX, 2);
+        }
+
+        /** {@code a * b + c} with a single rounding for operands a, b, c. */
+        public Builder fma() {
+            return push(FMA, 3);
+        }
+
+        public Builder neg() {
+            return push(NEG, 1);
+        }
+
+        public Builder abs() {
+            return push(ABS, 1);
+        }
+
+        public Builder sqrt() {
+            return push(SQRT, 1);
+        }
+
+        public Builder square() {
+            return push(SQUARE, 1);
+        }
+
+        public Builder exp() {
+            return push(EXP, 1);
+        }
+
+        public Builder log() {
+            return push(LOG, 1);
+        }
+
+        public Builder tanh() {
+            return push(TANH, 1);
+        }
+
+        /** {@code 1 / (1 + exp(-x))} */
+        public Builder sigmoid() {
+            return push(SIGMOID, 1);
+        }
+
+        public Builder reciprocal() {
+            return push(RECIPROCAL, 1);
+        }
+
+        /**
+         * Compiles the op list, which must leave exactly one value on the
+         * stack.
+         */
+        public Pipeline build() {
+            if (depth != 1) {
+                throw new IllegalStateException("the ops leave " + depth + " values on the stack");
+            }
+            return new Pipeline(Arrays.copyOf(code, length), Arrays.copyOf(constants, nConstants), inputs);
+        }
+
+        private Builder push(int op, int arity) {
+            if (depth < arity) {
+                throw new IllegalStateException("op " + op + " needs " + arity + " operands but has " + depth);
+            }
+            depth += 1 - arity;
+            if (depth > MAX_STACK) {
+                throw new IllegalStateException("more than " + MAX_STACK + " values on the stack");
+            }
+            return arg(op);
+        }
+
+        private Builder arg(int value) {
+            if (length == code.length) {
+                code = Arrays.copyOf(code, 2 * length);
+            }
+            code[length++] = value;
+            return this;
+        }
+    }
+
+    private static native double pipeline_double_n(int[] code, int codeLength, double[] constants,
+            int nConstants, double[] x, double[] y, double[] z, double[] out, int count, int reduction,
+            boolean useCriticalRegion);
+
+    private static native float pipeline_float_n(int[] code, int codeLength, double[] constants,
+            int nConstants, float[] x, float[] y, float[] z, float[] out, int count, int reduction,
+            boolean useCriticalRegion);
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package net.cramer.simd;
+
+/**
+ * Product quantization (PQ) of the rows of a row-major {@code rows x dim}
+ * float matrix and asymmetric distance computation (ADC) on the codes.
+ * <p>
+ * A vector is split into {@code m} sub-vectors of {@code dim / m}
+ * components and each sub-vector is encoded as the index (one byte) of its
+ * nearest centroid among the {@code ksub <= 256} centroids of its subspace,
+ * so a row compresses to {@code m} bytes. The codebooks are stored as a
+ * {@code m x ksub x (dim / m)} float array of length {@code ksub * dim}.
+ * <p>
+ * A query is compared to encoded rows through a {@code m x ksub} table of
+ * the distances between the query sub-vectors and the centroids
+ * ({@link #distanceTableL2Squared} or {@link #distanceTableInnerProduct}),
+ * the distance to a row being the sum of the {@code m} table entries its
+ * codes select ({@link #scan}).
+ * <p>
+ * With {@code ksub = 16} the codes can be packed into blocks of 32 rows of
+ * 4 bit codes ({@link #packCodes4}) and scanned with 8 bit quantized tables
+ * held in registers ({@link #scan4}). The fast scan result approximates the
+ * result of {@link #scan} up to the table quantization error and is meant
+ * for candidate selection followed by a re-ranking.
+ */
+public final class ProductQuantization {
+
+    private static final boolean USE_CRITICAL = true;
+
+    // must be kept in sync with the metrics in vectorize.h
+    private static final int METRIC_L2_SQUARED = 0;
+    private static final int METRIC_INNER_PRODUCT = 1;
+
+    // rows per block of packed 4 bit codes (must be kept in sync with pq.cpp)
+    private static final int PQ4_BLOCK = 32;
+
+    static {
+        try {
+            System.loadLibrary("vector_avx2");
+        } catch (Throwable t) {
+            t.printStackTrace();
+            throw t;
+        }
+    }
+
+    /**
+     * Trains the codebooks of the {@code m} subspaces with at most
+     * {@code iterations} k-means iterations ({@link KMeans}, with a fixed
+     * seed) on the {@code rows >= ksub} training rows of {@code x}. The result is written to {@code codebooks} (length
+     * {@code ksub * dim}).
+     */
+    public static void train(float[] x, int rows, int dim, int m, int ksub, int iterations, float[] codebooks) {
+        train_n(x, rows, dim, m, ksub, iterations, codebooks, USE_CRITICAL);
+    }
+
+    /**
+     * Encodes the {@code rows} rows of {@code x} into {@code codes} (length
+     * {@code rows * m}, one unsigned byte per subspace).
+     */
+    public static void encode(float[] x, int rows, int dim, int m, int ksub, float[] codebooks, byte[] codes) {
+        encode_n(x, rows, dim, m, ksub, codebooks, codes, USE_CRITICAL);
+    }
+
+    /**
+     * Computes the {@code m x ksub} table of the squared euclidean distances
+     * between the sub-vectors of {@code query} and the centroids.
+     */
+    public static void distanceTableL2Squared(float[] query, int dim, int m, int ksub, float[] codebooks,
+            float[] table) {
+        distance_table_n(query, dim, m, ksub, codebooks, METRIC_L2_SQUARED, table, USE_CRITICAL);
+    }
+
+    /**
+     * Computes the {@code m x ksub} table of the inner products between the
+     * sub-vectors of {@code query} and the centroids.
+     */
+    public static void distanceTableInnerProduct(float[] query, int dim, int m, int ksub, float[] codebooks,
+            float[] table) {
+        distance_table_n(query, dim, m, ksub, codebooks, METRIC_INNER_PRODUCT, table, USE_CRITICAL);
+    }
+
+    /**
+     * Writes the sum of the table entries selected by the codes of each of
+     * the {@code rows} encoded rows to {@code out[0 .. rows)}. Throws a
+     * {@code RuntimeException} if a code is {@code >= ksub}.
+     */
+    public static void scan(float[] table, int m, int ksub, byte[] codes, int rows, float[] out) {
+        scan_n(table, m, ksub, codes, rows, out, USE_CRITICAL);
+    }
+
+    /**
+     * Length of the array of the packed 4 bit codes of {@code rows} rows.
+     */
+    public static int packedLength4(int rows, int m) {
+        if (rows < 0 || m < 0) {
+            throw new IllegalArgumentException("negative rows / m: " + rows + " / " + m);
+        }
+        return Math.toIntExact(((rows + (long) PQ4_BLOCK - 1L) / PQ4_BLOCK) * m * (PQ4_BLOCK / 2));
+    }
+
+    /**
+     * Packs the {@code rows * m} codes (of a {@code ksub = 16} quantizer)
+     * into {@code packed} (length {@link #packedLength4(int, int)}) for
+     * {@link #scan4}.
+     */
+    public static void packCodes4(byte[] codes, int rows, int m, byte[] packed) {
+        pack4_n(codes, rows, m, packed, USE_CRITICAL);
+    }
+
+    /**
+     * Fast scan of the packed 4 bit codes: approximates {@link #scan} with
+     * the table quantized to 8 bit.
+     */
+    public static void scan4(float[] table, int m, byte[] packed, int rows, float[] out) {
+        scan4_n(table, m, packed, rows, out, USE_CRITICAL);
+    }
+
+    private static native void train_n(float[] x, int rows, int dim, int m, int ksub, int iterations,
+            float[] codebooks, boolean useCriticalRegion);
+
+    private static native void encode_n(float[] x, int rows, int dim, int m, int ksub, float[] codebooks,
+            byte[] codes, boolean useCriticalRegion);
+
+    private static native void distance_table_n(float[] query, int dim, int m, int ksub, float[] codebooks,
+            int metric, float[] table, boolean useCriticalRegion);
+
+    private static native void scan_n(float[] table, int m, int ksub, byte[] codes, int rows, float[] out,
+            boolean useCriticalRegion);
+
+    private static native void pack4_n(byte[] codes, int rows, int m, byte[] packed, boolean useCriticalRegion);
+
+    private static native void scan4_n(float[] table, int m, byte[] packed, int rows, float[] out,
+            boolean useCriticalRegion);
+
+    private ProductQuantization() {
+        throw new AssertionError();
+    }
+}
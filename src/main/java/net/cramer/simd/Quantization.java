@@ -0,0 +1,141 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package net.cramer.simd;
+
+/**
+ * 8 bit scalar quantization of the rows of a row-major {@code rows x dim}
+ * float matrix and integer kernels on the quantized data.
+ * <p>
+ * {@code int8}: symmetric per-row scale, {@code x ~ scale * q} with
+ * {@code q} in {@code [-127, 127]}. {@code uint8}: per-row scale and offset,
+ * {@code x ~ scale * (q & 0xff) + offset} with {@code q & 0xff} in
+ * {@code [0, 255]}. In both cases the rounding error is at most
+ * {@code scale / 2}.
+ */
+public final class Quantization {
+
+    private static final boolean USE_CRITICAL = true;
+
+    // must be kept in sync with the metrics in vectorize.h
+    private static final int METRIC_L2_SQUARED = 0;
+    private static final int METRIC_INNER_PRODUCT = 1;
+    private static final int METRIC_COSINE = 2;
+
+    static {
+        try {
+            System.loadLibrary("vector_avx2");
+        } catch (Throwable t) {
+            t.printStackTrace();
+            throw t;
+        }
+    }
+
+    public static void quantizeInt8(float[] x, int rows, int dim, byte[] q, float[] scales) {
+        quantize_n(x, rows, dim, q, scales, null, false, USE_CRITICAL);
+    }
+
+    public static void dequantizeInt8(byte[] q, float[] scales, int rows, int dim, float[] x) {
+        dequantize_n(q, scales, null, rows, dim, x, false, USE_CRITICAL);
+    }
+
+    public static void quantizeUint8(float[] x, int rows, int dim, byte[] q, float[] scales, float[] offsets) {
+        quantize_n(x, rows, dim, q, scales, offsets, true, USE_CRITICAL);
+    }
+
+    public static void dequantizeUint8(byte[] q, float[] scales, float[] offsets, int rows, int dim, float[] x) {
+        dequantize_n(q, scales, offsets, rows, dim, x, true, USE_CRITICAL);
+    }
+
+    /**
+     * Exact integer dot product of the signed bytes of {@code a} and
+     * {@code b}.
+     */
+    public static long dotInt8(byte[] a, byte[] b, int count) {
+        return dot_n(a, b, count, false, USE_CRITICAL);
+    }
+
+    /**
+     * Exact integer squared distance of the signed bytes of {@code a} and
+     * {@code b}.
+     */
+    public static long squaredDistanceInt8(byte[] a, byte[] b, int count) {
+        return squared_distance_n(a, b, count, false, USE_CRITICAL);
+    }
+
+    /**
+     * Exact integer dot product of the unsigned bytes of {@code a} and
+     * {@code b}.
+     */
+    public static long dotUint8(byte[] a, byte[] b, int count) {
+        return dot_n(a, b, count, true, USE_CRITICAL);
+    }
+
+    /**
+     * Exact integer squared distance of the unsigned bytes of {@code a} and
+     * {@code b}.
+     */
+    public static long squaredDistanceUint8(byte[] a, byte[] b, int count) {
+        return squared_distance_n(a, b, count, true, USE_CRITICAL);
+    }
+
+    /**
+     * Squared euclidean distances of the int8 quantized {@code query} to each
+     * of the {@code rows} int8 quantized rows of {@code base}, written to
+     * {@code out[0 .. rows)}.
+     */
+    public static void squaredDistancesInt8(byte[] query, float queryScale, byte[] base, float[] scales, int rows,
+            int dim, float[] out) {
+        distances_int8_n(query, queryScale, base, scales, rows, dim, METRIC_L2_SQUARED, out, USE_CRITICAL);
+    }
+
+    /**
+     * Inner products of the int8 quantized {@code query} with each of the
+     * {@code rows} int8 quantized rows of {@code base}, written to
+     * {@code out[0 .. rows)}.
+     */
+    public static void innerProductsInt8(byte[] query, float queryScale, byte[] base, float[] scales, int rows,
+            int dim, float[] out) {
+        distances_int8_n(query, queryScale, base, scales, rows, dim, METRIC_INNER_PRODUCT, out, USE_CRITICAL);
+    }
+
+    /**
+     * Cosine similarities of the int8 quantized {@code query} to each of the
+     * {@code rows} int8 quantized rows of {@code base}, written to
+     * {@code out[0 .. rows)}.
+     */
+    public static void cosineSimilaritiesInt8(byte[] query, float queryScale, byte[] base, float[] scales, int rows,
+            int dim, float[] out) {
+        distances_int8_n(query, queryScale, base, scales, rows, dim, METRIC_COSINE, out, USE_CRITICAL);
+    }
+
+    private static native void quantize_n(float[] x, int rows, int dim, byte[] q, float[] scales, float[] offsets,
+            boolean isUnsigned, boolean useCriticalRegion);
+
+    private static native void dequantize_n(byte[] q, float[] scales, float[] offsets, int rows, int dim, float[] x,
+            boolean isUnsigned, boolean useCriticalRegion);
+
+    private static native long dot_n(byte[] a, byte[] b, int count, boolean isUnsigned, boolean useCriticalRegion);
+
+    private static native long squared_distance_n(byte[] a, byte[] b, int count, boolean isUnsigned,
+            boolean useCriticalRegion);
+
+    private static native void distances_int8_n(byte[] query, float queryScale, byte[] base, float[] scales,
+            int rows, int dim, int metric, float[] out, boolean useCriticalRegion);
+
+    private Quantization() {
+        throw new AssertionError();
+    }
+}
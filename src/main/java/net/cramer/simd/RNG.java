@@ -42,6 +42,28 @@ public final class RNG {
         xor1024Large(random);
     }
 
+    /**
+     * Writes the next {@link #FETCH_SIZE} numbers to the longs
+     * {@code [offset, offset + FETCH_SIZE)} of {@code random}.
+     */
+    public static void next2048LongsSfc64(AlignedBuffer random, long offset) {
+        long randomAddress = random.acquireWritable(offset, FETCH_SIZE, Long.BYTES);
+        try {
+            sfc64LargeAddress(randomAddress);
+        } finally {
+            random.release();
+        }
+    }
+
+    public static void next2048LongsXor1024(AlignedBuffer random, long offset) {
+        long randomAddress = random.acquireWritable(offset, FETCH_SIZE, Long.BYTES);
+        try {
+            xor1024LargeAddress(randomAddress);
+        } finally {
+            random.release();
+        }
+    }
+
     public static void seedSfc64(long[] seed) {
         checkSeed(seed, SFC64_SEED_LENGTH);
         initSfc64(seed);
@@ -73,10 +95,14 @@ public final class RNG {
 
     private static native void xor1024Large(long[] a);
 
+    private static native void xor1024LargeAddress(long address);
+
     private static native long initSfc64(long[] a);
 
     private static native void sfc64Large(long[] a);
 
+    private static native void sfc64LargeAddress(long address);
+
     private RNG() {
         throw new AssertionError();
     }
@@ -17,8 +17,23 @@ package net.cramer.simd;
 
 public final class SIMD {
 
+    // allows the native code to pin double[] / float[] arrays, whether it
+    // does so depends on the array size (see AccessPolicy)
     private static final boolean USE_CRITICAL = true;
 
+    // metrics of distancesFloat, must be kept in sync with vectorize.h
+    private static final int METRIC_L2_SQUARED = 0;
+    private static final int METRIC_INNER_PRODUCT = 1;
+    private static final int METRIC_COSINE = 2;
+
+    // ops of the extremum natives, must be kept in sync with extrema.cpp
+    private static final int OP_MIN = 0;
+    private static final int OP_MAX = 1;
+    private static final int OP_ARGMIN = 2;
+    private static final int OP_ARGMAX = 3;
+
+    private static volatile boolean reproducible = Boolean.getBoolean("net.cramer.simd.reproducible");
+
     static {
         try {
             System.loadLibrary("vector_avx2");
@@ -28,12 +43,32 @@ public final class SIMD {
         }
     }
 
+    /**
+     * Switches the {@code l2norm} and {@code distance} reductions to a mode
+     * whose results are bitwise identical on every instruction set (AVX2 or
+     * AVX-512) and independent of how the work might get split across
+     * threads: the data is reduced in fixed-size chunks with a fixed lane
+     * count and the partial results get combined in a fixed pairwise order.
+     * Costs some throughput. The initial value is taken from the system
+     * property {@code net.cramer.simd.reproducible}.
+     * <p>
+     * The compensated sums / dot products and {@link Statistics} always use a
+     * fixed lane count and merge order and are therefore reproducible anyway.
+     */
+    public static void setReproducible(boolean enable) {
+        reproducible = enable;
+    }
+
+    public static boolean isReproducible() {
+        return reproducible;
+    }
+
     public static double l2normDouble(double[] array, int count) {
-        return l2norm_double_n(array, count, USE_CRITICAL);
+        return l2norm_double_n(array, count, USE_CRITICAL, reproducible);
     }
 
     public static float l2normFloat(float[] array, int count) {
-        return l2norm_float_n(array, count, USE_CRITICAL);
+        return l2norm_float_n(array, count, USE_CRITICAL, reproducible);
     }
 
     public static boolean approxEqualDouble(double[] a, double[] b, int count, double relTol, double absTol) {
@@ -44,17 +79,935 @@ public final class SIMD {
         return approx_equal_float_n(a, b, count, relTol, absTol, USE_CRITICAL);
     }
 
+    /**
+     * Finds the element pairs of {@code a} and {@code b} that are not within
+     * {@code relTol} / {@code absTol} of each other (same criterion as
+     * {@link #approxEqualDouble}; a NaN never matches). If {@code firstOnly}
+     * is {@code true} the scan stops at the first mismatch.
+     */
+    public static Mismatch mismatchDouble(double[] a, double[] b, int count, double relTol, double absTol,
+            boolean firstOnly) {
+        Mismatch mismatch = new Mismatch();
+        mismatch_double_n(a, b, count, relTol, absTol, firstOnly, mismatch.state, USE_CRITICAL);
+        return mismatch;
+    }
+
+    public static Mismatch mismatchFloat(float[] a, float[] b, int count, float relTol, float absTol,
+            boolean firstOnly) {
+        Mismatch mismatch = new Mismatch();
+        mismatch_float_n(a, b, count, relTol, absTol, firstOnly, mismatch.state, USE_CRITICAL);
+        return mismatch;
+    }
+
+    /**
+     * Finds the element pairs of {@code a} and {@code b} that are more than
+     * {@code maxUlps} units in the last place apart ({@code -0.0} and
+     * {@code 0.0} are 0 ULPs apart, a NaN never matches). If
+     * {@code firstOnly} is {@code true} the scan stops at the first mismatch.
+     */
+    public static Mismatch mismatchUlpDouble(double[] a, double[] b, int count, long maxUlps, boolean firstOnly) {
+        Mismatch mismatch = new Mismatch();
+        mismatch_ulp_double_n(a, b, count, maxUlps, firstOnly, mismatch.state, USE_CRITICAL);
+        return mismatch;
+    }
+
+    public static Mismatch mismatchUlpFloat(float[] a, float[] b, int count, int maxUlps, boolean firstOnly) {
+        Mismatch mismatch = new Mismatch();
+        mismatch_ulp_float_n(a, b, count, maxUlps, firstOnly, mismatch.state, USE_CRITICAL);
+        return mismatch;
+    }
+
     public static double distanceDouble(double[] a, double[] b, int count) {
-        return distance_double_n(a, b, count, USE_CRITICAL);
+        return distance_double_n(a, b, count, USE_CRITICAL, reproducible);
     }
 
     public static float distanceFloat(float[] a, float[] b, int count) {
-        return distance_float_n(a, b, count, USE_CRITICAL);
+        return distance_float_n(a, b, count, USE_CRITICAL, reproducible);
+    }
+
+    public static float squaredDistanceFloat(float[] a, float[] b, int count) {
+        return squared_distance_float_n(a, b, count, USE_CRITICAL);
+    }
+
+    public static float innerProductFloat(float[] a, float[] b, int count) {
+        return inner_product_float_n(a, b, count, USE_CRITICAL);
+    }
+
+    /**
+     * Cosine similarity of {@code a} and {@code b} ({@code 0.0f} if one of
+     * them is the zero vector).
+     */
+    public static float cosineSimilarityFloat(float[] a, float[] b, int count) {
+        return cosine_float_n(a, b, count, USE_CRITICAL);
+    }
+
+    /**
+     * Squared euclidean distances of {@code query} to each of the
+     * {@code rows} rows of the row-major {@code rows x dim} matrix
+     * {@code base}, written to {@code out[0 .. rows)}.
+     */
+    public static void squaredDistancesFloat(float[] query, float[] base, int rows, int dim, float[] out) {
+        distances_float_n(query, base, rows, dim, METRIC_L2_SQUARED, out, USE_CRITICAL);
+    }
+
+    /**
+     * Inner products of {@code query} with each of the {@code rows} rows of
+     * the row-major {@code rows x dim} matrix {@code base}, written to
+     * {@code out[0 .. rows)}.
+     */
+    public static void innerProductsFloat(float[] query, float[] base, int rows, int dim, float[] out) {
+        distances_float_n(query, base, rows, dim, METRIC_INNER_PRODUCT, out, USE_CRITICAL);
+    }
+
+    /**
+     * Cosine similarities of {@code query} to each of the {@code rows} rows
+     * of the row-major {@code rows x dim} matrix {@code base}, written to
+     * {@code out[0 .. rows)}.
+     */
+    public static void cosineSimilaritiesFloat(float[] query, float[] base, int rows, int dim, float[] out) {
+        distances_float_n(query, base, rows, dim, METRIC_COSINE, out, USE_CRITICAL);
+    }
+
+    public static Statistics statisticsDouble(double[] a, int count) {
+        return new Statistics().accept(a, count);
+    }
+
+    public static Statistics statisticsFloat(float[] a, int count) {
+        return new Statistics().accept(a, count);
+    }
+
+    public static double compensatedSumDouble(double[] a, int count) {
+        return compensated_sum_double_n(a, count, USE_CRITICAL);
+    }
+
+    public static float compensatedSumFloat(float[] a, int count) {
+        return compensated_sum_float_n(a, count, USE_CRITICAL);
+    }
+
+    /**
+     * Compensated sum of float values accumulated in double precision.
+     */
+    public static double compensatedSumFloatToDouble(float[] a, int count) {
+        return compensated_sum_float_d_n(a, count, USE_CRITICAL);
+    }
+
+    public static double compensatedDotDouble(double[] a, double[] b, int count) {
+        return compensated_dot_double_n(a, b, count, USE_CRITICAL);
+    }
+
+    public static float compensatedDotFloat(float[] a, float[] b, int count) {
+        return compensated_dot_float_n(a, b, count, USE_CRITICAL);
+    }
+
+    /**
+     * Compensated dot product of float vectors accumulated in double precision.
+     */
+    public static double compensatedDotFloatToDouble(float[] a, float[] b, int count) {
+        return compensated_dot_float_d_n(a, b, count, USE_CRITICAL);
+    }
+
+    /**
+     * Adds the histogram of {@code a[0 .. count)} over {@code bins} bins of
+     * equal width between {@code min} and {@code max} to
+     * {@code counts[0 .. bins)}. Bin {@code i} covers
+     * {@code [min + i * w, min + (i + 1) * w)} with
+     * {@code w = (max - min) / bins}, the last bin includes {@code max}.
+     * Values outside of {@code [min, max]} and NaNs are not counted, their
+     * number is returned. With {@code parallel} large arrays are split across
+     * threads.
+     */
+    public static long histogramDouble(double[] a, int count, double min, double max, int bins, int[] counts,
+            boolean parallel) {
+        return histogram_double_n(a, count, min, max, bins, counts, null, parallel, USE_CRITICAL);
+    }
+
+    public static long histogramDouble(double[] a, int count, double min, double max, int bins, long[] counts,
+            boolean parallel) {
+        return histogram_double_n(a, count, min, max, bins, null, counts, parallel, USE_CRITICAL);
+    }
+
+    public static long histogramFloat(float[] a, int count, float min, float max, int bins, int[] counts,
+            boolean parallel) {
+        return histogram_float_n(a, count, min, max, bins, counts, null, parallel, USE_CRITICAL);
+    }
+
+    public static long histogramFloat(float[] a, int count, float min, float max, int bins, long[] counts,
+            boolean parallel) {
+        return histogram_float_n(a, count, min, max, bins, null, counts, parallel, USE_CRITICAL);
+    }
+
+    /**
+     * Adds the histogram of {@code a[0 .. count)} over the
+     * {@code nEdges - 1} bins {@code [edges[i], edges[i + 1])} to
+     * {@code counts[0 .. nEdges - 1)}, the last bin includes its upper edge.
+     * The edges must be strictly increasing. Values outside of
+     * {@code [edges[0], edges[nEdges - 1]]} and NaNs are not counted, their
+     * number is returned.
+     */
+    public static long histogramEdgesDouble(double[] a, int count, double[] edges, int nEdges, int[] counts,
+            boolean parallel) {
+        return histogram_edges_double_n(a, count, edges, nEdges, counts, null, parallel, USE_CRITICAL);
+    }
+
+    public static long histogramEdgesDouble(double[] a, int count, double[] edges, int nEdges, long[] counts,
+            boolean parallel) {
+        return histogram_edges_double_n(a, count, edges, nEdges, null, counts, parallel, USE_CRITICAL);
+    }
+
+    public static long histogramEdgesFloat(float[] a, int count, float[] edges, int nEdges, int[] counts,
+            boolean parallel) {
+        return histogram_edges_float_n(a, count, edges, nEdges, counts, null, parallel, USE_CRITICAL);
+    }
+
+    public static long histogramEdgesFloat(float[] a, int count, float[] edges, int nEdges, long[] counts,
+            boolean parallel) {
+        return histogram_edges_float_n(a, count, edges, nEdges, null, counts, parallel, USE_CRITICAL);
+    }
+
+    /**
+     * Minimum of {@code a[0 .. count)}. NaNs are skipped if {@code ignoreNaN}
+     * is {@code true}, otherwise a NaN in the input yields NaN. Returns NaN if
+     * there are no (non-NaN) elements. {@code -0.0} and {@code 0.0} compare
+     * equal.
+     */
+    public static double minDouble(double[] a, int count, boolean ignoreNaN) {
+        return Double.longBitsToDouble(extremum_double_n(a, count, OP_MIN, ignoreNaN, USE_CRITICAL));
+    }
+
+    /**
+     * Maximum of {@code a[0 .. count)}, NaNs are handled as in
+     * {@link #minDouble}.
+     */
+    public static double maxDouble(double[] a, int count, boolean ignoreNaN) {
+        return Double.longBitsToDouble(extremum_double_n(a, count, OP_MAX, ignoreNaN, USE_CRITICAL));
+    }
+
+    /**
+     * Index of the first minimum of {@code a[0 .. count)} or {@code -1} if
+     * there are no (non-NaN) elements. If NaNs are not ignored the index of the
+     * first NaN is returned if there is one.
+     */
+    public static long argminDouble(double[] a, int count, boolean ignoreNaN) {
+        return extremum_double_n(a, count, OP_ARGMIN, ignoreNaN, USE_CRITICAL);
+    }
+
+    /**
+     * Index of the first maximum of {@code a[0 .. count)} or {@code -1} if
+     * there are no (non-NaN) elements. If NaNs are not ignored the index of the
+     * first NaN is returned if there is one.
+     */
+    public static long argmaxDouble(double[] a, int count, boolean ignoreNaN) {
+        return extremum_double_n(a, count, OP_ARGMAX, ignoreNaN, USE_CRITICAL);
+    }
+
+    /**
+     * Minimum and maximum of {@code a[0 .. count)} together with the index of
+     * their first occurrence, computed in a single native call. NaNs are
+     * handled as in {@link #minDouble} and {@link #argminDouble}.
+     */
+    public static MinMax minMaxDouble(double[] a, int count, boolean ignoreNaN) {
+        MinMax minMax = new MinMax(true);
+        min_max_double_n(a, count, ignoreNaN, minMax.state, USE_CRITICAL);
+        return minMax;
+    }
+
+    public static float minFloat(float[] a, int count, boolean ignoreNaN) {
+        return (float) Double.longBitsToDouble(extremum_float_n(a, count, OP_MIN, ignoreNaN, USE_CRITICAL));
+    }
+
+    public static float maxFloat(float[] a, int count, boolean ignoreNaN) {
+        return (float) Double.longBitsToDouble(extremum_float_n(a, count, OP_MAX, ignoreNaN, USE_CRITICAL));
+    }
+
+    public static long argminFloat(float[] a, int count, boolean ignoreNaN) {
+        return extremum_float_n(a, count, OP_ARGMIN, ignoreNaN, USE_CRITICAL);
+    }
+
+    public static long argmaxFloat(float[] a, int count, boolean ignoreNaN) {
+        return extremum_float_n(a, count, OP_ARGMAX, ignoreNaN, USE_CRITICAL);
+    }
+
+    public static MinMax minMaxFloat(float[] a, int count, boolean ignoreNaN) {
+        MinMax minMax = new MinMax(true);
+        min_max_float_n(a, count, ignoreNaN, minMax.state, USE_CRITICAL);
+        return minMax;
+    }
+
+    /**
+     * Minimum of {@code a[0 .. count)} or {@link Long#MAX_VALUE} if
+     * {@code count} is {@code 0} (likewise for the other integer types).
+     */
+    public static long minLong(long[] a, int count) {
+        return extremum_long_n(a, count, OP_MIN, USE_CRITICAL);
+    }
+
+    /**
+     * Maximum of {@code a[0 .. count)} or {@link Long#MIN_VALUE} if
+     * {@code count} is {@code 0} (likewise for the other integer types).
+     */
+    public static long maxLong(long[] a, int count) {
+        return extremum_long_n(a, count, OP_MAX, USE_CRITICAL);
+    }
+
+    public static long argminLong(long[] a, int count) {
+        return extremum_long_n(a, count, OP_ARGMIN, USE_CRITICAL);
+    }
+
+    public static long argmaxLong(long[] a, int count) {
+        return extremum_long_n(a, count, OP_ARGMAX, USE_CRITICAL);
+    }
+
+    public static MinMax minMaxLong(long[] a, int count) {
+        MinMax minMax = new MinMax(false);
+        min_max_long_n(a, count, minMax.state, USE_CRITICAL);
+        return minMax;
+    }
+
+    public static int minInt(int[] a, int count) {
+        return (int) extremum_int_n(a, count, OP_MIN, USE_CRITICAL);
+    }
+
+    public static int maxInt(int[] a, int count) {
+        return (int) extremum_int_n(a, count, OP_MAX, USE_CRITICAL);
+    }
+
+    public static long argminInt(int[] a, int count) {
+        return extremum_int_n(a, count, OP_ARGMIN, USE_CRITICAL);
+    }
+
+    public static long argmaxInt(int[] a, int count) {
+        return extremum_int_n(a, count, OP_ARGMAX, USE_CRITICAL);
+    }
+
+    public static MinMax minMaxInt(int[] a, int count) {
+        MinMax minMax = new MinMax(false);
+        min_max_int_n(a, count, minMax.state, USE_CRITICAL);
+        return minMax;
+    }
+
+    public static short minShort(short[] a, int count) {
+        return (short) extremum_short_n(a, count, OP_MIN, USE_CRITICAL);
+    }
+
+    public static short maxShort(short[] a, int count) {
+        return (short) extremum_short_n(a, count, OP_MAX, USE_CRITICAL);
+    }
+
+    public static long argminShort(short[] a, int count) {
+        return extremum_short_n(a, count, OP_ARGMIN, USE_CRITICAL);
+    }
+
+    public static long argmaxShort(short[] a, int count) {
+        return extremum_short_n(a, count, OP_ARGMAX, USE_CRITICAL);
+    }
+
+    public static MinMax minMaxShort(short[] a, int count) {
+        MinMax minMax = new MinMax(false);
+        min_max_short_n(a, count, minMax.state, USE_CRITICAL);
+        return minMax;
+    }
+
+    public static byte minByte(byte[] a, int count) {
+        return (byte) extremum_byte_n(a, count, OP_MIN, USE_CRITICAL);
+    }
+
+    public static byte maxByte(byte[] a, int count) {
+        return (byte) extremum_byte_n(a, count, OP_MAX, USE_CRITICAL);
+    }
+
+    public static long argminByte(byte[] a, int count) {
+        return extremum_byte_n(a, count, OP_ARGMIN, USE_CRITICAL);
+    }
+
+    public static long argmaxByte(byte[] a, int count) {
+        return extremum_byte_n(a, count, OP_ARGMAX, USE_CRITICAL);
+    }
+
+    public static MinMax minMaxByte(byte[] a, int count) {
+        MinMax minMax = new MinMax(false);
+        min_max_byte_n(a, count, minMax.state, USE_CRITICAL);
+        return minMax;
+    }
+
+    /**
+     * {@link #l2normDouble(double[], int)} of the first {@code count} doubles
+     * of {@code a} (likewise for the other {@code ...Aligned} methods, which
+     * have distinct names so that {@code null} arguments stay unambiguous).
+     */
+    public static double l2normDoubleAligned(AlignedBuffer a, long count) {
+        long aAddress = a.acquire(count, Double.BYTES);
+        try {
+            return l2norm_double_a(aAddress, count, reproducible);
+        } finally {
+            a.release();
+        }
+    }
+
+    public static float l2normFloatAligned(AlignedBuffer a, long count) {
+        long aAddress = a.acquire(count, Float.BYTES);
+        try {
+            return l2norm_float_a(aAddress, count, reproducible);
+        } finally {
+            a.release();
+        }
+    }
+
+    public static boolean approxEqualDoubleAligned(AlignedBuffer a, AlignedBuffer b, long count, double relTol,
+            double absTol) {
+        long aAddress = a.acquire(count, Double.BYTES);
+        try {
+            long bAddress = b.acquire(count, Double.BYTES);
+            try {
+                return approx_equal_double_a(aAddress, bAddress, count, relTol, absTol);
+            } finally {
+                b.release();
+            }
+        } finally {
+            a.release();
+        }
+    }
+
+    public static boolean approxEqualFloatAligned(AlignedBuffer a, AlignedBuffer b, long count, float relTol,
+            float absTol) {
+        long aAddress = a.acquire(count, Float.BYTES);
+        try {
+            long bAddress = b.acquire(count, Float.BYTES);
+            try {
+                return approx_equal_float_a(aAddress, bAddress, count, relTol, absTol);
+            } finally {
+                b.release();
+            }
+        } finally {
+            a.release();
+        }
+    }
+
+    public static Mismatch mismatchDoubleAligned(AlignedBuffer a, AlignedBuffer b, long count, double relTol,
+            double absTol, boolean firstOnly) {
+        Mismatch mismatch = new Mismatch();
+        long aAddress = a.acquire(count, Double.BYTES);
+        try {
+            long bAddress = b.acquire(count, Double.BYTES);
+            try {
+                mismatch_double_a(aAddress, bAddress, count, relTol, absTol, firstOnly, mismatch.state);
+            } finally {
+                b.release();
+            }
+        } finally {
+            a.release();
+        }
+        return mismatch;
+    }
+
+    public static Mismatch mismatchFloatAligned(AlignedBuffer a, AlignedBuffer b, long count, float relTol,
+            float absTol, boolean firstOnly) {
+        Mismatch mismatch = new Mismatch();
+        long aAddress = a.acquire(count, Float.BYTES);
+        try {
+            long bAddress = b.acquire(count, Float.BYTES);
+            try {
+                mismatch_float_a(aAddress, bAddress, count, relTol, absTol, firstOnly, mismatch.state);
+            } finally {
+                b.release();
+            }
+        } finally {
+            a.release();
+        }
+        return mismatch;
+    }
+
+    public static double distanceDoubleAligned(AlignedBuffer a, AlignedBuffer b, long count) {
+        long aAddress = a.acquire(count, Double.BYTES);
+        try {
+            long bAddress = b.acquire(count, Double.BYTES);
+            try {
+                return distance_double_a(aAddress, bAddress, count, reproducible);
+            } finally {
+                b.release();
+            }
+        } finally {
+            a.release();
+        }
+    }
+
+    public static float distanceFloatAligned(AlignedBuffer a, AlignedBuffer b, long count) {
+        long aAddress = a.acquire(count, Float.BYTES);
+        try {
+            long bAddress = b.acquire(count, Float.BYTES);
+            try {
+                return distance_float_a(aAddress, bAddress, count, reproducible);
+            } finally {
+                b.release();
+            }
+        } finally {
+            a.release();
+        }
+    }
+
+    public static float squaredDistanceFloatAligned(AlignedBuffer a, AlignedBuffer b, long count) {
+        long aAddress = a.acquire(count, Float.BYTES);
+        try {
+            long bAddress = b.acquire(count, Float.BYTES);
+            try {
+                return squared_distance_float_a(aAddress, bAddress, count);
+            } finally {
+                b.release();
+            }
+        } finally {
+            a.release();
+        }
+    }
+
+    public static float innerProductFloatAligned(AlignedBuffer a, AlignedBuffer b, long count) {
+        long aAddress = a.acquire(count, Float.BYTES);
+        try {
+            long bAddress = b.acquire(count, Float.BYTES);
+            try {
+                return inner_product_float_a(aAddress, bAddress, count);
+            } finally {
+                b.release();
+            }
+        } finally {
+            a.release();
+        }
+    }
+
+    public static float cosineSimilarityFloatAligned(AlignedBuffer a, AlignedBuffer b, long count) {
+        long aAddress = a.acquire(count, Float.BYTES);
+        try {
+            long bAddress = b.acquire(count, Float.BYTES);
+            try {
+                return cosine_float_a(aAddress, bAddress, count);
+            } finally {
+                b.release();
+            }
+        } finally {
+            a.release();
+        }
+    }
+
+    public static void squaredDistancesFloatAligned(AlignedBuffer query, AlignedBuffer base, long rows, int dim,
+            AlignedBuffer out) {
+        distancesFloat(query, base, rows, dim, METRIC_L2_SQUARED, out);
+    }
+
+    public static void innerProductsFloatAligned(AlignedBuffer query, AlignedBuffer base, long rows, int dim,
+            AlignedBuffer out) {
+        distancesFloat(query, base, rows, dim, METRIC_INNER_PRODUCT, out);
+    }
+
+    public static void cosineSimilaritiesFloatAligned(AlignedBuffer query, AlignedBuffer base, long rows, int dim,
+            AlignedBuffer out) {
+        distancesFloat(query, base, rows, dim, METRIC_COSINE, out);
+    }
+
+    public static Statistics statisticsDoubleAligned(AlignedBuffer a, long count) {
+        return new Statistics().acceptDouble(a, count);
+    }
+
+    public static Statistics statisticsFloatAligned(AlignedBuffer a, long count) {
+        return new Statistics().acceptFloat(a, count);
+    }
+
+    public static double compensatedSumDoubleAligned(AlignedBuffer a, long count) {
+        long aAddress = a.acquire(count, Double.BYTES);
+        try {
+            return compensated_sum_double_a(aAddress, count);
+        } finally {
+            a.release();
+        }
+    }
+
+    public static float compensatedSumFloatAligned(AlignedBuffer a, long count) {
+        long aAddress = a.acquire(count, Float.BYTES);
+        try {
+            return compensated_sum_float_a(aAddress, count);
+        } finally {
+            a.release();
+        }
+    }
+
+    public static double compensatedSumFloatToDoubleAligned(AlignedBuffer a, long count) {
+        long aAddress = a.acquire(count, Float.BYTES);
+        try {
+            return compensated_sum_float_d_a(aAddress, count);
+        } finally {
+            a.release();
+        }
+    }
+
+    public static double compensatedDotDoubleAligned(AlignedBuffer a, AlignedBuffer b, long count) {
+        long aAddress = a.acquire(count, Double.BYTES);
+        try {
+            long bAddress = b.acquire(count, Double.BYTES);
+            try {
+                return compensated_dot_double_a(aAddress, bAddress, count);
+            } finally {
+                b.release();
+            }
+        } finally {
+            a.release();
+        }
+    }
+
+    public static float compensatedDotFloatAligned(AlignedBuffer a, AlignedBuffer b, long count) {
+        long aAddress = a.acquire(count, Float.BYTES);
+        try {
+            long bAddress = b.acquire(count, Float.BYTES);
+            try {
+                return compensated_dot_float_a(aAddress, bAddress, count);
+            } finally {
+                b.release();
+            }
+        } finally {
+            a.release();
+        }
+    }
+
+    public static double compensatedDotFloatToDoubleAligned(AlignedBuffer a, AlignedBuffer b, long count) {
+        long aAddress = a.acquire(count, Float.BYTES);
+        try {
+            long bAddress = b.acquire(count, Float.BYTES);
+            try {
+                return compensated_dot_float_d_a(aAddress, bAddress, count);
+            } finally {
+                b.release();
+            }
+        } finally {
+            a.release();
+        }
+    }
+
+    public static long histogramDoubleAligned(AlignedBuffer a, long count, double min, double max, int bins,
+            long[] counts, boolean parallel) {
+        long aAddress = a.acquire(count, Double.BYTES);
+        try {
+            return histogram_double_a(aAddress, count, min, max, bins, counts, parallel);
+        } finally {
+            a.release();
+        }
+    }
+
+    public static long histogramFloatAligned(AlignedBuffer a, long count, float min, float max, int bins,
+            long[] counts, boolean parallel) {
+        long aAddress = a.acquire(count, Float.BYTES);
+        try {
+            return histogram_float_a(aAddress, count, min, max, bins, counts, parallel);
+        } finally {
+            a.release();
+        }
+    }
+
+    public static double minDoubleAligned(AlignedBuffer a, long count, boolean ignoreNaN) {
+        long aAddress = a.acquire(count, Double.BYTES);
+        try {
+            return Double.longBitsToDouble(extremum_double_a(aAddress, count, OP_MIN, ignoreNaN));
+        } finally {
+            a.release();
+        }
+    }
+
+    public static double maxDoubleAligned(AlignedBuffer a, long count, boolean ignoreNaN) {
+        long aAddress = a.acquire(count, Double.BYTES);
+        try {
+            return Double.longBitsToDouble(extremum_double_a(aAddress, count, OP_MAX, ignoreNaN));
+        } finally {
+            a.release();
+        }
+    }
+
+    public static long argminDoubleAligned(AlignedBuffer a, long count, boolean ignoreNaN) {
+        long aAddress = a.acquire(count, Double.BYTES);
+        try {
+            return extremum_double_a(aAddress, count, OP_ARGMIN, ignoreNaN);
+        } finally {
+            a.release();
+        }
+    }
+
+    public static long argmaxDoubleAligned(AlignedBuffer a, long count, boolean ignoreNaN) {
+        long aAddress = a.acquire(count, Double.BYTES);
+        try {
+            return extremum_double_a(aAddress, count, OP_ARGMAX, ignoreNaN);
+        } finally {
+            a.release();
+        }
+    }
+
+    public static MinMax minMaxDoubleAligned(AlignedBuffer a, long count, boolean ignoreNaN) {
+        MinMax minMax = new MinMax(true);
+        long aAddress = a.acquire(count, Double.BYTES);
+        try {
+            min_max_double_a(aAddress, count, ignoreNaN, minMax.state);
+        } finally {
+            a.release();
+        }
+        return minMax;
+    }
+
+    public static float minFloatAligned(AlignedBuffer a, long count, boolean ignoreNaN) {
+        long aAddress = a.acquire(count, Float.BYTES);
+        try {
+            return (float) Double.longBitsToDouble(extremum_float_a(aAddress, count, OP_MIN, ignoreNaN));
+        } finally {
+            a.release();
+        }
+    }
+
+    public static float maxFloatAligned(AlignedBuffer a, long count, boolean ignoreNaN) {
+        long aAddress = a.acquire(count, Float.BYTES);
+        try {
+            return (float) Double.longBitsToDouble(extremum_float_a(aAddress, count, OP_MAX, ignoreNaN));
+        } finally {
+            a.release();
+        }
+    }
+
+    public static long argminFloatAligned(AlignedBuffer a, long count, boolean ignoreNaN) {
+        long aAddress = a.acquire(count, Float.BYTES);
+        try {
+            return extremum_float_a(aAddress, count, OP_ARGMIN, ignoreNaN);
+        } finally {
+            a.release();
+        }
+    }
+
+    public static long argmaxFloatAligned(AlignedBuffer a, long count, boolean ignoreNaN) {
+        long aAddress = a.acquire(count, Float.BYTES);
+        try {
+            return extremum_float_a(aAddress, count, OP_ARGMAX, ignoreNaN);
+        } finally {
+            a.release();
+        }
+    }
+
+    public static MinMax minMaxFloatAligned(AlignedBuffer a, long count, boolean ignoreNaN) {
+        MinMax minMax = new MinMax(true);
+        long aAddress = a.acquire(count, Float.BYTES);
+        try {
+            min_max_float_a(aAddress, count, ignoreNaN, minMax.state);
+        } finally {
+            a.release();
+        }
+        return minMax;
+    }
+
+    /**
+     * Usage statistics (high-water marks, reserved bytes) of the native
+     * scratch memory arenas.
+     */
+    public static ArenaStats arenaStats() {
+        ArenaStats stats = new ArenaStats();
+        arena_stats_n(stats.state);
+        return stats;
+    }
+
+    /**
+     * Bounds the time a single call keeps a {@code double[]} or
+     * {@code float[]} pinned in critical mode, during which the garbage
+     * collector is blocked for all threads. The bound is translated into an
+     * array size with the memory bandwidth measured on the first call;
+     * larger arrays are copied in bounded slices into native scratch memory
+     * (and written back the same way, unless the array is a read-only
+     * input) so that the kernel runs unpinned. This trades an extra copy for
+     * the tail latency of the other threads. The copy doubles the memory the
+     * array occupies during the call; copies larger than 64 MiB are returned
+     * to the OS right after the call. If there isn't enough memory for the
+     * copy the call fails with a {@code RuntimeException} rather than pinning
+     * the array. A value of {@code 0} removes the bound (the default).
+     *
+     * @param micros
+     *            the maximum pin time in microseconds, {@code >= 0}
+     */
+    public static void setMaxPinMicros(long micros) {
+        if (micros < 0L) {
+            throw new IllegalArgumentException("micros < 0: " + micros);
+        }
+        set_max_pin_micros_n(micros);
+    }
+
+    /**
+     * The bound set with {@link #setMaxPinMicros(long)} ({@code 0} if none).
+     */
+    public static long maxPinMicros() {
+        return max_pin_micros_n();
+    }
+
+    /**
+     * Enables or disables the adaptive choice between pinning a
+     * {@code double[]} / {@code float[]} and copying it (enabled by
+     * default); when disabled arrays are always pinned (up to the bound of
+     * {@link #setMaxPinMicros(long)}). The access strategies get benchmarked
+     * once when the native library is loaded, which takes a few
+     * milliseconds.
+     */
+    public static void setAdaptiveAccess(boolean enabled) {
+        set_adaptive_access_n(enabled);
+    }
+
+    /**
+     * The current access policy for {@code double[]} / {@code float[]}
+     * arrays, see {@link #setAdaptiveAccess(boolean)}.
+     */
+    public static AccessPolicy accessPolicy() {
+        AccessPolicy policy = new AccessPolicy();
+        access_policy_n(policy.state);
+        return policy;
+    }
+
+    static void statsDouble(double[] a, int count, Statistics stats) {
+        stats_double_n(a, count, stats.state, USE_CRITICAL);
+    }
+
+    static void statsFloat(float[] a, int count, Statistics stats) {
+        stats_float_n(a, count, stats.state, USE_CRITICAL);
+    }
+
+    static void statsDoubleAligned(AlignedBuffer a, long count, Statistics stats) {
+        long aAddress = a.acquire(count, Double.BYTES);
+        try {
+            stats_double_a(aAddress, count, stats.state);
+        } finally {
+            a.release();
+        }
+    }
+
+    static void statsFloatAligned(AlignedBuffer a, long count, Statistics stats) {
+        long aAddress = a.acquire(count, Float.BYTES);
+        try {
+            stats_float_a(aAddress, count, stats.state);
+        } finally {
+            a.release();
+        }
+    }
+
+    static void l2normDouble(double[] a, int count, L2Norm norm) {
+        l2norm_accept_double_n(a, count, norm.state, USE_CRITICAL);
+    }
+
+    static void l2normFloat(float[] a, int count, L2Norm norm) {
+        l2norm_accept_float_n(a, count, norm.state, USE_CRITICAL);
+    }
+
+    static void l2normDoubleAligned(AlignedBuffer a, long count, L2Norm norm) {
+        long aAddress = a.acquire(count, Double.BYTES);
+        try {
+            l2norm_accept_double_a(aAddress, count, norm.state);
+        } finally {
+            a.release();
+        }
+    }
+
+    static void l2normFloatAligned(AlignedBuffer a, long count, L2Norm norm) {
+        long aAddress = a.acquire(count, Float.BYTES);
+        try {
+            l2norm_accept_float_a(aAddress, count, norm.state);
+        } finally {
+            a.release();
+        }
+    }
+
+    static void distanceDouble(double[] a, double[] b, int count, L1Distance distance) {
+        distance_accept_double_n(a, b, count, distance.state, USE_CRITICAL);
+    }
+
+    static void distanceFloat(float[] a, float[] b, int count, L1Distance distance) {
+        distance_accept_float_n(a, b, count, distance.state, USE_CRITICAL);
+    }
+
+    static void distanceDoubleAligned(AlignedBuffer a, AlignedBuffer b, long count, L1Distance distance) {
+        long aAddress = a.acquire(count, Double.BYTES);
+        try {
+            long bAddress = b.acquire(count, Double.BYTES);
+            try {
+                distance_accept_double_a(aAddress, bAddress, count, distance.state);
+            } finally {
+                b.release();
+            }
+        } finally {
+            a.release();
+        }
+    }
+
+    static void distanceFloatAligned(AlignedBuffer a, AlignedBuffer b, long count, L1Distance distance) {
+        long aAddress = a.acquire(count, Float.BYTES);
+        try {
+            long bAddress = b.acquire(count, Float.BYTES);
+            try {
+                distance_accept_float_a(aAddress, bAddress, count, distance.state);
+            } finally {
+                b.release();
+            }
+        } finally {
+            a.release();
+        }
+    }
+
+    static void approxEqualDouble(double[] a, double[] b, int count, ApproxEqual cmp) {
+        approx_equal_accept_double_n(a, b, count, cmp.relTol, cmp.absTol, cmp.state, USE_CRITICAL);
+    }
+
+    static void approxEqualFloat(float[] a, float[] b, int count, ApproxEqual cmp) {
+        approx_equal_accept_float_n(a, b, count, (float) cmp.relTol, (float) cmp.absTol, cmp.state, USE_CRITICAL);
+    }
+
+    static void approxEqualDoubleAligned(AlignedBuffer a, AlignedBuffer b, long count, ApproxEqual cmp) {
+        long aAddress = a.acquire(count, Double.BYTES);
+        try {
+            long bAddress = b.acquire(count, Double.BYTES);
+            try {
+                approx_equal_accept_double_a(aAddress, bAddress, count, cmp.relTol, cmp.absTol, cmp.state);
+            } finally {
+                b.release();
+            }
+        } finally {
+            a.release();
+        }
     }
 
-    private static native double l2norm_double_n(double[] array, int count, boolean useCriticalRegion);
+    static void approxEqualFloatAligned(AlignedBuffer a, AlignedBuffer b, long count, ApproxEqual cmp) {
+        long aAddress = a.acquire(count, Float.BYTES);
+        try {
+            long bAddress = b.acquire(count, Float.BYTES);
+            try {
+                approx_equal_accept_float_a(aAddress, bAddress, count,
+                        (float) cmp.relTol, (float) cmp.absTol, cmp.state);
+            } finally {
+                b.release();
+            }
+        } finally {
+            a.release();
+        }
+    }
 
-    private static native float l2norm_float_n(float[] array, int count, boolean useCriticalRegion);
+    private static void distancesFloat(AlignedBuffer query, AlignedBuffer base, long rows, int dim, int metric,
+            AlignedBuffer out) {
+        if (rows < 0L || dim < 0) {
+            throw new IllegalArgumentException("negative rows / dim: " + rows + " / " + dim);
+        }
+        long queryAddress = query.acquire(dim, Float.BYTES);
+        try {
+            long baseAddress = base.acquire(Math.multiplyExact(rows, dim), Float.BYTES);
+            try {
+                long outAddress = out.acquireWritable(0L, rows, Float.BYTES);
+                try {
+                    distances_float_a(queryAddress, baseAddress, rows, dim, metric, outAddress);
+                } finally {
+                    out.release();
+                }
+            } finally {
+                base.release();
+            }
+        } finally {
+            query.release();
+        }
+    }
+
+    private static native double l2norm_double_n(double[] array, int count, boolean useCriticalRegion,
+            boolean reproducible);
+
+    private static native float l2norm_float_n(float[] array, int count, boolean useCriticalRegion,
+            boolean reproducible);
 
     private static native boolean approx_equal_double_n(double[] a, double[] b, int count, double relTol, double absTol,
             boolean useCriticalRegion);
@@ -62,9 +1015,190 @@ public final class SIMD {
     private static native boolean approx_equal_float_n(float[] a, float[] b, int count, float relTol, float absTol,
             boolean useCriticalRegion);
 
-    private static native double distance_double_n(double[] a, double[] b, int count, boolean useCriticalRegion);
+    private static native void mismatch_double_n(double[] a, double[] b, int count, double relTol, double absTol,
+            boolean firstOnly, long[] result, boolean useCriticalRegion);
+
+    private static native void mismatch_float_n(float[] a, float[] b, int count, float relTol, float absTol,
+            boolean firstOnly, long[] result, boolean useCriticalRegion);
+
+    private static native void mismatch_ulp_double_n(double[] a, double[] b, int count, long maxUlps,
+            boolean firstOnly, long[] result, boolean useCriticalRegion);
+
+    private static native void mismatch_ulp_float_n(float[] a, float[] b, int count, int maxUlps,
+            boolean firstOnly, long[] result, boolean useCriticalRegion);
+
+    private static native double distance_double_n(double[] a, double[] b, int count, boolean useCriticalRegion,
+            boolean reproducible);
+
+    private static native float distance_float_n(float[] a, float[] b, int count, boolean useCriticalRegion,
+            boolean reproducible);
+
+    private static native float squared_distance_float_n(float[] a, float[] b, int count, boolean useCriticalRegion);
+
+    private static native float inner_product_float_n(float[] a, float[] b, int count, boolean useCriticalRegion);
+
+    private static native float cosine_float_n(float[] a, float[] b, int count, boolean useCriticalRegion);
+
+    private static native void distances_float_n(float[] query, float[] base, int rows, int dim, int metric,
+            float[] out, boolean useCriticalRegion);
+
+    private static native void stats_double_n(double[] a, int count, double[] state, boolean useCriticalRegion);
+
+    private static native void stats_float_n(float[] a, int count, double[] state, boolean useCriticalRegion);
+
+    private static native double compensated_sum_double_n(double[] a, int count, boolean useCriticalRegion);
+
+    private static native float compensated_sum_float_n(float[] a, int count, boolean useCriticalRegion);
+
+    private static native double compensated_sum_float_d_n(float[] a, int count, boolean useCriticalRegion);
+
+    private static native double compensated_dot_double_n(double[] a, double[] b, int count,
+            boolean useCriticalRegion);
+
+    private static native float compensated_dot_float_n(float[] a, float[] b, int count, boolean useCriticalRegion);
+
+    private static native double compensated_dot_float_d_n(float[] a, float[] b, int count,
+            boolean useCriticalRegion);
+
+    private static native long histogram_double_n(double[] a, int count, double min, double max, int bins,
+            int[] counts, long[] lcounts, boolean parallel, boolean useCriticalRegion);
+
+    private static native long histogram_float_n(float[] a, int count, float min, float max, int bins,
+            int[] counts, long[] lcounts, boolean parallel, boolean useCriticalRegion);
+
+    private static native long histogram_edges_double_n(double[] a, int count, double[] edges, int nEdges,
+            int[] counts, long[] lcounts, boolean parallel, boolean useCriticalRegion);
+
+    private static native long histogram_edges_float_n(float[] a, int count, float[] edges, int nEdges,
+            int[] counts, long[] lcounts, boolean parallel, boolean useCriticalRegion);
+
+    private static native long extremum_double_n(double[] a, int count, int op, boolean ignoreNaN, boolean useCriticalRegion);
+
+    private static native long extremum_float_n(float[] a, int count, int op, boolean ignoreNaN, boolean useCriticalRegion);
+
+    private static native long extremum_long_n(long[] a, int count, int op, boolean useCriticalRegion);
+
+    private static native long extremum_int_n(int[] a, int count, int op, boolean useCriticalRegion);
+
+    private static native long extremum_short_n(short[] a, int count, int op, boolean useCriticalRegion);
+
+    private static native long extremum_byte_n(byte[] a, int count, int op, boolean useCriticalRegion);
+
+    private static native void min_max_double_n(double[] a, int count, boolean ignoreNaN, long[] result,
+            boolean useCriticalRegion);
+
+    private static native void min_max_float_n(float[] a, int count, boolean ignoreNaN, long[] result,
+            boolean useCriticalRegion);
+
+    private static native void min_max_long_n(long[] a, int count, long[] result,
+            boolean useCriticalRegion);
+
+    private static native void min_max_int_n(int[] a, int count, long[] result,
+            boolean useCriticalRegion);
+
+    private static native void min_max_short_n(short[] a, int count, long[] result,
+            boolean useCriticalRegion);
+
+    private static native void min_max_byte_n(byte[] a, int count, long[] result,
+            boolean useCriticalRegion);
+
+    private static native void arena_stats_n(long[] state);
+
+    private static native void set_max_pin_micros_n(long micros);
+
+    private static native long max_pin_micros_n();
+
+    private static native void set_adaptive_access_n(boolean enabled);
+
+    private static native void access_policy_n(double[] state);
+
+    private static native double l2norm_double_a(long a, long count, boolean reproducible);
+
+    private static native float l2norm_float_a(long a, long count, boolean reproducible);
+
+    private static native boolean approx_equal_double_a(long a, long b, long count, double relTol, double absTol);
+
+    private static native boolean approx_equal_float_a(long a, long b, long count, float relTol, float absTol);
+
+    private static native void mismatch_double_a(long a, long b, long count, double relTol, double absTol,
+            boolean firstOnly, long[] result);
+
+    private static native void mismatch_float_a(long a, long b, long count, float relTol, float absTol,
+            boolean firstOnly, long[] result);
+
+    private static native double distance_double_a(long a, long b, long count, boolean reproducible);
+
+    private static native float distance_float_a(long a, long b, long count, boolean reproducible);
+
+    private static native float squared_distance_float_a(long a, long b, long count);
+
+    private static native float inner_product_float_a(long a, long b, long count);
+
+    private static native float cosine_float_a(long a, long b, long count);
+
+    private static native void distances_float_a(long query, long base, long rows, long dim, int metric, long out);
+
+    private static native void stats_double_a(long a, long count, double[] state);
+
+    private static native void stats_float_a(long a, long count, double[] state);
+
+    private static native double compensated_sum_double_a(long a, long count);
+
+    private static native float compensated_sum_float_a(long a, long count);
+
+    private static native double compensated_sum_float_d_a(long a, long count);
+
+    private static native double compensated_dot_double_a(long a, long b, long count);
+
+    private static native float compensated_dot_float_a(long a, long b, long count);
+
+    private static native double compensated_dot_float_d_a(long a, long b, long count);
+
+    private static native long histogram_double_a(long a, long count, double min, double max, int bins,
+            long[] counts, boolean parallel);
+
+    private static native long histogram_float_a(long a, long count, float min, float max, int bins,
+            long[] counts, boolean parallel);
+
+    private static native long extremum_double_a(long a, long count, int op, boolean ignoreNaN);
+
+    private static native long extremum_float_a(long a, long count, int op, boolean ignoreNaN);
+
+    private static native void min_max_double_a(long a, long count, boolean ignoreNaN, long[] result);
+
+    private static native void min_max_float_a(long a, long count, boolean ignoreNaN, long[] result);
+
+    private static native void l2norm_accept_double_n(double[] a, int count, double[] state,
+            boolean useCriticalRegion);
+
+    private static native void l2norm_accept_float_n(float[] a, int count, double[] state,
+            boolean useCriticalRegion);
+
+    private static native void l2norm_accept_double_a(long a, long count, double[] state);
+
+    private static native void l2norm_accept_float_a(long a, long count, double[] state);
+
+    private static native void distance_accept_double_n(double[] a, double[] b, int count, double[] state,
+            boolean useCriticalRegion);
+
+    private static native void distance_accept_float_n(float[] a, float[] b, int count, double[] state,
+            boolean useCriticalRegion);
+
+    private static native void distance_accept_double_a(long a, long b, long count, double[] state);
+
+    private static native void distance_accept_float_a(long a, long b, long count, double[] state);
+
+    private static native void approx_equal_accept_double_n(double[] a, double[] b, int count, double relTol,
+            double absTol, long[] state, boolean useCriticalRegion);
+
+    private static native void approx_equal_accept_float_n(float[] a, float[] b, int count, float relTol,
+            float absTol, long[] state, boolean useCriticalRegion);
+
+    private static native void approx_equal_accept_double_a(long a, long b, long count, double relTol,
+            double absTol, long[] state);
 
-    private static native float distance_float_n(float[] a, float[] b, int count, boolean useCriticalRegion);
+    private static native void approx_equal_accept_float_a(long a, long b, long count, float relTol, float absTol,
+            long[] state);
 
     private SIMD() {
         throw new AssertionError();
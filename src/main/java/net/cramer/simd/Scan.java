@@ -0,0 +1,128 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package net.cramer.simd;
+
+import java.util.Objects;
+
+/**
+ * Prefix sums (inclusive and exclusive) and cumulative products. The result
+ * array may be the same as the argument array in which case the computation
+ * happens in-place. The integer sums wrap around on overflow as Java's
+ * {@code +} does. The floating-point results are rounded differently than a
+ * sequential loop would, but don't depend on the number of threads used for
+ * large arrays.
+ */
+public final class Scan {
+
+    private static final boolean USE_CRITICAL = true;
+
+    static {
+        try {
+            System.loadLibrary("vector_avx2");
+        } catch (Throwable t) {
+            t.printStackTrace();
+            throw t;
+        }
+    }
+
+    /**
+     * {@code y[i] = x[0] + ... + x[i]} for {@code i < count}.
+     */
+    public static void prefixSumDouble(double[] x, double[] y, int count) {
+        prefix_sum_double_n(x, out(x, y), count, false, USE_CRITICAL);
+    }
+
+    /**
+     * {@code y[i] = x[0] + ... + x[i - 1]} for {@code i < count}, i.e.
+     * {@code y[0] = 0}.
+     */
+    public static void exclusivePrefixSumDouble(double[] x, double[] y, int count) {
+        prefix_sum_double_n(x, out(x, y), count, true, USE_CRITICAL);
+    }
+
+    /**
+     * {@code y[i] = x[0] * ... * x[i]} for {@code i < count}.
+     */
+    public static void cumulativeProductDouble(double[] x, double[] y, int count) {
+        cumulative_product_double_n(x, out(x, y), count, USE_CRITICAL);
+    }
+
+    public static void prefixSumFloat(float[] x, float[] y, int count) {
+        prefix_sum_float_n(x, out(x, y), count, false, USE_CRITICAL);
+    }
+
+    public static void exclusivePrefixSumFloat(float[] x, float[] y, int count) {
+        prefix_sum_float_n(x, out(x, y), count, true, USE_CRITICAL);
+    }
+
+    public static void cumulativeProductFloat(float[] x, float[] y, int count) {
+        cumulative_product_float_n(x, out(x, y), count, USE_CRITICAL);
+    }
+
+    public static void prefixSumInt(int[] x, int[] y, int count) {
+        prefix_sum_int_n(x, out(x, y), count, false, USE_CRITICAL);
+    }
+
+    public static void exclusivePrefixSumInt(int[] x, int[] y, int count) {
+        prefix_sum_int_n(x, out(x, y), count, true, USE_CRITICAL);
+    }
+
+    public static void prefixSumLong(long[] x, long[] y, int count) {
+        prefix_sum_long_n(x, out(x, y), count, false, USE_CRITICAL);
+    }
+
+    public static void exclusivePrefixSumLong(long[] x, long[] y, int count) {
+        prefix_sum_long_n(x, out(x, y), count, true, USE_CRITICAL);
+    }
+
+    private static double[] out(double[] x, double[] y) {
+        return (x == Objects.requireNonNull(y, "result")) ? null : y;
+    }
+
+    private static float[] out(float[] x, float[] y) {
+        return (x == Objects.requireNonNull(y, "result")) ? null : y;
+    }
+
+    private static int[] out(int[] x, int[] y) {
+        return (x == Objects.requireNonNull(y, "result")) ? null : y;
+    }
+
+    private static long[] out(long[] x, long[] y) {
+        return (x == Objects.requireNonNull(y, "result")) ? null : y;
+    }
+
+    private static native void prefix_sum_double_n(double[] x, double[] y, int count, boolean exclusive,
+            boolean useCriticalRegion);
+
+    private static native void prefix_sum_float_n(float[] x, float[] y, int count, boolean exclusive,
+            boolean useCriticalRegion);
+
+    private static native void prefix_sum_int_n(int[] x, int[] y, int count, boolean exclusive,
+            boolean useCriticalRegion);
+
+    private static native void prefix_sum_long_n(long[] x, long[] y, int count, boolean exclusive,
+            boolean useCriticalRegion);
+
+    private static native void cumulative_product_double_n(double[] x, double[] y, int count,
+            boolean useCriticalRegion);
+
+    private static native void cumulative_product_float_n(float[] x, float[] y, int count,
+            boolean useCriticalRegion);
+
+    private Scan() {
+        throw new AssertionError();
+    }
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package net.cramer.simd;
+
+/**
+ * Selection of order statistics without sorting the whole array: the k-th
+ * smallest element, the {@code k} largest elements with their indices and
+ * quantiles. The floating-point variants order the values as
+ * {@link java.util.Arrays#sort(double[])} does, i.e. {@code -0.0} is
+ * smaller than {@code 0.0} and NaNs are larger than any other value.
+ */
+public final class Selection {
+
+    private static final boolean USE_CRITICAL = true;
+
+    static {
+        try {
+            System.loadLibrary("vector_avx2");
+        } catch (Throwable t) {
+            t.printStackTrace();
+            throw t;
+        }
+    }
+
+    /**
+     * Returns the element that would be at index {@code k} if
+     * {@code a[0 .. count)} was sorted. The range gets reordered such that
+     * this element is at index {@code k}, the elements in front of it are
+     * not larger and the elements behind it are not smaller.
+     */
+    public static double nthElementDouble(double[] a, int count, int k) {
+        return nth_element_double_n(a, count, k, USE_CRITICAL);
+    }
+
+    /**
+     * Writes the {@code k} largest elements of {@code a[0 .. count)} in
+     * descending order to {@code values[0 .. k)} and their indices to
+     * {@code indices[0 .. k)}. The array {@code a} is left unmodified.
+     */
+    public static void topKDouble(double[] a, int count, int k, double[] values, int[] indices) {
+        top_k_double_n(a, count, k, values, indices, USE_CRITICAL);
+    }
+
+    /**
+     * Writes the quantiles of {@code a[0 .. count)} for the probabilities
+     * {@code probs[0 .. nProbs)} (each in {@code [0, 1]}) to
+     * {@code out[0 .. nProbs)}. The quantile for {@code p} interpolates
+     * linearly between the elements of the sorted order at the two ranks
+     * closest to {@code h = p * (count - 1)} (the default of numpy and R's
+     * type 7); quantiles that involve a NaN are NaN. The array {@code a} is
+     * left unmodified.
+     */
+    public static void quantilesDouble(double[] a, int count, double[] probs, int nProbs, double[] out) {
+        quantiles_double_n(a, count, probs, nProbs, out, USE_CRITICAL);
+    }
+
+    public static float nthElementFloat(float[] a, int count, int k) {
+        return nth_element_float_n(a, count, k, USE_CRITICAL);
+    }
+
+    public static void topKFloat(float[] a, int count, int k, float[] values, int[] indices) {
+        top_k_float_n(a, count, k, values, indices, USE_CRITICAL);
+    }
+
+    public static void quantilesFloat(float[] a, int count, double[] probs, int nProbs, double[] out) {
+        quantiles_float_n(a, count, probs, nProbs, out, USE_CRITICAL);
+    }
+
+    public static int nthElementInt(int[] a, int count, int k) {
+        return nth_element_int_n(a, count, k, USE_CRITICAL);
+    }
+
+    public static void topKInt(int[] a, int count, int k, int[] values, int[] indices) {
+        top_k_int_n(a, count, k, values, indices, USE_CRITICAL);
+    }
+
+    public static void quantilesInt(int[] a, int count, double[] probs, int nProbs, double[] out) {
+        quantiles_int_n(a, count, probs, nProbs, out, USE_CRITICAL);
+    }
+
+    public static long nthElementLong(long[] a, int count, int k) {
+        return nth_element_long_n(a, count, k, USE_CRITICAL);
+    }
+
+    public static void topKLong(long[] a, int count, int k, long[] values, int[] indices) {
+        top_k_long_n(a, count, k, values, indices, USE_CRITICAL);
+    }
+
+    public static void quantilesLong(long[] a, int count, double[] probs, int nProbs, double[] out) {
+        quantiles_long_n(a, count, probs, nProbs, out, USE_CRITICAL);
+    }
+
+    private static native double nth_element_double_n(double[] a, int count, int k, boolean useCriticalRegion);
+
+    private static native void top_k_double_n(double[] a, int count, int k, double[] values, int[] indices,
+            boolean useCriticalRegion);
+
+    private static native void quantiles_double_n(double[] a, int count, double[] probs, int nProbs, double[] out,
+            boolean useCriticalRegion);
+
+    private static native float nth_element_float_n(float[] a, int count, int k, boolean useCriticalRegion);
+
+    private static native void top_k_float_n(float[] a, int count, int k, float[] values, int[] indices,
+            boolean useCriticalRegion);
+
+    private static native void quantiles_float_n(float[] a, int count, double[] probs, int nProbs, double[] out,
+            boolean useCriticalRegion);
+
+    private static native int nth_element_int_n(int[] a, int count, int k, boolean useCriticalRegion);
+
+    private static native void top_k_int_n(int[] a, int count, int k, int[] values, int[] indices,
+            boolean useCriticalRegion);
+
+    private static native void quantiles_int_n(int[] a, int count, double[] probs, int nProbs, double[] out,
+            boolean useCriticalRegion);
+
+    private static native long nth_element_long_n(long[] a, int count, int k, boolean useCriticalRegion);
+
+    private static native void top_k_long_n(long[] a, int count, int k, long[] values, int[] indices,
+            boolean useCriticalRegion);
+
+    private static native void quantiles_long_n(long[] a, int count, double[] probs, int nProbs, double[] out,
+            boolean useCriticalRegion);
+
+    private Selection() {
+        throw new AssertionError();
+    }
+}
@@ -0,0 +1,174 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package net.cramer.simd;
+
+import java.nio.DoubleBuffer;
+import java.nio.FloatBuffer;
+import java.nio.IntBuffer;
+import java.nio.LongBuffer;
+
+/**
+ * Ascending sort and argsort of {@code double}, {@code float}, {@code int}
+ * and {@code long} arrays (a quicksort with a vectorized partition step
+ * whose small ranges are sorted by bitonic networks in vector registers).
+ * The floating-point variants order the values as {@link java.util.Arrays#sort(double[])}
+ * does: {@code -0.0} comes before {@code 0.0} and all NaNs go to the end.
+ * The argsort variants write the permutation that sorts the first
+ * {@code count} elements to {@code indices[0 .. count)} and leave the
+ * array unmodified. They are not stable, i.e. the indices of equal values
+ * may appear in any order (the indices of NaNs are in ascending order).
+ */
+public final class Sort {
+
+    private static final boolean USE_CRITICAL = true;
+
+    static {
+        try {
+            System.loadLibrary("vector_avx2");
+        } catch (Throwable t) {
+            t.printStackTrace();
+            throw t;
+        }
+    }
+
+    /**
+     * Sorts {@code a[0 .. count)} into ascending order.
+     */
+    public static void sortDouble(double[] a, int count) {
+        sort_double_n(a, count, USE_CRITICAL);
+    }
+
+    public static void sortDouble(DoubleBuffer a, int count) {
+        sort_double_b(Buffers.checkDirect(a, "a"), count);
+    }
+
+    /**
+     * Writes the indices of {@code a[0 .. count)} in the ascending order of
+     * their values to {@code indices[0 .. count)}.
+     */
+    public static void argsortDouble(double[] a, int count, int[] indices) {
+        argsort_double_n(a, count, indices, USE_CRITICAL);
+    }
+
+    public static void argsortDouble(DoubleBuffer a, int count, IntBuffer indices) {
+        argsort_double_b(Buffers.checkDirect(a, "a"), count, Buffers.checkDirect(indices, "indices"));
+    }
+
+    /**
+     * Sorts {@code a[0 .. count)} into ascending order.
+     */
+    public static void sortFloat(float[] a, int count) {
+        sort_float_n(a, count, USE_CRITICAL);
+    }
+
+    public static void sortFloat(FloatBuffer a, int count) {
+        sort_float_b(Buffers.checkDirect(a, "a"), count);
+    }
+
+    /**
+     * Writes the indices of {@code a[0 .. count)} in the ascending order of
+     * their values to {@code indices[0 .. count)}.
+     */
+    public static void argsortFloat(float[] a, int count, int[] indices) {
+        argsort_float_n(a, count, indices, USE_CRITICAL);
+    }
+
+    public static void argsortFloat(FloatBuffer a, int count, IntBuffer indices) {
+        argsort_float_b(Buffers.checkDirect(a, "a"), count, Buffers.checkDirect(indices, "indices"));
+    }
+
+    /**
+     * Sorts {@code a[0 .. count)} into ascending order.
+     */
+    public static void sortInt(int[] a, int count) {
+        sort_int_n(a, count, USE_CRITICAL);
+    }
+
+    public static void sortInt(IntBuffer a, int count) {
+        sort_int_b(Buffers.checkDirect(a, "a"), count);
+    }
+
+    /**
+     * Writes the indices of {@code a[0 .. count)} in the ascending order of
+     * their values to {@code indices[0 .. count)}.
+     */
+    public static void argsortInt(int[] a, int count, int[] indices) {
+        argsort_int_n(a, count, indices, USE_CRITICAL);
+    }
+
+    public static void argsortInt(IntBuffer a, int count, IntBuffer indices) {
+        argsort_int_b(Buffers.checkDirect(a, "a"), count, Buffers.checkDirect(indices, "indices"));
+    }
+
+    /**
+     * Sorts {@code a[0 .. count)} into ascending order.
+     */
+    public static void sortLong(long[] a, int count) {
+        sort_long_n(a, count, USE_CRITICAL);
+    }
+
+    public static void sortLong(LongBuffer a, int count) {
+        sort_long_b(Buffers.checkDirect(a, "a"), count);
+    }
+
+    /**
+     * Writes the indices of {@code a[0 .. count)} in the ascending order of
+     * their values to {@code indices[0 .. count)}.
+     */
+    public static void argsortLong(long[] a, int count, int[] indices) {
+        argsort_long_n(a, count, indices, USE_CRITICAL);
+    }
+
+    public static void argsortLong(LongBuffer a, int count, IntBuffer indices) {
+        argsort_long_b(Buffers.checkDirect(a, "a"), count, Buffers.checkDirect(indices, "indices"));
+    }
+
+    private static native void sort_double_n(double[] a, int count, boolean useCriticalRegion);
+
+    private static native void argsort_double_n(double[] a, int count, int[] indices, boolean useCriticalRegion);
+
+    private static native void sort_float_n(float[] a, int count, boolean useCriticalRegion);
+
+    private static native void argsort_float_n(float[] a, int count, int[] indices, boolean useCriticalRegion);
+
+    private static native void sort_int_n(int[] a, int count, boolean useCriticalRegion);
+
+    private static native void argsort_int_n(int[] a, int count, int[] indices, boolean useCriticalRegion);
+
+    private static native void sort_long_n(long[] a, int count, boolean useCriticalRegion);
+
+    private static native void argsort_long_n(long[] a, int count, int[] indices, boolean useCriticalRegion);
+
+    private static native void sort_double_b(DoubleBuffer a, int count);
+
+    private static native void argsort_double_b(DoubleBuffer a, int count, IntBuffer indices);
+
+    private static native void sort_float_b(FloatBuffer a, int count);
+
+    private static native void argsort_float_b(FloatBuffer a, int count, IntBuffer indices);
+
+    private static native void sort_int_b(IntBuffer a, int count);
+
+    private static native void argsort_int_b(IntBuffer a, int count, IntBuffer indices);
+
+    private static native void sort_long_b(LongBuffer a, int count);
+
+    private static native void argsort_long_b(LongBuffer a, int count, IntBuffer indices);
+
+    private Sort() {
+        throw new AssertionError();
+    }
+}
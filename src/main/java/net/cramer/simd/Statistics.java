@@ -0,0 +1,139 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package net.cramer.simd;
+
+/**
+ * One-pass summary statistics (count, sum, mean, variance, min, max) of the
+ * non-NaN values seen so far plus the number of NaN values. Instances can be
+ * fed chunk by chunk and partial results (e.g. from different threads) can be
+ * combined with {@link #merge(Statistics)}. Not thread-safe.
+ */
+public final class Statistics {
+
+    // layout must be kept in sync with struct RunningStats in vectorize.h
+    private static final int COUNT = 0;
+    private static final int NAN_COUNT = 1;
+    private static final int SUM = 2;
+    private static final int MEAN = 3;
+    private static final int M2 = 4;
+    private static final int MIN = 5;
+    private static final int MAX = 6;
+    static final int LENGTH = 7;
+
+    final double[] state = new double[LENGTH];
+
+    public Statistics() {
+        state[MIN] = Double.POSITIVE_INFINITY;
+        state[MAX] = Double.NEGATIVE_INFINITY;
+    }
+
+    public Statistics accept(double[] a, int count) {
+        SIMD.statsDouble(a, count, this);
+        return this;
+    }
+
+    public Statistics accept(float[] a, int count) {
+        SIMD.statsFloat(a, count, this);
+        return this;
+    }
+
+    /**
+     * Accepts the first {@code count} doubles of {@code a}.
+     */
+    public Statistics acceptDouble(AlignedBuffer a, long count) {
+        SIMD.statsDoubleAligned(a, count, this);
+        return this;
+    }
+
+    /**
+     * Accepts the first {@code count} floats of {@code a}.
+     */
+    public Statistics acceptFloat(AlignedBuffer a, long count) {
+        SIMD.statsFloatAligned(a, count, this);
+        return this;
+    }
+
+    public Statistics merge(Statistics other) {
+        double[] o = other.state;
+        state[NAN_COUNT] += o[NAN_COUNT];
+        double nb = o[COUNT];
+        if (nb == 0.0) {
+            return this;
+        }
+        double na = state[COUNT];
+        double n = na + nb;
+        double delta = o[MEAN] - state[MEAN];
+        state[MEAN] += delta * (nb / n);
+        state[M2] += o[M2] + delta * delta * (na * (nb / n));
+        state[SUM] += o[SUM];
+        state[COUNT] = n;
+        state[MIN] = Math.min(state[MIN], o[MIN]);
+        state[MAX] = Math.max(state[MAX], o[MAX]);
+        return this;
+    }
+
+    public long count() {
+        return (long) state[COUNT];
+    }
+
+    public long nanCount() {
+        return (long) state[NAN_COUNT];
+    }
+
+    public double sum() {
+        return state[SUM];
+    }
+
+    public double mean() {
+        return state[COUNT] > 0.0 ? state[MEAN] : Double.NaN;
+    }
+
+    /**
+     * Sum of squared deviations from the mean.
+     */
+    public double m2() {
+        return state[M2];
+    }
+
+    /**
+     * Sample variance (divides by {@code count - 1}).
+     */
+    public double variance() {
+        return state[COUNT] > 1.0 ? state[M2] / (state[COUNT] - 1.0) : Double.NaN;
+    }
+
+    public double populationVariance() {
+        return state[COUNT] > 0.0 ? state[M2] / state[COUNT] : Double.NaN;
+    }
+
+    public double standardDeviation() {
+        return Math.sqrt(variance());
+    }
+
+    public double min() {
+        return state[MIN];
+    }
+
+    public double max() {
+        return state[MAX];
+    }
+
+    @Override
+    public String toString() {
+        return "Statistics[count=" + count() + ", nanCount=" + nanCount() + ", sum=" + sum() + ", mean=" + mean()
+                + ", variance=" + variance() + ", min=" + min() + ", max=" + max() + "]";
+    }
+}
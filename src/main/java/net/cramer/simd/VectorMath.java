@@ -0,0 +1,339 @@
+/*
+ * Copyright 2026 Stefan Zobel
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package net.cramer.simd;
+
+import java.nio.DoubleBuffer;
+import java.nio.FloatBuffer;
+import java.util.Objects;
+
+/**
+ * Elementwise transcendental functions. The result array may be the same as
+ * the argument array in which case the computation happens in-place. Note
+ * that the VCL implementations don't handle all special cases (e.g. NaN
+ * arguments of {@code pow}) exactly as {@link Math} does.
+ */
+public final class VectorMath {
+
+    private static final boolean USE_CRITICAL = true;
+
+    // must be kept in sync with the op codes in elementwise.cpp
+    private static final int OP_EXP = 0;
+    private static final int OP_LOG = 1;
+    private static final int OP_LOG1P = 2;
+    private static final int OP_EXPM1 = 3;
+    private static final int OP_TANH = 4;
+    private static final int OP_SIGMOID = 5;
+    private static final int OP_SIN = 6;
+    private static final int OP_COS = 7;
+
+    static {
+        try {
+            System.loadLibrary("vector_avx2");
+        } catch (Throwable t) {
+            t.printStackTrace();
+            throw t;
+        }
+    }
+
+    public static void expDouble(double[] x, double[] y, int count) {
+        unary_double_n(OP_EXP, x, out(x, y), count, USE_CRITICAL);
+    }
+
+    public static void expFloat(float[] x, float[] y, int count) {
+        unary_float_n(OP_EXP, x, out(x, y), count, USE_CRITICAL);
+    }
+
+    public static void expDouble(DoubleBuffer x, DoubleBuffer y, int count) {
+        unary_double_b(OP_EXP, Buffers.checkDirect(x, "x"), out(x, y), count);
+    }
+
+    public static void expFloat(FloatBuffer x, FloatBuffer y, int count) {
+        unary_float_b(OP_EXP, Buffers.checkDirect(x, "x"), out(x, y), count);
+    }
+
+    public static void logDouble(double[] x, double[] y, int count) {
+        unary_double_n(OP_LOG, x, out(x, y), count, USE_CRITICAL);
+    }
+
+    public static void logFloat(float[] x, float[] y, int count) {
+        unary_float_n(OP_LOG, x, out(x, y), count, USE_CRITICAL);
+    }
+
+    public static void logDouble(DoubleBuffer x, DoubleBuffer y, int count) {
+        unary_double_b(OP_LOG, Buffers.checkDirect(x, "x"), out(x, y), count);
+    }
+
+    public static void logFloat(FloatBuffer x, FloatBuffer y, int count) {
+        unary_float_b(OP_LOG, Buffers.checkDirect(x, "x"), out(x, y), count);
+    }
+
+    public static void log1pDouble(double[] x, double[] y, int count) {
+        unary_double_n(OP_LOG1P, x, out(x, y), count, USE_CRITICAL);
+    }
+
+    public static void log1pFloat(float[] x, float[] y, int count) {
+        unary_float_n(OP_LOG1P, x, out(x, y), count, USE_CRITICAL);
+    }
+
+    public static void log1pDouble(DoubleBuffer x, DoubleBuffer y, int count) {
+        unary_double_b(OP_LOG1P, Buffers.checkDirect(x, "x"), out(x, y), count);
+    }
+
+    public static void log1pFloat(FloatBuffer x, FloatBuffer y, int count) {
+        unary_float_b(OP_LOG1P, Buffers.checkDirect(x, "x"), out(x, y), count);
+    }
+
+    public static void expm1Double(double[] x, double[] y, int count) {
+        unary_double_n(OP_EXPM1, x, out(x, y), count, USE_CRITICAL);
+    }
+
+    public static void expm1Float(float[] x, float[] y, int count) {
+        unary_float_n(OP_EXPM1, x, out(x, y), count, USE_CRITICAL);
+    }
+
+    public static void expm1Double(DoubleBuffer x, DoubleBuffer y, int count) {
+        unary_double_b(OP_EXPM1, Buffers.checkDirect(x, "x"), out(x, y), count);
+    }
+
+    public static void expm1Float(FloatBuffer x, FloatBuffer y, int count) {
+        unary_float_b(OP_EXPM1, Buffers.checkDirect(x, "x"), out(x, y), count);
+    }
+
+    public static void tanhDouble(double[] x, double[] y, int count) {
+        unary_double_n(OP_TANH, x, out(x, y), count, USE_CRITICAL);
+    }
+
+    public static void tanhFloat(float[] x, float[] y, int count) {
+        unary_float_n(OP_TANH, x, out(x, y), count, USE_CRITICAL);
+    }
+
+    public static void tanhDouble(DoubleBuffer x, DoubleBuffer y, int count) {
+        unary_double_b(OP_TANH, Buffers.checkDirect(x, "x"), out(x, y), count);
+    }
+
+    public static void tanhFloat(FloatBuffer x, FloatBuffer y, int count) {
+        unary_float_b(OP_TANH, Buffers.checkDirect(x, "x"), out(x, y), count);
+    }
+
+    public static void sigmoidDouble(double[] x, double[] y, int count) {
+        unary_double_n(OP_SIGMOID, x, out(x, y), count, USE_CRITICAL);
+    }
+
+    public static void sigmoidFloat(float[] x, float[] y, int count) {
+        unary_float_n(OP_SIGMOID, x, out(x, y), count, USE_CRITICAL);
+    }
+
+    public static void sigmoidDouble(DoubleBuffer x, DoubleBuffer y, int count) {
+        unary_double_b(OP_SIGMOID, Buffers.checkDirect(x, "x"), out(x, y), count);
+    }
+
+    public static void sigmoidFloat(FloatBuffer x, FloatBuffer y, int count) {
+        unary_float_b(OP_SIGMOID, Buffers.checkDirect(x, "x"), out(x, y), count);
+    }
+
+    public static void sinDouble(double[] x, double[] y, int count) {
+        unary_double_n(OP_SIN, x, out(x, y), count, USE_CRITICAL);
+    }
+
+    public static void sinFloat(float[] x, float[] y, int count) {
+        unary_float_n(OP_SIN, x, out(x, y), count, USE_CRITICAL);
+    }
+
+    public static void sinDouble(DoubleBuffer x, DoubleBuffer y, int count) {
+        unary_double_b(OP_SIN, Buffers.checkDirect(x, "x"), out(x, y), count);
+    }
+
+    public static void sinFloat(FloatBuffer x, FloatBuffer y, int count) {
+        unary_float_b(OP_SIN, Buffers.checkDirect(x, "x"), out(x, y), count);
+    }
+
+    public static void cosDouble(double[] x, double[] y, int count) {
+        unary_double_n(OP_COS, x, out(x, y), count, USE_CRITICAL);
+    }
+
+    public static void cosFloat(float[] x, float[] y, int count) {
+        unary_float_n(OP_COS, x, out(x, y), count, USE_CRITICAL);
+    }
+
+    public static void cosDouble(DoubleBuffer x, DoubleBuffer y, int count) {
+        unary_double_b(OP_COS, Buffers.checkDirect(x, "x"), out(x, y), count);
+    }
+
+    public static void cosFloat(FloatBuffer x, FloatBuffer y, int count) {
+        unary_float_b(OP_COS, Buffers.checkDirect(x, "x"), out(x, y), count);
+    }
+
+    public static void powDouble(double[] x, double[] y, double[] z, int count) {
+        pow_double_n(x, y, out(x, z), count, USE_CRITICAL);
+    }
+
+    public static void powFloat(float[] x, float[] y, float[] z, int count) {
+        pow_float_n(x, y, out(x, z), count, USE_CRITICAL);
+    }
+
+    public static void powDouble(DoubleBuffer x, DoubleBuffer y, DoubleBuffer z, int count) {
+        pow_double_b(Buffers.checkDirect(x, "x"), Buffers.checkDirect(y, "y"), out(x, z), count);
+    }
+
+    public static void powFloat(FloatBuffer x, FloatBuffer y, FloatBuffer z, int count) {
+        pow_float_b(Buffers.checkDirect(x, "x"), Buffers.checkDirect(y, "y"), out(x, z), count);
+    }
+
+    public static void powDouble(double[] x, double e, double[] z, int count) {
+        pow_scalar_double_n(x, e, out(x, z), count, USE_CRITICAL);
+    }
+
+    public static void powFloat(float[] x, float e, float[] z, int count) {
+        pow_scalar_float_n(x, e, out(x, z), count, USE_CRITICAL);
+    }
+
+    public static void powDouble(DoubleBuffer x, double e, DoubleBuffer z, int count) {
+        pow_scalar_double_b(Buffers.checkDirect(x, "x"), e, out(x, z), count);
+    }
+
+    public static void powFloat(FloatBuffer x, float e, FloatBuffer z, int count) {
+        pow_scalar_float_b(Buffers.checkDirect(x, "x"), e, out(x, z), count);
+    }
+
+    public static void sincosDouble(double[] x, double[] sin, double[] cos, int count) {
+        sincos_double_n(x, sin, cos, count, USE_CRITICAL);
+    }
+
+    public static void sincosFloat(float[] x, float[] sin, float[] cos, int count) {
+        sincos_float_n(x, sin, cos, count, USE_CRITICAL);
+    }
+
+    public static void sincosDouble(DoubleBuffer x, DoubleBuffer sin, DoubleBuffer cos, int count) {
+        sincos_double_b(Buffers.checkDirect(x, "x"), Buffers.checkDirect(sin, "sin"), Buffers.checkDirect(cos, "cos"),
+                count);
+    }
+
+    public static void sincosFloat(FloatBuffer x, FloatBuffer sin, FloatBuffer cos, int count) {
+        sincos_float_b(Buffers.checkDirect(x, "x"), Buffers.checkDirect(sin, "sin"), Buffers.checkDirect(cos, "cos"),
+                count);
+    }
+
+    public static void softmaxDouble(double[] x, double[] y, int count) {
+        softmax_double_n(x, out(x, y), 1, count, USE_CRITICAL);
+    }
+
+    public static void softmaxFloat(float[] x, float[] y, int count) {
+        softmax_float_n(x, out(x, y), 1, count, USE_CRITICAL);
+    }
+
+    /**
+     * Row-wise softmax of the row-major {@code rows x cols} matrix {@code x}.
+     * The {@code +Infinity} entries of a row share its mass equally.
+     */
+    public static void softmaxDouble(double[] x, double[] y, int rows, int cols) {
+        softmax_double_n(x, out(x, y), rows, cols, USE_CRITICAL);
+    }
+
+    public static void softmaxFloat(float[] x, float[] y, int rows, int cols) {
+        softmax_float_n(x, out(x, y), rows, cols, USE_CRITICAL);
+    }
+
+    public static double logSumExpDouble(double[] x, int count) {
+        return logsumexp_double_n(x, count, USE_CRITICAL);
+    }
+
+    public static float logSumExpFloat(float[] x, int count) {
+        return logsumexp_float_n(x, count, USE_CRITICAL);
+    }
+
+    /**
+     * Row-wise log-sum-exp of the row-major {@code rows x cols} matrix
+     * {@code x}, stored into {@code lse} (length {@code rows}).
+     */
+    public static void logSumExpDouble(double[] x, double[] lse, int rows, int cols) {
+        logsumexp_rows_double_n(x, lse, rows, cols, USE_CRITICAL);
+    }
+
+    public static void logSumExpFloat(float[] x, float[] lse, int rows, int cols) {
+        logsumexp_rows_float_n(x, lse, rows, cols, USE_CRITICAL);
+    }
+
+    // a null result signals the native side to compute in-place
+    private static double[] out(double[] x, double[] y) {
+        return (x == Objects.requireNonNull(y, "result")) ? null : y;
+    }
+
+    private static float[] out(float[] x, float[] y) {
+        return (x == Objects.requireNonNull(y, "result")) ? null : y;
+    }
+
+    private static DoubleBuffer out(DoubleBuffer x, DoubleBuffer y) {
+        return (x == y) ? null : Buffers.checkDirect(y, "result");
+    }
+
+    private static FloatBuffer out(FloatBuffer x, FloatBuffer y) {
+        return (x == y) ? null : Buffers.checkDirect(y, "result");
+    }
+
+    private static native void unary_double_n(int op, double[] x, double[] y, int count, boolean useCriticalRegion);
+
+    private static native void unary_float_n(int op, float[] x, float[] y, int count, boolean useCriticalRegion);
+
+    private static native void unary_double_b(int op, DoubleBuffer x, DoubleBuffer y, int count);
+
+    private static native void unary_float_b(int op, FloatBuffer x, FloatBuffer y, int count);
+
+    private static native void pow_double_n(double[] x, double[] y, double[] z, int count, boolean useCriticalRegion);
+
+    private static native void pow_float_n(float[] x, float[] y, float[] z, int count, boolean useCriticalRegion);
+
+    private static native void pow_double_b(DoubleBuffer x, DoubleBuffer y, DoubleBuffer z, int count);
+
+    private static native void pow_float_b(FloatBuffer x, FloatBuffer y, FloatBuffer z, int count);
+
+    private static native void pow_scalar_double_n(double[] x, double e, double[] z, int count,
+            boolean useCriticalRegion);
+
+    private static native void pow_scalar_float_n(float[] x, float e, float[] z, int count, boolean useCriticalRegion);
+
+    private static native void pow_scalar_double_b(DoubleBuffer x, double e, DoubleBuffer z, int count);
+
+    private static native void pow_scalar_float_b(FloatBuffer x, float e, FloatBuffer z, int count);
+
+    private static native void sincos_double_n(double[] x, double[] sin, double[] cos, int count,
+            boolean useCriticalRegion);
+
+    private static native void sincos_float_n(float[] x, float[] sin, float[] cos, int count,
+            boolean useCriticalRegion);
+
+    private static native void sincos_double_b(DoubleBuffer x, DoubleBuffer sin, DoubleBuffer cos, int count);
+
+    private static native void sincos_float_b(FloatBuffer x, FloatBuffer sin, FloatBuffer cos, int count);
+
+    private static native void softmax_double_n(double[] x, double[] y, int rows, int cols,
+            boolean useCriticalRegion);
+
+    private static native void softmax_float_n(float[] x, float[] y, int rows, int cols, boolean useCriticalRegion);
+
+    private static native double logsumexp_double_n(double[] x, int count, boolean useCriticalRegion);
+
+    private static native float logsumexp_float_n(float[] x, int count, boolean useCriticalRegion);
+
+    private static native void logsumexp_rows_double_n(double[] x, double[] lse, int rows, int cols,
+            boolean useCriticalRegion);
+
+    private static native void logsumexp_rows_float_n(float[] x, float[] lse, int rows, int cols,
+            boolean useCriticalRegion);
+
+    private VectorMath() {
+        throw new AssertionError();
+    }
+}
@@ -0,0 +1,63 @@
+package net.cramer.simd;
+
+public final class AccessPolicyPerfTest {
+
+    private static final int ITERS = 200_000;
+    private static final int N = 64;
+
+    private static void banner() {
+        System.out.println("****************************************");
+        System.out.println("*         AccessPolicyPerfTest         *");
+        System.out.println("****************************************");
+    }
+
+    public static void main(String[] args) {
+        banner();
+        System.out.println(SIMD.accessPolicy());
+        double[] a = new double[N];
+        for (int i = 0; i < N; ++i) {
+            a[i] = Math.sin(0.37 * i);
+        }
+
+        SIMD.setAdaptiveAccess(false);
+        double norm1 = SIMD.l2normDouble(a, N);
+        System.out.println("Pinned   l2norm    : " + norm1);
+
+        SIMD.setAdaptiveAccess(true);
+        double norm2 = SIMD.l2normDouble(a, N);
+        System.out.println("Adaptive l2norm    : " + norm2);
+
+        double sum1 = 0.0;
+        double sum2 = 0.0;
+
+        SIMD.setAdaptiveAccess(false);
+        int i = 1;
+        try {
+            for (; i <= ITERS; ++i) {
+                long start = System.nanoTime();
+                norm1 = SIMD.l2normDouble(a, N);
+                long took = System.nanoTime() - start;
+                if (i > 1) {
+                    sum1 += took;
+                }
+            }
+        } finally {
+            SIMD.setAdaptiveAccess(true);
+        }
+        System.out.println("Pinned   average   : " + sum1 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + norm1 + ")");
+        System.out.println("Pinned   average   : " + sum1 / ((ITERS - 1)) + " ns (" + i + ": " + norm1 + ")");
+
+        i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            norm2 = SIMD.l2normDouble(a, N);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum2 += took;
+            }
+        }
+        System.out.println("Adaptive average   : " + sum2 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + norm2 + ")");
+        System.out.println("Adaptive average   : " + sum2 / ((ITERS - 1)) + " ns (" + i + ": " + norm2 + ")");
+        System.out.println("Adaptive advantage : " + (sum2 / sum1));
+    }
+}
@@ -0,0 +1,64 @@
+package net.cramer.simd;
+
+import java.nio.DoubleBuffer;
+import java.util.Random;
+
+public final class AlignedBufferPerfTest {
+
+    private static final int ITERS = 200;
+    private static final int LENGTH = 4_000_000;
+
+    private static void banner() {
+        System.out.println("****************************************");
+        System.out.println("*        AlignedBufferPerfTest         *");
+        System.out.println("****************************************");
+    }
+
+    public static void main(String[] args) {
+        banner();
+        Random rnd = new Random(42L);
+        double[] x = new double[LENGTH];
+        for (int i = 0; i < x.length; ++i) {
+            x[i] = rnd.nextDouble();
+        }
+        try (AlignedBuffer buf = AlignedBuffer.allocate(8L * LENGTH, false, true)) {
+            DoubleBuffer view = buf.asDoubleBuffer();
+            view.put(x);
+            System.out.println(buf);
+
+            double norm1 = SIMD.l2normDouble(x, LENGTH);
+            System.out.println("Array  l2norm    : " + norm1);
+
+            double norm2 = SIMD.l2normDoubleAligned(buf, LENGTH);
+            System.out.println("Buffer l2norm    : " + norm2);
+
+            double sum1 = 0.0;
+            double sum2 = 0.0;
+
+            int i = 1;
+            for (; i <= ITERS; ++i) {
+                long start = System.nanoTime();
+                norm1 = SIMD.l2normDouble(x, LENGTH);
+                long took = System.nanoTime() - start;
+                if (i > 1) {
+                    sum1 += took;
+                }
+            }
+            System.out.println("Array  average   : " + sum1 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + norm1 + ")");
+            System.out.println("Array  average   : " + sum1 / ((ITERS - 1)) + " ns (" + i + ": " + norm1 + ")");
+
+            i = 1;
+            for (; i <= ITERS; ++i) {
+                long start = System.nanoTime();
+                norm2 = SIMD.l2normDoubleAligned(buf, LENGTH);
+                long took = System.nanoTime() - start;
+                if (i > 1) {
+                    sum2 += took;
+                }
+            }
+            System.out.println("Buffer average   : " + sum2 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + norm2 + ")");
+            System.out.println("Buffer average   : " + sum2 / ((ITERS - 1)) + " ns (" + i + ": " + norm2 + ")");
+            System.out.println("Buffer advantage : " + (sum2 / sum1));
+        }
+    }
+}
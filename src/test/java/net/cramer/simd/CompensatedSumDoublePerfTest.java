@@ -0,0 +1,80 @@
+package net.cramer.simd;
+
+import java.math.BigDecimal;
+
+public final class CompensatedSumDoublePerfTest {
+
+    private static final int ITERS = 4000;
+    private static final int N = 1024 * 1024;
+
+    private static void banner() {
+        System.out.println("****************************************");
+        System.out.println("*     CompensatedSumDoublePerfTest     *");
+        System.out.println("****************************************");
+    }
+
+    // Neumaier's improved Kahan summation
+    private static double javaSum(double[] a) {
+        double sum = 0.0;
+        double c = 0.0;
+        for (int i = 0; i < a.length; ++i) {
+            double x = a[i];
+            double t = sum + x;
+            if (Math.abs(sum) >= Math.abs(x)) {
+                c += (sum - t) + x;
+            } else {
+                c += (x - t) + sum;
+            }
+            sum = t;
+        }
+        return sum + c;
+    }
+
+    public static void main(String[] args) {
+        banner();
+        double[] a = new double[N];
+        BigDecimal exact = BigDecimal.ZERO;
+        double naive = 0.0;
+        for (int i = 0; i < N; ++i) {
+            a[i] = ((i & 1) == 0 ? 1.0e16 : -1.0e16) + 0.1 * i + 1.0 / 3.0;
+            exact = exact.add(new BigDecimal(a[i]));
+            naive += a[i];
+        }
+        System.out.println("Exact  sum: " + exact.doubleValue());
+        System.out.println("Naive  sum: " + naive);
+
+        double sum1 = javaSum(a);
+        System.out.println("Java   sum: " + sum1);
+
+        double sum2 = SIMD.compensatedSumDouble(a, N);
+        System.out.println("SIMD   sum: " + sum2);
+
+        double time1 = 0.0;
+        double time2 = 0.0;
+
+        int i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            sum1 = javaSum(a);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                time1 += took;
+            }
+        }
+        System.out.println("Java   average   : " + time1 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + sum1 + ")");
+        System.out.println("Java   average   : " + time1 / ((ITERS - 1)) + " ns (" + i + ": " + sum1 + ")");
+
+        i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            sum2 = SIMD.compensatedSumDouble(a, N);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                time2 += took;
+            }
+        }
+        System.out.println("SIMD   average   : " + time2 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + sum2 + ")");
+        System.out.println("SIMD   average   : " + time2 / ((ITERS - 1)) + " ns (" + i + ": " + sum2 + ")");
+        System.out.println("SIMD   advantage : " + (time2 / time1));
+    }
+}
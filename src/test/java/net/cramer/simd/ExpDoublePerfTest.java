@@ -0,0 +1,65 @@
+package net.cramer.simd;
+
+public final class ExpDoublePerfTest {
+
+    private static final int ITERS = 2000;
+    private static final int N = 1024 * 1024;
+
+    private static void banner() {
+        System.out.println("****************************************");
+        System.out.println("*           ExpDoublePerfTest          *");
+        System.out.println("****************************************");
+    }
+
+    private static void javaExp(double[] x, double[] y) {
+        for (int i = 0; i < x.length; ++i) {
+            y[i] = Math.exp(x[i]);
+        }
+    }
+
+    public static void main(String[] args) {
+        banner();
+        double[] x = new double[N];
+        for (int i = 0; i < N; ++i) {
+            x[i] = -10.0 + (20.0 * i) / N;
+        }
+        double[] y1 = new double[N];
+        double[] y2 = new double[N];
+
+        javaExp(x, y1);
+        VectorMath.expDouble(x, y2, N);
+        double maxRelErr = 0.0;
+        for (int i = 0; i < N; ++i) {
+            maxRelErr = Math.max(maxRelErr, Math.abs(y1[i] - y2[i]) / y1[i]);
+        }
+        System.out.println("Max. relative error: " + maxRelErr);
+
+        double sum1 = 0.0;
+        double sum2 = 0.0;
+
+        int i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            javaExp(x, y1);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum1 += took;
+            }
+        }
+        System.out.println("Java   average   : " + sum1 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + y1[N / 2] + ")");
+        System.out.println("Java   average   : " + sum1 / ((ITERS - 1)) + " ns (" + i + ": " + y1[N / 2] + ")");
+
+        i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            VectorMath.expDouble(x, y2, N);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum2 += took;
+            }
+        }
+        System.out.println("SIMD   average   : " + sum2 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + y2[N / 2] + ")");
+        System.out.println("SIMD   average   : " + sum2 / ((ITERS - 1)) + " ns (" + i + ": " + y2[N / 2] + ")");
+        System.out.println("SIMD   advantage : " + (sum2 / sum1));
+    }
+}
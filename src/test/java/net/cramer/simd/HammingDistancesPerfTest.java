@@ -0,0 +1,76 @@
+package net.cramer.simd;
+
+import java.util.Random;
+
+public final class HammingDistancesPerfTest {
+
+    private static final int ITERS = 500;
+    private static final int ROWS = 1_000_000;
+    private static final int WORDS = 4;
+
+    private static void banner() {
+        System.out.println("****************************************");
+        System.out.println("*       HammingDistancesPerfTest       *");
+        System.out.println("****************************************");
+    }
+
+    private static void javaHammingDistances(long[] query, long[] base, int rows, int words, int[] out) {
+        for (int r = 0; r < rows; ++r) {
+            int sum = 0;
+            for (int j = 0, k = r * words; j < words; ++j, ++k) {
+                sum += Long.bitCount(query[j] ^ base[k]);
+            }
+            out[r] = sum;
+        }
+    }
+
+    public static void main(String[] args) {
+        banner();
+        Random rnd = new Random(42L);
+        long[] query = new long[WORDS];
+        long[] base = new long[ROWS * WORDS];
+        for (int i = 0; i < query.length; ++i) {
+            query[i] = rnd.nextLong();
+        }
+        for (int i = 0; i < base.length; ++i) {
+            base[i] = rnd.nextLong();
+        }
+        int[] out1 = new int[ROWS];
+        int[] out2 = new int[ROWS];
+
+        javaHammingDistances(query, base, ROWS, WORDS, out1);
+        System.out.println("Java   Hamming distance[0]: " + out1[0]);
+
+        BitVectors.hammingDistances(query, base, ROWS, WORDS, out2);
+        System.out.println("SIMD   Hamming distance[0]: " + out2[0]);
+        System.out.println("SIMD   popcount        [0]: " + BitVectors.popcount(query, WORDS));
+
+        double sum1 = 0.0;
+        double sum2 = 0.0;
+
+        int i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            javaHammingDistances(query, base, ROWS, WORDS, out1);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum1 += took;
+            }
+        }
+        System.out.println("Java   average   : " + sum1 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + out1[0] + ")");
+        System.out.println("Java   average   : " + sum1 / ((ITERS - 1)) + " ns (" + i + ": " + out1[0] + ")");
+
+        i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            BitVectors.hammingDistances(query, base, ROWS, WORDS, out2);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum2 += took;
+            }
+        }
+        System.out.println("SIMD   average   : " + sum2 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + out2[0] + ")");
+        System.out.println("SIMD   average   : " + sum2 / ((ITERS - 1)) + " ns (" + i + ": " + out2[0] + ")");
+        System.out.println("SIMD   advantage : " + (sum2 / sum1));
+    }
+}
@@ -0,0 +1,77 @@
+package net.cramer.simd;
+
+import java.util.Random;
+
+public final class HistogramDoublePerfTest {
+
+    private static final int ITERS = 100;
+    private static final int LENGTH = 10_000_000;
+    private static final int BINS = 256;
+    private static final double MIN = -4.0;
+    private static final double MAX = 4.0;
+
+    private static void banner() {
+        System.out.println("****************************************");
+        System.out.println("*        HistogramDoublePerfTest       *");
+        System.out.println("****************************************");
+    }
+
+    private static long javaHistogram(double[] a, double min, double max, int bins, long[] counts) {
+        double scale = bins / (max - min);
+        long skipped = 0L;
+        for (int i = 0; i < a.length; ++i) {
+            double x = a[i];
+            if (x >= min && x <= max) {
+                ++counts[Math.min((int) ((x - min) * scale), bins - 1)];
+            } else {
+                ++skipped;
+            }
+        }
+        return skipped;
+    }
+
+    public static void main(String[] args) {
+        banner();
+        Random rnd = new Random(42L);
+        double[] a = new double[LENGTH];
+        for (int i = 0; i < a.length; ++i) {
+            a[i] = rnd.nextGaussian();
+        }
+        long[] counts1 = new long[BINS];
+        long[] counts2 = new long[BINS];
+
+        long skipped1 = javaHistogram(a, MIN, MAX, BINS, counts1);
+        System.out.println("Java   skipped   : " + skipped1 + ", count[" + BINS / 2 + "]: " + counts1[BINS / 2]);
+
+        long skipped2 = SIMD.histogramDouble(a, LENGTH, MIN, MAX, BINS, counts2, true);
+        System.out.println("SIMD   skipped   : " + skipped2 + ", count[" + BINS / 2 + "]: " + counts2[BINS / 2]);
+
+        double sum1 = 0.0;
+        double sum2 = 0.0;
+
+        int i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            skipped1 = javaHistogram(a, MIN, MAX, BINS, counts1);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum1 += took;
+            }
+        }
+        System.out.println("Java   average   : " + sum1 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + skipped1 + ")");
+        System.out.println("Java   average   : " + sum1 / ((ITERS - 1)) + " ns (" + i + ": " + skipped1 + ")");
+
+        i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            skipped2 = SIMD.histogramDouble(a, LENGTH, MIN, MAX, BINS, counts2, true);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum2 += took;
+            }
+        }
+        System.out.println("SIMD   average   : " + sum2 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + skipped2 + ")");
+        System.out.println("SIMD   average   : " + sum2 / ((ITERS - 1)) + " ns (" + i + ": " + skipped2 + ")");
+        System.out.println("SIMD   advantage : " + (sum2 / sum1));
+    }
+}
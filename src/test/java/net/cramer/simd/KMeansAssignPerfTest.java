@@ -0,0 +1,87 @@
+package net.cramer.simd;
+
+import java.util.Random;
+
+public final class KMeansAssignPerfTest {
+
+    private static final int ITERS = 50;
+    private static final int ROWS = 50_000;
+    private static final int DIM = 64;
+    private static final int K = 256;
+
+    private static void banner() {
+        System.out.println("****************************************");
+        System.out.println("*         KMeansAssignPerfTest         *");
+        System.out.println("****************************************");
+    }
+
+    private static double javaAssign(double[] x, int rows, int dim, double[] centroids, int k, int[] assignments) {
+        double inertia = 0.0;
+        for (int r = 0; r < rows; ++r) {
+            double best = Double.POSITIVE_INFINITY;
+            int bestIndex = 0;
+            for (int j = 0; j < k; ++j) {
+                double sum = 0.0;
+                for (int i = 0, p = r * dim, q = j * dim; i < dim; ++i, ++p, ++q) {
+                    double d = x[p] - centroids[q];
+                    sum += d * d;
+                }
+                if (sum < best) {
+                    best = sum;
+                    bestIndex = j;
+                }
+            }
+            assignments[r] = bestIndex;
+            inertia += best;
+        }
+        return inertia;
+    }
+
+    public static void main(String[] args) {
+        banner();
+        Random rnd = new Random(42L);
+        double[] x = new double[ROWS * DIM];
+        for (int i = 0; i < x.length; ++i) {
+            x[i] = rnd.nextGaussian();
+        }
+        double[] centroids = new double[K * DIM];
+        int[] assignments1 = new int[ROWS];
+        int[] assignments2 = new int[ROWS];
+        KMeansResult result = KMeans.clusterDouble(x, ROWS, DIM, K, 10, 1e-4, 42L, centroids, assignments2);
+        System.out.println("SIMD   " + result);
+
+        double inertia1 = javaAssign(x, ROWS, DIM, centroids, K, assignments1);
+        System.out.println("Java   inertia: " + inertia1);
+
+        double inertia2 = KMeans.assignDouble(x, ROWS, DIM, centroids, K, assignments2);
+        System.out.println("SIMD   inertia: " + inertia2);
+
+        double sum1 = 0.0;
+        double sum2 = 0.0;
+
+        int i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            inertia1 = javaAssign(x, ROWS, DIM, centroids, K, assignments1);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum1 += took;
+            }
+        }
+        System.out.println("Java   average   : " + sum1 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + inertia1 + ")");
+        System.out.println("Java   average   : " + sum1 / ((ITERS - 1)) + " ns (" + i + ": " + inertia1 + ")");
+
+        i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            inertia2 = KMeans.assignDouble(x, ROWS, DIM, centroids, K, assignments2);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum2 += took;
+            }
+        }
+        System.out.println("SIMD   average   : " + sum2 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + inertia2 + ")");
+        System.out.println("SIMD   average   : " + sum2 / ((ITERS - 1)) + " ns (" + i + ": " + inertia2 + ")");
+        System.out.println("SIMD   advantage : " + (sum2 / sum1));
+    }
+}
@@ -0,0 +1,61 @@
+package net.cramer.simd;
+
+public final class L2NormReproduciblePerfTest {
+
+    private static final int ITERS = 16000;
+    private static final int N = 1024;
+
+    private static void banner() {
+        System.out.println("****************************************");
+        System.out.println("*      L2NormReproduciblePerfTest      *");
+        System.out.println("****************************************");
+    }
+
+    public static void main(String[] args) {
+        banner();
+        boolean mode = SIMD.isReproducible();
+        double[] b = new double[N * N];
+        for (int i = 0; i < b.length; ++i) {
+            b[i] = 1.0e-4 * (1.0 + Math.sin(i));
+        }
+
+        SIMD.setReproducible(false);
+        double norm1 = SIMD.l2normDouble(b, b.length);
+        System.out.println("Default      norm2: " + norm1 + " (" + Double.toHexString(norm1) + ")");
+
+        SIMD.setReproducible(true);
+        double norm2 = SIMD.l2normDouble(b, b.length);
+        System.out.println("Reproducible norm2: " + norm2 + " (" + Double.toHexString(norm2) + ")");
+
+        double sum1 = 0.0;
+        double sum2 = 0.0;
+
+        SIMD.setReproducible(false);
+        int i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            norm1 = SIMD.l2normDouble(b, b.length);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum1 += took;
+            }
+        }
+        System.out.println("Default      average : " + sum1 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + norm1 + ")");
+        System.out.println("Default      average : " + sum1 / ((ITERS - 1)) + " ns (" + i + ": " + norm1 + ")");
+
+        SIMD.setReproducible(true);
+        i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            norm2 = SIMD.l2normDouble(b, b.length);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum2 += took;
+            }
+        }
+        System.out.println("Reproducible average : " + sum2 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + norm2 + ")");
+        System.out.println("Reproducible average : " + sum2 / ((ITERS - 1)) + " ns (" + i + ": " + norm2 + ")");
+        System.out.println("Reproducible cost    : " + (sum2 / sum1));
+        SIMD.setReproducible(mode);
+    }
+}
@@ -0,0 +1,91 @@
+package net.cramer.simd;
+
+public final class L2NormStreamingPerfTest {
+
+    private static final int ITERS = 2000;
+    private static final int N = 1024 * 1024;
+    private static final int CHUNK = 64 * 1024;
+
+    private static void banner() {
+        System.out.println("****************************************");
+        System.out.println("*       L2NormStreamingPerfTest        *");
+        System.out.println("****************************************");
+    }
+
+    // the scaled sum of squares of dnrm2, carried across the chunks in Java
+    private static double javaNorm(double[] a) {
+        double scale = 0.0;
+        double ssq = 1.0;
+        for (int off = 0; off < a.length; off += CHUNK) {
+            int end = Math.min(off + CHUNK, a.length);
+            for (int i = off; i < end; ++i) {
+                double x = a[i];
+                if (x != 0.0) {
+                    double absx = Math.abs(x);
+                    if (scale < absx) {
+                        double r = scale / absx;
+                        ssq = 1.0 + ssq * (r * r);
+                        scale = absx;
+                    } else {
+                        double r = absx / scale;
+                        ssq += r * r;
+                    }
+                }
+            }
+        }
+        return scale * Math.sqrt(ssq);
+    }
+
+    private static double streamingNorm(double[] a) {
+        L2Norm norm = new L2Norm();
+        double[] chunk = new double[CHUNK];
+        for (int off = 0; off < a.length; off += CHUNK) {
+            int n = Math.min(CHUNK, a.length - off);
+            System.arraycopy(a, off, chunk, 0, n);
+            norm.accept(chunk, n);
+        }
+        return norm.value();
+    }
+
+    public static void main(String[] args) {
+        banner();
+        double[] a = new double[N];
+        for (int i = 0; i < N; ++i) {
+            a[i] = 1.0e200 * Math.sin(0.37 * i);
+        }
+
+        double norm1 = javaNorm(a);
+        System.out.println("Java   l2norm    : " + norm1);
+
+        double norm2 = streamingNorm(a);
+        System.out.println("Stream l2norm    : " + norm2);
+
+        double sum1 = 0.0;
+        double sum2 = 0.0;
+
+        int i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            norm1 = javaNorm(a);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum1 += took;
+            }
+        }
+        System.out.println("Java   average   : " + sum1 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + norm1 + ")");
+        System.out.println("Java   average   : " + sum1 / ((ITERS - 1)) + " ns (" + i + ": " + norm1 + ")");
+
+        i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            norm2 = streamingNorm(a);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum2 += took;
+            }
+        }
+        System.out.println("Stream average   : " + sum2 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + norm2 + ")");
+        System.out.println("Stream average   : " + sum2 / ((ITERS - 1)) + " ns (" + i + ": " + norm2 + ")");
+        System.out.println("Stream advantage : " + (sum2 / sum1));
+    }
+}
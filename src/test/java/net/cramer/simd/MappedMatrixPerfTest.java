@@ -0,0 +1,105 @@
+package net.cramer.simd;
+
+import java.io.IOException;
+import java.io.RandomAccessFile;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.DoubleBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.Random;
+
+public final class MappedMatrixPerfTest {
+
+    private static final int ITERS = 50;
+    private static final int ROWS = 4_000;
+    private static final int COLS = 1_000;
+
+    private static void banner() {
+        System.out.println("****************************************");
+        System.out.println("*         MappedMatrixPerfTest         *");
+        System.out.println("****************************************");
+    }
+
+    // the pre-mmap way: read the whole data section onto the heap first
+    private static double readAndNorm(Path file) throws IOException {
+        double[] x = new double[ROWS * COLS];
+        try (RandomAccessFile raf = new RandomAccessFile(file.toFile(), "r")) {
+            FileChannel ch = raf.getChannel();
+            ByteBuffer buf = ByteBuffer.allocateDirect(1 << 20).order(ByteOrder.nativeOrder());
+            long pos = 4096L;
+            int off = 0;
+            while (off < x.length) {
+                buf.clear();
+                ch.read(buf, pos);
+                buf.flip();
+                int n = Math.min(buf.remaining() / 8, x.length - off);
+                buf.asDoubleBuffer().get(x, off, n);
+                off += n;
+                pos += 8L * n;
+            }
+        }
+        return SIMD.l2normDouble(x, x.length);
+    }
+
+    private static double mapAndNorm(Path file) throws IOException {
+        try (MappedMatrix m = MappedMatrix.open(file)) {
+            return SIMD.l2normDoubleAligned(m.data(), m.rows() * m.cols());
+        }
+    }
+
+    public static void main(String[] args) throws IOException {
+        banner();
+        Path file = Files.createTempFile("simd", ".mat");
+        try {
+            Random rnd = new Random(42L);
+            try (MappedMatrix m = MappedMatrix.create(file, MappedMatrix.DTYPE_FLOAT64, ROWS, COLS, false)) {
+                for (int i = 0; i < ROWS; ++i) {
+                    DoubleBuffer row = m.rowView(i).asDoubleBuffer();
+                    for (int j = 0; j < COLS; ++j) {
+                        row.put(rnd.nextDouble());
+                    }
+                }
+                m.force();
+                System.out.println(m);
+            }
+
+            double norm1 = readAndNorm(file);
+            System.out.println("Read   l2norm    : " + norm1);
+
+            double norm2 = mapAndNorm(file);
+            System.out.println("Mapped l2norm    : " + norm2);
+
+            double sum1 = 0.0;
+            double sum2 = 0.0;
+
+            int i = 1;
+            for (; i <= ITERS; ++i) {
+                long start = System.nanoTime();
+                norm1 = readAndNorm(file);
+                long took = System.nanoTime() - start;
+                if (i > 1) {
+                    sum1 += took;
+                }
+            }
+            System.out.println("Read   average   : " + sum1 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + norm1 + ")");
+            System.out.println("Read   average   : " + sum1 / ((ITERS - 1)) + " ns (" + i + ": " + norm1 + ")");
+
+            i = 1;
+            for (; i <= ITERS; ++i) {
+                long start = System.nanoTime();
+                norm2 = mapAndNorm(file);
+                long took = System.nanoTime() - start;
+                if (i > 1) {
+                    sum2 += took;
+                }
+            }
+            System.out.println("Mapped average   : " + sum2 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + norm2 + ")");
+            System.out.println("Mapped average   : " + sum2 / ((ITERS - 1)) + " ns (" + i + ": " + norm2 + ")");
+            System.out.println("Mapped advantage : " + (sum2 / sum1));
+        } finally {
+            Files.delete(file);
+        }
+    }
+}
@@ -0,0 +1,63 @@
+package net.cramer.simd;
+
+public final class MaxPinTimePerfTest {
+
+    private static final int ITERS = 500;
+    private static final int N = 16 * 1024 * 1024;
+    private static final long MAX_PIN_MICROS = 200L;
+
+    private static void banner() {
+        System.out.println("****************************************");
+        System.out.println("*          MaxPinTimePerfTest          *");
+        System.out.println("****************************************");
+    }
+
+    public static void main(String[] args) {
+        banner();
+        double[] a = new double[N];
+        for (int i = 0; i < N; ++i) {
+            a[i] = Math.sin(0.37 * i);
+        }
+
+        double norm1 = SIMD.l2normDouble(a, N);
+        System.out.println("Pinned l2norm    : " + norm1);
+
+        SIMD.setMaxPinMicros(MAX_PIN_MICROS);
+        double norm2 = SIMD.l2normDouble(a, N);
+        SIMD.setMaxPinMicros(0L);
+        System.out.println("Sliced l2norm    : " + norm2);
+
+        double sum1 = 0.0;
+        double sum2 = 0.0;
+
+        int i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            norm1 = SIMD.l2normDouble(a, N);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum1 += took;
+            }
+        }
+        System.out.println("Pinned average   : " + sum1 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + norm1 + ")");
+        System.out.println("Pinned average   : " + sum1 / ((ITERS - 1)) + " ns (" + i + ": " + norm1 + ")");
+
+        SIMD.setMaxPinMicros(MAX_PIN_MICROS);
+        try {
+            i = 1;
+            for (; i <= ITERS; ++i) {
+                long start = System.nanoTime();
+                norm2 = SIMD.l2normDouble(a, N);
+                long took = System.nanoTime() - start;
+                if (i > 1) {
+                    sum2 += took;
+                }
+            }
+        } finally {
+            SIMD.setMaxPinMicros(0L);
+        }
+        System.out.println("Sliced average   : " + sum2 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + norm2 + ")");
+        System.out.println("Sliced average   : " + sum2 / ((ITERS - 1)) + " ns (" + i + ": " + norm2 + ")");
+        System.out.println("Sliced advantage : " + (sum2 / sum1));
+    }
+}
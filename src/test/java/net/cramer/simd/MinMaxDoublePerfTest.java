@@ -0,0 +1,70 @@
+package net.cramer.simd;
+
+import java.util.Random;
+
+public final class MinMaxDoublePerfTest {
+
+    private static final int ITERS = 200;
+    private static final int LENGTH = 4_000_000;
+
+    private static void banner() {
+        System.out.println("****************************************");
+        System.out.println("*         MinMaxDoublePerfTest         *");
+        System.out.println("****************************************");
+    }
+
+    private static long javaArgMax(double[] x, int count) {
+        int idx = -1;
+        double max = Double.NEGATIVE_INFINITY;
+        for (int i = 0; i < count; ++i) {
+            if (x[i] > max || idx < 0) {
+                max = x[i];
+                idx = i;
+            }
+        }
+        return idx;
+    }
+
+    public static void main(String[] args) {
+        banner();
+        Random rnd = new Random(42L);
+        double[] x = new double[LENGTH];
+        for (int i = 0; i < x.length; ++i) {
+            x[i] = rnd.nextDouble();
+        }
+
+        long idx1 = javaArgMax(x, LENGTH);
+        System.out.println("Java   argmax    : " + idx1);
+
+        long idx2 = SIMD.argmaxDouble(x, LENGTH, true);
+        System.out.println("SIMD   argmax    : " + idx2);
+
+        double sum1 = 0.0;
+        double sum2 = 0.0;
+
+        int i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            idx1 = javaArgMax(x, LENGTH);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum1 += took;
+            }
+        }
+        System.out.println("Java   average   : " + sum1 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + idx1 + ")");
+        System.out.println("Java   average   : " + sum1 / ((ITERS - 1)) + " ns (" + i + ": " + idx1 + ")");
+
+        i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            idx2 = SIMD.argmaxDouble(x, LENGTH, true);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum2 += took;
+            }
+        }
+        System.out.println("SIMD   average   : " + sum2 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + idx2 + ")");
+        System.out.println("SIMD   average   : " + sum2 / ((ITERS - 1)) + " ns (" + i + ": " + idx2 + ")");
+        System.out.println("SIMD   advantage : " + (sum2 / sum1));
+    }
+}
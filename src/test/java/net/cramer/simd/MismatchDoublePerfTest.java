@@ -0,0 +1,82 @@
+package net.cramer.simd;
+
+import java.util.Arrays;
+
+public final class MismatchDoublePerfTest {
+
+    private static final int ITERS = 16000;
+    private static final int N = 1024;
+
+    private static void banner() {
+        System.out.println("****************************************");
+        System.out.println("*        MismatchDoublePerfTest        *");
+        System.out.println("****************************************");
+    }
+
+    private static Mismatch javaMismatch(double[] a, double[] b, double relTol, double absTol) {
+        Mismatch mismatch = new Mismatch();
+        for (int i = 0; i < a.length; ++i) {
+            double ai = a[i];
+            double bi = b[i];
+            if (ai != bi) {
+                double absdiff = Math.abs(ai - bi);
+                if (!(absdiff <= absTol || absdiff <= relTol * Math.max(Math.abs(ai), Math.abs(bi)))) {
+                    if (mismatch.state[0] < 0L) {
+                        mismatch.state[0] = i;
+                    }
+                    ++mismatch.state[1];
+                }
+            }
+        }
+        return mismatch;
+    }
+
+    public static void main(String[] args) {
+        banner();
+        double[] a = new double[N * N];
+        double[] b = new double[N * N];
+        Arrays.fill(a, 0.005);
+        Arrays.fill(b, 0.005);
+        for (int i = N * N / 3; i < N * N; i += N) {
+            b[i] = 0.006;
+        }
+
+        Mismatch mmismatch = javaMismatch(a, b, 1.0e-6, 0.0);
+        System.out.println("Java   mismatch double: " + mmismatch);
+
+        Mismatch mismatch = SIMD.mismatchDouble(a, b, a.length, 1.0e-6, 0.0, false);
+        System.out.println("SIMD   mismatch double: " + mismatch);
+        System.out.println("SIMD   first only     : " + SIMD.mismatchDouble(a, b, a.length, 1.0e-6, 0.0, true));
+        System.out.println("SIMD   ulp mismatch   : " + SIMD.mismatchUlpDouble(a, b, a.length, 4L, false));
+
+        double sum1 = 0.0;
+        double sum2 = 0.0;
+
+        int i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            mmismatch = javaMismatch(a, b, 1.0e-6, 0.0);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum1 += took;
+            }
+        }
+        System.out.println(
+                "Java   average   : " + sum1 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + mmismatch.count() + ")");
+        System.out.println("Java   average   : " + sum1 / ((ITERS - 1)) + " ns (" + i + ": " + mmismatch.count() + ")");
+
+        i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            mismatch = SIMD.mismatchDouble(a, b, a.length, 1.0e-6, 0.0, false);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum2 += took;
+            }
+        }
+        System.out.println(
+                "SIMD   average   : " + sum2 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + mismatch.count() + ")");
+        System.out.println("SIMD   average   : " + sum2 / ((ITERS - 1)) + " ns (" + i + ": " + mismatch.count() + ")");
+        System.out.println("SIMD   advantage : " + (sum2 / sum1));
+    }
+}
@@ -0,0 +1,95 @@
+package net.cramer.simd;
+
+import java.util.PriorityQueue;
+import java.util.Random;
+
+public final class NearestNeighborsFloatPerfTest {
+
+    private static final int ITERS = 20;
+    private static final int ROWS = 100_000;
+    private static final int DIM = 128;
+    private static final int QUERIES = 64;
+    private static final int K = 10;
+
+    private static void banner() {
+        System.out.println("****************************************");
+        System.out.println("*     NearestNeighborsFloatPerfTest    *");
+        System.out.println("****************************************");
+    }
+
+    // one SIMD.squaredDistanceFloat call per candidate
+    private static void javaSearch(float[] base, float[] queries, int[] indices, float[] distances) {
+        float[] row = new float[DIM];
+        float[] query = new float[DIM];
+        for (int q = 0; q < QUERIES; ++q) {
+            System.arraycopy(queries, q * DIM, query, 0, DIM);
+            PriorityQueue<float[]> heap = new PriorityQueue<>(K, (x, y) -> Float.compare(y[0], x[0]));
+            for (int r = 0; r < ROWS; ++r) {
+                System.arraycopy(base, r * DIM, row, 0, DIM);
+                float d = SIMD.squaredDistanceFloat(query, row, DIM);
+                if (heap.size() < K) {
+                    heap.add(new float[] { d, r });
+                } else if (d < heap.peek()[0]) {
+                    heap.poll();
+                    heap.add(new float[] { d, r });
+                }
+            }
+            for (int j = K - 1; j >= 0; --j) {
+                float[] n = heap.poll();
+                distances[q * K + j] = n[0];
+                indices[q * K + j] = (int) n[1];
+            }
+        }
+    }
+
+    public static void main(String[] args) {
+        banner();
+        Random rnd = new Random(42L);
+        float[] base = new float[ROWS * DIM];
+        float[] queries = new float[QUERIES * DIM];
+        for (int i = 0; i < base.length; ++i) {
+            base[i] = (float) rnd.nextGaussian();
+        }
+        for (int i = 0; i < queries.length; ++i) {
+            queries[i] = (float) rnd.nextGaussian();
+        }
+        int[] indices1 = new int[QUERIES * K];
+        float[] distances1 = new float[QUERIES * K];
+        int[] indices2 = new int[QUERIES * K];
+        float[] distances2 = new float[QUERIES * K];
+
+        javaSearch(base, queries, indices1, distances1);
+        System.out.println("Java   nearest: " + indices1[0] + " (" + distances1[0] + ")");
+
+        NearestNeighbors.searchL2SquaredFloat(base, ROWS, DIM, queries, QUERIES, K, indices2, distances2);
+        System.out.println("SIMD   nearest: " + indices2[0] + " (" + distances2[0] + ")");
+
+        double sum1 = 0.0;
+        double sum2 = 0.0;
+
+        int i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            javaSearch(base, queries, indices1, distances1);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum1 += took;
+            }
+        }
+        System.out.println("Java   average   : " + sum1 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + indices1[0] + ")");
+        System.out.println("Java   average   : " + sum1 / ((ITERS - 1)) + " ns (" + i + ": " + indices1[0] + ")");
+
+        i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            NearestNeighbors.searchL2SquaredFloat(base, ROWS, DIM, queries, QUERIES, K, indices2, distances2);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum2 += took;
+            }
+        }
+        System.out.println("SIMD   average   : " + sum2 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + indices2[0] + ")");
+        System.out.println("SIMD   average   : " + sum2 / ((ITERS - 1)) + " ns (" + i + ": " + indices2[0] + ")");
+        System.out.println("SIMD   advantage : " + (sum2 / sum1));
+    }
+}
@@ -0,0 +1,94 @@
+package net.cramer.simd;
+
+import java.util.Random;
+
+public final class NearestNeighborsInt8PerfTest {
+
+    private static final int ITERS = 20;
+    private static final int ROWS = 200_000;
+    private static final int DIM = 384;
+    private static final int QUERIES = 64;
+    private static final int K = 10;
+
+    private static void banner() {
+        System.out.println("****************************************");
+        System.out.println("*     NearestNeighborsInt8PerfTest     *");
+        System.out.println("****************************************");
+    }
+
+    private static double recall(int[] expected, int[] actual) {
+        int hits = 0;
+        for (int q = 0; q < QUERIES; ++q) {
+            for (int i = 0; i < K; ++i) {
+                for (int j = 0; j < K; ++j) {
+                    if (expected[q * K + i] == actual[q * K + j]) {
+                        ++hits;
+                        break;
+                    }
+                }
+            }
+        }
+        return hits / (double) (QUERIES * K);
+    }
+
+    public static void main(String[] args) {
+        banner();
+        Random rnd = new Random(42L);
+        float[] base = new float[ROWS * DIM];
+        float[] queries = new float[QUERIES * DIM];
+        for (int i = 0; i < base.length; ++i) {
+            base[i] = (float) rnd.nextGaussian();
+        }
+        for (int i = 0; i < queries.length; ++i) {
+            queries[i] = (float) rnd.nextGaussian();
+        }
+        byte[] base8 = new byte[ROWS * DIM];
+        float[] scales = new float[ROWS];
+        byte[] queries8 = new byte[QUERIES * DIM];
+        float[] queryScales = new float[QUERIES];
+        Quantization.quantizeInt8(base, ROWS, DIM, base8, scales);
+        Quantization.quantizeInt8(queries, QUERIES, DIM, queries8, queryScales);
+
+        int[] indices1 = new int[QUERIES * K];
+        float[] distances1 = new float[QUERIES * K];
+        int[] indices2 = new int[QUERIES * K];
+        float[] distances2 = new float[QUERIES * K];
+
+        NearestNeighbors.searchL2SquaredFloat(base, ROWS, DIM, queries, QUERIES, K, indices1, distances1);
+        System.out.println("Float  nearest: " + indices1[0] + " (" + distances1[0] + ")");
+
+        NearestNeighbors.searchL2SquaredInt8(base8, scales, ROWS, DIM, queries8, queryScales, QUERIES, K, indices2,
+                distances2);
+        System.out.println("Int8   nearest: " + indices2[0] + " (" + distances2[0] + ")");
+        System.out.println("Int8   recall : " + recall(indices1, indices2));
+
+        double sum1 = 0.0;
+        double sum2 = 0.0;
+
+        int i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            NearestNeighbors.searchL2SquaredFloat(base, ROWS, DIM, queries, QUERIES, K, indices1, distances1);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum1 += took;
+            }
+        }
+        System.out.println("Float  average   : " + sum1 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + indices1[0] + ")");
+        System.out.println("Float  average   : " + sum1 / ((ITERS - 1)) + " ns (" + i + ": " + indices1[0] + ")");
+
+        i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            NearestNeighbors.searchL2SquaredInt8(base8, scales, ROWS, DIM, queries8, queryScales, QUERIES, K,
+                    indices2, distances2);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum2 += took;
+            }
+        }
+        System.out.println("Int8   average   : " + sum2 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + indices2[0] + ")");
+        System.out.println("Int8   average   : " + sum2 / ((ITERS - 1)) + " ns (" + i + ": " + indices2[0] + ")");
+        System.out.println("Int8   advantage : " + (sum2 / sum1));
+    }
+}
@@ -0,0 +1,83 @@
+package net.cramer.simd;
+
+import java.util.Random;
+
+public final class PipelineDoublePerfTest {
+
+    private static final int ITERS = 200;
+    private static final int LENGTH = 4_000_000;
+
+    private static void banner() {
+        System.out.println("****************************************");
+        System.out.println("*        PipelineDoublePerfTest        *");
+        System.out.println("****************************************");
+    }
+
+    private static final double A = 0.75;
+    private static final double B = -0.5;
+
+    // z = exp(a * x + b) with one temporary per step, returns sum(z)
+    private static double javaChain(double[] x, double[] z, int count) {
+        double[] t1 = new double[count];
+        for (int i = 0; i < count; ++i) {
+            t1[i] = A * x[i];
+        }
+        double[] t2 = new double[count];
+        for (int i = 0; i < count; ++i) {
+            t2[i] = t1[i] + B;
+        }
+        double sum = 0.0;
+        for (int i = 0; i < count; ++i) {
+            z[i] = Math.exp(t2[i]);
+            sum += z[i];
+        }
+        return sum;
+    }
+
+    public static void main(String[] args) {
+        banner();
+        Random rnd = new Random(42L);
+        double[] x = new double[LENGTH];
+        for (int i = 0; i < x.length; ++i) {
+            x[i] = rnd.nextDouble();
+        }
+
+        double[] z1 = new double[LENGTH];
+        double[] z2 = new double[LENGTH];
+        Pipeline p = Pipeline.builder().input(0).constant(A).mul().constant(B).add().exp().build();
+
+        double sumJ = javaChain(x, z1, LENGTH);
+        System.out.println("Java   sum       : " + sumJ);
+
+        double sumS = p.applyAndSumDouble(z2, LENGTH, x);
+        System.out.println("SIMD   sum       : " + sumS);
+
+        double sum1 = 0.0;
+        double sum2 = 0.0;
+
+        int i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            sumJ = javaChain(x, z1, LENGTH);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum1 += took;
+            }
+        }
+        System.out.println("Java   average   : " + sum1 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + sumJ + ")");
+        System.out.println("Java   average   : " + sum1 / ((ITERS - 1)) + " ns (" + i + ": " + sumJ + ")");
+
+        i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            sumS = p.applyAndSumDouble(z2, LENGTH, x);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum2 += took;
+            }
+        }
+        System.out.println("SIMD   average   : " + sum2 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + sumS + ")");
+        System.out.println("SIMD   average   : " + sum2 / ((ITERS - 1)) + " ns (" + i + ": " + sumS + ")");
+        System.out.println("SIMD   advantage : " + (sum2 / sum1));
+    }
+}
@@ -0,0 +1,68 @@
+package net.cramer.simd;
+
+import java.util.Random;
+
+public final class PrefixSumDoublePerfTest {
+
+    private static final int ITERS = 200;
+    private static final int LENGTH = 4_000_000;
+
+    private static void banner() {
+        System.out.println("****************************************");
+        System.out.println("*        PrefixSumDoublePerfTest       *");
+        System.out.println("****************************************");
+    }
+
+    private static void javaPrefixSum(double[] x, double[] y, int count) {
+        double sum = 0.0;
+        for (int i = 0; i < count; ++i) {
+            sum += x[i];
+            y[i] = sum;
+        }
+    }
+
+    public static void main(String[] args) {
+        banner();
+        Random rnd = new Random(42L);
+        double[] x = new double[LENGTH];
+        for (int i = 0; i < x.length; ++i) {
+            x[i] = rnd.nextDouble();
+        }
+        double[] y1 = new double[LENGTH];
+        double[] y2 = new double[LENGTH];
+
+        javaPrefixSum(x, y1, LENGTH);
+        System.out.println("Java   total     : " + y1[LENGTH - 1]);
+
+        Scan.prefixSumDouble(x, y2, LENGTH);
+        System.out.println("SIMD   total     : " + y2[LENGTH - 1]);
+
+        double sum1 = 0.0;
+        double sum2 = 0.0;
+
+        int i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            javaPrefixSum(x, y1, LENGTH);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum1 += took;
+            }
+        }
+        System.out.println("Java   average   : " + sum1 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + y1[LENGTH - 1] + ")");
+        System.out.println("Java   average   : " + sum1 / ((ITERS - 1)) + " ns (" + i + ": " + y1[LENGTH - 1] + ")");
+
+        i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            Scan.prefixSumDouble(x, y2, LENGTH);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum2 += took;
+            }
+        }
+        System.out.println("SIMD   average   : " + sum2 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + y2[LENGTH - 1] + ")");
+        System.out.println("SIMD   average   : " + sum2 / ((ITERS - 1)) + " ns (" + i + ": " + y2[LENGTH - 1] + ")");
+        System.out.println("SIMD   advantage : " + (sum2 / sum1));
+    }
+}
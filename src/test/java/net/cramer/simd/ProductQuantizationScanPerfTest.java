@@ -0,0 +1,96 @@
+package net.cramer.simd;
+
+import java.util.Random;
+
+public final class ProductQuantizationScanPerfTest {
+
+    private static final int ITERS = 500;
+    private static final int TRAIN_ROWS = 20_000;
+    private static final int ROWS = 1_000_000;
+    private static final int DIM = 64;
+    private static final int M = 32;
+    private static final int KSUB = 16;
+
+    private static void banner() {
+        System.out.println("****************************************");
+        System.out.println("*    ProductQuantizationScanPerfTest   *");
+        System.out.println("****************************************");
+    }
+
+    private static void javaScan(float[] table, int m, int ksub, byte[] codes, int rows, float[] out) {
+        for (int r = 0; r < rows; ++r) {
+            float sum = 0.0f;
+            for (int j = 0, k = r * m; j < m; ++j, ++k) {
+                sum += table[j * ksub + (codes[k] & 0xff)];
+            }
+            out[r] = sum;
+        }
+    }
+
+    public static void main(String[] args) {
+        banner();
+        Random rnd = new Random(42L);
+        float[] train = new float[TRAIN_ROWS * DIM];
+        for (int i = 0; i < train.length; ++i) {
+            train[i] = (float) rnd.nextGaussian();
+        }
+        float[] codebooks = new float[KSUB * DIM];
+        ProductQuantization.train(train, TRAIN_ROWS, DIM, M, KSUB, 10, codebooks);
+
+        byte[] codes = new byte[ROWS * M];
+        float[] chunk = new float[TRAIN_ROWS * DIM];
+        for (int r = 0; r < ROWS; r += TRAIN_ROWS) {
+            for (int i = 0; i < chunk.length; ++i) {
+                chunk[i] = (float) rnd.nextGaussian();
+            }
+            byte[] c = new byte[TRAIN_ROWS * M];
+            ProductQuantization.encode(chunk, TRAIN_ROWS, DIM, M, KSUB, codebooks, c);
+            System.arraycopy(c, 0, codes, r * M, c.length);
+        }
+        byte[] packed = new byte[ProductQuantization.packedLength4(ROWS, M)];
+        ProductQuantization.packCodes4(codes, ROWS, M, packed);
+
+        float[] query = new float[DIM];
+        for (int i = 0; i < query.length; ++i) {
+            query[i] = (float) rnd.nextGaussian();
+        }
+        float[] table = new float[M * KSUB];
+        ProductQuantization.distanceTableL2Squared(query, DIM, M, KSUB, codebooks, table);
+        float[] out1 = new float[ROWS];
+        float[] out2 = new float[ROWS];
+
+        javaScan(table, M, KSUB, codes, ROWS, out1);
+        System.out.println("Java   ADC distance[0]: " + out1[0]);
+
+        ProductQuantization.scan4(table, M, packed, ROWS, out2);
+        System.out.println("SIMD   ADC distance[0]: " + out2[0] + " (4 bit fast scan)");
+
+        double sum1 = 0.0;
+        double sum2 = 0.0;
+
+        int i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            javaScan(table, M, KSUB, codes, ROWS, out1);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum1 += took;
+            }
+        }
+        System.out.println("Java   average   : " + sum1 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + out1[0] + ")");
+        System.out.println("Java   average   : " + sum1 / ((ITERS - 1)) + " ns (" + i + ": " + out1[0] + ")");
+
+        i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            ProductQuantization.scan4(table, M, packed, ROWS, out2);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum2 += took;
+            }
+        }
+        System.out.println("SIMD   average   : " + sum2 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + out2[0] + ")");
+        System.out.println("SIMD   average   : " + sum2 / ((ITERS - 1)) + " ns (" + i + ": " + out2[0] + ")");
+        System.out.println("SIMD   advantage : " + (sum2 / sum1));
+    }
+}
@@ -0,0 +1,75 @@
+package net.cramer.simd;
+
+import java.util.Arrays;
+import java.util.Random;
+
+public final class QuantilesDoublePerfTest {
+
+    private static final int ITERS = 50;
+    private static final int LENGTH = 2_000_000;
+    private static final double[] PROBS = { 0.5, 0.9, 0.99, 0.999 };
+
+    private static void banner() {
+        System.out.println("****************************************");
+        System.out.println("*        QuantilesDoublePerfTest       *");
+        System.out.println("****************************************");
+    }
+
+    private static void javaQuantiles(double[] a, double[] probs, double[] out) {
+        double[] sorted = a.clone();
+        Arrays.sort(sorted);
+        for (int i = 0; i < probs.length; ++i) {
+            double h = probs[i] * (sorted.length - 1);
+            int lo = (int) h;
+            double frac = h - lo;
+            double x = sorted[lo];
+            out[i] = (frac > 0.0) ? x + frac * (sorted[Math.min(lo + 1, sorted.length - 1)] - x) : x;
+        }
+    }
+
+    public static void main(String[] args) {
+        banner();
+        Random rnd = new Random(42L);
+        // latency-like: log-normal
+        double[] a = new double[LENGTH];
+        for (int i = 0; i < a.length; ++i) {
+            a[i] = Math.exp(rnd.nextGaussian());
+        }
+        double[] out1 = new double[PROBS.length];
+        double[] out2 = new double[PROBS.length];
+
+        javaQuantiles(a, PROBS, out1);
+        System.out.println("Java   quantiles : " + Arrays.toString(out1));
+
+        Selection.quantilesDouble(a, LENGTH, PROBS, PROBS.length, out2);
+        System.out.println("SIMD   quantiles : " + Arrays.toString(out2));
+
+        double sum1 = 0.0;
+        double sum2 = 0.0;
+
+        int i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            javaQuantiles(a, PROBS, out1);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum1 += took;
+            }
+        }
+        System.out.println("Java   average   : " + sum1 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + out1[0] + ")");
+        System.out.println("Java   average   : " + sum1 / ((ITERS - 1)) + " ns (" + i + ": " + out1[0] + ")");
+
+        i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            Selection.quantilesDouble(a, LENGTH, PROBS, PROBS.length, out2);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum2 += took;
+            }
+        }
+        System.out.println("SIMD   average   : " + sum2 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + out2[0] + ")");
+        System.out.println("SIMD   average   : " + sum2 / ((ITERS - 1)) + " ns (" + i + ": " + out2[0] + ")");
+        System.out.println("SIMD   advantage : " + (sum2 / sum1));
+    }
+}
@@ -1,8 +1,10 @@
 package net.cramer.simd;
 
+import java.io.IOException;
+
 public final class RunAllComparisons {
 
-    public static void main(String[] args) {
+    public static void main(String[] args) throws IOException {
         TestInitializeSIMD.main(null);
         L1NormDoublePerfTest.main(null);
         L1NormFloatPerfTest.main(null);
@@ -10,6 +12,30 @@ public final class RunAllComparisons {
         L2NormFloatPerfTest.main(null);
         ApproxEqualDoublePerfTest.main(null);
         ApproxEqualFloatPerfTest.main(null);
+        ExpDoublePerfTest.main(null);
+        SoftmaxDoublePerfTest.main(null);
+        StatisticsDoublePerfTest.main(null);
+        CompensatedSumDoublePerfTest.main(null);
+        L2NormReproduciblePerfTest.main(null);
+        MismatchDoublePerfTest.main(null);
+        SquaredDistancesFloatPerfTest.main(null);
+        NearestNeighborsFloatPerfTest.main(null);
+        NearestNeighborsInt8PerfTest.main(null);
+        SquaredDistancesFloat16PerfTest.main(null);
+        HammingDistancesPerfTest.main(null);
+        ProductQuantizationScanPerfTest.main(null);
+        KMeansAssignPerfTest.main(null);
+        SortDoublePerfTest.main(null);
+        QuantilesDoublePerfTest.main(null);
+        HistogramDoublePerfTest.main(null);
+        PrefixSumDoublePerfTest.main(null);
+        MinMaxDoublePerfTest.main(null);
+        PipelineDoublePerfTest.main(null);
+        AlignedBufferPerfTest.main(null);
+        MappedMatrixPerfTest.main(null);
+        L2NormStreamingPerfTest.main(null);
+        MaxPinTimePerfTest.main(null);
+        AccessPolicyPerfTest.main(null);
         System.out.println("****************************************");
         System.out.println("*                FINISHED              *");
         System.out.println("****************************************");
@@ -0,0 +1,79 @@
+package net.cramer.simd;
+
+public final class SoftmaxDoublePerfTest {
+
+    private static final int ITERS = 2000;
+    private static final int ROWS = 64;
+    private static final int COLS = 16 * 1024;
+
+    private static void banner() {
+        System.out.println("****************************************");
+        System.out.println("*         SoftmaxDoublePerfTest        *");
+        System.out.println("****************************************");
+    }
+
+    private static void javaSoftmax(double[] x, double[] y, int rows, int cols) {
+        for (int row = 0; row < rows; ++row) {
+            int off = row * cols;
+            double max = Double.NEGATIVE_INFINITY;
+            for (int j = off; j < off + cols; ++j) {
+                max = Math.max(max, x[j]);
+            }
+            double sum = 0.0;
+            for (int j = off; j < off + cols; ++j) {
+                double e = Math.exp(x[j] - max);
+                y[j] = e;
+                sum += e;
+            }
+            for (int j = off; j < off + cols; ++j) {
+                y[j] /= sum;
+            }
+        }
+    }
+
+    public static void main(String[] args) {
+        banner();
+        double[] x = new double[ROWS * COLS];
+        for (int i = 0; i < x.length; ++i) {
+            x[i] = 20.0 * Math.sin(0.01 * i);
+        }
+        double[] y1 = new double[x.length];
+        double[] y2 = new double[x.length];
+
+        javaSoftmax(x, y1, ROWS, COLS);
+        VectorMath.softmaxDouble(x, y2, ROWS, COLS);
+        double maxAbsErr = 0.0;
+        for (int i = 0; i < x.length; ++i) {
+            maxAbsErr = Math.max(maxAbsErr, Math.abs(y1[i] - y2[i]));
+        }
+        System.out.println("Max. absolute error: " + maxAbsErr);
+
+        double sum1 = 0.0;
+        double sum2 = 0.0;
+
+        int i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            javaSoftmax(x, y1, ROWS, COLS);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum1 += took;
+            }
+        }
+        System.out.println("Java   average   : " + sum1 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + y1[7] + ")");
+        System.out.println("Java   average   : " + sum1 / ((ITERS - 1)) + " ns (" + i + ": " + y1[7] + ")");
+
+        i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            VectorMath.softmaxDouble(x, y2, ROWS, COLS);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum2 += took;
+            }
+        }
+        System.out.println("SIMD   average   : " + sum2 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + y2[7] + ")");
+        System.out.println("SIMD   average   : " + sum2 / ((ITERS - 1)) + " ns (" + i + ": " + y2[7] + ")");
+        System.out.println("SIMD   advantage : " + (sum2 / sum1));
+    }
+}
@@ -0,0 +1,67 @@
+package net.cramer.simd;
+
+import java.util.Arrays;
+import java.util.Random;
+
+public final class SortDoublePerfTest {
+
+    private static final int ITERS = 50;
+    private static final int LENGTH = 2_000_000;
+
+    private static void banner() {
+        System.out.println("****************************************");
+        System.out.println("*          SortDoublePerfTest          *");
+        System.out.println("****************************************");
+    }
+
+    public static void main(String[] args) {
+        banner();
+        Random rnd = new Random(42L);
+        double[] data = new double[LENGTH];
+        for (int i = 0; i < data.length; ++i) {
+            data[i] = rnd.nextGaussian();
+        }
+        double[] a1 = data.clone();
+        double[] a2 = data.clone();
+        int[] indices = new int[LENGTH];
+
+        Arrays.sort(a1);
+        System.out.println("Java   median    : " + a1[LENGTH / 2]);
+
+        Sort.sortDouble(a2, LENGTH);
+        System.out.println("SIMD   median    : " + a2[LENGTH / 2]);
+        System.out.println("SIMD   equal     : " + Arrays.equals(a1, a2));
+        Sort.argsortDouble(data, LENGTH, indices);
+        System.out.println("SIMD   argsort   : " + data[indices[LENGTH / 2]]);
+
+        double sum1 = 0.0;
+        double sum2 = 0.0;
+
+        int i = 1;
+        for (; i <= ITERS; ++i) {
+            System.arraycopy(data, 0, a1, 0, LENGTH);
+            long start = System.nanoTime();
+            Arrays.sort(a1);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum1 += took;
+            }
+        }
+        System.out.println("Java   average   : " + sum1 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + a1[0] + ")");
+        System.out.println("Java   average   : " + sum1 / ((ITERS - 1)) + " ns (" + i + ": " + a1[0] + ")");
+
+        i = 1;
+        for (; i <= ITERS; ++i) {
+            System.arraycopy(data, 0, a2, 0, LENGTH);
+            long start = System.nanoTime();
+            Sort.sortDouble(a2, LENGTH);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum2 += took;
+            }
+        }
+        System.out.println("SIMD   average   : " + sum2 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + a2[0] + ")");
+        System.out.println("SIMD   average   : " + sum2 / ((ITERS - 1)) + " ns (" + i + ": " + a2[0] + ")");
+        System.out.println("SIMD   advantage : " + (sum2 / sum1));
+    }
+}
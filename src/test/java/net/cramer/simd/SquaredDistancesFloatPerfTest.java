@@ -0,0 +1,78 @@
+package net.cramer.simd;
+
+import java.util.Random;
+
+public final class SquaredDistancesFloatPerfTest {
+
+    private static final int ITERS = 2000;
+    private static final int ROWS = 10_000;
+    private static final int DIM = 384;
+
+    private static void banner() {
+        System.out.println("****************************************");
+        System.out.println("*     SquaredDistancesFloatPerfTest    *");
+        System.out.println("****************************************");
+    }
+
+    private static void javaSquaredDistances(float[] query, float[] base, int rows, int dim, float[] out) {
+        for (int r = 0; r < rows; ++r) {
+            float sum = 0.0f;
+            for (int j = 0, k = r * dim; j < dim; ++j, ++k) {
+                float d = query[j] - base[k];
+                sum += d * d;
+            }
+            out[r] = sum;
+        }
+    }
+
+    public static void main(String[] args) {
+        banner();
+        Random rnd = new Random(42L);
+        float[] query = new float[DIM];
+        float[] base = new float[ROWS * DIM];
+        for (int i = 0; i < query.length; ++i) {
+            query[i] = (float) rnd.nextGaussian();
+        }
+        for (int i = 0; i < base.length; ++i) {
+            base[i] = (float) rnd.nextGaussian();
+        }
+        float[] out1 = new float[ROWS];
+        float[] out2 = new float[ROWS];
+
+        javaSquaredDistances(query, base, ROWS, DIM, out1);
+        System.out.println("Java   squared distance[0]: " + out1[0]);
+
+        SIMD.squaredDistancesFloat(query, base, ROWS, DIM, out2);
+        System.out.println("SIMD   squared distance[0]: " + out2[0]);
+        System.out.println("SIMD   inner product   [0]: " + SIMD.innerProductFloat(query, base, DIM));
+        System.out.println("SIMD   cosine          [0]: " + SIMD.cosineSimilarityFloat(query, base, DIM));
+
+        double sum1 = 0.0;
+        double sum2 = 0.0;
+
+        int i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            javaSquaredDistances(query, base, ROWS, DIM, out1);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum1 += took;
+            }
+        }
+        System.out.println("Java   average   : " + sum1 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + out1[0] + ")");
+        System.out.println("Java   average   : " + sum1 / ((ITERS - 1)) + " ns (" + i + ": " + out1[0] + ")");
+
+        i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            SIMD.squaredDistancesFloat(query, base, ROWS, DIM, out2);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum2 += took;
+            }
+        }
+        System.out.println("SIMD   average   : " + sum2 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + out2[0] + ")");
+        System.out.println("SIMD   average   : " + sum2 / ((ITERS - 1)) + " ns (" + i + ": " + out2[0] + ")");
+        System.out.println("SIMD   advantage : " + (sum2 / sum1));
+    }
+}
@@ -0,0 +1,74 @@
+package net.cramer.simd;
+
+import java.util.DoubleSummaryStatistics;
+
+public final class StatisticsDoublePerfTest {
+
+    private static final int ITERS = 2000;
+    private static final int N = 1024 * 1024;
+
+    private static void banner() {
+        System.out.println("****************************************");
+        System.out.println("*       StatisticsDoublePerfTest       *");
+        System.out.println("****************************************");
+    }
+
+    // the multi-pass Java way: summary statistics plus a variance pass
+    private static double javaVariance(double[] a) {
+        DoubleSummaryStatistics stats = new DoubleSummaryStatistics();
+        for (int i = 0; i < a.length; ++i) {
+            stats.accept(a[i]);
+        }
+        double mean = stats.getAverage();
+        double m2 = 0.0;
+        for (int i = 0; i < a.length; ++i) {
+            double d = a[i] - mean;
+            m2 += d * d;
+        }
+        return m2 / (stats.getCount() - 1);
+    }
+
+    public static void main(String[] args) {
+        banner();
+        double[] a = new double[N];
+        for (int i = 0; i < N; ++i) {
+            a[i] = 1.0e6 + Math.sin(0.37 * i);
+        }
+
+        double var1 = javaVariance(a);
+        System.out.println("Java   variance: " + var1);
+
+        Statistics stats = SIMD.statisticsDouble(a, N);
+        System.out.println("SIMD   variance: " + stats.variance());
+        System.out.println(stats);
+
+        double sum1 = 0.0;
+        double sum2 = 0.0;
+
+        int i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            var1 = javaVariance(a);
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum1 += took;
+            }
+        }
+        System.out.println("Java   average   : " + sum1 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + var1 + ")");
+        System.out.println("Java   average   : " + sum1 / ((ITERS - 1)) + " ns (" + i + ": " + var1 + ")");
+
+        double var2 = 0.0;
+        i = 1;
+        for (; i <= ITERS; ++i) {
+            long start = System.nanoTime();
+            var2 = SIMD.statisticsDouble(a, N).variance();
+            long took = System.nanoTime() - start;
+            if (i > 1) {
+                sum2 += took;
+            }
+        }
+        System.out.println("SIMD   average   : " + sum2 / (1_000_000.0 * (ITERS - 1)) + " ms (" + i + ": " + var2 + ")");
+        System.out.println("SIMD   average   : " + sum2 / ((ITERS - 1)) + " ns (" + i + ": " + var2 + ")");
+        System.out.println("SIMD   advantage : " + (sum2 / sum1));
+    }
+}
@@ -1,5 +1,10 @@
 package net.cramer.simd;
 
+import java.io.IOException;
+import java.nio.DoubleBuffer;
+import java.nio.file.Paths;
+import java.util.Arrays;
+
 public final class TestInitializeSIMD {
 
     private static void banner() {
@@ -16,5 +21,91 @@ public final class TestInitializeSIMD {
         System.out.println(SIMD.approxEqualFloat(null, null, 0, 0.01f, 0.01f));
         System.out.println(SIMD.distanceDouble(null, null, 0));
         System.out.println(SIMD.distanceFloat(null, null, 0));
+        VectorMath.expDouble(new double[0], new double[0], 0);
+        VectorMath.expFloat(new float[0], new float[0], 0);
+        System.out.println(VectorMath.logSumExpDouble(null, 0));
+        System.out.println(SIMD.statisticsDouble(null, 0));
+        System.out.println(SIMD.compensatedSumDouble(null, 0));
+        System.out.println(SIMD.compensatedDotFloatToDouble(null, null, 0));
+        System.out.println(SIMD.mismatchDouble(null, null, 0, 0.01, 0.01, false));
+        System.out.println(SIMD.mismatchUlpFloat(null, null, 0, 1, true));
+        System.out.println(SIMD.cosineSimilarityFloat(null, null, 0));
+        SIMD.squaredDistancesFloat(null, null, 0, 0, null);
+        NearestNeighbors.searchL2SquaredFloat(null, 0, 0, null, 0, 1, null, null);
+        System.out.println(Quantization.dotInt8(null, null, 0));
+        Quantization.quantizeInt8(null, 0, 0, null, null);
+        System.out.println(HalfPrecision.dotFloat16(null, null, 0));
+        HalfPrecision.squaredDistancesBFloat16(null, null, 0, 0, null);
+        System.out.println(BitVectors.hammingDistance(null, null, 0));
+        BitVectors.hammingDistances(null, null, 0, 0, null);
+        ProductQuantization.scan(null, 1, 16, null, 0, null);
+        System.out.println(KMeans.assignDouble(null, 0, 0, null, 0, null));
+        Sort.sortDouble((double[]) null, 0);
+        System.out.println(Selection.nthElementDouble(null, 0, 0));
+        System.out.println(SIMD.histogramDouble(null, 0, 0.0, 1.0, 1, (long[]) null, false));
+        Scan.prefixSumDouble(new double[0], new double[0], 0);
+        System.out.println(SIMD.minMaxDouble(null, 0, true));
+        System.out.println(Pipeline.builder().input(0).exp().build().sumDouble(0, new double[0]));
+        System.out.println(SIMD.arenaStats());
+        try (AlignedBuffer buf = AlignedBuffer.allocate(4096)) {
+            System.out.println(SIMD.l2normDoubleAligned(buf, 512) + " " + buf);
+            buf.asDoubleBuffer().put(7, Double.NaN);
+            if (SIMD.approxEqualDoubleAligned(buf, buf, 512, 0.0, 0.0)) {
+                throw new AssertionError("a NaN compared equal to itself");
+            }
+        }
+        // a view keeps the memory alive after free()
+        AlignedBuffer freed = AlignedBuffer.allocate(4096);
+        DoubleBuffer view = freed.asDoubleBuffer();
+        freed.free();
+        System.out.println(view.get(511) + " " + freed);
+        expectRuntimeException(() -> SIMD.l2normDoubleAligned(freed, 512));
+        try {
+            MappedMatrix.open(Paths.get("no-such-matrix-file"));
+        } catch (IOException e) {
+            System.out.println(e.getMessage());
+        }
+        System.out.println(new L2Norm().accept((double[]) null, 0));
+        System.out.println(SIMD.maxPinMicros());
+        System.out.println(SIMD.accessPolicy());
+        // an output aliasing a read-only input must share its copy
+        SIMD.setMaxPinMicros(1L);
+        double[] x = new double[1 << 20];
+        Arrays.fill(x, Math.PI / 2.0);
+        VectorMath.sincosDouble(x, x, new double[x.length], x.length);
+        SIMD.setMaxPinMicros(0L);
+        if (Math.abs(x[x.length - 1] - 1.0) > 1e-12) {
+            throw new AssertionError("aliased sincos: " + x[x.length - 1]);
+        }
+        // a NaN never compares equal, not even when both arguments are the same array
+        double[] nan = { 1.0, Double.NaN, 2.0 };
+        Mismatch self = SIMD.mismatchDouble(nan, nan, nan.length, 0.0, 0.0, false);
+        if (self.firstIndex() != 1L || self.count() != 1L) {
+            throw new AssertionError("self mismatch: " + self);
+        }
+        // the +Infinity entries of a row share the whole mass
+        double[] inf = { 1.0, Double.POSITIVE_INFINITY, 2.0, Double.POSITIVE_INFINITY };
+        VectorMath.softmaxDouble(inf, inf, 1, inf.length);
+        if (!Arrays.equals(inf, new double[] { 0.0, 0.5, 0.0, 0.5 })) {
+            throw new AssertionError("softmax +Infinity: " + Arrays.toString(inf));
+        }
+        expectRuntimeException(() -> KMeans.assignDouble(new double[4], 4, 0, new double[2], 2, new int[4]));
+        expectRuntimeException(() -> KMeans.clusterFloat(new float[4], 4, 0, 2, 10, 0.0, 1L, new float[2],
+                new int[4]));
+        expectRuntimeException(() -> ProductQuantization.scan(new float[2 * 16], 2, 16, new byte[] { 3, 16 }, 1,
+                new float[1]));
+        expectRuntimeException(() -> ProductQuantization.packCodes4(new byte[64], -1, 2, new byte[64]));
+        expectRuntimeException(() -> ProductQuantization.scan4(new float[2 * 16], 2, new byte[64],
+                Integer.MAX_VALUE, new float[1]));
+    }
+
+    private static void expectRuntimeException(Runnable call) {
+        try {
+            call.run();
+        } catch (RuntimeException e) {
+            System.out.println("expected: " + e.getMessage());
+            return;
+        }
+        throw new AssertionError("RuntimeException expected");
     }
 }